@@ -5,6 +5,7 @@
 #ifndef PAASS_CHANNELCONFIGURATION_HPP
 #define PAASS_CHANNELCONFIGURATION_HPP
 #include "TimingConfiguration.hpp"
+#include "TraceAnalysisParameters.hpp"
 #include "TrapFilterParameters.hpp"
 
 #include <set>
@@ -46,19 +47,22 @@ public:
     std::string GetPlaceName() const;
 
     ///@return subtype_
-    std::string GetSubtype() const;
+    const std::string &GetSubtype() const;
 
     ///@returns A set containing all the tags
-    std::set<std::string> GetTags() const;
+    const std::set<std::string> &GetTags() const;
 
     ///@returns timingConfiguration_
-    TimingConfiguration GetTimingConfiguration() const;
+    const TimingConfiguration &GetTimingConfiguration() const;
+
+    ///@returns traceAnalysisParameters_, the settings that the trace analyzers use
+    const TraceAnalysisParameters &GetTraceAnalysisParameters() const;
 
     ///@return triggerFilterParameters_
     TrapFilterParameters GetTriggerFilterParameters() const;
 
     ///@return type_
-    std::string GetType() const;
+    const std::string &GetType() const;
 
     ///@return traceDelayInSamples_
     unsigned int GetTraceDelayInSamples() const;
@@ -146,6 +150,9 @@ public:
     bool operator>(const ChannelConfiguration &rhs) const;
 
 private:
+    ///Fills traceAnalysisParameters_ from the current settings, the setters that it depends on call this.
+    void ResolveTraceAnalysisParameters();
+
     double baselineThreshold_; ///< The threshold for the baseline to handle noisy traces.
     unsigned int discriminationStartInSamples_; ///< The position from the max that we'll do particle discrimination
     TrapFilterParameters energyFilterParameters_; ///< Parameters to use for energy filter calculations
@@ -153,6 +160,7 @@ private:
     std::string subtype_; ///< Specifies the detector sub type
     std::set<std::string> tags_; ///< A list of associated tags
     TimingConfiguration timingConfiguration_; //!< The timing configuration for the CFD and Fit
+    TraceAnalysisParameters traceAnalysisParameters_; ///< The settings for the trace analyzers
     unsigned int traceDelayInSamples_; ///< The trace delay to help find the location of waveforms in traces
     TrapFilterParameters triggerFilterParameters_; ///< Parameters to use for trigger filter calculations
     std::string type_; ///< Specifies the detector type
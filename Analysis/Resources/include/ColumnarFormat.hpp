@@ -0,0 +1,76 @@
+///@file ColumnarFormat.hpp
+///@brief Constants describing the chunked columnar files written by ColumnarWriter and read by ColumnarReader.
+///@date October 17, 2026
+///
+/// All numbers are stored in the byte order of the machine that wrote the file, which is little endian on all of the
+/// systems that we support. A file is laid out as follows.
+///
+/// Header
+///     char[8]     magic, "PAASSCOL"
+///     uint32      version
+///     uint32      number of columns
+///     for each column
+///         uint16      length of the name
+///         char[]      name, e.g. "vandle.qdc"
+///         char        type, the ROOT leaf type, one of B b O S s I i F f D d L l
+///         uint32      number of values in each row, larger than one for fixed arrays
+/// Chunks, one after the other
+///     uint32      number of rows
+///     for each column
+///         uint8       compression, see Compression
+///         uint64      number of bytes stored in the file
+///         uint64      number of bytes after decompression, rows * values * size of the type
+///         double      smallest value in the chunk
+///         double      largest value in the chunk
+///     for each column
+///         char[]      the values, row after row, compressed as a single LZ4 block if requested
+/// Footer
+///     uint64[]    offset of each chunk from the beginning of the file
+///     uint64      number of chunks
+///     char[8]     magic, "PAASSEND"
+///
+/// A file without the footer, e.g. from a scan that crashed, can still be read up to its last complete chunk. The
+/// values of uncompressed columns can be memory-mapped directly from the offsets that the chunk headers give.
+#ifndef PAASS_COLUMNARFORMAT_HPP
+#define PAASS_COLUMNARFORMAT_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace ColumnarFormat {
+    ///The magic bytes at the beginning of the file
+    static const char headerMagic[] = "PAASSCOL";
+    ///The magic bytes at the end of a complete file
+    static const char footerMagic[] = "PAASSEND";
+    ///The number of magic bytes
+    static const size_t magicSize = 8;
+    ///The version of the format, files with a different version are not read.
+    static const uint32_t version = 1;
+    ///The number of bytes that describe a column in the header of a chunk
+    static const size_t columnChunkHeaderSize = 1 + 8 + 8 + 8 + 8;
+
+    ///The ways that the values of a column in a chunk can be stored
+    enum Compression {
+        NONE = 0, ///< The values are stored as they are
+        LZ4 = 1 ///< The values are stored as one LZ4 block
+    };
+
+    ///@param[in] type : The ROOT leaf type of a column
+    ///@return The size of the type in bytes, or zero if the format does not support the type
+    inline size_t GetTypeSize(const char &type) {
+        switch (type) {
+            case 'B': case 'b': case 'O':
+                return 1;
+            case 'S': case 's':
+                return 2;
+            case 'I': case 'i': case 'F': case 'f':
+                return 4;
+            case 'D': case 'd': case 'L': case 'l':
+                return 8;
+            default:
+                return 0;
+        }
+    }
+}
+
+#endif //PAASS_COLUMNARFORMAT_HPP
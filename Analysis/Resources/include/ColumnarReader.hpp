@@ -0,0 +1,119 @@
+///@file ColumnarReader.hpp
+///@brief Class that reads the chunked columnar files written by ColumnarWriter.
+///@date October 17, 2026
+#ifndef PAASS_COLUMNARREADER_HPP
+#define PAASS_COLUMNARREADER_HPP
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstring>
+#include <stdint.h>
+
+#include "ColumnarFormat.hpp"
+
+///A class that reads the files laid out as described in ColumnarFormat.hpp. The constructor reads the header and the
+/// headers of all of the chunks, the values are read one column of one chunk at a time.
+class ColumnarReader {
+public:
+    ///Structure describing a column
+    struct Column {
+        std::string name; ///< The name of the column, e.g. "vandle.qdc"
+        char type; ///< The ROOT leaf type of the values
+        uint32_t count; ///< The number of values in each row
+        size_t size; ///< The number of bytes in each row
+    };
+
+    ///Structure describing the values of one column in one chunk
+    struct ColumnChunk {
+        uint8_t compression; ///< How the values are stored, see ColumnarFormat::Compression
+        uint64_t offset; ///< The offset of the stored values from the beginning of the file
+        uint64_t storedSize; ///< The number of bytes stored in the file
+        uint64_t rawSize; ///< The number of bytes after decompression
+        double minimum; ///< The smallest value in the chunk
+        double maximum; ///< The largest value in the chunk
+    };
+
+    ///Structure describing a chunk
+    struct Chunk {
+        uint32_t numberOfRows; ///< The number of rows in the chunk
+        unsigned long long firstRow; ///< The number of rows in the chunks before this one
+        std::vector<ColumnChunk> columns; ///< The values of each column
+    };
+
+    ///Constructor, reads the header and the headers of the chunks
+    ///@param[in] fileName : The name of the file that we read
+    ///@throws invalid_argument if the file cannot be opened, is not a columnar file or has a different version
+    ColumnarReader(const std::string &fileName);
+
+    ///Default destructor
+    ~ColumnarReader() {}
+
+    ///@return The chunks of the file
+    const std::vector<Chunk> &GetChunks() const { return chunks_; }
+
+    ///@return The columns of the file
+    const std::vector<Column> &GetColumns() const { return columns_; }
+
+    ///@param[in] name : The name of the column
+    ///@return The index of the column
+    ///@throws invalid_argument if there is no column with that name
+    size_t GetColumnIndex(const std::string &name) const;
+
+    ///@return The number of rows in the file
+    unsigned long long GetNumberOfRows() const { return numberOfRows_; }
+
+    ///@return True if the file has its footer, i.e. the writer closed it properly
+    bool IsComplete() const { return isComplete_; }
+
+    ///Reads the values of one column in one chunk
+    ///@param[in] chunk : The index of the chunk
+    ///@param[in] column : The index of the column
+    ///@param[out] values : The values, resized to the number of bytes that the column has in the chunk
+    ///@throws out_of_range if the chunk or the column don't exist
+    ///@throws runtime_error if the values cannot be read or decompressed
+    void ReadChunk(const size_t &chunk, const size_t &column, std::vector<char> &values);
+
+    ///Reads all of the values of a column
+    ///@param[in] name : The name of the column
+    ///@return The values, row after row
+    ///@throws invalid_argument if there is no column with that name or T does not have the size of its type
+    template<typename T>
+    std::vector<T> ReadColumn(const std::string &name) {
+        size_t column = GetColumnIndex(name);
+        if (sizeof(T) != ColumnarFormat::GetTypeSize(columns_[column].type))
+            throw std::invalid_argument("ColumnarReader::ReadColumn - The type does not have the size of the values "
+                                                "of " + name + ".");
+        std::vector<T> result(numberOfRows_ * columns_[column].count);
+        std::vector<char> values;
+        for (size_t chunk = 0; chunk < chunks_.size(); chunk++) {
+            ReadChunk(chunk, column, values);
+            memcpy(result.data() + chunks_[chunk].firstRow * columns_[column].count, values.data(), values.size());
+        }
+        return result;
+    }
+
+private:
+    ///Reads the headers of the chunks from the offsets in the footer
+    ///@return False if the file has no valid footer
+    bool ReadFooter();
+
+    ///Reads the header of the chunk at an offset and appends it to the chunks
+    ///@param[in] offset : The offset of the chunk from the beginning of the file
+    ///@return The offset after the chunk, or zero if the chunk is incomplete
+    uint64_t ReadChunkHeader(const uint64_t &offset);
+
+    std::string fileName_; ///< The name of the file
+    std::ifstream file_; ///< The file that we read
+    uint64_t fileSize_; ///< The number of bytes in the file
+    uint64_t dataOffset_; ///< The offset of the first chunk
+    std::vector<Column> columns_; ///< The columns
+    std::vector<Chunk> chunks_; ///< The chunks
+    std::vector<char> compressed_; ///< The buffer for compressed values
+    unsigned long long numberOfRows_; ///< The number of rows in the file
+    bool isComplete_; ///< True if the file has its footer
+};
+
+#endif //PAASS_COLUMNARREADER_HPP
@@ -0,0 +1,81 @@
+///@file ColumnarWriter.hpp
+///@brief Class that writes rows of fixed-width values into a chunked columnar file.
+///@date October 17, 2026
+#ifndef PAASS_COLUMNARWRITER_HPP
+#define PAASS_COLUMNARWRITER_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+///A class that writes the structures of the processors into a file laid out as described in ColumnarFormat.hpp. The
+/// structures are registered with the same leaf lists that ROOT uses for TTree::Branch, every leaf becomes a column.
+/// Fill copies the current contents of the structures into the next row. Once a chunk has all of its rows, each
+/// column is compressed on its own and written together with its smallest and largest value, so that readers can
+/// skip chunks without decompressing them.
+class ColumnarWriter {
+public:
+    ///Constructor
+    ///@param[in] fileName : The name of the file that we write
+    ///@param[in] rowsPerChunk : The number of rows in each chunk
+    ///@param[in] compress : True if the columns are compressed with LZ4
+    ///@throws invalid_argument if the file cannot be opened or rowsPerChunk is zero
+    ColumnarWriter(const std::string &fileName, const unsigned int &rowsPerChunk = 65536, const bool &compress = true);
+
+    ///Destructor, closes the file
+    ~ColumnarWriter();
+
+    ///Adds a column for every leaf of a structure. The columns are named after the structure and the leaf, e.g.
+    /// "vandle.qdc". A leaf without a type has the type of the leaf before it, the first leaf defaults to F.
+    ///@param[in] name : The name of the structure
+    ///@param[in] address : The structure, laid out like the leaf list without padding
+    ///@param[in] leaflist : The leaf definition of the structure, e.g. "qdc/D:time:id/i"
+    ///@throws logic_error if rows were already filled
+    ///@throws invalid_argument if the leaf list has strings, arrays of variable length or unknown types
+    void AddColumns(const std::string &name, const void *address, const std::string &leaflist);
+
+    ///Writes the last chunk and the footer and closes the file. Nothing can be filled afterwards.
+    void Close();
+
+    ///Copies the current contents of the structures into the next row
+    ///@throws logic_error if the file was closed
+    void Fill();
+
+    ///@return The number of columns
+    size_t GetNumberOfColumns() const { return columns_.size(); }
+
+    ///@return The number of rows that were filled
+    unsigned long long GetNumberOfRows() const { return numberOfRows_; }
+
+private:
+    ///Structure holding a column and the values of the current chunk
+    struct Column {
+        std::string name; ///< The name of the column
+        char type; ///< The ROOT leaf type of the values
+        uint32_t count; ///< The number of values in each row
+        size_t size; ///< The number of bytes in each row
+        const char *source; ///< The values in the structure of the processor
+        std::vector<char> values; ///< The values of the rows in the current chunk
+    };
+
+    ///Writes the header of the file
+    void WriteHeader();
+
+    ///Writes the rows that were filled since the last chunk
+    void WriteChunk();
+
+    std::string fileName_; ///< The name of the file
+    std::ofstream file_; ///< The file that we write
+    std::vector<Column> columns_; ///< The columns
+    std::vector<uint64_t> chunkOffsets_; ///< The offsets of the chunks that were written
+    std::vector<char> compressed_; ///< The buffer for the compressed values of one column
+    unsigned int rowsPerChunk_; ///< The number of rows in each chunk
+    unsigned int rowsInChunk_; ///< The number of rows filled since the last chunk
+    unsigned long long numberOfRows_; ///< The number of rows that were filled
+    bool compress_; ///< True if the columns are compressed
+    bool hasHeader_; ///< True once the header was written
+};
+
+#endif //PAASS_COLUMNARWRITER_HPP
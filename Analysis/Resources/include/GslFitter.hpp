@@ -7,6 +7,10 @@
 
 #include "TimingDriver.hpp"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_fit.h>
 #include <gsl/gsl_multifit_nlin.h>
@@ -18,23 +22,29 @@ public:
     ///Default Constructor
     GslFitter();
 
-    ///Default Destructor
+    ///Default Destructor, frees the workspaces
     ~GslFitter();
 
+    ///The workspaces belong to a single fitter, so the fitter cannot be copied.
+    GslFitter(const GslFitter &) = delete;
+
+    ///The workspaces belong to a single fitter, so the fitter cannot be assigned.
+    GslFitter &operator=(const GslFitter &) = delete;
+
     ///The ever important phase calculation
     /// @param[in] data The baseline subtracted data for the fitting
     /// @param[in] pars The parameters for the fit
     /// @param[in] max : Information about the maximum position and value
     /// @param[in] baseline : The average and standard deviation of the baseline
-    double CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
-                          const std::pair<unsigned int, double> &max, const std::pair<double, double> baseline);
+    double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                          const std::pair<unsigned int, double> &max, const std::pair<double, double> &baseline);
 
     /// @brief Structure that holds information required by the GSL fitting routines to calculate the value of the
     /// function being fit. It's required by GSL so that the signature of the function, jacobian, and derivative
     /// methods are as expected.
     struct FitConfiguration {
         size_t n;//!< The number of data points that we are fitting.
-        double *y;//!< The actual data that we are fitting.
+        const double *y;//!< The actual data that we are fitting, we point straight at the caller's samples.
         double *weight;//!< The weights for the fit
         double beta; //!< The beta parameter for the fit. We do not use this parameter for Gaussian fits.
         double gamma; //!< The gamma parameter for the fit. This is the only parameter used for Gaussian fits.
@@ -42,6 +52,22 @@ public:
     };
 
 private:
+    ///@brief The GSL objects that a fit needs. GSL sizes a solver for an exact number of data points and
+    /// parameters, and allocating it costs about as much as fitting a short waveform. We keep a workspace for each
+    /// size that we have fit, which is only a few since the waveform bounds are set per channel, and every fit of
+    /// that size reuses it. A fitter is used by a single thread, so the workspaces are not shared.
+    struct Workspace {
+        gsl_multifit_fdfsolver *solver; //!< The Levenberg-Marquardt solver
+        gsl_matrix *covarianceMatrix; //!< The covariance matrix of the fitted parameters
+        gsl_matrix *jacobian; //!< The Jacobian at the solution, only used by GSL v2+
+        std::vector<double> weights; //!< The weights of the data points
+    };
+
+    ///@param[in] numDataPoints : The number of data points in the fit
+    ///@param[in] numParameters : The number of parameters in the fit
+    ///@return The workspace for fits of this size, allocated the first time that we see the size.
+    Workspace &GetWorkspace(const size_t &numDataPoints, const size_t &numParameters);
+
     ///Defines the GSL fitting function for standard PMTs
     ///@param [in] x : the vector of gsl starting parameters
     ///@param [in] FitConfiguration : The data to use for the fit
@@ -106,5 +132,7 @@ private:
     double amp_; //!< The amplitude calculated by the fit
     double chi_; //!< The chi calculated from the fit
     double dof_; //!< The degrees of freedom in the fit.
+
+    std::map<std::pair<size_t, size_t>, Workspace> workspaces_; //!< The workspaces by (data points, parameters)
 };
 #endif //PAASS_LC_GSLFITTER_HPP
\ No newline at end of file
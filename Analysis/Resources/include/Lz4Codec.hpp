@@ -0,0 +1,36 @@
+///@file Lz4Codec.hpp
+///@brief Compression and decompression of single blocks in the LZ4 block format.
+///@date October 17, 2026
+#ifndef PAASS_LZ4CODEC_HPP
+#define PAASS_LZ4CODEC_HPP
+
+#include <vector>
+
+#include <cstddef>
+
+///A self-contained implementation of the LZ4 block format, so that the output of the scan can be compressed without
+/// an external library. The compressor is the greedy single-pass variant with a hash table of four byte sequences. It
+/// is slower and compresses a bit less than the reference implementation, but its blocks can be decompressed by any
+/// LZ4 decoder, e.g. lz4.block.decompress in Python, and this decoder reads blocks from any LZ4 encoder.
+class Lz4Codec {
+public:
+    ///@param[in] size : The number of bytes that we want to compress
+    ///@return The largest number of bytes that Compress can produce from size bytes
+    static size_t GetMaximumCompressedSize(const size_t &size) { return size + size / 255 + 16; }
+
+    ///Compresses a block of data
+    ///@param[in] source : The data that we want to compress
+    ///@param[in] size : The number of bytes in source
+    ///@param[out] destination : The compressed block, resized to the number of bytes that were written
+    static void Compress(const char *source, const size_t &size, std::vector<char> &destination);
+
+    ///Decompresses a block of data
+    ///@param[in] source : The compressed block
+    ///@param[in] size : The number of bytes in source
+    ///@param[out] destination : The buffer that receives the data, it has to hold rawSize bytes
+    ///@param[in] rawSize : The number of bytes that the block decompresses to
+    ///@return True if the block was valid and decompressed to exactly rawSize bytes
+    static bool Decompress(const char *source, const size_t &size, char *destination, const size_t &rawSize);
+};
+
+#endif //PAASS_LZ4CODEC_HPP
@@ -16,8 +16,8 @@ public:
     ~PolynomialCfd();
 
     /// Perform CFD analysis on the waveform using the pol2 algorithm.
-    double CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
-                          const std::pair<unsigned int, double> &max, const std::pair<double, double> baseline);
+    double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                          const std::pair<unsigned int, double> &max, const std::pair<double, double> &baseline);
 };
 
 #endif //PIXIESUITE_POLYNOMIALCFD_HPP
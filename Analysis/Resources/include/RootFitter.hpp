@@ -8,6 +8,7 @@
 #include "TimingDriver.hpp"
 
 class TF1;
+class TGraph;
 class VandleTimingFunction;
 class TimingConfiguration;
 
@@ -18,11 +19,18 @@ public:
     ~RootFitter();
 
     /// Perform fitting analysis using ROOT
-    double CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
-                          const std::pair<unsigned int, double> &maxInfo, std::pair<double, double> baseline);
+    double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                          const std::pair<unsigned int, double> &maxInfo, const std::pair<double, double> &baseline);
+
+    ///The function and the graph belong to a single fitter, so the fitter cannot be copied.
+    RootFitter(const RootFitter &) = delete;
+
+    ///The function and the graph belong to a single fitter, so the fitter cannot be assigned.
+    RootFitter &operator=(const RootFitter &) = delete;
 
 private:
     TF1 *func_;
+    TGraph *graph_; ///< The graph that we fit, resized and refilled for every waveform instead of being recreated
     VandleTimingFunction *vandleTimingFunction_;
 };
 
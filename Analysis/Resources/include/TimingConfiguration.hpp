@@ -13,7 +13,7 @@
 /// data types, which is not possible with a map.
 class TimingConfiguration {
 public:
-    /// Default Constructor
+    /// Default Constructor, sets the default CFD and fitting parameters from DefaultConfigurationValues.hpp
     TimingConfiguration();
 
     /// Default Destructor
@@ -9,6 +9,8 @@
 #include <utility>
 #include <vector>
 
+#include "SampleSpan.hpp"
+
 class TimingConfiguration;
 
 /// An abstract class that will be used to handle timing.
@@ -30,21 +32,21 @@ public:
     ///This is a virtual function that actually defines how we are going to determine the phase. We have several
     /// different implementations of how we can do this but we'll overload this method in the children to provide
     /// specific implementation.
-    ///@param[in] data : The vector of data that we are going to work with. This usually means a trace or waveform.
+    ///@param[in] data : The raw samples that we are going to work with. A vector converts to the span without a copy.
     ///@param[in] cfg : Timing configuration to use for the various drivers.
     ///@param[in] maxInfo : The information about the maximum in a pair of <position, value> NOTE : The value of the
     /// maximum for CFD based calculations should be the extrapolated maximum.
     ///@param[in] a : The baseline information in a pair<baseline, stddev>
     ///@return The phase calculated by the algorithm.
-    virtual double CalculatePhase(const std::vector<unsigned int> &data,  const TimingConfiguration &cfg,
+    virtual double CalculatePhase(const SampleSpan<unsigned short> &data, const TimingConfiguration &cfg,
                                   const std::pair<unsigned int, double> &max,
-                                  const std::pair<double, double> baseline) { return 0.0; }
+                                  const std::pair<double, double> &baseline) { return 0.0; }
 
-    ///@Brief Overload of the Calculate phase method to allow for data vectors of type double. We do this since we
-    // cannot template a virtual method.
-    virtual double CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
+    ///@Brief Overload of the Calculate phase method to allow for data of type double, usually the baseline
+    /// subtracted waveform. We do this since we cannot template a virtual method.
+    virtual double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
                                   const std::pair<unsigned int, double> &max,
-                                  const std::pair<double, double> baseline)  { return 0.0; }
+                                  const std::pair<double, double> &baseline)  { return 0.0; }
 
     /// @return the amplitude from fits
     virtual double GetAmplitude(void) { return 0.0; }
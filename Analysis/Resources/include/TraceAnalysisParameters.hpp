@@ -0,0 +1,22 @@
+///@file TraceAnalysisParameters.hpp
+///@brief The settings of a channel that the trace analyzers need, resolved when the channel is configured.
+///@date October 17, 2026
+#ifndef PAASS_TRACEANALYSISPARAMETERS_HPP
+#define PAASS_TRACEANALYSISPARAMETERS_HPP
+
+#include "TimingConfiguration.hpp"
+
+#include <utility>
+
+///The trace analyzers run on every trace, so they should not look up tags or compare types to find out how to treat
+/// a channel. ChannelConfiguration fills this structure whenever one of the settings that it depends on changes, and
+/// the analyzers only read it.
+struct TraceAnalysisParameters {
+    ///The timing configuration of the channel, with the fast SiPM flag already set for the channels that need it.
+    /// The QDC is not part of it since it belongs to each trace.
+    TimingConfiguration timingConfiguration;
+    unsigned int traceDelayInSamples = 0; ///< The trace delay in samples
+    std::pair<unsigned int, unsigned int> waveformBoundsInSamples; ///< The low and high bound of the waveform
+};
+
+#endif //PAASS_TRACEANALYSISPARAMETERS_HPP
@@ -0,0 +1,70 @@
+///@file TraceKernels.hpp
+///@brief Vectorized kernels for the quantities that we calculate from every trace.
+///@date October 17, 2026
+#ifndef PAASS_TRACEKERNELS_HPP
+#define PAASS_TRACEKERNELS_HPP
+
+#include "SampleSpan.hpp"
+
+#include <utility>
+
+#include <cstddef>
+
+///Kernels over the raw 16-bit samples of a trace that calculate the maximum, the baseline and the QDC. They give the
+/// same answers as the functions in the TraceFunctions namespace, but work on integer sums so that the baseline
+/// subtracted trace never has to be calculated. Each kernel has a scalar version and, on x86, versions using SSE2,
+/// AVX2 and AVX-512. The best version that the CPU supports is picked the first time that a kernel is called, a
+/// specific one can be requested for testing.
+class TraceKernels {
+public:
+    ///The instruction sets that the kernels can use
+    enum InstructionSet {
+        SCALAR = 0, ///< Plain C++, always supported
+        SSE2 = 1, ///< 128 bit vectors
+        AVX2 = 2, ///< 256 bit vectors
+        AVX512 = 3 ///< 512 bit vectors, needs AVX-512F and AVX-512BW
+    };
+
+    ///The baseline and the QDC of a waveform
+    struct BaselineAndQdc {
+        std::pair<double, double> baseline; ///< The average and standard deviation of the baseline
+        double qdc; ///< The QDC of the waveform with the baseline subtracted
+    };
+
+    ///@return The best instruction set that the CPU supports, determined once
+    static InstructionSet GetBestInstructionSet();
+
+    ///@param[in] instructionSet : The instruction set that we want to check
+    ///@return True if this build and the CPU both support the instruction set
+    static bool IsSupported(const InstructionSet &instructionSet);
+
+    ///Finds the first sample with the largest value in a range of the trace, like std::max_element.
+    ///@param[in] samples : The samples of the trace
+    ///@param[in] begin : The first sample of the range
+    ///@param[in] end : One past the last sample of the range
+    ///@param[in] instructionSet : The instruction set to use
+    ///@return The position of the maximum in the trace and its value
+    ///@throws range_error if the range is empty or does not fit into the trace
+    ///@throws invalid_argument if the instruction set is not supported
+    static std::pair<unsigned int, double> FindMaximum(const SampleSpan<unsigned short> &samples, const size_t &begin,
+                                                       const size_t &end,
+                                                       const InstructionSet &instructionSet = GetBestInstructionSet());
+
+    ///Calculates the baseline from the samples in [0, baselineEnd) and the QDC of the waveform in [baselineEnd,
+    /// waveformEnd) in a single pass over the samples. The baseline is the average and the population standard
+    /// deviation, like TraceFunctions::CalculateBaseline. The QDC is the trapezoidal integral of the waveform with the
+    /// baseline subtracted, like TraceFunctions::CalculateQdc on the baseline subtracted trace.
+    ///@param[in] samples : The samples of the trace, at most 65536 of them so that the sums are exact
+    ///@param[in] baselineEnd : One past the last sample of the baseline and the first sample of the waveform
+    ///@param[in] waveformEnd : One past the last sample of the waveform
+    ///@param[in] instructionSet : The instruction set to use
+    ///@return The baseline and the QDC
+    ///@throws range_error if the baseline is empty, the waveform has less than two samples or does not fit into the
+    /// trace, or the trace has too many samples
+    ///@throws invalid_argument if the instruction set is not supported
+    static BaselineAndQdc CalculateBaselineAndQdc(const SampleSpan<unsigned short> &samples,
+                                                  const size_t &baselineEnd, const size_t &waveformEnd,
+                                                  const InstructionSet &instructionSet = GetBestInstructionSet());
+};
+
+#endif //PAASS_TRACEKERNELS_HPP
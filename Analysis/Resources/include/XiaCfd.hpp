@@ -19,7 +19,14 @@ public:
 
     /// Calculates the phase using an approximated XIA CFD method.
     /// @param[in] pars : A pair containing (fraction, delay)
-    double CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg);
+    double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg);
+
+    /// Overrides the TimingDriver method so that the analyzers reach this driver through the base class. The CFD
+    /// does not need the maximum or the baseline.
+    double CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                          const std::pair<unsigned int, double> &max, const std::pair<double, double> &baseline) {
+        return CalculatePhase(data, cfg);
+    }
 
     std::vector<double> GetCfd();
 
@@ -9,14 +9,18 @@
 #include <iomanip>
 #include <iostream>
 
-ChannelConfiguration::ChannelConfiguration() : location_(9999), subtype_(""), type_("") {}
+ChannelConfiguration::ChannelConfiguration() : location_(9999), subtype_(""), traceDelayInSamples_(0), type_("") {}
 
 ChannelConfiguration::~ChannelConfiguration() = default;
 
 ChannelConfiguration::ChannelConfiguration(const std::string &atype, const std::string &subType,
-                                           const unsigned int &loc) : location_(loc), subtype_(subType), type_(atype) {}
+                                           const unsigned int &loc) : location_(loc), subtype_(subType),
+                                                                      traceDelayInSamples_(0), type_(atype) {}
 
-void ChannelConfiguration::AddTag(const std::string &s) { tags_.insert(s); }
+void ChannelConfiguration::AddTag(const std::string &s) {
+    tags_.insert(s);
+    ResolveTraceAnalysisParameters();
+}
 
 double ChannelConfiguration::GetBaselineThreshold() const { return baselineThreshold_; }
 
@@ -30,15 +34,19 @@ std::string ChannelConfiguration::GetPlaceName() const {
     return type_ + "_" + subtype_ + "_" + std::to_string(location_);
 }
 
-std::string ChannelConfiguration::GetSubtype() const { return subtype_; }
+const std::string &ChannelConfiguration::GetSubtype() const { return subtype_; }
+
+const std::set<std::string> &ChannelConfiguration::GetTags() const { return tags_; }
 
-std::set<std::string> ChannelConfiguration::GetTags() const { return tags_; }
+const TimingConfiguration &ChannelConfiguration::GetTimingConfiguration() const { return timingConfiguration_; }
 
-TimingConfiguration ChannelConfiguration::GetTimingConfiguration() const { return timingConfiguration_; }
+const TraceAnalysisParameters &ChannelConfiguration::GetTraceAnalysisParameters() const {
+    return traceAnalysisParameters_;
+}
 
 TrapFilterParameters ChannelConfiguration::GetTriggerFilterParameters() const { return triggerFilterParameters_; }
 
-std::string ChannelConfiguration::GetType() const { return type_; }
+const std::string &ChannelConfiguration::GetType() const { return type_; }
 
 unsigned int ChannelConfiguration::GetTraceDelayInSamples() const { return traceDelayInSamples_; }
 
@@ -58,6 +66,15 @@ void ChannelConfiguration::Print(void) const {
     std::cout << std::endl;
 }
 
+void ChannelConfiguration::ResolveTraceAnalysisParameters() {
+    traceAnalysisParameters_.timingConfiguration = timingConfiguration_;
+    //The fast output of the double beta SiPMs is fit with a Gaussian instead of the PMT function.
+    if (type_ == "beta" && subtype_ == "double" && HasTag("timing"))
+        traceAnalysisParameters_.timingConfiguration.SetIsFastSiPm(true);
+    traceAnalysisParameters_.traceDelayInSamples = traceDelayInSamples_;
+    traceAnalysisParameters_.waveformBoundsInSamples = waveformBoundsInSeconds_;
+}
+
 void ChannelConfiguration::SetBaselineThreshold(const double &a) { baselineThreshold_ = a; }
 
 void ChannelConfiguration::SetDiscriminationStartInSamples(const unsigned int &a) { discriminationStartInSamples_ = a; }
@@ -66,18 +83,31 @@ void ChannelConfiguration::SetEnergyFilterParameters(const TrapFilterParameters
 
 void ChannelConfiguration::SetLocation(const unsigned int &a) { location_ = a; }
 
-void ChannelConfiguration::SetSubtype(const std::string &a) { subtype_ = a; }
+void ChannelConfiguration::SetSubtype(const std::string &a) {
+    subtype_ = a;
+    ResolveTraceAnalysisParameters();
+}
 
-void ChannelConfiguration::SetTimingConfiguration(const TimingConfiguration &a) { timingConfiguration_ = a; }
+void ChannelConfiguration::SetTimingConfiguration(const TimingConfiguration &a) {
+    timingConfiguration_ = a;
+    ResolveTraceAnalysisParameters();
+}
 
-void ChannelConfiguration::SetTraceDelayInSamples(const unsigned int &a) { traceDelayInSamples_ = a; }
+void ChannelConfiguration::SetTraceDelayInSamples(const unsigned int &a) {
+    traceDelayInSamples_ = a;
+    ResolveTraceAnalysisParameters();
+}
 
 void ChannelConfiguration::SetTriggerFilterParameters(const TrapFilterParameters &a) { triggerFilterParameters_ = a; }
 
-void ChannelConfiguration::SetType(const std::string &a) { type_ = a; }
+void ChannelConfiguration::SetType(const std::string &a) {
+    type_ = a;
+    ResolveTraceAnalysisParameters();
+}
 
 void ChannelConfiguration::SetWaveformBoundsInSamples(const std::pair<unsigned int, unsigned int> &a) {
     waveformBoundsInSeconds_ = a;
+    ResolveTraceAnalysisParameters();
 }
 
 void ChannelConfiguration::Zero() {
@@ -85,6 +115,7 @@ void ChannelConfiguration::Zero() {
     type_ = "";
     subtype_ = "";
     tags_.clear();
+    ResolveTraceAnalysisParameters();
 }
 
 bool ChannelConfiguration::operator==(const ChannelConfiguration &rhs) const {
@@ -0,0 +1,148 @@
+///@file ColumnarReader.cpp
+///@brief Class that reads the chunked columnar files written by ColumnarWriter.
+///@date October 17, 2026
+#include "ColumnarReader.hpp"
+
+#include "Lz4Codec.hpp"
+
+using namespace std;
+
+namespace {
+    template<typename T>
+    bool Read(ifstream &file, T &value) {
+        file.read((char *) &value, sizeof(T));
+        return file.good();
+    }
+}
+
+ColumnarReader::ColumnarReader(const std::string &fileName) : fileName_(fileName), fileSize_(0), dataOffset_(0),
+                                                               numberOfRows_(0), isComplete_(false) {
+    file_.open(fileName.c_str(), ios::binary);
+    if (!file_.good())
+        throw invalid_argument("ColumnarReader::ColumnarReader - Unable to open " + fileName + ".");
+    file_.seekg(0, ios::end);
+    fileSize_ = (uint64_t) file_.tellg();
+    file_.seekg(0, ios::beg);
+
+    char magic[ColumnarFormat::magicSize];
+    uint32_t version = 0, numberOfColumns = 0;
+    file_.read(magic, ColumnarFormat::magicSize);
+    if (!file_.good() || strncmp(magic, ColumnarFormat::headerMagic, ColumnarFormat::magicSize) != 0)
+        throw invalid_argument("ColumnarReader::ColumnarReader - " + fileName + " is not a columnar file.");
+    if (!Read(file_, version) || version != ColumnarFormat::version)
+        throw invalid_argument("ColumnarReader::ColumnarReader - " + fileName + " was written with a different "
+                "version of the format.");
+    if (!Read(file_, numberOfColumns))
+        throw invalid_argument("ColumnarReader::ColumnarReader - The header of " + fileName + " is incomplete.");
+
+    for (uint32_t i = 0; i < numberOfColumns; i++) {
+        uint16_t length = 0;
+        Column column;
+        if (!Read(file_, length))
+            throw invalid_argument("ColumnarReader::ColumnarReader - The header of " + fileName + " is incomplete.");
+        column.name.resize(length);
+        file_.read(&column.name[0], length);
+        if (!Read(file_, column.type) || !Read(file_, column.count))
+            throw invalid_argument("ColumnarReader::ColumnarReader - The header of " + fileName + " is incomplete.");
+        column.size = column.count * ColumnarFormat::GetTypeSize(column.type);
+        if (column.size == 0)
+            throw invalid_argument("ColumnarReader::ColumnarReader - The column " + column.name + " has an unknown "
+                    "type.");
+        columns_.push_back(column);
+    }
+    dataOffset_ = (uint64_t) file_.tellg();
+
+    if (!ReadFooter()) {
+        //Without a footer we walk the chunks until we hit one that was not written completely.
+        chunks_.clear();
+        numberOfRows_ = 0;
+        for (uint64_t offset = dataOffset_; offset != 0 && offset < fileSize_;)
+            offset = ReadChunkHeader(offset);
+    }
+}
+
+size_t ColumnarReader::GetColumnIndex(const std::string &name) const {
+    for (vector<Column>::size_type i = 0; i < columns_.size(); i++)
+        if (columns_[i].name == name)
+            return i;
+    throw invalid_argument("ColumnarReader::GetColumnIndex - There is no column named " + name + " in " + fileName_
+                           + ".");
+}
+
+void ColumnarReader::ReadChunk(const size_t &chunk, const size_t &column, std::vector<char> &values) {
+    if (chunk >= chunks_.size() || column >= columns_.size())
+        throw out_of_range("ColumnarReader::ReadChunk - The chunk or the column does not exist.");
+
+    const ColumnChunk &info = chunks_[chunk].columns[column];
+    values.resize(info.rawSize);
+    file_.clear();
+    file_.seekg(info.offset);
+    if (info.compression == ColumnarFormat::NONE) {
+        file_.read(values.data(), info.rawSize);
+        if (!file_.good())
+            throw runtime_error("ColumnarReader::ReadChunk - Unable to read " + columns_[column].name + ".");
+        return;
+    }
+
+    compressed_.resize(info.storedSize);
+    file_.read(compressed_.data(), info.storedSize);
+    if (!file_.good() || !Lz4Codec::Decompress(compressed_.data(), compressed_.size(), values.data(), info.rawSize))
+        throw runtime_error("ColumnarReader::ReadChunk - Unable to decompress " + columns_[column].name + ".");
+}
+
+bool ColumnarReader::ReadFooter() {
+    const uint64_t trailerSize = sizeof(uint64_t) + ColumnarFormat::magicSize;
+    if (fileSize_ < dataOffset_ + trailerSize)
+        return false;
+
+    char magic[ColumnarFormat::magicSize];
+    uint64_t numberOfChunks = 0;
+    file_.seekg(fileSize_ - trailerSize);
+    if (!Read(file_, numberOfChunks))
+        return false;
+    file_.read(magic, ColumnarFormat::magicSize);
+    if (!file_.good() || strncmp(magic, ColumnarFormat::footerMagic, ColumnarFormat::magicSize) != 0
+        || numberOfChunks > (fileSize_ - dataOffset_ - trailerSize) / sizeof(uint64_t))
+        return false;
+
+    vector<uint64_t> offsets(numberOfChunks);
+    file_.seekg(fileSize_ - trailerSize - numberOfChunks * sizeof(uint64_t));
+    file_.read((char *) offsets.data(), numberOfChunks * sizeof(uint64_t));
+    if (!file_.good())
+        return false;
+    for (vector<uint64_t>::const_iterator it = offsets.begin(); it != offsets.end(); it++)
+        if (ReadChunkHeader(*it) == 0)
+            return false;
+    isComplete_ = true;
+    return true;
+}
+
+uint64_t ColumnarReader::ReadChunkHeader(const uint64_t &offset) {
+    Chunk chunk;
+    chunk.firstRow = numberOfRows_;
+    chunk.columns.resize(columns_.size());
+    file_.clear();
+    file_.seekg(offset);
+    if (!Read(file_, chunk.numberOfRows))
+        return 0;
+
+    uint64_t position = offset + sizeof(uint32_t) + columns_.size() * ColumnarFormat::columnChunkHeaderSize;
+    for (vector<Column>::size_type i = 0; i < columns_.size(); i++) {
+        ColumnChunk &column = chunk.columns[i];
+        if (!Read(file_, column.compression) || !Read(file_, column.storedSize) || !Read(file_, column.rawSize)
+            || !Read(file_, column.minimum) || !Read(file_, column.maximum))
+            return 0;
+        if (column.rawSize != (uint64_t) chunk.numberOfRows * columns_[i].size
+            || (column.compression == ColumnarFormat::NONE && column.storedSize != column.rawSize)
+            || column.compression > ColumnarFormat::LZ4)
+            return 0;
+        column.offset = position;
+        position += column.storedSize;
+    }
+    if (position > fileSize_)
+        return 0;
+
+    numberOfRows_ += chunk.numberOfRows;
+    chunks_.push_back(chunk);
+    return position;
+}
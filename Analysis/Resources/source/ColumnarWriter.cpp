@@ -0,0 +1,185 @@
+///@file ColumnarWriter.cpp
+///@brief Class that writes rows of fixed-width values into a chunked columnar file.
+///@date October 17, 2026
+#include "ColumnarWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "ColumnarFormat.hpp"
+#include "Lz4Codec.hpp"
+
+using namespace std;
+
+namespace {
+    template<typename T>
+    void Write(ofstream &file, const T &value) {
+        file.write((const char *) &value, sizeof(T));
+    }
+
+    ///Finds the smallest and largest of a number of values of one type
+    template<typename T>
+    void FindRange(const char *data, const size_t &numberOfValues, double &minimum, double &maximum) {
+        for (size_t i = 0; i < numberOfValues; i++) {
+            T value;
+            memcpy(&value, data + i * sizeof(T), sizeof(T));
+            minimum = min(minimum, (double) value);
+            maximum = max(maximum, (double) value);
+        }
+    }
+
+    ///Finds the smallest and largest of a number of values of a ROOT leaf type
+    void FindRange(const char &type, const char *data, const size_t &numberOfValues, double &minimum, double &maximum) {
+        minimum = numeric_limits<double>::max();
+        maximum = numeric_limits<double>::lowest();
+        switch (type) {
+            case 'B': FindRange<int8_t>(data, numberOfValues, minimum, maximum); break;
+            case 'b': case 'O': FindRange<uint8_t>(data, numberOfValues, minimum, maximum); break;
+            case 'S': FindRange<int16_t>(data, numberOfValues, minimum, maximum); break;
+            case 's': FindRange<uint16_t>(data, numberOfValues, minimum, maximum); break;
+            case 'I': FindRange<int32_t>(data, numberOfValues, minimum, maximum); break;
+            case 'i': FindRange<uint32_t>(data, numberOfValues, minimum, maximum); break;
+            case 'F': case 'f': FindRange<float>(data, numberOfValues, minimum, maximum); break;
+            case 'D': case 'd': FindRange<double>(data, numberOfValues, minimum, maximum); break;
+            case 'L': FindRange<int64_t>(data, numberOfValues, minimum, maximum); break;
+            case 'l': FindRange<uint64_t>(data, numberOfValues, minimum, maximum); break;
+            default: break;
+        }
+    }
+}
+
+ColumnarWriter::ColumnarWriter(const std::string &fileName, const unsigned int &rowsPerChunk, const bool &compress) :
+        fileName_(fileName), rowsPerChunk_(rowsPerChunk), rowsInChunk_(0), numberOfRows_(0), compress_(compress),
+        hasHeader_(false) {
+    if (rowsPerChunk == 0)
+        throw invalid_argument("ColumnarWriter::ColumnarWriter - A chunk needs at least one row.");
+    file_.open(fileName.c_str(), ios::binary | ios::trunc);
+    if (!file_.good())
+        throw invalid_argument("ColumnarWriter::ColumnarWriter - Unable to open " + fileName + " for writing.");
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    Close();
+}
+
+void ColumnarWriter::AddColumns(const std::string &name, const void *address, const std::string &leaflist) {
+    if (hasHeader_)
+        throw logic_error("ColumnarWriter::AddColumns - The columns of " + name + " have to be added before the first "
+                "row is filled.");
+
+    vector<Column> columns;
+    const char *source = (const char *) address;
+    char type = 'F';
+    stringstream leaves(leaflist);
+    string leaf;
+    while (getline(leaves, leaf, ':')) {
+        size_t slash = leaf.find('/');
+        if (slash != string::npos) {
+            if (slash + 2 != leaf.size())
+                throw invalid_argument("ColumnarWriter::AddColumns - The leaf \"" + leaf + "\" has a malformed type.");
+            type = leaf[slash + 1];
+            leaf.erase(slash);
+        }
+        if (ColumnarFormat::GetTypeSize(type) == 0)
+            throw invalid_argument("ColumnarWriter::AddColumns - The leaf \"" + leaf + "\" has the type " + type
+                                   + ", which the format does not support.");
+
+        uint32_t count = 1;
+        size_t open = leaf.find('[');
+        for (size_t bracket = open; bracket != string::npos; bracket = leaf.find('[', bracket + 1)) {
+            size_t close = leaf.find(']', bracket);
+            string dimension = leaf.substr(bracket + 1, close == string::npos ? string::npos : close - bracket - 1);
+            if (close == string::npos || dimension.empty() || dimension.find_first_not_of("0123456789") != string::npos)
+                throw invalid_argument("ColumnarWriter::AddColumns - The leaf \"" + leaf + "\" needs arrays of "
+                        "fixed length.");
+            count *= stoul(dimension);
+        }
+
+        Column column = {name + "." + leaf.substr(0, open), type, count, count * ColumnarFormat::GetTypeSize(type),
+                         source, vector<char>()};
+        column.values.reserve(column.size * rowsPerChunk_);
+        source += column.size;
+        columns.push_back(column);
+    }
+    columns_.insert(columns_.end(), columns.begin(), columns.end());
+}
+
+void ColumnarWriter::Close() {
+    if (!file_.is_open())
+        return;
+    if (!hasHeader_)
+        WriteHeader();
+    if (rowsInChunk_ != 0)
+        WriteChunk();
+
+    for (vector<uint64_t>::const_iterator it = chunkOffsets_.begin(); it != chunkOffsets_.end(); it++)
+        Write(file_, *it);
+    Write(file_, (uint64_t) chunkOffsets_.size());
+    file_.write(ColumnarFormat::footerMagic, ColumnarFormat::magicSize);
+    file_.close();
+}
+
+void ColumnarWriter::Fill() {
+    if (!file_.is_open())
+        throw logic_error("ColumnarWriter::Fill - The file " + fileName_ + " was already closed.");
+    if (!hasHeader_)
+        WriteHeader();
+
+    for (vector<Column>::iterator it = columns_.begin(); it != columns_.end(); it++)
+        it->values.insert(it->values.end(), it->source, it->source + it->size);
+    numberOfRows_++;
+    if (++rowsInChunk_ == rowsPerChunk_)
+        WriteChunk();
+}
+
+void ColumnarWriter::WriteHeader() {
+    file_.write(ColumnarFormat::headerMagic, ColumnarFormat::magicSize);
+    Write(file_, ColumnarFormat::version);
+    Write(file_, (uint32_t) columns_.size());
+    for (vector<Column>::const_iterator it = columns_.begin(); it != columns_.end(); it++) {
+        Write(file_, (uint16_t) it->name.size());
+        file_.write(it->name.data(), it->name.size());
+        Write(file_, it->type);
+        Write(file_, it->count);
+    }
+    hasHeader_ = true;
+}
+
+void ColumnarWriter::WriteChunk() {
+    chunkOffsets_.push_back((uint64_t) file_.tellp());
+    Write(file_, (uint32_t) rowsInChunk_);
+
+    //The headers of all of the columns come first, so we compress the columns that we keep before writing them.
+    vector<vector<char> > stored(columns_.size());
+    for (vector<Column>::size_type i = 0; i < columns_.size(); i++) {
+        Column &column = columns_[i];
+        uint8_t compression = ColumnarFormat::NONE;
+        if (compress_) {
+            Lz4Codec::Compress(column.values.data(), column.values.size(), compressed_);
+            if (compressed_.size() < column.values.size()) {
+                compression = ColumnarFormat::LZ4;
+                stored[i].swap(compressed_);
+            }
+        }
+
+        double minimum, maximum;
+        FindRange(column.type, column.values.data(), column.values.size() / ColumnarFormat::GetTypeSize(column.type),
+                  minimum, maximum);
+        Write(file_, compression);
+        Write(file_, (uint64_t) (compression == ColumnarFormat::NONE ? column.values.size() : stored[i].size()));
+        Write(file_, (uint64_t) column.values.size());
+        Write(file_, minimum);
+        Write(file_, maximum);
+    }
+
+    for (vector<Column>::size_type i = 0; i < columns_.size(); i++) {
+        const vector<char> &values = stored[i].empty() ? columns_[i].values : stored[i];
+        file_.write(values.data(), values.size());
+        columns_[i].values.clear();
+    }
+    file_.flush();
+    rowsInChunk_ = 0;
+}
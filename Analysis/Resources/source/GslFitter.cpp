@@ -14,11 +14,35 @@ using namespace std;
 
 GslFitter::GslFitter() : TimingDriver() {}
 
-GslFitter::~GslFitter() = default;
+GslFitter::~GslFitter() {
+    for (auto it = workspaces_.begin(); it != workspaces_.end(); it++) {
+        gsl_multifit_fdfsolver_free(it->second.solver);
+        gsl_matrix_free(it->second.covarianceMatrix);
+        if (it->second.jacobian)
+            gsl_matrix_free(it->second.jacobian);
+    }
+}
+
+GslFitter::Workspace &GslFitter::GetWorkspace(const size_t &numDataPoints, const size_t &numParameters) {
+    auto it = workspaces_.find(make_pair(numDataPoints, numParameters));
+    if (it != workspaces_.end())
+        return it->second;
+
+    Workspace workspace;
+    workspace.solver = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, numDataPoints, numParameters);
+    workspace.covarianceMatrix = gsl_matrix_alloc(numParameters, numParameters);
+#ifndef GSL_VERSION_ONE
+    workspace.jacobian = gsl_matrix_alloc(numDataPoints, numParameters);
+#else
+    workspace.jacobian = NULL;
+#endif
+    workspace.weights.resize(numDataPoints);
+    return workspaces_[make_pair(numDataPoints, numParameters)] = workspace;
+}
 
 int GslFitter::GaussianFunction(const gsl_vector *x, void *FitConfiguration, gsl_vector *f) {
     size_t n = ((struct GslFitter::FitConfiguration *) FitConfiguration)->n;
-    double *y = ((struct GslFitter::FitConfiguration *) FitConfiguration)->y;
+    const double *y = ((struct GslFitter::FitConfiguration *) FitConfiguration)->y;
     double *weight = ((struct GslFitter::FitConfiguration *) FitConfiguration)->weight;
     double gamma = ((struct GslFitter::FitConfiguration *) FitConfiguration)->gamma;
     double qdc = ((struct GslFitter::FitConfiguration *) FitConfiguration)->qdc;
@@ -63,7 +87,7 @@ int GslFitter::GaussianDerivative(const gsl_vector *x, void *FitConfiguration, g
 
 int GslFitter::PmtFunction(const gsl_vector *x, void *FitConfiguration, gsl_vector *f) {
     size_t n = ((struct GslFitter::FitConfiguration *) FitConfiguration)->n;
-    double *y = ((struct GslFitter::FitConfiguration *) FitConfiguration)->y;
+    const double *y = ((struct GslFitter::FitConfiguration *) FitConfiguration)->y;
     double *weight = ((struct GslFitter::FitConfiguration *) FitConfiguration)->weight;
     double beta = ((struct GslFitter::FitConfiguration *) FitConfiguration)->beta;
     double gamma = ((struct GslFitter::FitConfiguration *) FitConfiguration)->gamma;
@@ -150,8 +174,9 @@ void GslFitter::InitializeGaussian(size_t &numParameters, double *initialFitValu
 #endif
 }
 
-double GslFitter::CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
-                                 const std::pair<unsigned int, double> &max, const std::pair<double, double> baseline) {
+double GslFitter::CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                                 const std::pair<unsigned int, double> &max,
+                                 const std::pair<double, double> &baseline) {
     if (data.empty())
         throw range_error("GslFitter::CalculatePhase - The data vector had a zero size. No data to fit!!");
 
@@ -172,18 +197,16 @@ double GslFitter::CalculatePhase(const std::vector<double> &data, const TimingCo
 
     dof_ = numDataPoints - numParameters;
 
-    static const gsl_multifit_fdfsolver_type *T_ = gsl_multifit_fdfsolver_lmsder;
-    gsl_multifit_fdfsolver *solver = gsl_multifit_fdfsolver_alloc(T_, numDataPoints, numParameters);
-    gsl_matrix *covarianceMatrix = gsl_matrix_alloc(numParameters, numParameters);
-
-    double *y = new double[numDataPoints];
-    double *weights = new double[numDataPoints];
-    for (unsigned int i = 0; i < numDataPoints; i++) {
-        y[i] = data[i];
+    //Setting the function and the starting values below resets the solver, so a reused workspace gives the same
+    // result as a new one.
+    Workspace &workspace = GetWorkspace(numDataPoints, numParameters);
+    gsl_multifit_fdfsolver *solver = workspace.solver;
+    double *weights = workspace.weights.data();
+    for (unsigned int i = 0; i < numDataPoints; i++)
         weights[i] = baseline.second;
-    }
 
-    struct FitConfiguration fitData = {numDataPoints, y, weights, cfg.GetBeta(), cfg.GetGamma(), cfg.GetQdc()};
+    struct FitConfiguration fitData = {numDataPoints, data.data(), weights, cfg.GetBeta(), cfg.GetGamma(),
+                                       cfg.GetQdc()};
     gsl_vector_view x = gsl_vector_view_array(initialFitValues, numParameters);
 
     fitFunction.n = numDataPoints;
@@ -192,13 +215,12 @@ double GslFitter::CalculatePhase(const std::vector<double> &data, const TimingCo
 
 #ifndef GSL_VERSION_ONE
     static constexpr double ftol = 0.0;
-    gsl_matrix *jacobian = gsl_matrix_alloc(numDataPoints, numParameters);
     gsl_vector_view gslWeights = gsl_vector_view_array(weights, numDataPoints);
 
     gsl_multifit_fdfsolver_wset(solver, &fitFunction, &x.vector, &gslWeights.vector);
     gsl_multifit_fdfsolver_driver(solver, maxIterations, xtol, gtol, ftol, &status);
-    gsl_multifit_fdfsolver_jac(solver, jacobian);
-    gsl_multifit_covar(jacobian, 0.0, covarianceMatrix);
+    gsl_multifit_fdfsolver_jac(solver, workspace.jacobian);
+    gsl_multifit_covar(workspace.jacobian, 0.0, workspace.covarianceMatrix);
 
     chi_ = gsl_blas_dnrm2(gsl_multifit_fdfsolver_residual(solver));
 #else
@@ -223,13 +245,5 @@ double GslFitter::CalculatePhase(const std::vector<double> &data, const TimingCo
         amp_ = 0.0;
     }
 
-    gsl_multifit_fdfsolver_free(solver);
-    gsl_matrix_free(covarianceMatrix);
-#ifndef GSL_VERSION_ONE
-    gsl_matrix_free(jacobian);
-#endif
-    delete[] y;
-    delete[] weights;
-
     return phase;
 }
\ No newline at end of file
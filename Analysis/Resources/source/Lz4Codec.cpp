@@ -0,0 +1,145 @@
+///@file Lz4Codec.cpp
+///@brief Compression and decompression of single blocks in the LZ4 block format.
+///@date October 17, 2026
+#include "Lz4Codec.hpp"
+
+#include <cstring>
+
+#include <stdint.h>
+
+using namespace std;
+
+namespace {
+    ///The shortest match that the format can encode
+    const size_t minimumMatch = 4;
+    ///The last match has to start this many bytes before the end of the block
+    const size_t matchStartLimit = 12;
+    ///The last bytes of a block are always literals
+    const size_t lastLiterals = 5;
+    ///The largest distance to a match, the offsets are stored in 16 bits
+    const size_t maximumOffset = 65535;
+    ///The number of bits of the hash of a four byte sequence
+    const unsigned int hashBits = 12;
+
+    uint32_t Read32(const unsigned char *data) {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint32_t Hash(const uint32_t &sequence) {
+        return (sequence * 2654435761u) >> (32 - hashBits);
+    }
+
+    ///Writes the part of a length that does not fit into the four bits of the token
+    void WriteLength(vector<char> &destination, size_t length) {
+        for (; length >= 255; length -= 255)
+            destination.push_back((char) 255);
+        destination.push_back((char) length);
+    }
+
+    ///Reads the part of a length that did not fit into the four bits of the token
+    bool ReadLength(const unsigned char *source, const size_t &size, size_t &position, size_t &length) {
+        unsigned char byte;
+        do {
+            if (position >= size)
+                return false;
+            byte = source[position++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    ///Writes a sequence of literals followed by a match. A match length of zero writes only the literals, which ends
+    /// the block.
+    void WriteSequence(vector<char> &destination, const unsigned char *literals, const size_t &numberOfLiterals,
+                       const size_t &offset, const size_t &matchLength) {
+        size_t match = matchLength == 0 ? 0 : matchLength - minimumMatch;
+        destination.push_back((char) (((numberOfLiterals < 15 ? numberOfLiterals : 15) << 4) | (match < 15 ? match : 15)));
+        if (numberOfLiterals >= 15)
+            WriteLength(destination, numberOfLiterals - 15);
+        destination.insert(destination.end(), literals, literals + numberOfLiterals);
+        if (matchLength == 0)
+            return;
+        destination.push_back((char) (offset & 0xFF));
+        destination.push_back((char) (offset >> 8));
+        if (match >= 15)
+            WriteLength(destination, match - 15);
+    }
+}
+
+void Lz4Codec::Compress(const char *source, const size_t &size, std::vector<char> &destination) {
+    const unsigned char *in = (const unsigned char *) source;
+    destination.clear();
+    destination.reserve(GetMaximumCompressedSize(size));
+
+    size_t anchor = 0;
+    if (size > matchStartLimit) {
+        //The table holds the position of the last occurrence of each hash plus one, zero marks an empty slot.
+        vector<uint32_t> table(1 << hashBits, 0);
+        const size_t matchEndLimit = size - lastLiterals;
+        size_t position = 0;
+        while (position < size - matchStartLimit) {
+            uint32_t sequence = Read32(in + position);
+            uint32_t &slot = table[Hash(sequence)];
+            size_t candidate = slot;
+            slot = (uint32_t) (position + 1);
+            if (candidate == 0 || position - (candidate - 1) > maximumOffset || Read32(in + candidate - 1) != sequence) {
+                position++;
+                continue;
+            }
+
+            size_t match = candidate - 1;
+            size_t length = minimumMatch;
+            while (position + length < matchEndLimit && in[match + length] == in[position + length])
+                length++;
+            while (position > anchor && match > 0 && in[position - 1] == in[match - 1]) {
+                position--;
+                match--;
+                length++;
+            }
+
+            WriteSequence(destination, in + anchor, position - anchor, position - match, length);
+            position += length;
+            anchor = position;
+        }
+    }
+    WriteSequence(destination, in + anchor, size - anchor, 0, 0);
+}
+
+bool Lz4Codec::Decompress(const char *source, const size_t &size, char *destination, const size_t &rawSize) {
+    const unsigned char *in = (const unsigned char *) source;
+    size_t position = 0, written = 0;
+    while (position < size) {
+        unsigned char token = in[position++];
+        size_t numberOfLiterals = token >> 4;
+        if (numberOfLiterals == 15 && !ReadLength(in, size, position, numberOfLiterals))
+            return false;
+        if (numberOfLiterals > size - position || numberOfLiterals > rawSize - written)
+            return false;
+        memcpy(destination + written, in + position, numberOfLiterals);
+        position += numberOfLiterals;
+        written += numberOfLiterals;
+
+        //The last sequence has no match.
+        if (position == size)
+            break;
+        if (size - position < 2)
+            return false;
+        size_t offset = in[position] | ((size_t) in[position + 1] << 8);
+        position += 2;
+        if (offset == 0 || offset > written)
+            return false;
+
+        size_t length = token & 0x0F;
+        if (length == 15 && !ReadLength(in, size, position, length))
+            return false;
+        length += minimumMatch;
+        if (length > rawSize - written)
+            return false;
+        //The match may overlap the bytes that it writes, so we copy one byte at a time.
+        for (size_t i = 0; i < length; i++, written++)
+            destination[written] = destination[written - offset];
+    }
+    return written == rawSize;
+}
@@ -7,15 +7,17 @@
 #include "HelperFunctions.hpp"
 #include "TimingConfiguration.hpp"
 
+#include <limits>
+
 using namespace std;
 
 PolynomialCfd::PolynomialCfd() = default;
 PolynomialCfd::~PolynomialCfd() = default;
 
 /// Perform CFD analysis on the waveform.
-double PolynomialCfd::CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
+double PolynomialCfd::CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
                                      const std::pair<unsigned int, double> &max,
-                                     const std::pair<double, double> baseline) {
+                                     const std::pair<double, double> &baseline) {
     if (data.size() == 0)
         throw range_error("PolynomialCfd::CalculatePhase - The data vector was empty!");
     if (data.size() < max.first)
@@ -16,30 +16,32 @@ using namespace std;
 RootFitter::RootFitter() {
     vandleTimingFunction_ = new VandleTimingFunction();
     func_ = new TF1("func", vandleTimingFunction_, 0., 1.e6, 5);
+    graph_ = new TGraph();
 }
 
 RootFitter::~RootFitter() {
     delete vandleTimingFunction_;
     delete func_;
+    delete graph_;
 }
 
-double RootFitter::CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg,
-                                  const std::pair<unsigned int, double> &maxInfo, std::pair<double, double> baseline) {
+double RootFitter::CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg,
+                                  const std::pair<unsigned int, double> &maxInfo,
+                                  const std::pair<double, double> &baseline) {
     if (data.size() == 0)
         throw range_error("RootFitter::CalculatePhase - The data was sized zero.");
 
-    vector<double> xvals;
+    graph_->Set((int) data.size());
     for (unsigned int i = 0; i < data.size(); i++)
-        xvals.push_back(double(i));
-
-    TGraph graph((int) data.size(), &(xvals[0]), &(data[0]));
+        graph_->SetPoint((int) i, double(i), data[i]);
 
     func_->SetParameters(0, cfg.GetQdc() * 0.5);
     func_->FixParameter(2, cfg.GetBeta());
     func_->FixParameter(3, cfg.GetGamma());
     func_->FixParameter(4, 0.0);
 
-    graph.Fit(func_, "WRQ", "", 0, data.size());
+    //N keeps the graph from storing a copy of the function after every fit, we read the result from func_.
+    graph_->Fit(func_, "WRQN", "", 0, data.size());
 
     return func_->GetParameter(0);
 }
\ No newline at end of file
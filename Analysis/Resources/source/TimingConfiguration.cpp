@@ -5,9 +5,13 @@
 /// @copyright Copyright (c) 2018 S. V. Paulauskas. 
 /// @copyright All rights reserved. Released under the Creative Commons Attribution-ShareAlike 4.0 International License
 
+#include "DefaultConfigurationValues.hpp"
 #include "TimingConfiguration.hpp"
 
-TimingConfiguration::TimingConfiguration() : isFastSiPm_(false) {}
+TimingConfiguration::TimingConfiguration() : beta_(DefaultConfig::fitBeta), delay_(DefaultConfig::cfdD),
+                                             fraction_(DefaultConfig::cfdF), gamma_(DefaultConfig::fitGamma),
+                                             gap_(DefaultConfig::cfdG), isFastSiPm_(false),
+                                             length_(DefaultConfig::cfdL), qdc_(0) {}
 
 TimingConfiguration::~TimingConfiguration() = default;
 
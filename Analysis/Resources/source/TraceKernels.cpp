@@ -0,0 +1,375 @@
+///@file TraceKernels.cpp
+///@brief Vectorized kernels for the quantities that we calculate from every trace.
+///@date October 17, 2026
+#include "TraceKernels.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include <cmath>
+
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PAASS_TRACEKERNELS_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    ///The number of vectors that we add into 32 bit lanes before moving the sums into 64 bit lanes. Every vector adds
+    /// at most two samples of 65535 to a lane, so the lanes cannot overflow.
+    const size_t vectorsPerBlock = 16384;
+
+    ///The largest number of samples for which n * sum(x^2) fits into 64 bits
+    const size_t maximumNumberOfSamples = 65536;
+
+    ///Finds the first sample with the largest value
+    typedef size_t (*FindMaximumKernel)(const unsigned short *samples, const size_t &size);
+
+    ///Adds the samples, and their squares if the kernel calculates them, to sum and sumOfSquares
+    typedef void (*AccumulateKernel)(const unsigned short *samples, const size_t &size, uint64_t &sum,
+                                     uint64_t &sumOfSquares);
+
+    ///The kernels of one instruction set
+    struct Kernels {
+        FindMaximumKernel findMaximum; ///< Finds the maximum
+        AccumulateKernel sumAndSquares; ///< Adds the samples and their squares
+        AccumulateKernel sum; ///< Only adds the samples
+    };
+
+    size_t FindFirst(const unsigned short *samples, size_t position, const size_t &size, const unsigned short &value) {
+        while (position < size && samples[position] != value)
+            position++;
+        return position;
+    }
+
+    size_t FindMaximumScalar(const unsigned short *samples, const size_t &size) {
+        size_t position = 0;
+        for (size_t i = 1; i < size; i++)
+            if (samples[i] > samples[position])
+                position = i;
+        return position;
+    }
+
+    template<bool withSquares>
+    void AccumulateScalar(const unsigned short *samples, const size_t &size, uint64_t &sum, uint64_t &sumOfSquares) {
+        for (size_t i = 0; i < size; i++) {
+            sum += samples[i];
+            if (withSquares)
+                sumOfSquares += (uint64_t) samples[i] * samples[i];
+        }
+    }
+
+#ifdef PAASS_TRACEKERNELS_X86
+    ///@return The sum of the 64 bit lanes of the vector
+    __attribute__((target("sse2")))
+    uint64_t AddLanes(const __m128i &vector) {
+        uint64_t lanes[2];
+        _mm_storeu_si128((__m128i *) lanes, vector);
+        return lanes[0] + lanes[1];
+    }
+
+    ///@return The 32 bit lanes of the vector widened and added pairwise into two 64 bit lanes
+    __attribute__((target("sse2")))
+    __m128i Widen(const __m128i &vector) {
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_add_epi64(_mm_unpacklo_epi32(vector, zero), _mm_unpackhi_epi32(vector, zero));
+    }
+
+    __attribute__((target("sse2")))
+    size_t FindMaximumSse2(const unsigned short *samples, const size_t &size) {
+        //SSE2 only compares signed 16 bit integers, flipping the sign bit keeps the order of the unsigned ones.
+        const __m128i signBit = _mm_set1_epi16((short) 0x8000);
+        unsigned short maximum = 0;
+        size_t i = 0;
+        if (size >= 8) {
+            __m128i best = _mm_xor_si128(_mm_loadu_si128((const __m128i *) samples), signBit);
+            for (i = 8; i + 8 <= size; i += 8)
+                best = _mm_max_epi16(best, _mm_xor_si128(_mm_loadu_si128((const __m128i *) (samples + i)), signBit));
+            best = _mm_max_epi16(best, _mm_srli_si128(best, 8));
+            best = _mm_max_epi16(best, _mm_srli_si128(best, 4));
+            best = _mm_max_epi16(best, _mm_srli_si128(best, 2));
+            maximum = (unsigned short) ((_mm_cvtsi128_si32(best) & 0xFFFF) ^ 0x8000);
+        }
+        for (; i < size; i++)
+            maximum = max(maximum, samples[i]);
+
+        const __m128i target = _mm_set1_epi16((short) maximum);
+        for (i = 0; i + 8 <= size; i += 8) {
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (samples + i)),
+                                                               target));
+            if (mask)
+                return i + __builtin_ctz((unsigned int) mask) / 2;
+        }
+        return FindFirst(samples, i, size, maximum);
+    }
+
+    template<bool withSquares>
+    __attribute__((target("sse2")))
+    void AccumulateSse2(const unsigned short *samples, const size_t &size, uint64_t &sum, uint64_t &sumOfSquares) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sums = zero, squares = zero;
+        size_t i = 0;
+        while (i + 8 <= size) {
+            const size_t blockEnd = i + min((size - i) / 8, vectorsPerBlock) * 8;
+            __m128i blockSums = zero;
+            for (; i < blockEnd; i += 8) {
+                const __m128i v = _mm_loadu_si128((const __m128i *) (samples + i));
+                blockSums = _mm_add_epi32(blockSums, _mm_add_epi32(_mm_unpacklo_epi16(v, zero),
+                                                                   _mm_unpackhi_epi16(v, zero)));
+                if (withSquares) {
+                    //The low and high halves of the 32 bit products interleave into the products.
+                    const __m128i low = _mm_mullo_epi16(v, v), high = _mm_mulhi_epu16(v, v);
+                    squares = _mm_add_epi64(squares, Widen(_mm_unpacklo_epi16(low, high)));
+                    squares = _mm_add_epi64(squares, Widen(_mm_unpackhi_epi16(low, high)));
+                }
+            }
+            sums = _mm_add_epi64(sums, Widen(blockSums));
+        }
+        sum += AddLanes(sums);
+        if (withSquares)
+            sumOfSquares += AddLanes(squares);
+        AccumulateScalar<withSquares>(samples + i, size - i, sum, sumOfSquares);
+    }
+
+    ///@return The sum of the 64 bit lanes of the vector
+    __attribute__((target("avx2")))
+    uint64_t AddLanes(const __m256i &vector) {
+        uint64_t lanes[4];
+        _mm256_storeu_si256((__m256i *) lanes, vector);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    ///@return The 32 bit lanes of the vector widened and added pairwise into four 64 bit lanes
+    __attribute__((target("avx2")))
+    __m256i Widen(const __m256i &vector) {
+        return _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(vector)),
+                                _mm256_cvtepu32_epi64(_mm256_extracti128_si256(vector, 1)));
+    }
+
+    ///@return The largest of the unsigned 16 bit lanes of the vector
+    __attribute__((target("avx2")))
+    unsigned short MaximumLane(const __m128i &vector) {
+        __m128i best = _mm_max_epu16(vector, _mm_srli_si128(vector, 8));
+        best = _mm_max_epu16(best, _mm_srli_si128(best, 4));
+        best = _mm_max_epu16(best, _mm_srli_si128(best, 2));
+        return (unsigned short) (_mm_cvtsi128_si32(best) & 0xFFFF);
+    }
+
+    __attribute__((target("avx2")))
+    size_t FindMaximumAvx2(const unsigned short *samples, const size_t &size) {
+        unsigned short maximum = 0;
+        size_t i = 0;
+        if (size >= 16) {
+            __m256i best = _mm256_loadu_si256((const __m256i *) samples);
+            for (i = 16; i + 16 <= size; i += 16)
+                best = _mm256_max_epu16(best, _mm256_loadu_si256((const __m256i *) (samples + i)));
+            maximum = MaximumLane(_mm_max_epu16(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1)));
+        }
+        for (; i < size; i++)
+            maximum = max(maximum, samples[i]);
+
+        const __m256i target = _mm256_set1_epi16((short) maximum);
+        for (i = 0; i + 16 <= size; i += 16) {
+            const int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(
+                    _mm256_loadu_si256((const __m256i *) (samples + i)), target));
+            if (mask)
+                return i + __builtin_ctz((unsigned int) mask) / 2;
+        }
+        return FindFirst(samples, i, size, maximum);
+    }
+
+    template<bool withSquares>
+    __attribute__((target("avx2")))
+    void AccumulateAvx2(const unsigned short *samples, const size_t &size, uint64_t &sum, uint64_t &sumOfSquares) {
+        __m256i sums = _mm256_setzero_si256(), squares = _mm256_setzero_si256();
+        size_t i = 0;
+        while (i + 16 <= size) {
+            const size_t blockEnd = i + min((size - i) / 16, vectorsPerBlock) * 16;
+            __m256i blockSums = _mm256_setzero_si256();
+            for (; i < blockEnd; i += 16) {
+                const __m256i v = _mm256_loadu_si256((const __m256i *) (samples + i));
+                const __m256i low = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+                const __m256i high = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1));
+                blockSums = _mm256_add_epi32(blockSums, _mm256_add_epi32(low, high));
+                if (withSquares) {
+                    squares = _mm256_add_epi64(squares, Widen(_mm256_mullo_epi32(low, low)));
+                    squares = _mm256_add_epi64(squares, Widen(_mm256_mullo_epi32(high, high)));
+                }
+            }
+            sums = _mm256_add_epi64(sums, Widen(blockSums));
+        }
+        sum += AddLanes(sums);
+        if (withSquares)
+            sumOfSquares += AddLanes(squares);
+        AccumulateScalar<withSquares>(samples + i, size - i, sum, sumOfSquares);
+    }
+
+    //GCC 12 warns about the undefined vectors that its own AVX-512 intrinsics use internally (GCC bug 105593).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    ///@return The sum of the 64 bit lanes of the vector
+    __attribute__((target("avx512f")))
+    uint64_t AddLanes(const __m512i &vector) {
+        uint64_t lanes[8];
+        _mm512_storeu_si512((void *) lanes, vector);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    }
+
+    ///@return The 32 bit lanes of the vector widened and added pairwise into eight 64 bit lanes
+    __attribute__((target("avx512f")))
+    __m512i Widen(const __m512i &vector) {
+        return _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(vector, 0)),
+                                _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(vector, 1)));
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx2")))
+    size_t FindMaximumAvx512(const unsigned short *samples, const size_t &size) {
+        unsigned short maximum = 0;
+        size_t i = 0;
+        if (size >= 32) {
+            __m512i best = _mm512_loadu_si512((const void *) samples);
+            for (i = 32; i + 32 <= size; i += 32)
+                best = _mm512_max_epu16(best, _mm512_loadu_si512((const void *) (samples + i)));
+            const __m256i half = _mm256_max_epu16(_mm512_extracti64x4_epi64(best, 0), _mm512_extracti64x4_epi64(best, 1));
+            maximum = MaximumLane(_mm_max_epu16(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1)));
+        }
+        for (; i < size; i++)
+            maximum = max(maximum, samples[i]);
+
+        const __m512i target = _mm512_set1_epi16((short) maximum);
+        for (i = 0; i + 32 <= size; i += 32) {
+            const __mmask32 mask = _mm512_cmpeq_epi16_mask(_mm512_loadu_si512((const void *) (samples + i)), target);
+            if (mask)
+                return i + __builtin_ctz((unsigned int) mask);
+        }
+        return FindFirst(samples, i, size, maximum);
+    }
+
+    template<bool withSquares>
+    __attribute__((target("avx512f,avx512bw")))
+    void AccumulateAvx512(const unsigned short *samples, const size_t &size, uint64_t &sum, uint64_t &sumOfSquares) {
+        __m512i sums = _mm512_setzero_si512(), squares = _mm512_setzero_si512();
+        size_t i = 0;
+        while (i + 32 <= size) {
+            const size_t blockEnd = i + min((size - i) / 32, vectorsPerBlock) * 32;
+            __m512i blockSums = _mm512_setzero_si512();
+            for (; i < blockEnd; i += 32) {
+                const __m512i v = _mm512_loadu_si512((const void *) (samples + i));
+                const __m512i low = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(v, 0));
+                const __m512i high = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(v, 1));
+                blockSums = _mm512_add_epi32(blockSums, _mm512_add_epi32(low, high));
+                if (withSquares) {
+                    squares = _mm512_add_epi64(squares, Widen(_mm512_mullo_epi32(low, low)));
+                    squares = _mm512_add_epi64(squares, Widen(_mm512_mullo_epi32(high, high)));
+                }
+            }
+            sums = _mm512_add_epi64(sums, Widen(blockSums));
+        }
+        sum += AddLanes(sums);
+        if (withSquares)
+            sumOfSquares += AddLanes(squares);
+        AccumulateScalar<withSquares>(samples + i, size - i, sum, sumOfSquares);
+    }
+#pragma GCC diagnostic pop
+#endif
+
+    ///@param[in] instructionSet : The instruction set of the kernels
+    ///@return The kernels, the caller has checked that the instruction set is supported
+    const Kernels &GetKernels(const TraceKernels::InstructionSet &instructionSet) {
+        static const Kernels kernels[] = {
+                {&FindMaximumScalar, &AccumulateScalar<true>, &AccumulateScalar<false>},
+#ifdef PAASS_TRACEKERNELS_X86
+                {&FindMaximumSse2, &AccumulateSse2<true>, &AccumulateSse2<false>},
+                {&FindMaximumAvx2, &AccumulateAvx2<true>, &AccumulateAvx2<false>},
+                {&FindMaximumAvx512, &AccumulateAvx512<true>, &AccumulateAvx512<false>},
+#endif
+        };
+        return kernels[instructionSet];
+    }
+
+    void CheckInstructionSet(const TraceKernels::InstructionSet &instructionSet, const string &caller) {
+        if (!TraceKernels::IsSupported(instructionSet)) {
+            stringstream ss;
+            ss << "TraceKernels::" << caller << " - The instruction set " << instructionSet
+               << " is not supported by this CPU or build.";
+            throw invalid_argument(ss.str());
+        }
+    }
+}
+
+TraceKernels::InstructionSet TraceKernels::GetBestInstructionSet() {
+    static const InstructionSet best = IsSupported(AVX512) ? AVX512 : IsSupported(AVX2) ? AVX2 :
+                                                                      IsSupported(SSE2) ? SSE2 : SCALAR;
+    return best;
+}
+
+bool TraceKernels::IsSupported(const InstructionSet &instructionSet) {
+#ifdef PAASS_TRACEKERNELS_X86
+    __builtin_cpu_init();
+    switch (instructionSet) {
+        case SCALAR:
+            return true;
+        case SSE2:
+            return __builtin_cpu_supports("sse2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+        case AVX512:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("avx512f")
+                   && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+#else
+    return instructionSet == SCALAR;
+#endif
+}
+
+std::pair<unsigned int, double> TraceKernels::FindMaximum(const SampleSpan<unsigned short> &samples,
+                                                          const size_t &begin, const size_t &end,
+                                                          const InstructionSet &instructionSet) {
+    if (begin >= end || end > samples.size()) {
+        stringstream ss;
+        ss << "TraceKernels::FindMaximum - The range [" << begin << "," << end << ") is empty or does not fit into "
+           << "the " << samples.size() << " samples of the trace.";
+        throw range_error(ss.str());
+    }
+    CheckInstructionSet(instructionSet, "FindMaximum");
+
+    const size_t position = begin + GetKernels(instructionSet).findMaximum(samples.data() + begin, end - begin);
+    return make_pair((unsigned int) position, (double) samples[position]);
+}
+
+TraceKernels::BaselineAndQdc TraceKernels::CalculateBaselineAndQdc(const SampleSpan<unsigned short> &samples,
+                                                                   const size_t &baselineEnd,
+                                                                   const size_t &waveformEnd,
+                                                                   const InstructionSet &instructionSet) {
+    if (samples.size() > maximumNumberOfSamples || baselineEnd == 0 || waveformEnd > samples.size()
+        || waveformEnd < baselineEnd + 2) {
+        stringstream ss;
+        ss << "TraceKernels::CalculateBaselineAndQdc - The baseline [0," << baselineEnd << ") and the waveform ["
+           << baselineEnd << "," << waveformEnd << ") do not fit into the " << samples.size()
+           << " samples of the trace.";
+        throw range_error(ss.str());
+    }
+    CheckInstructionSet(instructionSet, "CalculateBaselineAndQdc");
+
+    const Kernels &kernels = GetKernels(instructionSet);
+    uint64_t baselineSum = 0, baselineSumOfSquares = 0, waveformSum = 0, unused = 0;
+    kernels.sumAndSquares(samples.data(), baselineEnd, baselineSum, baselineSumOfSquares);
+    kernels.sum(samples.data() + baselineEnd, waveformEnd - baselineEnd, waveformSum, unused);
+
+    //n^2 times the variance is n * sum(x^2) - sum(x)^2, which is exact in 64 bits for our number of samples.
+    const uint64_t n = baselineEnd;
+    BaselineAndQdc result;
+    result.baseline.first = (double) baselineSum / n;
+    result.baseline.second = sqrt((double) (n * baselineSumOfSquares - baselineSum * baselineSum)) / n;
+
+    //The trapezoidal rule counts the first and last sample of the waveform half, and subtracting the baseline from
+    // each sample removes it once for each of the intervals between the samples.
+    result.qdc = (double) waveformSum - 0.5 * (samples[baselineEnd] + samples[waveformEnd - 1])
+                 - (double) (waveformEnd - baselineEnd - 1) * result.baseline.first;
+    return result;
+}
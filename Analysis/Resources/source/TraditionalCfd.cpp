@@ -9,7 +9,7 @@
 
 using namespace std;
 
-double TraditionalCfd::CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg) {
+double TraditionalCfd::CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg) {
     if (data.empty())
         throw range_error("TraditionalCfd::CalculatePhase - The data vector was empty!");
 
@@ -13,7 +13,7 @@
 
 using namespace std;
 
-double XiaCfd::CalculatePhase(const std::vector<double> &data, const TimingConfiguration &cfg) {
+double XiaCfd::CalculatePhase(const SampleSpan<double> &data, const TimingConfiguration &cfg) {
     if (data.empty())
         throw range_error("XiaCfd::CalculatePhase - The data vector was empty!");
 
@@ -28,4 +28,6 @@ double XiaCfd::CalculatePhase(const std::vector<double> &data, const TimingConfi
         if (cfd_.at(i) <= 0.0)
             return cfd_.at(i - 1) / (cfd_.at(i - 1) + fabs(cfd_.at(i)));
     return 0.0;
-}
\ No newline at end of file
+}
+
+vector<double> XiaCfd::GetCfd() { return cfd_; }
\ No newline at end of file
@@ -67,6 +67,30 @@ TEST_FIXTURE (ChannelConfiguration, Test_Zero) {
     CHECK(*this == id);
 }
 
+///Test that the parameters for the trace analyzers follow the settings of the channel
+TEST_FIXTURE (ChannelConfiguration, Test_TraceAnalysisParameters) {
+    TimingConfiguration timing;
+    timing.SetBeta(0.5);
+    SetTimingConfiguration(timing);
+    SetTraceDelayInSamples(200);
+    SetWaveformBoundsInSamples(make_pair(5, 10));
+
+    const TraceAnalysisParameters &parameters = GetTraceAnalysisParameters();
+    CHECK_EQUAL(0.5, parameters.timingConfiguration.GetBeta());
+    CHECK_EQUAL(200u, parameters.traceDelayInSamples);
+    CHECK(parameters.waveformBoundsInSamples == make_pair(5u, 10u));
+    CHECK(!parameters.timingConfiguration.IsFastSiPm());
+
+    SetType("beta");
+    SetSubtype("double");
+    AddTag("timing");
+    CHECK(parameters.timingConfiguration.IsFastSiPm());
+    CHECK(!GetTimingConfiguration().IsFastSiPm());
+
+    Zero();
+    CHECK(!parameters.timingConfiguration.IsFastSiPm());
+}
+
 int main(int argv, char *argc[]) {
     return (UnitTest::RunAllTests());
 }
@@ -0,0 +1,126 @@
+///@file unittest-ColumnarWriter.cpp
+///@brief Unit tests for the ColumnarWriter, ColumnarReader and Lz4Codec classes
+///@date October 17, 2026
+#include "ColumnarReader.hpp"
+#include "ColumnarWriter.hpp"
+#include "Lz4Codec.hpp"
+
+#include <UnitTest++.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+TEST(TestLz4RoundTrip) {
+    //Repeated patterns, a long run and bytes that don't repeat, to exercise the long lengths and the overlaps.
+    vector<char> data;
+    for (unsigned int i = 0; i < 5000; i++)
+        data.push_back((char) (i % 7));
+    data.insert(data.end(), 1000, 'x');
+    for (unsigned int i = 0; i < 300; i++)
+        data.push_back((char) ((i * 2654435761u) >> 24));
+
+    vector<char> compressed, decompressed(data.size());
+    Lz4Codec::Compress(data.data(), data.size(), compressed);
+    CHECK(compressed.size() < data.size() / 4);
+    CHECK(compressed.size() <= Lz4Codec::GetMaximumCompressedSize(data.size()));
+    CHECK(Lz4Codec::Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+    CHECK_ARRAY_EQUAL(data, decompressed, data.size());
+
+    CHECK(!Lz4Codec::Decompress(compressed.data(), compressed.size() - 1, decompressed.data(), decompressed.size()));
+    CHECK(!Lz4Codec::Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size() - 1));
+
+    //Blocks that are too short for a match are stored as literals.
+    for (size_t size = 0; size < 20; size++) {
+        Lz4Codec::Compress(data.data(), size, compressed);
+        CHECK(Lz4Codec::Decompress(compressed.data(), compressed.size(), decompressed.data(), size));
+        CHECK_ARRAY_EQUAL(data, decompressed, size);
+    }
+}
+
+TEST(TestWriteAndRead) {
+    const string fileName = "unittest-ColumnarWriter.col";
+    struct Data {
+        double qdc;
+        double tof;
+        unsigned char id;
+    } data = {0, 0, 0};
+    short trace[4] = {0, 0, 0, 0};
+
+    {
+        ColumnarWriter writer(fileName, 100);
+        writer.AddColumns("bar", &data, "qdc/D:tof:id/b");
+        writer.AddColumns("trace", trace, "values[4]/S");
+        CHECK_THROW(writer.AddColumns("bad", &data, "name/C"), invalid_argument);
+        CHECK_THROW(writer.AddColumns("bad", &data, "values[n]/D"), invalid_argument);
+        CHECK_EQUAL((size_t) 4, writer.GetNumberOfColumns());
+
+        for (unsigned int i = 0; i < 250; i++) {
+            data.qdc = 10.0 * i;
+            data.tof = i % 10;
+            data.id = (unsigned char) (i % 3);
+            for (unsigned int j = 0; j < 4; j++)
+                trace[j] = (short) (j - (int) i);
+            writer.Fill();
+        }
+        CHECK_THROW(writer.AddColumns("late", &data, "qdc/D"), logic_error);
+    }
+
+    ColumnarReader reader(fileName);
+    CHECK(reader.IsComplete());
+    CHECK_EQUAL(250ULL, reader.GetNumberOfRows());
+    CHECK_EQUAL((size_t) 3, reader.GetChunks().size());
+    CHECK_EQUAL((uint32_t) 50, reader.GetChunks()[2].numberOfRows);
+    CHECK_THROW(reader.GetColumnIndex("bar.energy"), invalid_argument);
+    CHECK_THROW(reader.ReadColumn<float>("bar.qdc"), invalid_argument);
+
+    const ColumnarReader::ColumnChunk &qdc = reader.GetChunks()[1].columns[reader.GetColumnIndex("bar.qdc")];
+    CHECK_EQUAL(1000.0, qdc.minimum);
+    CHECK_EQUAL(1990.0, qdc.maximum);
+
+    vector<double> qdcs = reader.ReadColumn<double>("bar.qdc");
+    vector<unsigned char> ids = reader.ReadColumn<unsigned char>("bar.id");
+    vector<short> traces = reader.ReadColumn<short>("trace.values");
+    CHECK_EQUAL((size_t) 1000, traces.size());
+    for (unsigned int i = 0; i < 250; i++) {
+        CHECK_EQUAL(10.0 * i, qdcs[i]);
+        CHECK_EQUAL(i % 3, (unsigned int) ids[i]);
+        CHECK_EQUAL((short) (3 - (int) i), traces[4 * i + 3]);
+    }
+    remove(fileName.c_str());
+}
+
+TEST(TestReadWithoutFooter) {
+    const string fileName = "unittest-ColumnarWriter-incomplete.col";
+    double value = 0;
+    {
+        ColumnarWriter writer(fileName, 10, false);
+        writer.AddColumns("value", &value, "x/D");
+        for (unsigned int i = 0; i < 25; i++, value++)
+            writer.Fill();
+    }
+
+    //Cutting the footer and half of the last chunk leaves the first two chunks readable.
+    FILE *file = fopen(fileName.c_str(), "rb");
+    vector<char> contents(1 << 16);
+    contents.resize(fread(contents.data(), 1, contents.size(), file));
+    fclose(file);
+    file = fopen(fileName.c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size() - 3 * sizeof(uint64_t) - 8 - 20, file);
+    fclose(file);
+
+    ColumnarReader reader(fileName);
+    CHECK(!reader.IsComplete());
+    CHECK_EQUAL(20ULL, reader.GetNumberOfRows());
+    vector<double> values = reader.ReadColumn<double>("value.x");
+    CHECK_EQUAL(19.0, values.back());
+    remove(fileName.c_str());
+
+    CHECK_THROW(ColumnarReader("unittest-ColumnarWriter-missing.col"), invalid_argument);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
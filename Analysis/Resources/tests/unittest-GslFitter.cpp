@@ -36,6 +36,19 @@ TEST_FIXTURE(GslFitter, TestGaussianFitting) {
     CHECK_CLOSE(gaussian::phase, CalculatePhase(unittest_gaussian_trace::waveform, cfg, max_pair, baseline_pair), 0.1);
 }
 
+///Checks that fits reusing a workspace give the same phase as the first fit of that size.
+TEST_FIXTURE(GslFitter, TestWorkspaceReuse) {
+    TimingConfiguration cfg;
+    cfg.SetBeta(pmt::beta);
+    cfg.SetGamma(pmt::gamma);
+    cfg.SetQdc(waveform_qdc);
+    cfg.SetIsFastSiPm(false);
+
+    double phase = CalculatePhase(waveform, cfg, max_pair, baseline_pair);
+    for (unsigned int i = 0; i < 3; i++)
+        CHECK_EQUAL(phase, CalculatePhase(waveform, cfg, max_pair, baseline_pair));
+}
+
 int main(int argv, char *argc[]) {
     return (UnitTest::RunAllTests());
 }
\ No newline at end of file
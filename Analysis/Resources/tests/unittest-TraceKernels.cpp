@@ -0,0 +1,112 @@
+///@file unittest-TraceKernels.cpp
+///@brief Checks that every version of the trace kernels agrees with the TraceFunctions.
+///@date October 17, 2026
+#include "HelperFunctions.hpp"
+#include "TraceKernels.hpp"
+#include "UnitTestSampleData.hpp"
+
+#include <UnitTest++.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <cstdlib>
+
+using namespace std;
+using namespace unittest_trace_variables;
+
+namespace {
+    ///The instruction sets that the CPU running the test supports
+    vector<TraceKernels::InstructionSet> GetSupportedInstructionSets() {
+        vector<TraceKernels::InstructionSet> instructionSets;
+        const TraceKernels::InstructionSet all[] = {TraceKernels::SCALAR, TraceKernels::SSE2, TraceKernels::AVX2,
+                                                    TraceKernels::AVX512};
+        for (unsigned int i = 0; i < 4; i++)
+            if (TraceKernels::IsSupported(all[i]))
+                instructionSets.push_back(all[i]);
+        return instructionSets;
+    }
+
+    ///The sample data as the 16 bit samples of a trace
+    const vector<unsigned short> samples(trace.begin(), trace.end());
+}
+
+TEST(TestTraceKernelsDispatch) {
+    CHECK(TraceKernels::IsSupported(TraceKernels::SCALAR));
+    CHECK(TraceKernels::IsSupported(TraceKernels::GetBestInstructionSet()));
+}
+
+TEST(TestTraceKernelsFindMaximum) {
+    CHECK_THROW(TraceKernels::FindMaximum(samples, 10, 10), range_error);
+    CHECK_THROW(TraceKernels::FindMaximum(samples, 0, samples.size() + 1), range_error);
+
+    const pair<unsigned int, double> expected = TraceFunctions::FindMaximum(trace, trace_delay);
+    const vector<TraceKernels::InstructionSet> instructionSets = GetSupportedInstructionSets();
+    for (unsigned int i = 0; i < instructionSets.size(); i++) {
+        const pair<unsigned int, double> result = TraceKernels::FindMaximum(
+                samples, TraceFunctions::minimum_baseline_length, trace_delay, instructionSets[i]);
+        CHECK_EQUAL(expected.first, result.first);
+        CHECK_EQUAL(expected.second, result.second);
+        CHECK_EQUAL(max_position, result.first);
+    }
+}
+
+TEST(TestTraceKernelsBaselineAndQdc) {
+    CHECK_THROW(TraceKernels::CalculateBaselineAndQdc(samples, 0, 10), range_error);
+    CHECK_THROW(TraceKernels::CalculateBaselineAndQdc(samples, 70, 71), range_error);
+    CHECK_THROW(TraceKernels::CalculateBaselineAndQdc(samples, 70, samples.size() + 1), range_error);
+    CHECK_THROW(TraceKernels::CalculateBaselineAndQdc(vector<unsigned short>(65537, 1), 70, 80), range_error);
+
+    const pair<double, double> baselineRange(0, waveform_range.first);
+    const pair<double, double> expectedBaseline = TraceFunctions::CalculateBaseline(trace, baselineRange);
+
+    vector<double> sansBaseline;
+    for (vector<unsigned short>::const_iterator it = samples.begin(); it != samples.end(); it++)
+        sansBaseline.push_back(*it - expectedBaseline.first);
+    const double expectedQdc = TraceFunctions::CalculateQdc(sansBaseline, waveform_range);
+
+    const vector<TraceKernels::InstructionSet> instructionSets = GetSupportedInstructionSets();
+    for (unsigned int i = 0; i < instructionSets.size(); i++) {
+        const TraceKernels::BaselineAndQdc result = TraceKernels::CalculateBaselineAndQdc(
+                samples, waveform_range.first, waveform_range.second, instructionSets[i]);
+        CHECK_CLOSE(expectedBaseline.first, result.baseline.first, 1e-9);
+        CHECK_CLOSE(expectedBaseline.second, result.baseline.second, 1e-9);
+        CHECK_CLOSE(expectedQdc, result.qdc, 1e-6);
+    }
+}
+
+///Checks the vectorized versions against the scalar one on random samples, with lengths that leave every possible
+/// number of samples for the scalar tail and with long traces that need several blocks of 32 bit sums.
+TEST(TestTraceKernelsAgainstScalar) {
+    srand(1234);
+    vector<unsigned short> random(65536);
+    for (vector<unsigned short>::iterator it = random.begin(); it != random.end(); it++)
+        *it = (unsigned short) (rand() & 0xFFFF);
+
+    const size_t sizes[] = {3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 250, 1000, 40001, 65536};
+    const vector<TraceKernels::InstructionSet> instructionSets = GetSupportedInstructionSets();
+    for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        const SampleSpan<unsigned short> span(random.data(), sizes[i]);
+        const size_t baselineEnd = sizes[i] / 3;
+        const pair<unsigned int, double> expectedMaximum =
+                TraceKernels::FindMaximum(span, 0, sizes[i], TraceKernels::SCALAR);
+        const TraceKernels::BaselineAndQdc expected =
+                TraceKernels::CalculateBaselineAndQdc(span, baselineEnd, sizes[i], TraceKernels::SCALAR);
+
+        for (unsigned int j = 0; j < instructionSets.size(); j++) {
+            const pair<unsigned int, double> maximum = TraceKernels::FindMaximum(span, 0, sizes[i], instructionSets[j]);
+            CHECK_EQUAL(expectedMaximum.first, maximum.first);
+            CHECK_EQUAL(expectedMaximum.second, maximum.second);
+
+            const TraceKernels::BaselineAndQdc result =
+                    TraceKernels::CalculateBaselineAndQdc(span, baselineEnd, sizes[i], instructionSets[j]);
+            CHECK_EQUAL(expected.baseline.first, result.baseline.first);
+            CHECK_EQUAL(expected.baseline.second, result.baseline.second);
+            CHECK_EQUAL(expected.qdc, result.qdc);
+        }
+    }
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -15,14 +15,17 @@
 class ProcessedXiaData : public XiaData {
 public:
     /// Default constructor.
-    ProcessedXiaData() {}
+    ProcessedXiaData() : isTraceLoaded_(true) {}
 
     ///Constructor taking the base class as an argument so that we can set
     /// the trace information properly
     ///@param[in] evt : The event that we are going to assign here.
     ProcessedXiaData(XiaData &evt) : XiaData(evt) {
-        trace_ = evt.GetTrace();
-        trace_.SetIsSaturated(evt.IsSaturated());
+        isTraceLoaded_ = !evt.HasPendingPayload();
+        if (isTraceLoaded_) {
+            evt.CopyTrace(trace_);
+            trace_.SetIsSaturated(evt.IsSaturated());
+        }
         walkCorrectedTime_ = 0;
     };
 
@@ -35,11 +38,20 @@ public:
     ///@return The sub-sampling arrival time of the signal in nanoseconds.
     double GetHighResTimeInNs() const { return highResTimeInNs_; }
 
-    ///@return A constant reference to the trace.
-    const Trace &GetTrace() const { return trace_; }
+    ///@return A constant reference to the trace. The trace is decoded from
+    /// the list mode buffer on the first call if decoding was deferred.
+    const Trace &GetTrace() const {
+        if (!isTraceLoaded_)
+            LoadTrace();
+        return trace_;
+    }
 
     ///@return An editable trace.
-    Trace &GetTrace() { return trace_; }
+    Trace &GetTrace() {
+        if (!isTraceLoaded_)
+            LoadTrace();
+        return trace_;
+    }
 
     ///@return The Walk corrected time of the channel
     double GetWalkCorrectedTime() const { return walkCorrectedTime_; }
@@ -62,14 +74,25 @@ public:
 
     ///Sets the trace appropriately
     ///@param[in] a : The trace that we want to set
-    void SetTrace(const std::vector<unsigned int> &a) { trace_ = a; }
+    void SetTrace(const std::vector<unsigned int> &a) {
+        trace_ = a;
+        isTraceLoaded_ = true;
+    }
 
     ///Set the Walk corrected time
     ///@param [in] a : the walk corrected time */
     void SetWalkCorrectedTime(const double &a) { walkCorrectedTime_ = a; }
 
 private:
-    Trace trace_; ///< A Trace object to handle the Trace related stuff.
+    mutable Trace trace_; ///< A Trace object to handle the Trace related stuff.
+    mutable bool isTraceLoaded_; ///< False until the trace has been copied out of the XiaData payload.
+
+    ///Copies the trace out of the XiaData payload into the 16-bit samples.
+    void LoadTrace() const {
+        XiaData::CopyTrace(trace_);
+        trace_.SetIsSaturated(IsSaturated());
+        isTraceLoaded_ = true;
+    }
 
     bool isIgnored_; ///< True if we ignore this event.
     bool isValidData_; ///< True if the energy and High Res time are valid.
@@ -14,6 +14,7 @@
 #define SCANINTERFACE_HPP
 
 #include <deque>
+#include <fstream>
 #include <map>
 #include <string>
 #include <sstream>
@@ -103,6 +104,9 @@ public:
     /// Return true if dry run mode is enabled.
     bool DryRunMode() { return dry_run_mode; }
 
+    /// Return true if only the headers of the hits are decoded (see Unpacker::SetBatchMode).
+    bool HeadersOnlyMode() { return headers_only_mode; }
+
     /// Return true if shared memory mode is enabled.
     bool ShmMode() { return shm_mode; }
 
@@ -142,6 +146,9 @@ public:
     /// Enable or disable dry run mode.
     bool SetDryRunMode(bool state_ = true) { return (dry_run_mode = state_); }
 
+    /// Enable or disable decoding only the headers of the hits. Takes effect in Setup.
+    bool SetHeadersOnlyMode(bool state_ = true) { return (headers_only_mode = state_); }
+
     /// Enable or disable shared memory mode.
     bool SetShmMode(bool state_ = true) { return (shm_mode = state_); }
 
@@ -298,6 +305,7 @@ private:
     bool is_verbose; /// Set to true if the user wishes verbose information to be displayed.
     bool debug_mode; /// Set to true if the user wishes to display debug information.
     bool dry_run_mode; /// Set to true if a dry run is to be performed i.e. data is to be read but not processed.
+    bool headers_only_mode; /// Set to true if the hits are decoded into batches of headers instead of into events.
     bool shm_mode; /// Set to true if shared memory mode is to be used.
     bool batch_mode; /// Set to true if the program is to be run with no interactive command line.
     bool file_open; /// Set to true when an input binary file is successfully opened for reading.
@@ -321,6 +329,18 @@ private:
 
     Terminal *term; /// ncurses terminal used for displaying output and handling user input.
 
+    /// A list mode file that is merged with the main input file, e.g. the file written by another crate.
+    struct MergeFile {
+        std::string name; /// The name of the file.
+        std::ifstream file; /// The opened binary file.
+        DIR_buffer dirbuff; /// HRIBF DIR buffer handler.
+        HEAD_buffer headbuff; /// HRIBF HEAD buffer handler.
+        DATA_buffer databuff; /// HRIBF DATA buffer handler.
+    };
+
+    std::vector<std::string> mergeFilenames_; /// The names of the files to merge with the main input file.
+    std::vector<MergeFile *> mergeFiles_; /// The files that are merged with the main input file.
+
     /// Start the scan.
     void start_scan();
 
@@ -336,6 +356,15 @@ private:
     /// Open a new binary input file for reading.
     bool open_input_file(const std::string &fname_);
 
+    /// Open the .ldf files that are merged with the main input file.
+    bool open_merge_files();
+
+    /// Close the .ldf files that are merged with the main input file.
+    void close_merge_files();
+
+    /// Read the main input file and all merge files, letting the unpacker merge their hits on the time stamps.
+    void run_merged_scan();
+
     ///Sets output Filename and path that were passed using the -o flag.
     ///@param[in] a : The parameter that we are going to set
     void SetOutputInformation(const std::string &a);
@@ -5,6 +5,7 @@
 #ifndef __TRACE_HPP__
 #define __TRACE_HPP__
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <string>
@@ -13,21 +14,25 @@
 #include <cmath>
 
 /// @brief This defines a more extensible implementation of a digitized trace.
-/// The class is derived from a vector of unsigned integers. This is the basic
-/// form of a trace from most digitizers. The Trace class enables processed
-/// information about the trace (such as the baseline, integral, etc.).
+/// The class is derived from a vector of 16-bit samples, which holds the 12,
+/// 14 and 16-bit samples of the digitizers at half the size of an unsigned
+/// int. The Trace class enables processed information about the trace (such
+/// as the baseline, integral, etc.).
 ///
 /// We also store information about the Waveform. The waveform is the part
 /// of the trace that actually contains information about the signal that
-/// was captured. This excludes the baseline.
-class Trace : public std::vector<unsigned int> {
+/// was captured. This excludes the baseline. The baseline subtracted trace
+/// and waveform are not stored, they are calculated from the samples when
+/// they are requested. Analyzers that do this for every trace fill a buffer
+/// that they own, so that its memory is reused from one trace to the next.
+class Trace : public std::vector<unsigned short> {
 public:
     ///Default constructor
-    Trace() : std::vector<unsigned int>() {}
+    Trace() : std::vector<unsigned short>() {}
 
     ///An automatic conversion for the trace
     ///@param [in] x : the trace to store in the class
-    Trace(const std::vector<unsigned int> &x) : std::vector<unsigned int>(x) {}
+    Trace(const std::vector<unsigned int> &x) : std::vector<unsigned short>(x.begin(), x.end()) {}
 
     ///@return Returns a std::pair<double,double> containing the average and
     /// standard deviation of the baseline as the .first and .second
@@ -35,7 +40,7 @@ public:
     std::pair<double, double> GetBaselineInfo() const { return baseline_; }
 
     ///@return Returns the energy sums that were set.
-    std::vector<double> GetEnergySums() const { return esums_; }
+    const std::vector<double> &GetEnergySums() const { return esums_; }
 
     ///@return Returns a std::pair<unsigned int, double> containing the
     /// position of the maximum value in the trace and the amplitude of the
@@ -47,7 +52,7 @@ public:
     double GetFilteredBaseline() const { return filteredBaseline_; }
 
     ///@return The energies found by filtering the trace.
-    std::vector<double> GetFilteredEnergies() const { return filteredEnergies_; }
+    const std::vector<double> &GetFilteredEnergies() const { return filteredEnergies_; }
 
     ///@return Returns a std::pair<unsigned int, double> containing the
     /// position of the maximum value in the trace and the amplitude of the
@@ -73,27 +78,48 @@ public:
     ///@return The value of tau that was calculated from the trace.
     double GetTau() const { return tau_; }
 
-    ///@return Returns the waveform sans baseline
-    std::vector<double> GetTraceSansBaseline() const { return traceSansBaseline_; }
+    ///@return Returns the trace sans baseline, which is empty until the
+    /// baseline was set. This allocates a new vector on every call.
+    std::vector<double> GetTraceSansBaseline() const {
+        std::vector<double> result;
+        GetTraceSansBaseline(result);
+        return result;
+    }
+
+    ///Fills a buffer with the trace sans baseline, which is empty until the
+    /// baseline was set.
+    ///@param[out] out : The buffer, its memory is reused
+    void GetTraceSansBaseline(std::vector<double> &out) const { SubtractBaseline(0, size(), out); }
 
     ///@return Returns the Trigger Filter that was set.
-    std::vector<double> GetTriggerFilter() const { return trigFilter_; }
+    const std::vector<double> &GetTriggerFilter() const { return trigFilter_; }
 
     ///@return Returns a vector containing all of the found triggers
-    std::vector<unsigned int> GetTriggerPositions() const { return triggerPositions_; }
+    const std::vector<unsigned int> &GetTriggerPositions() const { return triggerPositions_; }
+
+    ///@return Returns the baseline subtracted waveform found inside the
+    /// trace, which is empty until the baseline was set. This allocates a
+    /// new vector on every call.
+    std::vector<double> GetWaveform() const {
+        std::vector<double> result;
+        GetWaveform(result);
+        return result;
+    }
 
-    ///@return Returns the baseline subtracted waveform found inside the trace.
-    std::vector<double> GetWaveform() {
-        return std::vector<double>(traceSansBaseline_.begin() + waveformRange_.first,
-                                   traceSansBaseline_.begin() + waveformRange_.second);
+    ///Fills a buffer with the baseline subtracted waveform found inside the
+    /// trace, which is empty until the baseline was set.
+    ///@param[out] out : The buffer, its memory is reused
+    void GetWaveform(std::vector<double> &out) const {
+        SubtractBaseline(waveformRange_.first, waveformRange_.second, out);
     }
 
     ///@return The bounds of the waveform in the trace
     std::pair<unsigned int, unsigned int> GetWaveformRange() const { return waveformRange_; }
 
     ///@return Returns the waveform with the baseline
-    std::vector<unsigned int> GetWaveformWithBaseline() {
-        return std::vector<unsigned int>(begin() + waveformRange_.first, begin() + waveformRange_.second);
+    std::vector<unsigned int> GetWaveformWithBaseline() const {
+        return std::vector<unsigned int>(begin() + std::min(waveformRange_.first, (unsigned int) size()),
+                                         begin() + std::min(waveformRange_.second, (unsigned int) size()));
     }
 
     ///@return True if we were able to successfully analyze the trace.
@@ -106,7 +132,10 @@ public:
     /// deviation)
     ///@param[in] a : The pair<double,double> containing the average and
     /// standard deviation.
-    void SetBaseline(const std::pair<double, double> &a) { baseline_ = a; }
+    void SetBaseline(const std::pair<double, double> &a) {
+        baseline_ = a;
+        hasBaseline_ = true;
+    }
 
     ///sets the energy sums vector if we are using the TriggerFilterAnalyzer
     ///@param [in] a : the vector of energy sums
@@ -152,10 +181,6 @@ public:
     ///@param[in] a : The value that we are going to set
     void SetQdc(const double &a) { qdc_ = a; }
 
-    ///Sets the baseline subtracted trace.
-    ///@param[in] a : The vector that we are going to assign.
-    void SetTraceSansBaseline(const std::vector<double> &a) { traceSansBaseline_ = a; }
-
     ///Sets the value of the tail-ratio method used for doing discrimination
     /// on signals that have a varying decay constant. This is generally
     /// defined as the integral of the "tail" of the waveform divided by the
@@ -181,16 +206,31 @@ public:
     void SetWaveformRange(const std::pair<unsigned int, unsigned int> &a) { waveformRange_ = a; }
 
 private:
-    bool isSaturated_; ///< True if the trace was flagged as saturated.
-    bool hasValidAnalysis_;///< True if the analysis of the trace was successful
+    ///Subtracts the baseline from the samples in a range.
+    ///@param[in] low : The first sample of the range
+    ///@param[in] high : One past the last sample, limited to the size
+    ///@param[out] result : The baseline subtracted samples, empty if the baseline was not set
+    void SubtractBaseline(const unsigned int &low, const unsigned int &high, std::vector<double> &result) const {
+        result.clear();
+        if (!hasBaseline_)
+            return;
+        const_iterator first = begin() + std::min(low, (unsigned int) size());
+        const_iterator last = begin() + std::min(high, (unsigned int) size());
+        for (const_iterator it = first; it < last; it++)
+            result.push_back(*it - baseline_.first);
+    }
+
+    bool isSaturated_ = false; ///< True if the trace was flagged as saturated.
+    bool hasValidAnalysis_ = false;///< True if the analysis of the trace was successful
+    bool hasBaseline_ = false; ///< True once the baseline was set
 
-    double phase_; ///< The sub-sampling phase of the trace.
-    double qdc_; ///< The qdc that was calculated from the waveform.
-    double tailRatio_; ///< The tail-ratio of the trace.
-    double tau_; ///< The tau as calculated from the waveform
-    double filteredBaseline_; ///< Baseline calculated from filtering the trc.
+    double phase_ = 0; ///< The sub-sampling phase of the trace.
+    double qdc_ = 0; ///< The qdc that was calculated from the waveform.
+    double tailRatio_ = 0; ///< The tail-ratio of the trace.
+    double tau_ = 0; ///< The tau as calculated from the waveform
+    double filteredBaseline_ = 0; ///< Baseline calculated from filtering the trc.
 
-    unsigned int numTriggers_; ///< The number of triggers in the trace.
+    unsigned int numTriggers_ = 0; ///< The number of triggers in the trace.
 
     std::pair<double, double> baseline_; ///< Baseline Average and Std. Dev.
     std::pair<unsigned int, double> max_; ///< Max position and value sans baseline
@@ -198,7 +238,6 @@ private:
     std::pair<unsigned int, unsigned int> waveformRange_; ///< Waveform Range
 
     std::vector<double> filteredEnergies_; ///< Energies from filtering the trc.
-    std::vector<double> traceSansBaseline_; ///< Baseline subtracted trace
     std::vector<double> trigFilter_; ///< The trigger filter for the trace
     std::vector<double> esums_; ///< The Energy sums calculated from the trace
 
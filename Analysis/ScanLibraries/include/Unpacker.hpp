@@ -16,16 +16,16 @@
 #include <deque>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "XiaListModeDataMask.hpp"
+#include <stdint.h>
 
-#ifndef MAX_PIXIE_MOD
-#define MAX_PIXIE_MOD 12
-#endif
-#ifndef MAX_PIXIE_CHAN
-#define MAX_PIXIE_CHAN 15
-#endif
+#include "XiaDataMerger.hpp"
+#include "XiaHitBatch.hpp"
+#include "XiaListModeDataDecoder.hpp"
+#include "XiaListModeDataMask.hpp"
+#include "XiaTopology.hpp"
 
 class XiaData;
 
@@ -33,6 +33,16 @@ class ScanMain;
 
 class Unpacker {
 public:
+    /// The part of a triggered event that the hits of one group of channels are taken from, in clock ticks.
+    struct EventWindow {
+        EventWindow(const double &preWindow = 0, const double &postWindow = 0, const bool &trigger = false) :
+                pre(preWindow), post(postWindow), isTrigger(trigger) {}
+
+        double pre; ///< How far before the trigger the window opens
+        double post; ///< How far after the trigger the window closes
+        bool isTrigger; ///< True if the hits in this group start events
+    };
+
     /// Default constructor.
     Unpacker();
 
@@ -63,15 +73,117 @@ public:
     /// Get the time of the last xia event in the raw event.
     double GetRealStopTime() { return realStopTime; }
 
+    /// Get the merger that combines the hits from several synchronized sources.
+    const XiaDataMerger &GetMerger() const { return merger_; }
+
+    /// Get the index of the source that we need to read next to advance the merge, or -1 if all sources finished.
+    int GetNextSource() const { return merger_.GetNextSource(); }
+
+    /// Get the number of synchronized sources that are merged into one event stream.
+    unsigned int GetNumberOfSources() const { return merger_.GetNumberOfSources(); }
+
     /// Return true if the scan is running and false otherwise.
     bool IsRunning() { return running; }
 
     /// Toggle debug mode on / off.
     bool SetDebugMode(bool state_ = true) { return (debug_mode = state_); }
 
+    /// Get the number of spills that were skipped because they were inside of a rejection region.
+    unsigned long long GetNumberOfRejectedSpills() const { return numRejectedSpills_; }
+
+    /** Check if a time is inside of one of the rejection regions.
+      * \param[in] time The time in clock ticks, e.g. GetEventStartTime.
+      * \return True if the time is rejected, always false before the first event has been built.
+      */
+    bool IsRejected(const double &time);
+
+    /** Set the regions of the data that we want to ignore. The regions are open intervals in clock ticks after the
+      * start of the first event. They are sorted and overlapping regions are merged. Spills that lie inside of a
+      * region are skipped before they are decoded.
+      * \param[in] regions The start and stop of the regions.
+      * \return Nothing.
+      */
+    void SetRejectionRegions(const std::vector<std::pair<double, double> > &regions);
+
+    /// Get true if the spills are decoded into a XiaHitBatch instead of into XiaData.
+    bool IsBatchMode() const { return isBatchMode_; }
+
+    /// Toggle batch mode on / off. In batch mode only the header quantities of the hits are decoded into the
+    /// columns of a XiaHitBatch, which is handed to ProcessHitBatch once per spill. No events are built, so the
+    /// rejection regions are not applied. GetFirstTime is the earliest hit of the first batch.
+    void SetBatchMode(const bool &a) { isBatchMode_ = a; }
+
     /// Set the width of events in pixie16 clock ticks.
     void SetEventWidth(double width) { eventWidth_ = width; }
 
+    /// Toggle lazy decoding of the energy sums, QDCs and traces on / off.
+    void SetLazyDecoding(const bool &a) { decoder_.SetLazy(a); }
+
+    /// Set the mask of channel IDs (see XiaData::GetId) that we want to keep.
+    /// Hits from all other channels are discarded while decoding the buffer.
+    void SetKeepMask(const std::vector<bool> &a) { decoder_.SetKeepMask(a); }
+
+    /// Get the number of hits that were discarded because of the keep mask.
+    unsigned long long GetNumberOfDiscardedHits() const { return decoder_.GetNumberOfDiscardedHits(); }
+
+    /// Get the number of hits whose crate, module or channel was outside of the topology.
+    unsigned long long GetNumberOfOutOfRangeHits() const { return numOutOfRangeHits_; }
+
+    /// Set the crate, module and channel layout of the system. This sizes the per-module event lists and
+    /// per-channel counters, and sets the topology used by XiaData::GetId.
+    void SetTopology(const XiaTopology &topology);
+
+    /// Get the number of hits that were not inside the window of any trigger.
+    unsigned long long GetNumberOfUntriggeredHits() const { return numUntriggeredHits_; }
+
+    /** Build events around triggers instead of around the first hit. Every channel is put into a group, each
+      * group gets its own time sorted list and window around the trigger. The earliest hit from the trigger groups
+      * opens the event. Calling this with no windows goes back to building events with the event width.
+      * \param[in] groupOfId The group of every channel ID in the topology (see XiaData::GetId).
+      * \param[in] windows The event window of every group.
+      * \throws invalid_argument if a channel has no group, a window is negative or none of the groups triggers.
+      * \return Nothing.
+      */
+    void SetTriggeredBuilding(const std::vector<unsigned int> &groupOfId, const std::vector<EventWindow> &windows);
+
+    /** Build all of the events from the hits that are still waiting in the re-ordering buffer.
+      * \return Nothing.
+      */
+    void Flush();
+
+    /// Get the number of times that the clock went backwards by more than the clock reset threshold.
+    unsigned int GetNumberOfClockResets() const { return numClockResets_; }
+
+    /// Get the number of hits that arrived after the watermark of the re-ordering buffer passed them.
+    unsigned long long GetNumberOfLateHits() const { return numLateHits_; }
+
+    /// Set how far back (in clock ticks) a spill has to start behind the watermark before we call it a clock reset.
+    void SetClockResetThreshold(const double &a) { clockResetThreshold_ = a; }
+
+    /// Set the width of the re-ordering buffer in clock ticks. Hits are held until the latest time that we've seen
+    /// is this far past them. A width of zero builds every spill on its own.
+    void SetReorderWindow(const double &a) {
+        reorderWindow_ = a;
+        merger_.SetReorderWindow(a);
+    }
+
+    /// Set the clock correction of one of the merged sources, see XiaDataMerger::SetClockCorrection.
+    void SetClockCorrection(const unsigned int &source, const double &offset, const double &drift) {
+        merger_.SetClockCorrection(source, offset, drift);
+    }
+
+    /// Set the maximum number of hits buffered for a source before the merge stops waiting for empty sources.
+    void SetMaximumBufferedHits(const size_t &a) { merger_.SetMaximumBufferedHits(a); }
+
+    /// Set the number of synchronized sources (e.g. one file per crate) that are merged into one event stream.
+    void SetNumberOfSources(const unsigned int &a) { merger_.SetNumberOfSources(a); }
+
+    /** Tell the unpacker that a source will not deliver any more spills. Once all of the sources are finished the
+      * remaining hits are built into events.
+      * \param[in]  source The index of the source that finished.
+      */
+    void FinishSource(const unsigned int &source);
+
     void InitializeDataMask(const std::string &firmware, const unsigned int &frequency = 0);
 
     /** ReadSpill is responsible for constructing a list of pixie16 events from
@@ -80,9 +192,12 @@ public:
       * \param[in]  data       Pointer to an array of unsigned ints containing the spill data.
       * \param[in]  nWords     The number of words in the array.
       * \param[in]  is_verbose Toggle the verbosity flag on/off.
+      * \param[in]  source     The index of the synchronized source that the spill came from. The hits of the spill
+      *                        are handed to the merger and only built into events once all sources caught up. A
+      *                        value of -1 builds the events from this spill alone.
       * \return True if the spill was read successfully and false otherwise.
       */
-    bool ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbose = true);
+    bool ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbose = true, const int &source = -1);
 
     /** Write all recorded channel counts to a file.
       * \return Nothing.
@@ -103,6 +218,7 @@ protected:
     bool debug_mode; ///< True if debug mode is set.
     std::vector<std::deque<XiaData *>> eventList; ///< The list of all events in a spill.
     double eventWidth_; ///< The width of the raw event in pixie clock ticks
+    XiaListModeDataDecoder decoder_; ///< Object that decodes the buffers into XiaData.
     XiaListModeDataMask mask_; ///< Object providing the masks necessary to decode the data.
     std::map<unsigned int, std::pair<std::string, unsigned int> > maskMap_;///< Maps firmware/frequency to module number
     unsigned int maxModuleNumberInFile_; ///< The maximum module number that we've encountered in the data file.
@@ -122,6 +238,13 @@ protected:
       */
     virtual void RawStats(XiaData *event_) {}
 
+    /** Process the header quantities of all of the hits in a spill when in batch mode. The payload offsets of the
+      * batch point into the spill buffer, which is only valid for the duration of the call. Unused by default.
+      * \param[in]  batch The columns of the hits in the spill.
+      * \return Nothing.
+      */
+    virtual void ProcessHitBatch(const XiaHitBatch &batch) {}
+
     /** Called form ReadSpill. Scan the current spill and construct a list of
       * events which fired by obtaining the module, channel, trace, etc. of the
       * timestamped event. This method will construct the event list for
@@ -137,13 +260,63 @@ private:
     unsigned int maxWords; /// Maximum number of data words for revision D.
     unsigned int numRawEvt; /// The total count of raw events read from file.
 
-    unsigned int channel_counts[MAX_PIXIE_MOD + 1][MAX_PIXIE_CHAN + 1]; /// Counters for each channel in each module.
+    std::vector<unsigned int> channelCounts_; /// Counters for each channel, indexed by XiaData::GetId.
+    unsigned long long numOutOfRangeHits_; /// The number of hits that fell outside of the topology.
 
     double firstTime; /// The first recorded event time.
     double eventStartTime; /// The start time of the current raw event.
     double realStartTime; /// The time of the first xia event in the raw event.
     double realStopTime; /// The time of the last xia event in the raw event.
 
+    XiaDataMerger merger_; /// Merges the hits from several synchronized sources.
+    int currentSource_; /// The source of the spill that we are reading, -1 if we aren't merging.
+    std::vector<XiaData *> spillHits_; /// The hits of the current spill when we are merging or re-ordering.
+    double reorderWindow_; /// The width of the re-ordering buffer in clock ticks.
+    double clockResetThreshold_; /// How far a spill has to jump backwards in clock ticks to start a new epoch.
+    double watermark_; /// All events before this time have been built.
+    double latestTime_; /// The latest time that we have seen in the current epoch.
+    unsigned long long numLateHits_; /// The number of hits that arrived behind the watermark.
+    unsigned int numClockResets_; /// The number of clock resets that we detected.
+
+    std::vector<EventWindow> eventWindows_; /// The window of every group of channels when building on triggers.
+    std::vector<unsigned int> groupOfId_; /// The group of every channel ID when building on triggers.
+    double maxPostWindow_; /// The largest post trigger window of all of the groups.
+    unsigned long long numUntriggeredHits_; /// The number of hits that were outside of every trigger window.
+    bool isBatchMode_; /// True if we decode the spills into batch_ instead of into XiaData.
+    XiaHitBatch batch_; /// The header quantities of the hits in the current spill in batch mode.
+    unsigned long long numHitBatches_; /// The number of batches that were handed to ProcessHitBatch.
+    std::vector<std::pair<double, double> > rejectionRegions_; /// The sorted, disjoint rejection regions.
+    size_t rejectionCursor_; /// The first rejection region that ends after the last time that we checked.
+    unsigned long long numRejectedSpills_; /// The number of spills that were skipped by the rejection regions.
+    XiaListModeDataDecoder spillScanner_; /// Decoder without a keep mask used to find the time range of a spill.
+    XiaHitBatch spillScan_; /// The headers of the spill that we're checking against the rejection regions.
+
+    /** Set the firmware and frequency of the data mask for a module.
+      * \param[in] vsn The module number.
+      * \return Nothing.
+      */
+    void SetMaskForVsn(const unsigned int &vsn);
+
+    /** Find the first rejection region that ends after a time.
+      * \param[in] relativeTime The time in clock ticks since the first event.
+      * \return The index of the region, or the number of regions if they have all ended.
+      */
+    size_t FindRejectionRegion(const double &relativeTime) const;
+
+    /** Check if all of the hits in a spill lie inside of a single rejection region.
+      * \param[in] data The spill that we are going to check.
+      * \param[in] nWords The number of words in the spill.
+      * \return True if the whole spill can be skipped.
+      */
+    bool IsSpillRejected(unsigned int *data, const unsigned int &nWords);
+
+    ///@return The index of the list in the eventList that the hits from the channel go into, the group of the
+    /// channel when building on triggers and the module otherwise.
+    unsigned int GetListIndex(const unsigned int &id) const;
+
+    ///@return True if the hits of a spill are collected in spillHits_ before they're added to the event list.
+    bool IsBufferingSpill() const { return currentSource_ >= 0 || reorderWindow_ > 0; }
+
     /** Scan the event list and sort it by timestamp.
       * \return Nothing.
       */
@@ -167,6 +340,44 @@ private:
       */
     void ClearEventList();
 
+    /** Clear all of the events that were read from the current spill. WARNING! This method will delete the events.
+      * \return Nothing.
+      */
+    void ClearSpill();
+
+    /** Take all of the hits that the merger can release, and build and process every event that is complete.
+      * \return Nothing.
+      */
+    void ProcessMergedHits();
+
+    /** Add the hits of the current spill to the re-ordering buffer and build every event that the watermark passed.
+      * \return Nothing.
+      */
+    void ProcessReorderedHits();
+
+    /** Decode the payloads of the hits that are still waiting in the event list, so that they don't point into
+      * the spill buffer once ReadSpill returns. Does nothing unless we're decoding lazily.
+      * \return Nothing.
+      */
+    void DecodeRetainedHits();
+
+    /** Build and process all of the events that close before the provided time.
+      * \param[in]  time The time before which all events are complete.
+      * \return Nothing.
+      */
+    void BuildEventsBefore(const double &time);
+
+    /** Build the next event around the earliest trigger.
+      * \return True if we found a trigger and false otherwise.
+      */
+    bool BuildTriggeredEvent();
+
+    /** Get the time of the earliest hit from the groups of channels that trigger events.
+      * \param[out] time The fixed-point time of the next trigger (see XiaData::GetFixedTime).
+      * \return True if there is a trigger in the event list and false otherwise.
+      */
+    bool GetNextTriggerTime(int64_t &time);
+
     /** Clear all events in the raw event list. WARNING! This method will delete all events in the
       * event list. This could cause seg faults if the events are used elsewhere.
       * \return Nothing.
@@ -179,6 +390,12 @@ private:
       */
     bool GetFirstTime(double &time);
 
+    /** Get the minimum fixed-point channel time from the event list.
+      * \param[out] time The minimum time from the event list, see XiaData::GetFixedTime.
+      * \return True if the event list is not empty and false otherwise.
+      */
+    bool GetFirstTime(int64_t &time);
+
     /** Check whether or not the eventList is empty.
       * \return True if the eventList is empty, and false otherwise.
       */
@@ -4,8 +4,13 @@
 #ifndef XIADATA_HPP
 #define XIADATA_HPP
 
+#include <deque>
 #include <vector>
 
+#include <stdint.h>
+
+#include "XiaTopology.hpp"
+
 /*! \brief A pixie16 channel event
  *
  * All data is grouped together into channels.  For each pixie16 channel that
@@ -39,7 +44,7 @@ public:
     /// class is less than the time of the comparison class.
     ///@param[in] rhs : The right hand side for the comparison
     ///@return True if this instance arrived earlier than the right hand side.
-    bool operator<(const XiaData &rhs) const { return GetTime() < rhs.GetTime(); }
+    bool operator<(const XiaData &rhs) const { return fixedTime_ < rhs.fixedTime_; }
 
     ///@brief The conjugate of the less than operator
     ///@param[in] rhs : The right hand side for the comparison
@@ -53,7 +58,27 @@ public:
     ///@param[in] rhs : A pointer to the right hand side of the comparison
     ///@return True if the time of arrival for right hand side is later than
     /// that of the left hand side.
-    static bool CompareTime(const XiaData *lhs, const XiaData *rhs) { return lhs->GetTime() < rhs->GetTime(); }
+    static bool CompareTime(const XiaData *lhs, const XiaData *rhs) { return lhs->fixedTime_ < rhs->fixedTime_; }
+
+    ///@brief Sorts the hits on their fixed-point time. Long lists are sorted
+    /// with an LSD radix sort on the integer time, short ones with std::sort.
+    ///@param[in,out] hits : The hits that we are going to sort.
+    static void SortByTime(std::deque<XiaData *> &hits);
+
+    ///@brief The number of fractional bits in the fixed-point time. 48 bits of
+    /// time stamp times the factor 10 for the 500 MHz modules leaves 11 bits for
+    /// the CFD fraction in a signed 64-bit integer, i.e. 1/2048 of a sample.
+    static const unsigned int fixedTimeFractionBits = 11;
+
+    ///@param[in] fixedTime : A fixed-point time
+    ///@return The time in samples
+    static double FromFixedTime(const int64_t &fixedTime) {
+        return fixedTime * (1.0 / (int64_t(1) << fixedTimeFractionBits));
+    }
+
+    ///@param[in] time : A time in samples
+    ///@return The time as a fixed-point number, rounded to the nearest step
+    static int64_t ToFixedTime(const double &time);
 
     ///@brief A method that will compare the unique ID of two XiaData classes
     ///@param[in] lhs : A pointer to the left hand side of the comparison
@@ -77,11 +102,19 @@ public:
     ///@return True if this channel was generated on the module
     bool IsVirtualChannel() const { return isVirtualChannel_; }
 
+    ///@return True if the energy sums, QDCs and trace have not yet been
+    /// decoded from the list mode buffer.
+    bool HasPendingPayload() const { return payload_ != nullptr; }
+
     ///@return The baseline as calculated on-board the Pixie-16 modules using
     /// the energy filter. This parameter is only set if the data set
     /// contains the Energy Sums in the list mode data. This baseline cannot
     /// be used in conjunction with trace information.
-    double GetFilterBaseline() const { return filterBaseline_; }
+    double GetFilterBaseline() const {
+        if (payload_)
+            DecodePayload();
+        return filterBaseline_;
+    }
 
     ///@return The energy that was calculated on the module
     double GetEnergy() const { return energy_; }
@@ -90,8 +123,22 @@ public:
     double GetExternalTimestamp() const { return externalTimestamp_; }
 
     ///@return The time for the channel including all of the CFD information
-    /// when available.
-    double GetTime() const { return time_; }
+    /// when available. Hits set with SetTimeFromTimestamp calculate it with the
+    /// full precision of the CFD fraction the first time that it's called,
+    /// hits set with SetFixedTime convert the fixed-point time.
+    double GetTime() const {
+        if (!isTimeConverted_) {
+            time_ = cfdSize_ != 0 ? CalculateTime() : FromFixedTime(fixedTime_);
+            isTimeConverted_ = true;
+        }
+        return time_;
+    }
+
+    ///@return The time for the channel as a fixed-point number with
+    /// fixedTimeFractionBits fractional bits. This is the key that the hits
+    /// are sorted and built into events on. It is the CFD time rounded down to
+    /// 1/2048 of a sample, so it can be up to that much before GetTime.
+    int64_t GetFixedTime() const { return fixedTime_; }
 
     ///@return The arrival time of the signal without any CFD information in
     /// the calculation
@@ -120,10 +167,17 @@ public:
     /// module via the front panel
     unsigned int GetExternalTimeLow() const { return externalTimeLow_; }
 
-    ///@return The unique ID of the channel.
-    ///We can have a maximum of 208 channels in a crate, the first module (#0) is always in the second slot of the crate, and
-    /// we always have 16 channels
-    unsigned int GetId() const { return crateNum_ * 208 + GetModuleNumber() * 16 + chanNum_; }
+    ///@return The unique ID of the channel. The IDs are assigned densely using the topology that was set with
+    /// SetTopology. The first module (#0) is always in the second slot of the crate. Channels that lie outside of
+    /// the topology return XiaTopology::InvalidId.
+    unsigned int GetId() const { return topology_.GetId(crateNum_, GetModuleNumber(), chanNum_); }
+
+    ///@return The topology that is used to calculate the channel IDs.
+    static const XiaTopology &GetTopology() { return topology_; }
+
+    ///Sets the topology that is used to calculate the channel IDs of all XiaData objects.
+    ///@param[in] a : The topology of the system
+    static void SetTopology(const XiaTopology &a) { topology_ = a; }
 
     ///@return the module number
     unsigned int GetModuleNumber() const { return slotNum_ - 2; }
@@ -132,13 +186,35 @@ public:
     unsigned int GetSlotNumber() const { return slotNum_; }
 
     ///@return The energy sums recorded on the module
-    std::vector<unsigned int> GetEnergySums() const { return eSums_; }
+    std::vector<unsigned int> GetEnergySums() const {
+        if (payload_)
+            DecodePayload();
+        return eSums_;
+    }
 
     ///@return the QDC recorded on the module
-    std::vector<unsigned int> GetQdc() const { return qdc_; }
+    std::vector<unsigned int> GetQdc() const {
+        if (payload_)
+            DecodePayload();
+        return qdc_;
+    }
 
     ///@return The trace that was sampled on the module
-    std::vector<unsigned int> GetTrace() const { return trace_; }
+    std::vector<unsigned int> GetTrace() const {
+        if (payload_)
+            DecodePayload();
+        return trace_;
+    }
+
+    ///Copies the trace into 16-bit samples. A trace that is still in the
+    /// list mode buffer is copied straight from there without decoding the
+    /// rest of the payload.
+    ///@param[out] samples : The vector that gets the samples
+    void CopyTrace(std::vector<unsigned short> &samples) const;
+
+    ///@return The length of the trace that was sampled on the module. This
+    /// does not require the trace to be decoded.
+    unsigned int GetTraceLength() const { return payload_ ? payloadTraceLength_ : (unsigned int) trace_.size(); }
 
     ///@brief This value is set to true if the CFD was forced to trigger
     ///@param[in] a : The value to set
@@ -151,7 +227,11 @@ public:
     ///@brief Sets the baseline recorded on the module if the energy sums
     /// were recorded in the data stream
     ///@param[in] a : The value to set
-    void SetFilterBaseline(const double &a) { filterBaseline_ = a; }
+    void SetFilterBaseline(const double &a) {
+        if (payload_)
+            DecodePayload();
+        filterBaseline_ = a;
+    }
 
     ///@brief Sets the CFD fractional time calculated on-board
     ///@param[in] a : The value to set
@@ -175,7 +255,11 @@ public:
 
     ///@brief Sets the energy sums calculated on-board
     ///@param[in] a : The value to set
-    void SetEnergySums(const std::vector<unsigned int> &a) { eSums_ = a; }
+    void SetEnergySums(const std::vector<unsigned int> &a) {
+        if (payload_)
+            DecodePayload();
+        eSums_ = a;
+    }
 
     ///@brief Sets the upper 16 bits of the event time
     ///@param[in] a : The value to set
@@ -197,9 +281,29 @@ public:
     ///@param[in] a : The value to set
     void SetPileup(const bool &a) { isPileup_ = a; }
 
+    ///@brief Records where the energy sums, QDCs and trace for this channel
+    /// live in the list mode buffer so that they can be decoded the first
+    /// time that they are requested. The buffer must outlive this object or
+    /// the payload must be decoded before the buffer is released.
+    ///@param[in] buf : Pointer to the first word of the channel header
+    ///@param[in] energySumsOffset : Offset of the energy sums from buf, 0 if there are none.
+    ///@param[in] numEnergySumWords : The number of energy sum words including the baseline
+    ///@param[in] qdcOffset : Offset of the QDC sums from buf, 0 if there are none.
+    ///@param[in] numQdcWords : The number of QDC words
+    ///@param[in] traceOffset : Offset of the trace from buf.
+    ///@param[in] traceLength : The number of samples in the trace
+    void SetPayload(const unsigned int *buf, const unsigned int &energySumsOffset,
+                    const unsigned int &numEnergySumWords, const unsigned int &qdcOffset,
+                    const unsigned int &numQdcWords, const unsigned int &traceOffset,
+                    const unsigned int &traceLength);
+
     ///@brief Sets the QDCs that were calculated on-board
     ///@param[in] a : The value to set
-    void SetQdc(const std::vector<unsigned int> &a) { qdc_ = a; }
+    void SetQdc(const std::vector<unsigned int> &a) {
+        if (payload_)
+            DecodePayload();
+        qdc_ = a;
+    }
 
     ///@brief Sets the saturation flag
     ///@param[in] a : True if we found a saturation on board
@@ -211,7 +315,33 @@ public:
 
     ///@brief Sets the calculated arrival time of the signal
     ///@param[in] a : The value to set
-    void SetTime(const double &a) { time_ = a; }
+    void SetTime(const double &a) {
+        time_ = a;
+        fixedTime_ = ToFixedTime(a);
+        isTimeConverted_ = true;
+    }
+
+    ///@brief Sets the arrival time of the signal as a fixed-point number,
+    /// GetTime converts it to a double the first time that it's called.
+    ///@param[in] a : The value to set
+    void SetFixedTime(const int64_t &a) {
+        fixedTime_ = a;
+        cfdSize_ = 0;
+        isTimeConverted_ = false;
+    }
+
+    ///@brief Sets the arrival time of the signal from the time stamp and the
+    /// CFD information that were decoded. GetTime calculates the time from
+    /// them the first time that it's called.
+    ///@param[in] fixedTime : The fixed-point time for sorting and building
+    ///@param[in] multiplier : The number of samples per tick of the time stamp
+    ///@param[in] cfdSize : The number of steps of the CFD fractional time
+    void SetTimeFromTimestamp(const int64_t &fixedTime, const unsigned int &multiplier, const double &cfdSize) {
+        fixedTime_ = fixedTime;
+        timeMultiplier_ = multiplier;
+        cfdSize_ = cfdSize;
+        isTimeConverted_ = false;
+    }
 
     ///@brief Sets the calculated arrival time of the signal sans the CFD
     /// fractional time components.
@@ -220,7 +350,11 @@ public:
 
     ///@brief Sets the trace recorded on board
     ///@param[in] a : The value to set
-    void SetTrace(const std::vector<unsigned int> &a) { trace_ = a; }
+    void SetTrace(const std::vector<unsigned int> &a) {
+        if (payload_)
+            DecodePayload();
+        trace_ = a;
+    }
 
     ///@brief Sets the flag for channels generated on-board
     ///@param[in] a : True if we this channel was generated on-board
@@ -229,18 +363,32 @@ public:
     ///@brief Initialize all variables and set them to some default values.
     void Initialize();
 
+    ///@brief Decodes the energy sums, QDCs and trace from the list mode
+    /// buffer recorded with SetPayload. This is called automatically by the
+    /// getters, and can be called by hand to detach this object from the
+    /// buffer.
+    void DecodePayload() const;
+
 private:
+    ///@return The time in samples calculated from the time stamp and the CFD
+    /// fractional time, see XiaListModeDataDecoder::CalculateTimeInSamples.
+    double CalculateTime() const;
+
+    static XiaTopology topology_; ///< The topology used to calculate the channel IDs
     bool cfdForceTrig_; /// CFD was forced to trigger.
     bool cfdTrigSource_; /// The ADC that the CFD/FPGA synced with.
     bool isPileup_; /// Pile-up flag from Pixie.
     bool isSaturated_; /// Saturation flag from Pixie.
     bool isVirtualChannel_; /// Flagged if generated virtually in Pixie DSP.
+    mutable bool isTimeConverted_; ///< True if time_ holds the fixed-point time as a double
 
     double energy_; /// Raw pixie energy.
     double externalTimestamp_; ///!< The external timestamp recorded by the module.
-    double filterBaseline_;///Baseline that was recorded with the energy sums
-    double time_; ///< The time of arrival using all parts of the time
+    mutable double filterBaseline_;///Baseline that was recorded with the energy sums
+    mutable double time_; ///< The time of arrival using all parts of the time
+    int64_t fixedTime_; ///< The time of arrival as a fixed-point number
     double timeSansCfd_; ///< The time of arrival of the signal sans CFD time.
+    double cfdSize_; ///< Steps of the CFD fraction, 0 if GetTime converts the fixed-point time.
 
     unsigned int cfdTime_; /// CFD trigger time
     unsigned int chanNum_; /// Channel number.
@@ -250,10 +398,19 @@ private:
     unsigned int externalTimeHigh_; ///Upper 16 bits of external time stamp
     unsigned int externalTimeLow_; ///Lower 32 bits of external time stamp
     unsigned int slotNum_; ///Slot number
-
-    std::vector<unsigned int> eSums_;///Energy sums recorded by the module
-    std::vector<unsigned int> qdc_; ///QDCs recorded by the module
-    std::vector<unsigned int> trace_; /// ADC trace capture.
+    unsigned int timeMultiplier_; ///< Samples per tick of the time stamp
+
+    mutable std::vector<unsigned int> eSums_;///Energy sums recorded by the module
+    mutable std::vector<unsigned int> qdc_; ///QDCs recorded by the module
+    mutable std::vector<unsigned int> trace_; /// ADC trace capture.
+
+    mutable const unsigned int *payload_; ///Header of the channel in the list mode buffer, null once decoded.
+    unsigned int payloadEnergySumsOffset_; ///Offset of the energy sums in the payload
+    unsigned int payloadNumEnergySumWords_; ///Number of energy sum words in the payload
+    unsigned int payloadQdcOffset_; ///Offset of the QDCs in the payload
+    unsigned int payloadNumQdcWords_; ///Number of QDC words in the payload
+    unsigned int payloadTraceOffset_; ///Offset of the trace in the payload
+    unsigned int payloadTraceLength_; ///Number of trace samples in the payload
 };
 
 #endif
\ No newline at end of file
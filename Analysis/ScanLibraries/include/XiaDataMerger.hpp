@@ -0,0 +1,120 @@
+///@file XiaDataMerger.hpp
+///@brief Class that performs a k-way merge on the time stamps of hits coming
+/// from several synchronized data streams, e.g. one list mode file per crate.
+///@date October 17, 2026
+#ifndef PIXIESUITE_XIADATAMERGER_HPP
+#define PIXIESUITE_XIADATAMERGER_HPP
+
+#include <deque>
+#include <vector>
+
+#include <cstddef>
+
+class XiaData;
+
+///A class that buffers the hits from several data streams (sources) and merges them into a single time ordered
+/// stream. Each source has its own clock correction, the corrected time is
+/// time + offset + drift * time, with the offset in clock ticks and the drift in ticks per tick. The sources must
+/// deliver their hits in (roughly) increasing time. A hit is only released once every unfinished source has
+/// buffered a later hit, so that nothing that arrives later can land in front of it. The look-ahead buffers are
+/// bounded : once a source holds more than the maximum number of hits the merge stops waiting for the sources that
+/// have nothing buffered.
+class XiaDataMerger {
+public:
+    ///Default constructor
+    XiaDataMerger();
+
+    ///Default destructor. Deletes all of the hits that are still buffered.
+    ~XiaDataMerger();
+
+    ///Deletes all of the buffered hits and resets the state of the sources.
+    void Clear();
+
+    ///Marks a source as finished, it will not hold back the merge any more.
+    ///@param[in] source : The index of the source
+    void Finish(const unsigned int &source);
+
+    ///@return True if all of the sources were marked finished.
+    bool IsFinished() const;
+
+    ///@return The index of the source that holds back the merge, i.e. the
+    /// unfinished source with the earliest last buffered hit. Returns -1 if
+    /// all of the sources are finished.
+    int GetNextSource() const;
+
+    ///@return The number of sources that we are merging
+    unsigned int GetNumberOfSources() const { return (unsigned int) sources_.size(); }
+
+    ///@return The difference in clock ticks between the latest buffered hit and the last merged hit. This is the
+    /// amount of data that is waiting for the slowest source.
+    double GetLag() const;
+
+    ///@param[in] source : The index of the source
+    ///@return The number of hits that are buffered for the source
+    size_t GetOccupancy(const unsigned int &source) const { return sources_.at(source).hits.size(); }
+
+    ///@return The largest number of hits that were buffered for any source at one time
+    size_t GetPeakOccupancy() const { return peakOccupancy_; }
+
+    ///@return The number of hits that arrived after we had already merged later hits
+    unsigned long long GetNumberOfLateHits() const { return numLateHits_; }
+
+    ///@return The number of merges that did not wait for all sources because a look-ahead buffer was full.
+    unsigned long long GetNumberOfForcedMerges() const { return numForcedMerges_; }
+
+    ///Adds hits from a source. The clock correction for the source is applied to the hits and they are sorted
+    /// into the buffer of the source. The merger takes ownership of the hits.
+    ///@param[in] source : The index of the source
+    ///@param[in] hits : The hits that we are going to add.
+    void Add(const unsigned int &source, const std::vector<XiaData *> &hits);
+
+    ///Decodes the payloads of all of the buffered hits (see XiaData::DecodePayload). Hits that were decoded lazily
+    /// point into the buffer that they were read from, which is reused long before the hits are merged.
+    void DecodePayloads();
+
+    ///Moves every hit that can safely be released into the provided vector, in time order.
+    ///@param[out] merged : The vector that we append the merged hits to.
+    ///@return The time up to which the merged stream is complete.
+    double Merge(std::vector<XiaData *> &merged);
+
+    ///Sets the clock correction for a source
+    ///@param[in] source : The index of the source
+    ///@param[in] offset : The offset of the clock in clock ticks
+    ///@param[in] drift : The drift of the clock in ticks per tick
+    void SetClockCorrection(const unsigned int &source, const double &offset, const double &drift);
+
+    ///@param[in] a : The maximum number of hits buffered for any source before we stop waiting for empty sources.
+    void SetMaximumBufferedHits(const size_t &a) { maxBufferedHits_ = a; }
+
+    ///@param[in] a : The width of the re-ordering window in clock ticks. Hits are held back until every source
+    /// is this far past them.
+    void SetReorderWindow(const double &a) { reorderWindow_ = a; }
+
+    ///Sets the number of sources and resets all of them.
+    ///@param[in] a : The number of sources that we are going to merge
+    void SetNumberOfSources(const unsigned int &a);
+
+private:
+    ///Structure holding the buffered hits and settings for one of the sources.
+    struct Source {
+        Source() : offset(0), drift(0), isFinished(false) {}
+
+        std::deque<XiaData *> hits; ///< The time ordered hits that are waiting to be merged
+        double offset; ///< The clock offset in clock ticks
+        double drift; ///< The clock drift in ticks per tick
+        bool isFinished; ///< True if the source will not deliver any more hits
+    };
+
+    std::vector<Source> sources_; ///< The sources that we are merging
+    size_t maxBufferedHits_; ///< Maximum number of hits buffered for a source before we force a merge
+    size_t peakOccupancy_; ///< The largest number of hits buffered for a source
+    double lastMergedTime_; ///< The time of the last hit that was released
+    double reorderWindow_; ///< The hits are held back by this many clock ticks
+    unsigned long long numLateHits_; ///< Number of hits that arrived after later hits were released
+    unsigned long long numForcedMerges_; ///< Number of merges that did not wait for empty sources
+
+    ///@return The time up to which we can release hits.
+    double CalculateHorizon();
+};
+
+#endif //PIXIESUITE_XIADATAMERGER_HPP
@@ -0,0 +1,130 @@
+///@file XiaHitBatch.hpp
+///@brief Class that holds the header quantities of the hits in a spill in
+/// columns, one array per quantity.
+///@date October 17, 2026
+#ifndef PIXIESUITE_XIAHITBATCH_HPP
+#define PIXIESUITE_XIAHITBATCH_HPP
+
+#include <vector>
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "XiaData.hpp"
+
+///A structure of arrays holding the quantities from the first four header words of every hit in a batch, usually a
+/// spill. This is filled by XiaListModeDataDecoder::DecodeHeaders without creating any XiaData objects. Tools that
+/// only need the time, channel or energy of the hits, e.g. rate monitors or quick look spectra, can loop over the
+/// columns directly. The hit with index i has its values at index i of every column.
+class XiaHitBatch {
+public:
+    ///The bits of the flags column
+    enum Flags {
+        PILEUP = 0x1, ///< The module flagged a pileup
+        SATURATED = 0x2, ///< The trace was out of range
+        CFD_FORCED_TRIGGER = 0x4, ///< The CFD was forced to trigger
+        CFD_TRIGGER_SOURCE = 0x8, ///< The ADC that the CFD synced with
+        VIRTUAL_CHANNEL = 0x10 ///< The channel was generated on the module
+    };
+
+    ///Default constructor
+    XiaHitBatch() : buffer_(nullptr) {}
+
+    ///Default destructor
+    ~XiaHitBatch() {}
+
+    ///Removes all of the hits and forgets the buffer, the memory of the columns is kept for the next batch.
+    void Clear() {
+        fixedTime_.clear();
+        id_.clear();
+        energy_.clear();
+        cfdFraction_.clear();
+        flags_.clear();
+        payloadOffset_.clear();
+        buffer_ = nullptr;
+    }
+
+    ///Reserves memory in all of the columns
+    ///@param[in] size : The number of hits that we expect
+    void Reserve(const size_t &size) {
+        fixedTime_.reserve(size);
+        id_.reserve(size);
+        energy_.reserve(size);
+        cfdFraction_.reserve(size);
+        flags_.reserve(size);
+        payloadOffset_.reserve(size);
+    }
+
+    ///Adds a hit to the end of the batch
+    ///@param[in] fixedTime : The fixed-point time of the hit, see XiaData::GetFixedTime
+    ///@param[in] id : The channel ID of the hit, see XiaData::GetId
+    ///@param[in] energy : The energy calculated on the module
+    ///@param[in] cfdFraction : The CFD fractional time
+    ///@param[in] flags : The bitwise or of the Flags of the hit
+    ///@param[in] payloadOffset : The offset of the first header word of the hit from the start of the buffer
+    void Add(const int64_t &fixedTime, const unsigned int &id, const unsigned int &energy,
+             const unsigned int &cfdFraction, const uint8_t &flags, const unsigned int &payloadOffset) {
+        fixedTime_.push_back(fixedTime);
+        id_.push_back(id);
+        energy_.push_back(energy);
+        cfdFraction_.push_back((uint16_t) cfdFraction);
+        flags_.push_back(flags);
+        payloadOffset_.push_back(payloadOffset);
+    }
+
+    ///@return The number of hits in the batch
+    size_t Size() const { return id_.size(); }
+
+    ///@return True if there are no hits in the batch
+    bool IsEmpty() const { return id_.empty(); }
+
+    ///@return The buffer that the payload offsets point into
+    const unsigned int *GetBuffer() const { return buffer_; }
+
+    ///@return The fixed-point times of the hits, see XiaData::GetFixedTime
+    const std::vector<int64_t> &GetFixedTimes() const { return fixedTime_; }
+
+    ///@return The channel IDs of the hits. Hits from outside of the topology have XiaTopology::InvalidId.
+    const std::vector<unsigned int> &GetIds() const { return id_; }
+
+    ///@return The energies calculated on the modules
+    const std::vector<unsigned int> &GetEnergies() const { return energy_; }
+
+    ///@return The CFD fractional times of the hits
+    const std::vector<uint16_t> &GetCfdFractions() const { return cfdFraction_; }
+
+    ///@return The flags of the hits, see Flags
+    const std::vector<uint8_t> &GetFlags() const { return flags_; }
+
+    ///@return The offsets of the first header word of the hits from the start of the buffer
+    const std::vector<unsigned int> &GetPayloadOffsets() const { return payloadOffset_; }
+
+    ///@param[in] i : The index of the hit
+    ///@return The first header word of the hit. This is only valid as long as the buffer is.
+    const unsigned int *GetHeader(const size_t &i) const { return buffer_ + payloadOffset_[i]; }
+
+    ///@param[in] i : The index of the hit
+    ///@return The time of the hit in samples, from the fixed-point time. The CFD fraction is rounded down to 1/2048
+    /// of a sample, see XiaData::GetFixedTime.
+    double GetTime(const size_t &i) const { return XiaData::FromFixedTime(fixedTime_[i]); }
+
+    ///@param[in] i : The index of the hit
+    ///@param[in] flag : The flag that we want to check
+    ///@return True if the flag is set for the hit
+    bool HasFlag(const size_t &i, const Flags &flag) const { return (flags_[i] & flag) != 0; }
+
+    ///Sets the buffer that the payload offsets point into
+    ///@param[in] a : The first word of the buffer
+    void SetBuffer(const unsigned int *a) { buffer_ = a; }
+
+private:
+    std::vector<int64_t> fixedTime_; ///< The fixed-point times of the hits
+    std::vector<unsigned int> id_; ///< The channel IDs of the hits
+    std::vector<unsigned int> energy_; ///< The energies calculated on the modules
+    std::vector<uint16_t> cfdFraction_; ///< The CFD fractional times
+    std::vector<uint8_t> flags_; ///< The flags of the hits
+    std::vector<unsigned int> payloadOffset_; ///< Offsets of the first header words from the start of the buffer
+    const unsigned int *buffer_; ///< The buffer that the hits were decoded from
+};
+
+#endif //PIXIESUITE_XIAHITBATCH_HPP
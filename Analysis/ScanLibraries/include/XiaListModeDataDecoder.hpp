@@ -9,13 +9,14 @@
 #include <vector>
 
 #include "XiaData.hpp"
+#include "XiaHitBatch.hpp"
 #include "XiaListModeDataMask.hpp"
 
 ///Class to decode Xia List mode Data
 class XiaListModeDataDecoder {
 public:
     ///Default constructor
-    XiaListModeDataDecoder() {};
+    XiaListModeDataDecoder() : isLazy_(false), numDiscardedHits_(0) {};
 
     ///Default destructor
     ~XiaListModeDataDecoder() {};
@@ -26,6 +27,38 @@ public:
     ///@return A vector containing all of the decoded XiaData events.
     std::vector<XiaData *> DecodeBuffer(unsigned int *buf, const XiaListModeDataMask &mask);
 
+    ///Decodes only the header quantities of the hits in the buffer into the
+    /// columns of a batch, no XiaData are created. The keep mask is applied
+    /// the same way as in DecodeBuffer. If the batch doesn't have a buffer
+    /// yet, this buffer becomes the one that the payload offsets refer to.
+    ///@param[in] buf : Pointer to the beginning of the data buffer.
+    ///@param[in] mask : The mask set that we need to decode the data
+    ///@param[out] batch : The batch that we append the hits to
+    ///@return The number of hits that were added to the batch
+    unsigned int DecodeHeaders(const unsigned int *buf, const XiaListModeDataMask &mask, XiaHitBatch &batch);
+
+    ///@return True if we only decode the headers and leave the payload for later
+    bool IsLazy() const { return isLazy_; }
+
+    ///Sets the decoding mode. In lazy mode only the four header words (and
+    /// the external timestamp) are decoded by DecodeBuffer. The energy sums,
+    /// QDCs and trace are recorded as offsets into the buffer and decoded
+    /// the first time that XiaData is asked for them. The buffer must then
+    /// stay valid for as long as the decoded XiaData are in use.
+    ///@param[in] a : True if we want to decode lazily.
+    void SetLazy(const bool &a) { isLazy_ = a; }
+
+    ///@return The number of hits that were discarded because of the keep mask.
+    unsigned long long GetNumberOfDiscardedHits() const { return numDiscardedHits_; }
+
+    ///Sets the mask of channels that we want to keep. The mask is indexed
+    /// using XiaData::GetId and should span the whole topology. Hits from
+    /// channels that are not flagged in the mask are dropped right after the
+    /// header words are decoded, without reading their payload. Hits whose ID
+    /// falls outside of the mask are kept. An empty mask keeps everything.
+    ///@param[in] a : The keep mask indexed by channel ID
+    void SetKeepMask(const std::vector<bool> &a) { keepMask_ = a; }
+
     ///Method to calculate the arrival time of the signal in samples
     ///@param[in] mask : The data mask containing the necessary information
     /// to calculate the time.
@@ -36,6 +69,16 @@ public:
     /// If the CFD information is unavailable these two elements are identical.
     static std::pair<double, double> CalculateTimeInSamples(const XiaListModeDataMask &mask, const XiaData &data);
 
+    ///Method to calculate the arrival time of the signal in samples as a
+    /// fixed-point number (see XiaData::fixedTimeFractionBits). This only uses
+    /// integer operations, it is what DecodeBuffer uses to sort and build the
+    /// hits. The CFD fraction is rounded down to 1/2048 of a sample.
+    ///@param[in] mask : The data mask containing the necessary information
+    /// to calculate the time.
+    ///@param[in] data : The data that we will use to calculate the time
+    ///@return The time calculated using all available CFD information.
+    static int64_t CalculateFixedTime(const XiaListModeDataMask &mask, const XiaData &data);
+
     ///Method to calculate the arrival time of the signal in nanoseconds
     ///@param[in] mask : The data mask containing the necessary information
     /// to calculate the time.
@@ -44,6 +87,14 @@ public:
     static double CalculateTimeInNs(const XiaListModeDataMask &mask, const XiaData &data);
 
 private:
+    ///@param[in] mask : The data mask with the frequency of the module
+    ///@return The number of samples per tick of the time stamp
+    static unsigned int CalculateTimeMultiplier(const XiaListModeDataMask &mask);
+
+    bool isLazy_; ///< True if we defer decoding of the energy sums, QDCs and trace.
+    std::vector<bool> keepMask_; ///< Channels that we keep, indexed by XiaData::GetId
+    unsigned long long numDiscardedHits_; ///< Number of hits dropped because of the keep mask
+
     ///Method to decode word zero from the header.
     ///@param[in] word : The word that we need to decode
     ///@param[in] data : The XiaData object that we are going to fill.
@@ -0,0 +1,99 @@
+///@file XiaTopology.hpp
+///@brief Class describing the layout of the crates, modules and channels in
+/// a Pixie-16 system. It provides the dense mapping between a
+/// (crate, module, channel) triplet and a channel ID.
+///@date October 17, 2026
+#ifndef PIXIESUITE_XIATOPOLOGY_HPP
+#define PIXIESUITE_XIATOPOLOGY_HPP
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Constants.hpp"
+
+///A class that holds the number of crates, modules per crate and channels per module in the system. IDs are
+/// assigned densely as (crate * modulesPerCrate + module) * channelsPerModule + channel, so that every per-channel
+/// table can be sized with GetNumberOfChannels.
+class XiaTopology {
+public:
+    ///Default constructor. Sets up a single crate filled with Pixie-16 modules.
+    XiaTopology() : numberOfCrates_(1), modulesPerCrate_(Pixie16::maximumNumberOfModulesPerCrate),
+                    channelsPerModule_(Pixie16::maximumNumberOfChannels) {}
+
+    ///Constructor that sets the full topology of the system
+    ///@param[in] numberOfCrates : The number of crates in the system
+    ///@param[in] modulesPerCrate : The number of modules in each crate
+    ///@param[in] channelsPerModule : The number of channels in each module
+    ///@throws invalid_argument if any of the parameters are zero
+    XiaTopology(const unsigned int &numberOfCrates, const unsigned int &modulesPerCrate,
+                const unsigned int &channelsPerModule) : numberOfCrates_(numberOfCrates),
+                                                         modulesPerCrate_(modulesPerCrate),
+                                                         channelsPerModule_(channelsPerModule) {
+        if (numberOfCrates == 0 || modulesPerCrate == 0 || channelsPerModule == 0)
+            throw std::invalid_argument("XiaTopology::XiaTopology - The number of crates, modules per crate and "
+                                                "channels per module must all be larger than zero.");
+    }
+
+    ///Default destructor
+    ~XiaTopology() {}
+
+    ///@return The value that is returned for IDs that are outside of the topology.
+    static unsigned int InvalidId() { return std::numeric_limits<unsigned int>::max(); }
+
+    ///@return The number of crates in the system
+    unsigned int GetNumberOfCrates() const { return numberOfCrates_; }
+
+    ///@return The number of modules in each crate
+    unsigned int GetModulesPerCrate() const { return modulesPerCrate_; }
+
+    ///@return The number of channels in each module
+    unsigned int GetChannelsPerModule() const { return channelsPerModule_; }
+
+    ///@return The total number of modules in the system
+    unsigned int GetNumberOfModules() const { return numberOfCrates_ * modulesPerCrate_; }
+
+    ///@return The total number of channels in the system. All IDs are smaller than this number.
+    unsigned int GetNumberOfChannels() const { return GetNumberOfModules() * channelsPerModule_; }
+
+    ///@param[in] crate : The crate number
+    ///@param[in] module : The module number inside of the crate
+    ///@param[in] channel : The channel number inside of the module
+    ///@return True if the triplet lies inside of the topology
+    bool IsValid(const unsigned int &crate, const unsigned int &module, const unsigned int &channel) const {
+        return crate < numberOfCrates_ && module < modulesPerCrate_ && channel < channelsPerModule_;
+    }
+
+    ///@param[in] crate : The crate number
+    ///@param[in] module : The module number inside of the crate
+    ///@param[in] channel : The channel number inside of the module
+    ///@return The dense ID of the channel, or InvalidId if the triplet lies outside of the topology.
+    unsigned int GetId(const unsigned int &crate, const unsigned int &module, const unsigned int &channel) const {
+        if (!IsValid(crate, module, channel))
+            return InvalidId();
+        return (crate * modulesPerCrate_ + module) * channelsPerModule_ + channel;
+    }
+
+    ///@param[in] id : The dense ID of the channel
+    ///@return The index of the module in the whole system, i.e. crate * modulesPerCrate + module.
+    unsigned int GetGlobalModuleFromId(const unsigned int &id) const { return id / channelsPerModule_; }
+
+    ///@param[in] id : The dense ID of the channel
+    ///@return The crate number
+    unsigned int GetCrateFromId(const unsigned int &id) const { return GetGlobalModuleFromId(id) / modulesPerCrate_; }
+
+    ///@param[in] id : The dense ID of the channel
+    ///@return The module number inside of the crate
+    unsigned int GetModuleFromId(const unsigned int &id) const { return GetGlobalModuleFromId(id) % modulesPerCrate_; }
+
+    ///@param[in] id : The dense ID of the channel
+    ///@return The channel number inside of the module
+    unsigned int GetChannelFromId(const unsigned int &id) const { return id % channelsPerModule_; }
+
+private:
+    unsigned int numberOfCrates_; ///< The number of crates in the system
+    unsigned int modulesPerCrate_; ///< The number of modules in each crate
+    unsigned int channelsPerModule_; ///< The number of channels in each module
+};
+
+#endif //PIXIESUITE_XIATOPOLOGY_HPP
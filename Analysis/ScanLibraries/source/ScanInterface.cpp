@@ -304,6 +304,131 @@ bool ScanInterface::open_input_file(const string &fname_) {
     return true;
 }
 
+/** Open the list mode files that are merged with the main input file. Every file is a separate source for the
+  * Unpacker's merger, the main input file is source 0.
+  * \return True if all of the files were opened and false otherwise.
+  */
+bool ScanInterface::open_merge_files() {
+    close_merge_files();
+
+    if (file_format != 0) {
+        cout << " ERROR! Merging is only supported for ldf files.\n";
+        return false;
+    }
+
+    for (vector<string>::iterator it = mergeFilenames_.begin(); it != mergeFilenames_.end(); it++) {
+        string filePrefix;
+        if (get_extension(*it, filePrefix) != "ldf") {
+            cout << " ERROR! Merge file '" << *it << "' is not an ldf file.\n";
+            return false;
+        }
+
+        MergeFile *merge = new MergeFile();
+        merge->name = *it;
+        merge->file.open(it->c_str(), ios::binary);
+        if (!merge->file.is_open() || !merge->file.good()) {
+            cout << " ERROR! Failed to open merge file '" << *it << "'! Check that the path is correct.\n";
+            delete merge;
+            return false;
+        }
+
+        merge->dirbuff.Read(&merge->file);
+        merge->headbuff.Read(&merge->file);
+        if (debug_mode) {
+            merge->dirbuff.SetDebugMode();
+            merge->headbuff.SetDebugMode();
+            merge->databuff.SetDebugMode();
+        }
+
+        cout << msgHeader << "Merging run " << merge->dirbuff.GetRunNumber() << " from " << *it << " as source "
+             << mergeFiles_.size() + 1 << ".\n";
+        mergeFiles_.push_back(merge);
+    }
+
+    return true;
+}
+
+void ScanInterface::close_merge_files() {
+    for (vector<MergeFile *>::iterator it = mergeFiles_.begin(); it != mergeFiles_.end(); it++) {
+        (*it)->file.close();
+        delete *it;
+    }
+    mergeFiles_.clear();
+}
+
+/** Read spills from the main input file and the merge files. We always read from the source that is holding back
+  * the merge, so that the look-ahead buffers of the other sources stay small.
+  * \return Nothing.
+  */
+void ScanInterface::run_merged_scan() {
+    vector<ifstream *> files(1, &input_file);
+    vector<DATA_buffer *> buffers(1, &databuff);
+    for (vector<MergeFile *>::iterator it = mergeFiles_.begin(); it != mergeFiles_.end(); it++) {
+        files.push_back(&(*it)->file);
+        buffers.push_back(&(*it)->databuff);
+    }
+
+    for (vector<DATA_buffer *>::iterator it = buffers.begin(); it != buffers.end(); it++)
+        (*it)->Reset();
+
+    unsigned int *data = new unsigned int[250000];
+    bool full_spill;
+    bool bad_spill;
+    unsigned int nBytes;
+
+    while (true) {
+        if (kill_all == true) {
+            break;
+        } else if (!is_running) {
+            IdleTask();
+            usleep(100000); //0.1 seconds
+            continue;
+        }
+
+        int source = unpacker_->GetNextSource();
+        if (source < 0)
+            break;
+
+        if (!buffers[source]->Read(files[source], (char *) data, nBytes, 1000000, full_spill, bad_spill,
+                                   dry_run_mode)) {
+            // End of file or a failed read, this source won't give us anything else.
+            if (buffers[source]->GetRetval() == 2 || buffers[source]->GetRetval() == 6) {
+                if (debug_mode)
+                    cout << "debug: Finished reading source " << source << ".\n";
+                unpacker_->FinishSource((unsigned int) source);
+            }
+            continue;
+        }
+
+        if (full_spill && !dry_run_mode) {
+            if (!bad_spill) {
+                unpacker_->ReadSpill(data, nBytes / 4, is_verbose, source);
+                IdleTask();
+            } else {
+                cout << " WARNING: Spill from source " << source << " has been flagged as corrupt, skipping (at word "
+                     << files[source]->tellg() / 4 << " in file)!\n";
+            }
+        }
+        num_spills_recvd++;
+
+        const XiaDataMerger &merger = unpacker_->GetMerger();
+        stringstream status;
+        status << "\033[0;32m" << "[MERGE] " << "\033[0m" << nBytes / 4 << " words from source " << source
+               << " (" << 100 * input_file.tellg() / file_length << "%), LAG = " << merger.GetLag()
+               << " ticks, BUFFERED =";
+        for (unsigned int i = 0; i < merger.GetNumberOfSources(); i++)
+            status << " " << merger.GetOccupancy(i);
+        if (!batch_mode) { term->SetStatus(status.str()); }
+        else { cout << "\r" << status.str(); }
+    }
+
+    delete[] data;
+
+    if (!batch_mode) {
+        term->SetStatus("\033[0;33m[IDLE]\033[0m Finished merging files.");
+    } else { cout << endl << endl; }
+}
+
 /** Add a command line option to the option list.
   * \param[in]  opt_ The option to add to the list.
   * \return Nothing.
@@ -382,6 +507,7 @@ ScanInterface::ScanInterface() {
     is_verbose = true;
     debug_mode = false;
     dry_run_mode = false;
+    headers_only_mode = false;
     shm_mode = false;
     batch_mode = false;
     scan_init = false;
@@ -411,8 +537,13 @@ ScanInterface::ScanInterface() {
                               "See the wiki or HelperEnumerations.hpp for more information."),
             optionExt("frequency", required_argument, NULL, 0, "<frequency in MHz or MS/s>",
                       "Specifies the sampling frequency used to collect the data."),
+            optionExt("headers-only", no_argument, NULL, 0, "",
+                      "Only decode the headers of the hits and hand them over a spill at a time, no events are built"),
             optionExt("help", no_argument, NULL, 'h', "", "Display this dialogue"),
             optionExt("input", required_argument, NULL, 'i', "<filename>", "Specifies the input file to analyze"),
+            optionExt("merge", required_argument, NULL, 0, "<filename>",
+                      "Merge the time stamps of another ldf file (e.g. from another crate) with the input file. "
+                              "May be given more than once."),
             optionExt("output", required_argument, NULL, 'o', "<filename>",
                       "Specifies the name of the output file. Default is \"out\""),
             optionExt("quiet", no_argument, NULL, 'q', "", "Toggle off verbosity flag"),
@@ -582,6 +713,8 @@ void ScanInterface::RunControl() {
             }
 
             delete[] shm_data;
+        } else if (file_format == 0 && !mergeFiles_.empty()) {
+            run_merged_scan();
         } else if (file_format == 0) {
             unsigned int *data = NULL;
             bool full_spill;
@@ -719,6 +852,9 @@ void ScanInterface::RunControl() {
         } else if (file_format == 2) {
         }
 
+        // Build the events that are still held back by the re-ordering window.
+        unpacker_->Flush();
+
         // Notify that the scan has completed.
         Notify("SCAN_COMPLETE");
 
@@ -910,8 +1046,12 @@ bool ScanInterface::Setup(int argc, char *argv[], Unpacker *unpacker/*=NULL*/) {
                 debug_mode = true;
             } else if (strcmp("dry-run", longOpts[idx].name) == 0) {
                 dry_run_mode = true;
+            } else if (strcmp("headers-only", longOpts[idx].name) == 0) {
+                headers_only_mode = true;
             } else if (strcmp("fast-fwd", longOpts[idx].name) == 0) {
                 file_start_offset = atoll(optarg);
+            } else if (strcmp("merge", longOpts[idx].name) == 0) {
+                mergeFilenames_.push_back(optarg);
             } else if (strcmp("frequency", longOpts[idx].name) == 0)
                 samplingFrequency = (unsigned int) stoi(optarg);
             else if (strcmp("firmware", longOpts[idx].name) == 0)
@@ -995,6 +1135,11 @@ bool ScanInterface::Setup(int argc, char *argv[], Unpacker *unpacker/*=NULL*/) {
     if (debug_mode)
         unpacker_->SetDebugMode();
 
+    unpacker_->SetBatchMode(headers_only_mode);
+
+    if (!mergeFilenames_.empty())
+        unpacker_->SetNumberOfSources((unsigned int) mergeFilenames_.size() + 1);
+
     // Parse for any extra arguments that are known to the derived class.
     ExtraArguments();
 
@@ -1034,6 +1179,7 @@ bool ScanInterface::Setup(int argc, char *argv[], Unpacker *unpacker/*=NULL*/) {
 
     if (debug_mode) { cout << msgHeader << "Using debug mode.\n\n"; }
     if (dry_run_mode) { cout << msgHeader << "Doing a dry run.\n\n"; }
+    if (headers_only_mode) { cout << msgHeader << "Only decoding the headers of the hits.\n\n"; }
     if (shm_mode) {
         cout << msgHeader << "Using shared-memory mode.\n\n";
         cout << msgHeader << "Listening on poll2 SHM port 5555\n\n";
@@ -1043,8 +1189,10 @@ bool ScanInterface::Setup(int argc, char *argv[], Unpacker *unpacker/*=NULL*/) {
     if (!shm_mode && !input_filename.empty()) {
         cout << msgHeader << "Using filename " << input_filename << ".\n";
         if (open_input_file(input_filename)) {
-            // Start the scan.
-            start_scan();
+            if (mergeFilenames_.empty() || open_merge_files()) {
+                // Start the scan.
+                start_scan();
+            } else { cout << msgHeader << "Failed to load the merge files!\n"; }
         } else { cout << msgHeader << "Failed to load input file!\n"; }
     }
 #endif
@@ -1117,6 +1265,7 @@ bool ScanInterface::Close() {
 
     if (input_file.good())
         input_file.close();
+    close_merge_files();
 
     // Clean up detector driver
     cout << "\n" << msgHeader << "Cleaning up...\n";
@@ -1125,6 +1274,14 @@ bool ScanInterface::Close() {
     cout << msgHeader << "Read " << databuff.GetNumChunks() << " spill chunks.\n";
     cout << msgHeader << "Lost at least " << databuff.GetNumMissing() << " spill chunks.\n";
 
+    if (unpacker_->GetNumberOfSources() > 1) {
+        const XiaDataMerger &merger = unpacker_->GetMerger();
+        cout << msgHeader << "Merged " << unpacker_->GetNumberOfSources() << " sources with at most "
+             << merger.GetPeakOccupancy() << " hits buffered per source.\n";
+        cout << msgHeader << "Found " << merger.GetNumberOfLateHits() << " late hits and had to force "
+             << merger.GetNumberOfForcedMerges() << " merges.\n";
+    }
+
     if (write_counts)
         unpacker_->Write();
 
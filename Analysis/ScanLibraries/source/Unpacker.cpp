@@ -13,6 +13,8 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <string>
 
 #include <cstring>
 
@@ -34,7 +36,7 @@ void clearDeque(deque<XiaData *> &list) {
 /// @return Nothing.
 void Unpacker::TimeSort() {
     for (vector<deque<XiaData *> >::iterator iter = eventList.begin(); iter != eventList.end(); iter++)
-        sort(iter->begin(), iter->end(), &XiaData::CompareTime);
+        XiaData::SortByTime(*iter);
 }
 
 /** Scan the time sorted event list and package the events into a raw
@@ -45,25 +47,29 @@ bool Unpacker::BuildRawEvent() {
     if (!rawEvent.empty())
         ClearRawEvent();
 
+    if (!eventWindows_.empty())
+        return BuildTriggeredEvent();
+
+    // The comparisons are done on the fixed-point times of the hits.
+    int64_t eventStart;
     if (numRawEvt == 0) {// This is the first rawEvent. Do some special processing.
         // Find the first XiaData event. The eventList is time sorted by module.
         // The first component of each deque will be the earliest time from that module.
         // The first event time will be the minimum of these first components.
-        if (!GetFirstTime(firstTime))
+        if (!GetFirstTime(eventStart))
             return false;
+        firstTime = XiaData::FromFixedTime(eventStart);
         std::cout << "BuildRawEvent: First event time is " << firstTime << " clock ticks.\n";
-        eventStartTime = firstTime;
     } else {
         // Move the event window forward to the next valid channel fire.
-        if (!GetFirstTime(eventStartTime))
+        if (!GetFirstTime(eventStart))
             return false;
     }
+    eventStartTime = XiaData::FromFixedTime(eventStart);
 
-    realStartTime = eventStartTime + eventWidth_;
-    realStopTime = eventStartTime;
+    const int64_t eventStop = eventStart + XiaData::ToFixedTime(eventWidth_);
+    int64_t realStart = eventStop, realStop = eventStart;
 
-    unsigned int mod, chan;
-    string type, subtype, tag;
     XiaData *current_event = NULL;
 
     // Loop over all  time-sorted modules.
@@ -74,38 +80,26 @@ bool Unpacker::BuildRawEvent() {
         // Loop over the list of channels that fired in this buffer
         while (!iter->empty()) {
             current_event = iter->front();
-            mod = current_event->GetModuleNumber();
-            chan = current_event->GetChannelNumber();
-
-            if (mod > MAX_PIXIE_MOD ||
-                chan > MAX_PIXIE_CHAN) { // Skip this channel
-                cout << "BuildRawEvent: Encountered non-physical Pixie ID (mod = "
-                     << mod << ", chan = " << chan << ")\n";
-                delete current_event;
-                iter->pop_front();
-                continue;
-            }
-
-            double currtime = current_event->GetTime();
+            int64_t currtime = current_event->GetFixedTime();
 
             // Check for backwards time-skip. This is un-handled currently and needs fixed CRT!!!
-            if (currtime < eventStartTime)
+            if (currtime < eventStart)
                 cout << "BuildRawEvent: Detected backwards time-skip from start=" << eventStartTime << " to "
                      << current_event->GetTime() << "???\n";
 
             // If the time difference between the current and previous event is
             // larger than the event width, finalize the current event, otherwise
             // treat this as part of the current event
-            if ((currtime - eventStartTime) > eventWidth_)
+            if (currtime > eventStop)
                 break;
 
             // Check for the minimum time in this raw event.
-            if (currtime < realStartTime)
-                realStartTime = currtime;
+            if (currtime < realStart)
+                realStart = currtime;
 
             // Check for the maximum time in this raw event.
-            if (currtime > realStopTime)
-                realStopTime = currtime;
+            if (currtime > realStop)
+                realStop = currtime;
 
             // Update raw stats output with the new event before adding it to the raw event.
             RawStats(current_event);
@@ -119,6 +113,55 @@ bool Unpacker::BuildRawEvent() {
         }
     }
 
+    realStartTime = XiaData::FromFixedTime(realStart);
+    realStopTime = XiaData::FromFixedTime(realStop);
+    numRawEvt++;
+
+    return true;
+}
+
+/** Build an event around the earliest trigger in the event list. Every group of channels has its own list, sorted
+  * in time, and contributes the hits inside of [trigger - pre, trigger + post] of its window. Hits that are earlier
+  * than the window are not part of any event and are deleted. Every hit is looked at once when it's taken off its
+  * list, so the cost does not grow with the width of the windows.
+  * \return True if we found a trigger and false otherwise. */
+bool Unpacker::BuildTriggeredEvent() {
+    int64_t trigger;
+    if (!GetNextTriggerTime(trigger))
+        return false;
+    const double triggerTime = XiaData::FromFixedTime(trigger);
+
+    if (numRawEvt == 0) {
+        firstTime = triggerTime;
+        std::cout << "BuildRawEvent: First trigger time is " << firstTime << " clock ticks.\n";
+    }
+
+    eventStartTime = triggerTime;
+    int64_t realStart = numeric_limits<int64_t>::max(), realStop = numeric_limits<int64_t>::min();
+
+    for (unsigned int group = 0; group < eventWindows_.size(); group++) {
+        deque<XiaData *> &list = eventList[group];
+        const int64_t low = trigger - XiaData::ToFixedTime(eventWindows_[group].pre);
+        const int64_t high = trigger + XiaData::ToFixedTime(eventWindows_[group].post);
+
+        while (!list.empty() && list.front()->GetFixedTime() < low) {
+            delete list.front();
+            list.pop_front();
+            numUntriggeredHits_++;
+        }
+
+        while (!list.empty() && list.front()->GetFixedTime() <= high) {
+            XiaData *current_event = list.front();
+            realStart = min(realStart, current_event->GetFixedTime());
+            realStop = max(realStop, current_event->GetFixedTime());
+            RawStats(current_event);
+            rawEvent.push_back(current_event);
+            list.pop_front();
+        }
+    }
+
+    realStartTime = XiaData::FromFixedTime(realStart);
+    realStopTime = XiaData::FromFixedTime(realStop);
     numRawEvt++;
 
     return true;
@@ -126,17 +169,22 @@ bool Unpacker::BuildRawEvent() {
 
 /** Push an event into the event list.
   * \param[in]  event_ The XiaData to push onto the back of the event list.
-  * \return True if the XiaData's module number is valid and false otherwise. */
+  * \return True if the XiaData's crate, module and channel are inside the topology and false otherwise. */
 bool Unpacker::AddEvent(XiaData *event_) {
-    if (event_->GetModuleNumber() > MAX_PIXIE_MOD)
+    unsigned int id = event_->GetId();
+    if (id == XiaTopology::InvalidId()) {
+        if (numOutOfRangeHits_++ < 10)
+            cout << "Unpacker::AddEvent : Encountered a hit outside of the configured topology (crate = "
+                 << event_->GetCrateNumber() << ", slot = " << event_->GetSlotNumber() << ", chan = "
+                 << event_->GetChannelNumber() << "). Check the Topology node in the configuration." << endl;
         return false;
+    }
 
-    // Check for the need to add a new deque to the event list.
-    if (event_->GetModuleNumber() + 1 > (unsigned int) eventList.size())
-        while (eventList.size() < event_->GetModuleNumber() + 1)
-            eventList.push_back(std::deque<XiaData *>());
-
-    eventList.at(event_->GetModuleNumber()).push_back(event_);
+    channelCounts_[id]++;
+    if (IsBufferingSpill())
+        spillHits_.push_back(event_);
+    else
+        eventList[GetListIndex(id)].push_back(event_);
 
     return true;
 }
@@ -149,6 +197,129 @@ void Unpacker::ClearEventList() {
         clearDeque((*iter));
 }
 
+/** Clear all of the events that were read from the current spill. When we are merging or re-ordering these live
+  * in a separate list so that the hits waiting to be built into events are kept.
+  * \return Nothing. */
+void Unpacker::ClearSpill() {
+    batch_.Clear();
+    if (!IsBufferingSpill()) {
+        ClearEventList();
+        return;
+    }
+    for (vector<XiaData *>::iterator it = spillHits_.begin(); it != spillHits_.end(); it++)
+        delete *it;
+    spillHits_.clear();
+}
+
+/** Take all of the hits that the merger can release and append them to the event list. The merger releases them
+  * in time order, so the event list stays sorted. We only build events that close before the merge horizon,
+  * everything else waits for the next spill with its payload decoded.
+  * \return Nothing. */
+void Unpacker::ProcessMergedHits() {
+    vector<XiaData *> merged;
+    double horizon = merger_.Merge(merged);
+
+    //Late hits come out of the merger behind hits that were already released.
+    bool isSorted = true;
+    for (vector<XiaData *>::iterator it = merged.begin(); it != merged.end(); it++) {
+        deque<XiaData *> &list = eventList[GetListIndex((*it)->GetId())];
+        if (!list.empty() && XiaData::CompareTime(*it, list.back()))
+            isSorted = false;
+        list.push_back(*it);
+    }
+    if (!isSorted)
+        TimeSort();
+
+    if (merger_.IsFinished())
+        Flush();
+    else
+        BuildEventsBefore(horizon);
+
+    //The hits that wait for the other sources outlive the spill buffer that they were read from.
+    if (decoder_.IsLazy())
+        merger_.DecodePayloads();
+    DecodeRetainedHits();
+}
+
+/** Take the hits of the spill that we just read and add them to the re-ordering buffer. Events are only built once
+  * the watermark, i.e. the latest time that we have seen minus the re-ordering window, has passed them. This
+  * keeps hits that show up in the next spill because of FIFO readout skew in the right event. A spill that starts
+  * further behind the watermark than the clock reset threshold starts a new time epoch : we build everything from
+  * the previous epoch before we touch the new hits.
+  * \return Nothing. */
+void Unpacker::ProcessReorderedHits() {
+    if (spillHits_.empty())
+        return;
+
+    double earliest = numeric_limits<double>::max();
+    double latest = -numeric_limits<double>::max();
+    for (vector<XiaData *>::iterator it = spillHits_.begin(); it != spillHits_.end(); it++) {
+        earliest = min(earliest, (*it)->GetTime());
+        latest = max(latest, (*it)->GetTime());
+    }
+
+    if (watermark_ != -numeric_limits<double>::max() && earliest < watermark_ - clockResetThreshold_) {
+        cout << "Unpacker::ProcessReorderedHits : Detected a clock reset from " << watermark_ << " to " << earliest
+             << " clock ticks. Starting time epoch " << ++numClockResets_ << "." << endl;
+        Flush();
+    }
+
+    for (vector<XiaData *>::iterator it = spillHits_.begin(); it != spillHits_.end(); it++) {
+        if ((*it)->GetTime() < watermark_)
+            numLateHits_++;
+        eventList[GetListIndex((*it)->GetId())].push_back(*it);
+    }
+    spillHits_.clear();
+
+    TimeSort();
+    latestTime_ = max(latestTime_, latest);
+    watermark_ = max(watermark_, latestTime_ - reorderWindow_);
+    BuildEventsBefore(watermark_);
+    DecodeRetainedHits();
+}
+
+/** Decode the payloads of all of the hits that are still waiting in the event list. With lazy decoding the
+  * payload of a hit points into the spill buffer, which the caller overwrites with the next spill. Hits that
+  * outlive the spill they came from need their energy sums, QDCs and traces copied out before ReadSpill returns.
+  * \return Nothing. */
+void Unpacker::DecodeRetainedHits() {
+    if (!decoder_.IsLazy())
+        return;
+    for (vector<deque<XiaData *> >::iterator list = eventList.begin(); list != eventList.end(); list++)
+        for (deque<XiaData *>::iterator it = list->begin(); it != list->end(); it++)
+            (*it)->DecodePayload();
+}
+
+/** Build and process all of the events that close before the provided time. The remaining hits stay in the event
+  * list.
+  * \param[in] time The time before which all events are complete.
+  * \return Nothing. */
+void Unpacker::BuildEventsBefore(const double &time) {
+    int64_t nextEventTime;
+    if (eventWindows_.empty()) {
+        while (GetFirstTime(nextEventTime) && XiaData::FromFixedTime(nextEventTime) + eventWidth_ < time
+               && BuildRawEvent())
+            ProcessRawEvent();
+    } else {
+        while (GetNextTriggerTime(nextEventTime) && XiaData::FromFixedTime(nextEventTime) + maxPostWindow_ < time
+               && BuildRawEvent())
+            ProcessRawEvent();
+    }
+}
+
+void Unpacker::Flush() {
+    TimeSort();
+    while (BuildRawEvent())
+        ProcessRawEvent();
+    ClearEventList();
+    watermark_ = latestTime_ = -numeric_limits<double>::max();
+}
+
+void Unpacker::FinishSource(const unsigned int &source) {
+    merger_.Finish(source);
+    ProcessMergedHits();
+}
+
 /** Clear all events in the raw event list. WARNING! This method will delete all events in the
   * event list. This could cause seg faults if the events are used elsewhere.
   * \return Nothing. */
@@ -160,15 +331,26 @@ void Unpacker::ClearRawEvent() {
   * \param[out] time The minimum time from the event list in system clock ticks.
   * \return True if the event list is not empty and false otherwise. */
 bool Unpacker::GetFirstTime(double &time) {
+    int64_t first;
+    if (!GetFirstTime(first))
+        return false;
+    time = XiaData::FromFixedTime(first);
+    return true;
+}
+
+/** Get the minimum fixed-point channel time from the event list.
+  * \param[out] time The minimum fixed-point time from the event list (see XiaData::GetFixedTime).
+  * \return True if the event list is not empty and false otherwise. */
+bool Unpacker::GetFirstTime(int64_t &time) {
     if (IsEmpty())
         return false;
 
-    time = std::numeric_limits<double>::max();
+    time = numeric_limits<int64_t>::max();
     for (std::vector<std::deque<XiaData *> >::iterator iter = eventList.begin(); iter != eventList.end(); iter++) {
         if (iter->empty())
             continue;
-        if (iter->front()->GetTime() < time)
-            time = iter->front()->GetTime();
+        if (iter->front()->GetFixedTime() < time)
+            time = iter->front()->GetFixedTime();
     }
 
     return true;
@@ -193,8 +375,35 @@ void Unpacker::ProcessRawEvent() {
 ///@param[in] buf : Pointer to an array of unsigned ints containing raw buffer data.
 ///@return The number of XiaDatas read from the buffer.
 int Unpacker::ReadBuffer(unsigned int *buf, const unsigned int &vsn) {
-    static XiaListModeDataDecoder decoder;
+    SetMaskForVsn(vsn);
+
+    if (isBatchMode_) {
+        size_t first = batch_.Size();
+        int numAdded = (int) decoder_.DecodeHeaders(buf, mask_, batch_);
+        for (size_t i = first; i < batch_.Size(); i++) {
+            if (batch_.GetIds()[i] == XiaTopology::InvalidId())
+                numOutOfRangeHits_++;
+            else
+                channelCounts_[batch_.GetIds()[i]]++;
+        }
+        return numAdded;
+    }
+
+    std::vector<XiaData *> decodedList = decoder_.DecodeBuffer(buf, mask_);
+    int numAdded = 0;
+    for (vector<XiaData *>::iterator it = decodedList.begin(); it != decodedList.end(); it++) {
+        if (AddEvent(*it))
+            numAdded++;
+        else
+            delete *it;
+    }
+    return numAdded;
+}
 
+/** Set the firmware and frequency of the data mask for a module when the modules have different ones.
+  * \param[in] vsn The module number of the buffer that we are about to decode.
+  * \return Nothing. */
+void Unpacker::SetMaskForVsn(const unsigned int &vsn) {
     if (maskMap_.size() != 0) {
         auto found = maskMap_.find(vsn);
         if(found == maskMap_.end())
@@ -203,22 +412,107 @@ int Unpacker::ReadBuffer(unsigned int *buf, const unsigned int &vsn) {
         mask_.SetFirmware((*found).second.first);
         mask_.SetFrequency((*found).second.second);
     }
+}
+
+void Unpacker::SetRejectionRegions(const std::vector<std::pair<double, double> > &regions) {
+    vector<pair<double, double> > sorted(regions);
+    sort(sorted.begin(), sorted.end());
+
+    //The regions are open intervals, so only overlapping regions are merged. Touching regions keep the point
+    // between them.
+    rejectionRegions_.clear();
+    for (vector<pair<double, double> >::const_iterator it = sorted.begin(); it != sorted.end(); it++) {
+        if (!rejectionRegions_.empty() && it->first < rejectionRegions_.back().second)
+            rejectionRegions_.back().second = max(rejectionRegions_.back().second, it->second);
+        else
+            rejectionRegions_.push_back(*it);
+    }
+    rejectionCursor_ = 0;
+}
+
+/** Check if a time is inside of one of the rejection regions. The events come in increasing time, so we keep a
+  * cursor on the first region that hasn't ended yet and only move it forward. A time earlier than the region
+  * before the cursor puts the cursor back with a binary search.
+  * \param[in] time The time in clock ticks.
+  * \return True if the time is rejected and false otherwise. */
+bool Unpacker::IsRejected(const double &time) {
+    if (rejectionRegions_.empty() || numRawEvt == 0)
+        return false;
+
+    const double relativeTime = time - firstTime;
+    if (rejectionCursor_ != 0 && relativeTime < rejectionRegions_[rejectionCursor_ - 1].second)
+        rejectionCursor_ = FindRejectionRegion(relativeTime);
+
+    while (rejectionCursor_ < rejectionRegions_.size() && rejectionRegions_[rejectionCursor_].second <= relativeTime)
+        rejectionCursor_++;
+
+    return rejectionCursor_ < rejectionRegions_.size() && relativeTime > rejectionRegions_[rejectionCursor_].first;
+}
+
+/** Find the first rejection region that ends after a time.
+  * \param[in] relativeTime The time in clock ticks since the first event.
+  * \return The index of the region, or the number of regions if they have all ended. */
+size_t Unpacker::FindRejectionRegion(const double &relativeTime) const {
+    size_t low = 0, high = rejectionRegions_.size();
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (rejectionRegions_[middle].second <= relativeTime)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+/** Check if all of the hits in a spill lie inside of a single rejection region. Only the headers of the hits are
+  * looked at, so a rejected spill costs a fraction of what decoding and building it does.
+  * \param[in] data The spill that we are going to check.
+  * \param[in] nWords The number of words in the spill.
+  * \return True if the whole spill can be skipped. */
+bool Unpacker::IsSpillRejected(unsigned int *data, const unsigned int &nWords) {
+    const unsigned int maxVsn = XiaData::GetTopology().GetNumberOfModules() + 1;
+    spillScan_.Clear();
+    unsigned int nWords_read = 0;
+    while (nWords_read + 1 < nWords) {
+        while (nWords_read < nWords && data[nWords_read] == 0xFFFFFFFF)
+            nWords_read++;
+        if (nWords_read + 1 >= nWords)
+            break;
+
+        unsigned int lenRec = data[nWords_read];
+        unsigned int vsn = data[nWords_read + 1];
+        if (vsn == 9999 || lenRec == 0 || lenRec > maxWords || nWords_read + lenRec > nWords)
+            break;
+
+        if (vsn < maxVsn && lenRec != 6) {
+            SetMaskForVsn(vsn);
+            spillScanner_.DecodeHeaders(&data[nWords_read], mask_, spillScan_);
+        }
+        nWords_read += lenRec;
+    }
+
+    if (spillScan_.IsEmpty())
+        return false;
 
-    std::vector<XiaData *> decodedList = decoder.DecodeBuffer(buf, mask_);
-    for (vector<XiaData *>::iterator it = decodedList.begin(); it != decodedList.end(); it++)
-        AddEvent(*it);
-    return (int) decodedList.size();
+    const vector<int64_t> &times = spillScan_.GetFixedTimes();
+    const double first = XiaData::FromFixedTime(*min_element(times.begin(), times.end())) - firstTime;
+    const double last = XiaData::FromFixedTime(*max_element(times.begin(), times.end())) - firstTime;
+    size_t region = FindRejectionRegion(first);
+    return region < rejectionRegions_.size() && first > rejectionRegions_[region].first
+           && last < rejectionRegions_[region].second;
 }
 
 Unpacker::Unpacker() : debug_mode(false), eventWidth_(62), running(true),
                        TOTALREAD(1000000), // Maximum number of data words to read.
                        maxWords(131072), // Maximum number of data words for revision D.
                        numRawEvt(0), // Count of raw events read from file.
-                       firstTime(0), eventStartTime(0), realStartTime(0), realStopTime(0) {
-
-    for (unsigned int i = 0; i <= MAX_PIXIE_MOD; i++)
-        for (unsigned int j = 0; j <= MAX_PIXIE_CHAN; j++)
-            channel_counts[i][j] = 0;
+                       numOutOfRangeHits_(0),
+                       firstTime(0), eventStartTime(0), realStartTime(0), realStopTime(0), currentSource_(-1),
+                       reorderWindow_(0), clockResetThreshold_(125e6), watermark_(-numeric_limits<double>::max()),
+                       latestTime_(-numeric_limits<double>::max()), numLateHits_(0), numClockResets_(0),
+                       maxPostWindow_(0), numUntriggeredHits_(0), isBatchMode_(false),
+                       numHitBatches_(0), rejectionCursor_(0), numRejectedSpills_(0) {
+    SetTopology(XiaData::GetTopology());
 }
 
 Unpacker::~Unpacker() {
@@ -226,6 +520,68 @@ Unpacker::~Unpacker() {
     ClearEventList();
 }
 
+void Unpacker::SetTopology(const XiaTopology &topology) {
+    ClearEventList();
+    XiaData::SetTopology(topology);
+    eventWindows_.clear();
+    groupOfId_.clear();
+    eventList.resize(topology.GetNumberOfModules());
+    channelCounts_.assign(topology.GetNumberOfChannels(), 0);
+}
+
+void Unpacker::SetTriggeredBuilding(const std::vector<unsigned int> &groupOfId,
+                                    const std::vector<EventWindow> &windows) {
+    if (windows.empty()) {
+        SetTopology(XiaData::GetTopology());
+        return;
+    }
+
+    if (groupOfId.size() < XiaData::GetTopology().GetNumberOfChannels())
+        throw invalid_argument("Unpacker::SetTriggeredBuilding - Every one of the "
+                               + to_string(XiaData::GetTopology().GetNumberOfChannels())
+                               + " channels in the topology needs a group.");
+
+    bool hasTrigger = false;
+    maxPostWindow_ = 0;
+    for (vector<EventWindow>::const_iterator it = windows.begin(); it != windows.end(); it++) {
+        if (it->pre < 0 || it->post < 0)
+            throw invalid_argument("Unpacker::SetTriggeredBuilding - The pre and post windows cannot be negative.");
+        hasTrigger |= it->isTrigger;
+        maxPostWindow_ = max(maxPostWindow_, it->post);
+    }
+    if (!hasTrigger)
+        throw invalid_argument("Unpacker::SetTriggeredBuilding - None of the groups of channels is a trigger.");
+
+    for (vector<unsigned int>::const_iterator it = groupOfId.begin(); it != groupOfId.end(); it++)
+        if (*it >= windows.size())
+            throw invalid_argument("Unpacker::SetTriggeredBuilding - Group " + to_string(*it)
+                                   + " does not have an event window.");
+
+    ClearEventList();
+    groupOfId_ = groupOfId;
+    eventWindows_ = windows;
+    eventList.resize(windows.size());
+}
+
+unsigned int Unpacker::GetListIndex(const unsigned int &id) const {
+    return groupOfId_.empty() ? XiaData::GetTopology().GetGlobalModuleFromId(id) : groupOfId_[id];
+}
+
+/** Get the time of the earliest hit in the groups of channels that trigger events.
+  * \param[out] time The fixed-point time of the next trigger (see XiaData::GetFixedTime).
+  * \return True if there is a trigger in the event list and false otherwise. */
+bool Unpacker::GetNextTriggerTime(int64_t &time) {
+    bool hasTrigger = false;
+    time = numeric_limits<int64_t>::max();
+    for (unsigned int group = 0; group < eventWindows_.size(); group++) {
+        if (!eventWindows_[group].isTrigger || eventList[group].empty())
+            continue;
+        time = min(time, eventList[group].front()->GetFixedTime());
+        hasTrigger = true;
+    }
+    return hasTrigger;
+}
+
 void Unpacker::InitializeDataMask(const std::string &firmware, const unsigned int &frequency) {
     if (frequency == 0) {
         unsigned int modCounter = 0;
@@ -259,8 +615,10 @@ void Unpacker::InitializeDataMask(const std::string &firmware, const unsigned in
   * \param[in]  is_verbose Toggle the verbosity flag on/off.
   * \return True if the spill was read successfully and false otherwise.
   */
-bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbose/*=true*/) {
-    const unsigned int maxVsn = 14; // No more than 14 pixie modules per crate
+bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbose/*=true*/,
+                         const int &source/*=-1*/) {
+    // The VSNs run over all of the modules in the system.
+    const unsigned int maxVsn = XiaData::GetTopology().GetNumberOfModules() + 1;
     unsigned int nWords_read = 0;
 
     int retval = 0; // return value from various functions
@@ -272,6 +630,19 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
     unsigned int lastVsn = 0xFFFFFFFF; // the last vsn read from the data
     time_t theTime = 0;
 
+    // Toss out the hits of a previous spill that we could not finish reading.
+    currentSource_ = source;
+    if (IsBufferingSpill())
+        ClearSpill();
+
+    // Events are only built from a single spill here, so a spill that lies inside of a rejection region can be
+    // skipped before we decode it.
+    if (!rejectionRegions_.empty() && numRawEvt != 0 && !IsBufferingSpill() && !isBatchMode_
+        && IsSpillRejected(data, nWords)) {
+        numRejectedSpills_++;
+        return true;
+    }
+
     if (counter == 0)
         maxModuleNumberInFile_ = 0;
 
@@ -318,7 +689,7 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
                 if (is_verbose)
                     cout << "ReadSpill: MISSING BUFFER " << lastVsn + 1 << ", lastVsn = " << lastVsn << ", vsn = "
                          << vsn << ", lenrec = " << lenRec << endl;
-                ClearEventList();
+                ClearSpill();
                 fullSpill = false; // WHY WAS THIS TRUE!?!? CRT
             }
 
@@ -335,7 +706,7 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
                 if (retval == -100) {
                     if (is_verbose)
                         cout << "ReadSpill:  Remove list " << lastVsn << " " << vsn << endl;
-                    ClearEventList();
+                    ClearSpill();
                 }
                 return false;
             } else if (retval > 0) {
@@ -391,16 +762,32 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
             // Sort the vector of pointers eventlist according to time
             //double lastTimestamp = (*(eventList.rbegin()))->time;
 
-            // Sort the event list in time
-            TimeSort();
+            if (isBatchMode_) {
+                // The first batch gives the first time, just like the first spill does when we build events.
+                if (numHitBatches_++ == 0)
+                    firstTime = XiaData::FromFixedTime(*min_element(batch_.GetFixedTimes().begin(),
+                                                                     batch_.GetFixedTimes().end()));
+                ProcessHitBatch(batch_);
+                batch_.Clear();
+            } else if (source < 0 && reorderWindow_ > 0) {
+                ProcessReorderedHits();
+            } else if (source < 0) {
+                // Sort the event list in time
+                TimeSort();
+
+                // Once the vector of pointers eventlist is sorted based on time,
+                // begin the event processing in ScanList().
+                // ScanList will also clear the event list for us.
+                while (BuildRawEvent())
+                    ProcessRawEvent();
 
-            // Once the vector of pointers eventlist is sorted based on time,
-            // begin the event processing in ScanList().
-            // ScanList will also clear the event list for us.
-            while (BuildRawEvent())
-                ProcessRawEvent();
-
-            ClearEventList();
+                ClearEventList();
+            } else {
+                // Hand the spill to the merger and build whatever all of the sources agree on.
+                merger_.Add((unsigned int) source, spillHits_);
+                spillHits_.clear();
+                ProcessMergedHits();
+            }
 
             // Once the eventlist has been scanned, reset the number
             // of events to zero and update the event counter
@@ -414,13 +801,13 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
         } else {
             if (is_verbose)
                 cout << "ReadSpill: Spill split between buffers" << endl;
-            ClearEventList(); // This tosses out all events read into the deque so far
+            ClearSpill(); // This tosses out all events read into the deque so far
             return false;
         }
     } else if (retval != -10) {
         if (is_verbose)
             cout << "ReadSpill: bad buffer, numEvents = " << numEvents << endl;
-        ClearEventList(); // This tosses out all events read into the deque so far
+        ClearSpill(); // This tosses out all events read into the deque so far
         return false;
     }
 
@@ -433,9 +820,10 @@ bool Unpacker::ReadSpill(unsigned int *data, unsigned int nWords, bool is_verbos
 void Unpacker::Write() {
     std::ofstream count_output("counts.dat");
     if (count_output.good()) {
-        for (unsigned int i = 0; i <= MAX_PIXIE_MOD; i++)
-            for (unsigned int j = 0; j <= MAX_PIXIE_CHAN; j++)
-                count_output << i << "\t" << j << "\t" << channel_counts[i][j] << endl;
+        const XiaTopology &topology = XiaData::GetTopology();
+        for (unsigned int id = 0; id < channelCounts_.size(); id++)
+            count_output << topology.GetCrateFromId(id) << "\t" << topology.GetModuleFromId(id) << "\t"
+                         << topology.GetChannelFromId(id) << "\t" << channelCounts_[id] << endl;
         count_output.close();
     }
 }
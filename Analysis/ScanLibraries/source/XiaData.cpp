@@ -4,12 +4,25 @@
 ///@authors C. R. Thornsberry and S. V. Paulauskas
 #include "XiaData.hpp"
 
+#include <algorithm>
+
+#include <cmath>
+
+#include "HelperFunctions.hpp"
+
+using namespace std;
+
+XiaTopology XiaData::topology_;
+
 ///Clears all of the variables. The vectors are all cleared using the clear() method. This method is called when the class is
 /// first initalizied so that it has some default values for the software to use in the event that they are needed.
 void XiaData::Initialize() {
     cfdForceTrig_ = cfdTrigSource_ = isPileup_ = isSaturated_ = isVirtualChannel_ = false;
+    isTimeConverted_ = true;
+    fixedTime_ = 0;
 
-    filterBaseline_ = energy_ = time_ = timeSansCfd_ = 0.0;
+    filterBaseline_ = energy_ = time_ = timeSansCfd_ = cfdSize_ = 0.0;
+    timeMultiplier_ = 1;
 
     chanNum_ = crateNum_ = cfdTime_ = 0;
     eventTimeHigh_ = eventTimeLow_ = externalTimestamp_ = externalTimeLow_ = externalTimeHigh_ = 0;
@@ -18,4 +31,120 @@ void XiaData::Initialize() {
     eSums_.clear();
     qdc_.clear();
     trace_.clear();
-}
\ No newline at end of file
+
+    payload_ = nullptr;
+    payloadEnergySumsOffset_ = payloadNumEnergySumWords_ = payloadQdcOffset_ = payloadNumQdcWords_ = 0;
+    payloadTraceOffset_ = payloadTraceLength_ = 0;
+}
+
+///The 250 and 500 MHz modules are told apart by the multiplier, they correct the fraction with the trigger source.
+double XiaData::CalculateTime() const {
+    double filterTime = double((uint64_t(eventTimeHigh_) << 32) | eventTimeLow_);
+    if (cfdTime_ == 0 || cfdForceTrig_)
+        return filterTime;
+
+    double cfdTime = cfdTime_ / cfdSize_;
+    if (timeMultiplier_ == 2)
+        cfdTime -= cfdTrigSource_;
+    else if (timeMultiplier_ == 10)
+        cfdTime += cfdTrigSource_ - 1.0;
+    return filterTime * timeMultiplier_ + cfdTime;
+}
+
+void XiaData::SetPayload(const unsigned int *buf, const unsigned int &energySumsOffset,
+                         const unsigned int &numEnergySumWords, const unsigned int &qdcOffset,
+                         const unsigned int &numQdcWords, const unsigned int &traceOffset,
+                         const unsigned int &traceLength) {
+    payload_ = buf;
+    payloadEnergySumsOffset_ = energySumsOffset;
+    payloadNumEnergySumWords_ = numEnergySumWords;
+    payloadQdcOffset_ = qdcOffset;
+    payloadNumQdcWords_ = numQdcWords;
+    payloadTraceOffset_ = traceOffset;
+    payloadTraceLength_ = traceLength;
+}
+
+///The energy sums are stored with the baseline in the last word as an IEEE 754 float. The trace is packed with two
+/// 16-bit samples per word. We clear the payload pointer once we are done so that we only ever decode once.
+void XiaData::DecodePayload() const {
+    if (!payload_)
+        return;
+
+    if (payloadNumEnergySumWords_ != 0) {
+        eSums_.assign(payload_ + payloadEnergySumsOffset_,
+                      payload_ + payloadEnergySumsOffset_ + payloadNumEnergySumWords_ - 1);
+        filterBaseline_ = IeeeStandards::IeeeFloatingToDecimal(
+                payload_[payloadEnergySumsOffset_ + payloadNumEnergySumWords_ - 1]);
+    }
+
+    if (payloadNumQdcWords_ != 0)
+        qdc_.assign(payload_ + payloadQdcOffset_, payload_ + payloadQdcOffset_ + payloadNumQdcWords_);
+
+    if (payloadTraceLength_ != 0) {
+        const unsigned short *sbuf = (const unsigned short *) (payload_ + payloadTraceOffset_);
+        trace_.assign(sbuf, sbuf + payloadTraceLength_);
+    }
+
+    payload_ = nullptr;
+}
+void XiaData::CopyTrace(std::vector<unsigned short> &samples) const {
+    if (payload_ && payloadTraceLength_ != 0) {
+        const unsigned short *sbuf = (const unsigned short *) (payload_ + payloadTraceOffset_);
+        samples.assign(sbuf, sbuf + payloadTraceLength_);
+    } else
+        samples.assign(trace_.begin(), trace_.end());
+}
+
+int64_t XiaData::ToFixedTime(const double &time) {
+    return llround(ldexp(time, fixedTimeFractionBits));
+}
+
+///The keys are made unsigned by flipping the sign bit and are sorted one byte
+/// at a time, starting with the least significant one. All of the histograms
+/// are filled in a single pass over the keys, and the passes where every key
+/// has the same byte are skipped. In a spill the upper bytes of the time
+/// hardly change, so only a few of the eight passes are actually done.
+void XiaData::SortByTime(deque<XiaData *> &hits) {
+    static const size_t minimumRadixSortSize = 256;
+    static const unsigned int numberOfPasses = 8;
+    static const unsigned int numberOfBuckets = 256;
+
+    if (hits.size() < minimumRadixSortSize) {
+        sort(hits.begin(), hits.end(), &XiaData::CompareTime);
+        return;
+    }
+
+    typedef pair<uint64_t, XiaData *> Entry;
+    vector<Entry> entries(hits.size()), scratch(hits.size());
+    vector<size_t> counts(numberOfPasses * numberOfBuckets, 0);
+
+    bool isSorted = true;
+    for (size_t i = 0; i < hits.size(); i++) {
+        entries[i] = make_pair(uint64_t(hits[i]->fixedTime_) ^ (uint64_t(1) << 63), hits[i]);
+        if (i != 0 && entries[i].first < entries[i - 1].first)
+            isSorted = false;
+        for (unsigned int pass = 0; pass < numberOfPasses; pass++)
+            counts[pass * numberOfBuckets + ((entries[i].first >> (8 * pass)) & 0xFF)]++;
+    }
+    if (isSorted)
+        return;
+
+    for (unsigned int pass = 0; pass < numberOfPasses; pass++) {
+        size_t *count = &counts[pass * numberOfBuckets];
+        if (count[(entries[0].first >> (8 * pass)) & 0xFF] == entries.size())
+            continue;
+
+        size_t offset = 0;
+        for (unsigned int bucket = 0; bucket < numberOfBuckets; bucket++) {
+            size_t size = count[bucket];
+            count[bucket] = offset;
+            offset += size;
+        }
+        for (vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); it++)
+            scratch[count[(it->first >> (8 * pass)) & 0xFF]++] = *it;
+        entries.swap(scratch);
+    }
+
+    for (size_t i = 0; i < entries.size(); i++)
+        hits[i] = entries[i].second;
+}
@@ -0,0 +1,164 @@
+///@file XiaDataMerger.cpp
+///@brief Class that performs a k-way merge on the time stamps of hits coming
+/// from several synchronized data streams, e.g. one list mode file per crate.
+///@date October 17, 2026
+#include "XiaDataMerger.hpp"
+#include "XiaData.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+XiaDataMerger::XiaDataMerger() : maxBufferedHits_(1000000), peakOccupancy_(0),
+                                 lastMergedTime_(-numeric_limits<double>::max()), reorderWindow_(0), numLateHits_(0),
+                                 numForcedMerges_(0) {}
+
+XiaDataMerger::~XiaDataMerger() {
+    Clear();
+}
+
+void XiaDataMerger::Clear() {
+    for (vector<Source>::iterator it = sources_.begin(); it != sources_.end(); it++) {
+        for (deque<XiaData *>::iterator hit = it->hits.begin(); hit != it->hits.end(); hit++)
+            delete *hit;
+        it->hits.clear();
+        it->isFinished = false;
+    }
+    lastMergedTime_ = -numeric_limits<double>::max();
+}
+
+void XiaDataMerger::SetNumberOfSources(const unsigned int &a) {
+    Clear();
+    sources_.resize(a);
+}
+
+void XiaDataMerger::SetClockCorrection(const unsigned int &source, const double &offset, const double &drift) {
+    if (source >= sources_.size())
+        throw out_of_range("XiaDataMerger::SetClockCorrection - Source " + to_string(source)
+                           + " is larger than the number of sources (" + to_string(sources_.size()) + ").");
+    sources_[source].offset = offset;
+    sources_[source].drift = drift;
+}
+
+void XiaDataMerger::Finish(const unsigned int &source) {
+    sources_.at(source).isFinished = true;
+}
+
+bool XiaDataMerger::IsFinished() const {
+    for (vector<Source>::const_iterator it = sources_.begin(); it != sources_.end(); it++)
+        if (!it->isFinished)
+            return false;
+    return true;
+}
+
+int XiaDataMerger::GetNextSource() const {
+    int next = -1;
+    double earliest = numeric_limits<double>::max();
+    for (unsigned int i = 0; i < sources_.size(); i++) {
+        if (sources_[i].isFinished)
+            continue;
+        if (sources_[i].hits.empty())
+            return (int) i;
+        if (sources_[i].hits.back()->GetTime() < earliest) {
+            earliest = sources_[i].hits.back()->GetTime();
+            next = (int) i;
+        }
+    }
+    return next;
+}
+
+double XiaDataMerger::GetLag() const {
+    if (lastMergedTime_ == -numeric_limits<double>::max())
+        return 0.0;
+
+    double latest = lastMergedTime_;
+    for (vector<Source>::const_iterator it = sources_.begin(); it != sources_.end(); it++)
+        if (!it->hits.empty() && it->hits.back()->GetTime() > latest)
+            latest = it->hits.back()->GetTime();
+    return latest - lastMergedTime_;
+}
+
+void XiaDataMerger::Add(const unsigned int &source, const vector<XiaData *> &hits) {
+    Source &src = sources_.at(source);
+
+    deque<XiaData *>::difference_type numOld = src.hits.size();
+    for (vector<XiaData *>::const_iterator it = hits.begin(); it != hits.end(); it++) {
+        double time = (*it)->GetTime();
+        (*it)->SetTime(time + src.offset + src.drift * time);
+        time = (*it)->GetTimeSansCfd();
+        (*it)->SetTimeSansCfd(time + src.offset + src.drift * time);
+        if ((*it)->GetTime() < lastMergedTime_)
+            numLateHits_++;
+        src.hits.push_back(*it);
+    }
+
+    //The spills are only sorted per module, so we sort the new hits and merge them with what was already buffered.
+    sort(src.hits.begin() + numOld, src.hits.end(), &XiaData::CompareTime);
+    if (numOld != 0 && !hits.empty() && XiaData::CompareTime(src.hits[numOld], src.hits[numOld - 1]))
+        inplace_merge(src.hits.begin(), src.hits.begin() + numOld, src.hits.end(), &XiaData::CompareTime);
+
+    if (src.hits.size() > peakOccupancy_)
+        peakOccupancy_ = src.hits.size();
+}
+
+void XiaDataMerger::DecodePayloads() {
+    for (vector<Source>::iterator it = sources_.begin(); it != sources_.end(); it++)
+        for (deque<XiaData *>::iterator hit = it->hits.begin(); hit != it->hits.end(); hit++)
+            (*hit)->DecodePayload();
+}
+
+double XiaDataMerger::CalculateHorizon() {
+    bool isOverflowing = false;
+    for (vector<Source>::const_iterator it = sources_.begin(); it != sources_.end(); it++)
+        if (it->hits.size() > maxBufferedHits_)
+            isOverflowing = true;
+
+    double horizon = numeric_limits<double>::max();
+    bool isForced = false;
+    for (vector<Source>::const_iterator it = sources_.begin(); it != sources_.end(); it++) {
+        if (it->isFinished)
+            continue;
+        if (it->hits.empty()) {
+            if (!isOverflowing)
+                return -numeric_limits<double>::max();
+            isForced = true;
+            continue;
+        }
+        horizon = min(horizon, it->hits.back()->GetTime());
+    }
+
+    if (isForced)
+        numForcedMerges_++;
+    return horizon == numeric_limits<double>::max() ? horizon : horizon - reorderWindow_;
+}
+
+double XiaDataMerger::Merge(vector<XiaData *> &merged) {
+    double horizon = CalculateHorizon();
+
+    typedef pair<double, unsigned int> HeapEntry;
+    priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > heap;
+    for (unsigned int i = 0; i < sources_.size(); i++)
+        if (!sources_[i].hits.empty())
+            heap.push(make_pair(sources_[i].hits.front()->GetTime(), i));
+
+    while (!heap.empty() && heap.top().first <= horizon) {
+        unsigned int source = heap.top().second;
+        deque<XiaData *> &hits = sources_[source].hits;
+        heap.pop();
+
+        merged.push_back(hits.front());
+        lastMergedTime_ = max(lastMergedTime_, hits.front()->GetTime());
+        hits.pop_front();
+
+        if (!hits.empty())
+            heap.push(make_pair(hits.front()->GetTime(), source));
+    }
+
+    return horizon;
+}
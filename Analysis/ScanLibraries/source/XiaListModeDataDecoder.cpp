@@ -39,8 +39,13 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
     vector<XiaData *> events;
     static unsigned int numSkippedBuffers = 0;
 
+    XiaData *data = nullptr;
     while (buf < bufStart + bufLen) {
-        XiaData *data = new XiaData();
+        //Reuse the object left over from a discarded hit if we have one.
+        if (data)
+            data->Initialize();
+        else
+            data = new XiaData();
         bool hasExternalTimestamp = false;
         bool hasQdc = false;
         bool hasEnergySums = false;
@@ -106,6 +111,15 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
                 return vector<XiaData *>();
         }
 
+        //Drop hits from channels we do not care about before we touch anything past the first four words. Hits
+        // outside of the topology are kept so that the Unpacker can report them.
+        unsigned int id = data->GetId();
+        if (id < keepMask_.size() && !keepMask_[id] && traceLength / 2 + headerLength == eventLength) {
+            numDiscardedHits_++;
+            buf += eventLength;
+            continue;
+        }
+
         if (hasExternalTimestamp) {
             data->SetExternalTimeLow(buf[externalTimestampOffset]);
             data->SetExternalTimeHigh(buf[externalTimestampOffset + 1]);
@@ -113,7 +127,12 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
                                                                      data->GetExternalTimeHigh(), 32));
         }
 
-        if (hasEnergySums) {
+        //In lazy mode the energy sums, QDCs and trace stay in the buffer until somebody asks for them.
+        if (isLazy_)
+            data->SetPayload(buf, energySumsOffset, hasEnergySums ? mask.GetNumberOfEnergySumWords() : 0, qdcOffset,
+                             hasQdc ? mask.GetNumberOfQdcWords() : 0, headerLength, traceLength);
+
+        if (hasEnergySums && !isLazy_) {
             vector<unsigned int> tmp;
             for(unsigned int i = 0; i < mask.GetNumberOfEnergySumWords() - 1; i++)
                 tmp.push_back(buf[energySumsOffset + i]);
@@ -122,7 +141,7 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
                     mask.GetNumberOfEnergySumWords() - 1]));
         }
 
-        if (hasQdc) {
+        if (hasQdc && !isLazy_) {
             vector<unsigned int> tmp;
             for (unsigned int i = 0; i < mask.GetNumberOfQdcWords(); i++) {
                 tmp.push_back(buf[qdcOffset + i]);
@@ -130,9 +149,6 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
             data->SetQdc(tmp);
         }
 
-        ///@TODO Figure out where to put this...
-        //channel_counts[modNum][chanNum]++;
-
         ///@TODO This needs to be revised to take into account the bit
         /// resolution of the modules. I've currently set it to the maximum
         /// bit resolution of any module (16-bit).
@@ -140,9 +156,8 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
             data->SetEnergy(65536);
 
         //We set the time according to the revision and firmware.
-        pair<double, double> times = CalculateTimeInSamples(mask, *data);
-        data->SetTimeSansCfd(times.first);
-        data->SetTime(times.second);
+        data->SetTimeSansCfd(double((uint64_t(data->GetEventTimeHigh()) << 32) | data->GetEventTimeLow()));
+        data->SetTimeFromTimestamp(CalculateFixedTime(mask, *data), CalculateTimeMultiplier(mask), mask.GetCfdSize());
 
         // One last check to ensure event length matches what we think it
         // should be.
@@ -159,14 +174,97 @@ vector<XiaData *> XiaListModeDataDecoder::DecodeBuffer(unsigned int *buf, const
             buf += headerLength;
 
         if (traceLength > 0) {
-            DecodeTrace(buf, *data, traceLength);
+            if (!isLazy_)
+                DecodeTrace(buf, *data, traceLength);
             buf += traceLength / 2;
         }
         events.push_back(data);
+        data = nullptr;
     }// while(buf < bufStart + bufLen)
+    delete data;
     return events;
 }
 
+unsigned int XiaListModeDataDecoder::DecodeHeaders(const unsigned int *buf, const XiaListModeDataMask &mask,
+                                                   XiaHitBatch &batch) {
+    const unsigned int *bufStart = buf;
+    unsigned int bufLen = *buf++;
+    unsigned int modNum = *buf++;
+
+    if (bufLen == 0)
+        throw length_error("XiaListModeDataDecoder::DecodeHeaders - The buffer length was sized 0. This is a huge "
+                                   "issue.");
+
+    if (!batch.GetBuffer())
+        batch.SetBuffer(bufStart);
+
+    //The word decoders fill an XiaData, we reuse one on the stack so that nothing is allocated per hit.
+    XiaData data;
+    size_t numOld = batch.Size();
+    while (buf < bufStart + bufLen) {
+        data.Initialize();
+        pair<unsigned int, unsigned int> lengths = DecodeWordZero(buf[0], data, mask);
+        unsigned int headerLength = lengths.first;
+        unsigned int eventLength = lengths.second;
+
+        if (headerLength == STATS_BLOCK) {
+            buf += eventLength;
+            continue;
+        }
+
+        switch (headerLength) {
+            case HEADER :
+            case HEADER_W_ETS :
+            case HEADER_W_QDC :
+            case HEADER_W_ESUM :
+            case HEADER_W_ESUM_ETS :
+            case HEADER_W_ESUM_QDC :
+            case HEADER_W_ESUM_QDC_ETS :
+            case HEADER_W_QDC_ETS :
+                break;
+            default:
+                cerr << "XiaListModeDataDecoder::DecodeHeaders : We encountered an unrecognized header length ("
+                     << headerLength << ") in the buffer of module " << modNum << ". Skipped the rest of it." << endl;
+                return (unsigned int) (batch.Size() - numOld);
+        }
+
+        data.SetEventTimeLow(buf[1]);
+        DecodeWordTwo(buf[2], data, mask);
+        unsigned int traceLength = DecodeWordThree(buf[3], data, mask);
+
+        if (traceLength / 2 + headerLength != eventLength) {
+            cerr << "XiaListModeDataDecoder::DecodeHeaders : Event length (" << eventLength << ") does not "
+                    "correspond to header length (" << headerLength << ") and trace length (" << traceLength / 2
+                 << "). Skipped the rest of the buffer of module " << modNum << "." << endl;
+            return (unsigned int) (batch.Size() - numOld);
+        }
+
+        unsigned int id = data.GetId();
+        if (id < keepMask_.size() && !keepMask_[id]) {
+            numDiscardedHits_++;
+            buf += eventLength;
+            continue;
+        }
+
+        uint8_t flags = 0;
+        if (data.IsPileup())
+            flags |= XiaHitBatch::PILEUP;
+        if (data.IsSaturated())
+            flags |= XiaHitBatch::SATURATED;
+        if (data.GetCfdForcedTriggerBit())
+            flags |= XiaHitBatch::CFD_FORCED_TRIGGER;
+        if (data.GetCfdTriggerSourceBit())
+            flags |= XiaHitBatch::CFD_TRIGGER_SOURCE;
+        if (data.IsVirtualChannel())
+            flags |= XiaHitBatch::VIRTUAL_CHANNEL;
+
+        batch.Add(CalculateFixedTime(mask, data), id, data.IsSaturated() ? 65536 : (unsigned int) data.GetEnergy(),
+                  data.GetCfdFractionalTime(), flags, (unsigned int) (buf - batch.GetBuffer()));
+        buf += eventLength;
+    }
+    return (unsigned int) (batch.Size() - numOld);
+}
+
 std::pair<unsigned int, unsigned int> XiaListModeDataDecoder::DecodeWordZero(const unsigned int &word, XiaData &data,
                                                                              const XiaListModeDataMask &mask) {
 
@@ -258,6 +356,36 @@ pair<double, double> XiaListModeDataDecoder::CalculateTimeInSamples(const XiaLis
     return make_pair(filterTime, filterTime * multiplier + cfdTime);
 }
 
+int64_t XiaListModeDataDecoder::CalculateFixedTime(const XiaListModeDataMask &mask, const XiaData &data) {
+    static const int fractionBits = XiaData::fixedTimeFractionBits;
+    static const int64_t oneSample = int64_t(1) << fractionBits;
+    int64_t filterTime = int64_t((uint64_t(data.GetEventTimeHigh()) << 32) | data.GetEventTimeLow());
+
+    if (data.GetCfdFractionalTime() == 0 || data.GetCfdForcedTriggerBit())
+        return filterTime * oneSample;
+
+    //The CFD sizes are all powers of two, so we can shift the fraction into place.
+    int cfdBits = ilogb(mask.GetCfdSize());
+    int64_t cfdTime = data.GetCfdFractionalTime();
+    cfdTime = cfdBits > fractionBits ? cfdTime >> (cfdBits - fractionBits) : cfdTime << (fractionBits - cfdBits);
+
+    if (mask.GetFrequency() == 250)
+        cfdTime -= data.GetCfdTriggerSourceBit() * oneSample;
+
+    if (mask.GetFrequency() == 500)
+        cfdTime += (data.GetCfdTriggerSourceBit() - 1) * oneSample;
+
+    return filterTime * CalculateTimeMultiplier(mask) * oneSample + cfdTime;
+}
+
+unsigned int XiaListModeDataDecoder::CalculateTimeMultiplier(const XiaListModeDataMask &mask) {
+    if (mask.GetFrequency() == 250)
+        return 2;
+    if (mask.GetFrequency() == 500)
+        return 10;
+    return 1;
+}
+
 double XiaListModeDataDecoder::CalculateTimeInNs(const XiaListModeDataMask &mask, const XiaData &data) {
     double conversionToNs = 1. / (mask.GetFrequency() * 1.e6);
     return CalculateTimeInSamples(mask, data).second * conversionToNs;
@@ -29,11 +29,6 @@ TEST_FIXTURE(Trace, TestingGettersAndSetters){
     CHECK_EQUAL(waveform_range.first, GetWaveformRange().first);
     CHECK_EQUAL(waveform_range.second, GetWaveformRange().second);
 
-    SetTraceSansBaseline(trace_sans_baseline);
-    CHECK_ARRAY_EQUAL(trace_sans_baseline, GetTraceSansBaseline(), trace_sans_baseline.size());
-
-    CHECK_ARRAY_EQUAL(waveform, GetWaveform(), waveform.size());
-
     SetTriggerFilter(trace_sans_baseline);
     CHECK_ARRAY_EQUAL(trace_sans_baseline, GetTriggerFilter(), trace_sans_baseline.size());
 
@@ -57,6 +52,45 @@ TEST_FIXTURE(Trace, TestingGettersAndSetters){
     CHECK_EQUAL(double_input, GetTau());
 }
 
+TEST(TestingCompactSamplesAndViews) {
+    Trace trc(trace);
+    CHECK_EQUAL((size_t) 2, sizeof(Trace::value_type));
+    CHECK_ARRAY_EQUAL(trace, trc, trace.size());
+
+    //The views stay empty until the baseline is known.
+    trc.SetWaveformRange(waveform_range);
+    CHECK(trc.GetTraceSansBaseline().empty());
+    CHECK(trc.GetWaveform().empty());
+
+    trc.SetBaseline(baseline_pair);
+    CHECK_ARRAY_CLOSE(trace_sans_baseline, trc.GetTraceSansBaseline(), trace_sans_baseline.size(), 1e-2);
+    CHECK_ARRAY_CLOSE(waveform, trc.GetWaveform(), waveform.size(), 1e-2);
+    CHECK_EQUAL(waveform.size(), trc.GetWaveform().size());
+    CHECK_EQUAL(waveform.size(), trc.GetWaveformWithBaseline().size());
+    CHECK_EQUAL(trace[waveform_range.first], trc.GetWaveformWithBaseline().front());
+
+    //A range past the end of the trace is cut at the last sample.
+    trc.SetWaveformRange(make_pair(trace.size() - 2, trace.size() + 5));
+    CHECK_EQUAL((size_t) 2, trc.GetWaveform().size());
+
+    //The views of two traces can be held at the same time.
+    Trace other(trace);
+    other.SetBaseline(make_pair(baseline_pair.first + 1, baseline_pair.second));
+    const vector<double> &first = trc.GetTraceSansBaseline();
+    const vector<double> &second = other.GetTraceSansBaseline();
+    CHECK_CLOSE(first.front() - 1, second.front(), 1e-9);
+
+    //A buffer that the caller owns is refilled by every call.
+    vector<double> buffer(1000, 1.);
+    trc.GetTraceSansBaseline(buffer);
+    CHECK_ARRAY_EQUAL(first, buffer, first.size());
+    CHECK_EQUAL(first.size(), buffer.size());
+    trc.SetWaveformRange(waveform_range);
+    trc.GetWaveform(buffer);
+    CHECK_ARRAY_CLOSE(waveform, buffer, waveform.size(), 1e-2);
+    CHECK_EQUAL(waveform.size(), buffer.size());
+}
+
 int main(int argv, char *argc[]) {
     return (UnitTest::RunAllTests());
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+///@file unittest-Unpacker.cpp
+///@brief Unit tests for the Unpacker class
+///@date October 17, 2026
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <UnitTest++.h>
+
+#include "Unpacker.hpp"
+#include "XiaData.hpp"
+#include "XiaListModeDataEncoder.hpp"
+
+using namespace std;
+
+namespace {
+    ///Firmware and frequency of the test data
+    const string firmware = "R30474";
+    const unsigned int frequency = 250;
+
+    ///Makes a hit from the first module with the provided time stamp and trace.
+    XiaData MakeHit(const unsigned int &channel, const unsigned int &timeLow, const vector<unsigned int> &trace) {
+        XiaData hit;
+        hit.SetCrateNumber(0);
+        hit.SetSlotNumber(2);
+        hit.SetChannelNumber(channel);
+        hit.SetEnergy(100 + channel);
+        hit.SetEventTimeLow(timeLow);
+        hit.SetTrace(trace);
+        return hit;
+    }
+
+    ///Encodes the hits into a spill with a single module buffer and the end of spill marker.
+    vector<unsigned int> MakeSpill(const vector<XiaData> &hits) {
+        XiaListModeDataEncoder encoder(firmware, frequency);
+        vector<unsigned int> module;
+        for (vector<XiaData>::const_iterator it = hits.begin(); it != hits.end(); it++) {
+            vector<unsigned int> words = encoder.EncodeXiaData(*it);
+            module.insert(module.end(), words.begin(), words.end());
+        }
+
+        vector<unsigned int> spill;
+        spill.push_back((unsigned int) module.size() + 2);
+        spill.push_back(0);
+        spill.insert(spill.end(), module.begin(), module.end());
+        spill.push_back(2);
+        spill.push_back(9999);
+        return spill;
+    }
+
+    ///Unpacker that records the hits of every event that it builds.
+    class RecordingUnpacker : public Unpacker {
+    public:
+        RecordingUnpacker() { InitializeDataMask(firmware, frequency); }
+
+        vector<double> times; ///< The time of every hit in the order they were processed
+        vector<vector<unsigned int> > traces; ///< The trace of every hit in the order they were processed
+        vector<unsigned int> eventSizes; ///< The number of hits in every event
+        vector<tuple<double, unsigned int, unsigned int> > headers; ///< The time, ID and energy of every hit
+
+    protected:
+        void ProcessRawEvent() {
+            eventSizes.push_back((unsigned int) rawEvent.size());
+            for (deque<XiaData *>::const_iterator it = rawEvent.begin(); it != rawEvent.end(); it++) {
+                times.push_back((*it)->GetTime());
+                traces.push_back((*it)->GetTrace());
+                headers.push_back(make_tuple((*it)->GetTime(), (*it)->GetId(), (unsigned int) (*it)->GetEnergy()));
+            }
+            Unpacker::ProcessRawEvent();
+        }
+
+        void ProcessHitBatch(const XiaHitBatch &batch) {
+            for (size_t i = 0; i < batch.Size(); i++)
+                headers.push_back(make_tuple(batch.GetTime(i), batch.GetIds()[i], batch.GetEnergies()[i]));
+        }
+    };
+
+    ///Reads the spills with the unpacker and flushes it.
+    void ReadSpills(RecordingUnpacker &unpacker, const vector<vector<unsigned int> > &spills) {
+        for (vector<vector<unsigned int> >::const_iterator it = spills.begin(); it != spills.end(); it++) {
+            vector<unsigned int> buffer(*it);
+            unpacker.ReadSpill(buffer.data(), (unsigned int) buffer.size(), false);
+        }
+        unpacker.Flush();
+    }
+
+    const vector<unsigned int> firstTrace = {10, 11, 12, 13};
+    const vector<unsigned int> secondTrace = {20, 21, 22, 23};
+    const vector<unsigned int> thirdTrace = {30, 31, 32, 33};
+}
+
+///Hits that the re-ordering window holds back must not read their traces from the spill buffer after it was
+/// reused for the next spill.
+TEST_FIXTURE(RecordingUnpacker, TestLazyHitsOutliveTheirSpill) {
+    SetLazyDecoding(true);
+    SetReorderWindow(1000);
+
+    vector<unsigned int> buffer = MakeSpill({MakeHit(0, 100, firstTrace), MakeHit(1, 1000000, secondTrace)});
+    CHECK(ReadSpill(buffer.data(), (unsigned int) buffer.size(), false));
+    CHECK_EQUAL((size_t) 1, traces.size());
+
+    //The next spill goes into the same buffer, just like ScanInterface does it.
+    const vector<unsigned int> next = MakeSpill({MakeHit(2, 2000000, thirdTrace), MakeHit(3, 2000001, thirdTrace)});
+    CHECK_EQUAL(buffer.size(), next.size());
+    copy(next.begin(), next.end(), buffer.begin());
+    CHECK(ReadSpill(buffer.data(), (unsigned int) buffer.size(), false));
+    Flush();
+
+    CHECK_EQUAL((size_t) 4, traces.size());
+    if (traces.size() == 4) {
+        CHECK_ARRAY_EQUAL(firstTrace, traces[0], firstTrace.size());
+        CHECK_ARRAY_EQUAL(secondTrace, traces[1], secondTrace.size());
+        CHECK_ARRAY_EQUAL(thirdTrace, traces[2], thirdTrace.size());
+    }
+}
+
+///Hits that wait in the merger for the other sources must not read their traces from the spill buffer after the
+/// next source was read into it.
+TEST_FIXTURE(RecordingUnpacker, TestLazyHitsWaitingForOtherSources) {
+    SetLazyDecoding(true);
+    SetNumberOfSources(2);
+
+    vector<unsigned int> buffer = MakeSpill({MakeHit(0, 100, firstTrace)});
+    CHECK(ReadSpill(buffer.data(), (unsigned int) buffer.size(), false, 0));
+    CHECK_EQUAL((size_t) 0, traces.size());
+
+    const vector<unsigned int> next = MakeSpill({MakeHit(1, 1000, secondTrace)});
+    CHECK_EQUAL(buffer.size(), next.size());
+    copy(next.begin(), next.end(), buffer.begin());
+    CHECK(ReadSpill(buffer.data(), (unsigned int) buffer.size(), false, 1));
+    fill(buffer.begin(), buffer.end(), 0);
+    FinishSource(0);
+    FinishSource(1);
+
+    CHECK_EQUAL((size_t) 2, traces.size());
+    if (traces.size() == 2) {
+        CHECK_ARRAY_EQUAL(firstTrace, traces[0], firstTrace.size());
+        CHECK_ARRAY_EQUAL(secondTrace, traces[1], secondTrace.size());
+    }
+}
+
+///Decoding only the headers hands over the same hits as building events does, only in the order of the spill
+/// instead of in time order.
+TEST(TestBatchModeMatchesEvents) {
+    const vector<vector<unsigned int> > spills = {
+            MakeSpill({MakeHit(3, 500, firstTrace), MakeHit(0, 100, secondTrace), MakeHit(1, 120, thirdTrace)}),
+            MakeSpill({MakeHit(2, 900, firstTrace), MakeHit(0, 700, secondTrace)})};
+
+    RecordingUnpacker events;
+    ReadSpills(events, spills);
+
+    RecordingUnpacker batches;
+    batches.SetBatchMode(true);
+    ReadSpills(batches, spills);
+
+    CHECK_EQUAL((size_t) 0, batches.eventSizes.size());
+    CHECK_EQUAL((size_t) 5, events.headers.size());
+    CHECK_EQUAL(events.headers.size(), batches.headers.size());
+    sort(batches.headers.begin(), batches.headers.end());
+    sort(events.headers.begin(), events.headers.end());
+    CHECK(events.headers == batches.headers);
+    CHECK_EQUAL(events.GetFirstTime(), batches.GetFirstTime());
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
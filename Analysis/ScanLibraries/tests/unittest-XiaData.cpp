@@ -30,6 +30,26 @@ TEST_FIXTURE (XiaData, Test_GetId) {
     CHECK_EQUAL(crateId*208 + GetModuleNumber() * 16 + channelNumber, GetId());
 }
 
+TEST_FIXTURE (XiaData, Test_GetIdWithTopology) {
+    SetSlotNumber(slotId + 1);
+    SetChannelNumber(channelNumber);
+    SetCrateNumber(1);
+    CHECK_EQUAL(XiaTopology::InvalidId(), GetId());
+
+    SetTopology(XiaTopology(2, 4, 32));
+    CHECK_EQUAL((unsigned int)256, GetTopology().GetNumberOfChannels());
+    CHECK_EQUAL((1 * 4 + GetModuleNumber()) * 32 + channelNumber, GetId());
+    CHECK_EQUAL((unsigned int)1, GetTopology().GetCrateFromId(GetId()));
+    CHECK_EQUAL(GetModuleNumber(), GetTopology().GetModuleFromId(GetId()));
+    CHECK_EQUAL(channelNumber, GetTopology().GetChannelFromId(GetId()));
+
+    SetSlotNumber(6);
+    CHECK_EQUAL(XiaTopology::InvalidId(), GetId());
+
+    CHECK_THROW(XiaTopology(1, 0, 16), std::invalid_argument);
+    SetTopology(XiaTopology());
+}
+
 TEST_FIXTURE (XiaData, Test_GetSetCfdForcedTrig) {
     SetCfdForcedTriggerBit(cfd_forced_trigger);
     CHECK (GetCfdForcedTriggerBit());
@@ -170,6 +190,29 @@ TEST (Test_LessThanOperator) {
     CHECK(lhs < rhs);
 }
 
+TEST_FIXTURE (XiaData, Test_FixedTime) {
+    SetFixedTime(ToFixedTime(unittest_decoded_data::R30474_250::ts_w_cfd));
+    CHECK_CLOSE(unittest_decoded_data::R30474_250::ts_w_cfd, GetTime(), 1e-3);
+    SetTime(12.5);
+    CHECK_EQUAL((int64_t)(12.5 * 2048), GetFixedTime());
+}
+
+TEST (Test_SortByTime) {
+    //Large enough for the radix sort, with some negative times to check the sign handling.
+    deque<XiaData *> hits;
+    for (unsigned int i = 0; i < 1000; i++) {
+        hits.push_back(new XiaData());
+        hits.back()->SetFixedTime((int64_t)((i * 7919) % 1000) * 1234567 - 100000000);
+    }
+
+    XiaData::SortByTime(hits);
+    for (unsigned int i = 1; i < hits.size(); i++)
+        CHECK(hits[i - 1]->GetFixedTime() <= hits[i]->GetFixedTime());
+
+    for (deque<XiaData *>::iterator it = hits.begin(); it != hits.end(); it++)
+        delete *it;
+}
+
 int main(int argv, char *argc[]) {
     return (UnitTest::RunAllTests());
 }
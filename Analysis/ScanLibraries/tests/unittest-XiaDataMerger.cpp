@@ -0,0 +1,111 @@
+///@file unittest-XiaDataMerger.cpp
+///@brief Unit tests for the XiaDataMerger class
+///@date October 17, 2026
+#include <vector>
+
+#include <UnitTest++.h>
+
+#include "XiaData.hpp"
+#include "XiaDataMerger.hpp"
+
+using namespace std;
+
+///Makes a list of hits with the provided times.
+vector<XiaData *> MakeHits(const vector<double> &times) {
+    vector<XiaData *> hits;
+    for (vector<double>::const_iterator it = times.begin(); it != times.end(); it++) {
+        XiaData *hit = new XiaData();
+        hit->SetTime(*it);
+        hit->SetTimeSansCfd(*it);
+        hits.push_back(hit);
+    }
+    return hits;
+}
+
+///Checks the times of the merged hits and deletes them.
+void CheckAndDelete(const vector<double> &expected, vector<XiaData *> &merged) {
+    CHECK_EQUAL(expected.size(), merged.size());
+    for (unsigned int i = 0; i < expected.size() && i < merged.size(); i++)
+        CHECK_CLOSE(expected[i], merged[i]->GetTime(), 1e-6);
+    for (vector<XiaData *>::iterator it = merged.begin(); it != merged.end(); it++)
+        delete *it;
+    merged.clear();
+}
+
+TEST_FIXTURE(XiaDataMerger, TestMergeWaitsForAllSources) {
+    SetNumberOfSources(2);
+    vector<XiaData *> merged;
+
+    Add(0, MakeHits({30, 10, 20}));
+    CHECK_EQUAL(1, GetNextSource());
+    Merge(merged);
+    CHECK_EQUAL((size_t) 0, merged.size());
+
+    Add(1, MakeHits({15, 25}));
+    CHECK_EQUAL(1, GetNextSource());
+    CHECK_CLOSE(25., Merge(merged), 1e-6);
+    CheckAndDelete({10, 15, 20, 25}, merged);
+    CHECK_EQUAL((size_t) 1, GetOccupancy(0));
+    CHECK_CLOSE(5., GetLag(), 1e-6);
+
+    Finish(1);
+    CHECK_EQUAL(0, GetNextSource());
+    Merge(merged);
+    CheckAndDelete({30}, merged);
+
+    Finish(0);
+    CHECK(IsFinished());
+    CHECK_EQUAL(-1, GetNextSource());
+}
+
+TEST_FIXTURE(XiaDataMerger, TestClockCorrection) {
+    SetNumberOfSources(2);
+    SetClockCorrection(1, 100, 0.5);
+    CHECK_THROW(SetClockCorrection(2, 0, 0), out_of_range);
+
+    vector<XiaData *> merged;
+    Add(0, MakeHits({150, 250}));
+    Add(1, MakeHits({40, 100}));
+    Finish(0);
+    Finish(1);
+    Merge(merged);
+    CheckAndDelete({150, 160, 250, 250}, merged);
+}
+
+TEST_FIXTURE(XiaDataMerger, TestBoundedBuffers) {
+    SetNumberOfSources(2);
+    SetMaximumBufferedHits(2);
+    vector<XiaData *> merged;
+
+    Add(0, MakeHits({1, 2}));
+    Merge(merged);
+    CHECK_EQUAL((size_t) 0, merged.size());
+
+    Add(0, MakeHits({3}));
+    Merge(merged);
+    CheckAndDelete({1, 2, 3}, merged);
+    CHECK_EQUAL((unsigned long long) 1, GetNumberOfForcedMerges());
+    CHECK_EQUAL((size_t) 3, GetPeakOccupancy());
+
+    Add(1, MakeHits({2.5}));
+    CHECK_EQUAL((unsigned long long) 1, GetNumberOfLateHits());
+}
+
+TEST_FIXTURE(XiaDataMerger, TestReorderWindow) {
+    SetNumberOfSources(1);
+    SetReorderWindow(10);
+    vector<XiaData *> merged;
+
+    Add(0, MakeHits({5, 20, 30}));
+    CHECK_CLOSE(20., Merge(merged), 1e-6);
+    CheckAndDelete({5, 20}, merged);
+
+    Add(0, MakeHits({25, 45}));
+    CHECK_EQUAL((unsigned long long) 0, GetNumberOfLateHits());
+    Merge(merged);
+    CheckAndDelete({25, 30}, merged);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -97,6 +97,76 @@ TEST_FIXTURE(XiaListModeDataDecoder, TestCfdTimeCalculation) {
     XiaData result = *(DecodeBuffer(&headerWithCfd[0], mask).front());
     CHECK_EQUAL(cfd_fractional_time, result.GetCfdFractionalTime());
     CHECK_CLOSE(unittest_decoded_data::R30474_250::ts_w_cfd, result.GetTime(), 1e-5);
+
+    //The time keeps the full CFD fraction, the fixed-point key is rounded down to 1/2048 of a sample.
+    CHECK_EQUAL(CalculateTimeInSamples(mask, result).second, result.GetTime());
+    double rounding = result.GetTime() - XiaData::FromFixedTime(result.GetFixedTime());
+    CHECK(rounding >= 0);
+    CHECK(rounding < 1. / 2048);
+}
+
+TEST_FIXTURE(XiaListModeDataDecoder, TestDecodeHeaders) {
+    XiaHitBatch batch;
+    CHECK_EQUAL((unsigned int) 1, DecodeHeaders(&headerWithCfd[0], mask, batch));
+    CHECK_EQUAL((unsigned int) 1, DecodeHeaders(&headerWithTrace[0], mask, batch));
+    CHECK_EQUAL((size_t) 2, batch.Size());
+    CHECK(batch.GetBuffer() == &headerWithCfd[0]);
+    CHECK_EQUAL((unsigned int) 2, batch.GetPayloadOffsets()[0]);
+
+    XiaData *result = DecodeBuffer(&headerWithCfd[0], mask).front();
+    CHECK_EQUAL(result->GetFixedTime(), batch.GetFixedTimes()[0]);
+    CHECK_EQUAL(result->GetId(), batch.GetIds()[0]);
+    CHECK_EQUAL((unsigned int) result->GetEnergy(), batch.GetEnergies()[0]);
+    CHECK_EQUAL(cfd_fractional_time, (unsigned int) batch.GetCfdFractions()[0]);
+    CHECK_EQUAL(result->IsPileup(), batch.HasFlag(0, XiaHitBatch::PILEUP));
+    delete result;
+
+    batch.Clear();
+    CHECK(batch.IsEmpty());
+    CHECK(batch.GetBuffer() == nullptr);
+}
+
+TEST_FIXTURE(XiaListModeDataDecoder, TestLazyPayloadDecoding) {
+    SetLazy(true);
+
+    XiaData *result = DecodeBuffer(&headerWithEnergySumsQdcExternalTimestamp[0], mask).front();
+    CHECK(result->HasPendingPayload());
+    CHECK_EQUAL(energy, result->GetEnergy());
+    CHECK_EQUAL(unittest_decoded_data::ex_ts_low, result->GetExternalTimeLow());
+    CHECK_EQUAL(unittest_decoded_data::ex_ts_high, result->GetExternalTimeHigh());
+    CHECK_ARRAY_EQUAL(unittest_decoded_data::energy_sums, result->GetEnergySums(), unittest_decoded_data::energy_sums.size());
+    CHECK(!result->HasPendingPayload());
+    CHECK_CLOSE(unittest_decoded_data::filterBaseline, result->GetFilterBaseline(), 1e-4);
+    CHECK_ARRAY_EQUAL(qdc, result->GetQdc(), qdc.size());
+    delete result;
+
+    result = DecodeBuffer(&headerWithTrace[0], mask).front();
+    CHECK_EQUAL(unittest_trace_variables::trace.size(), result->GetTraceLength());
+    CHECK(result->HasPendingPayload());
+    CHECK_ARRAY_EQUAL(unittest_trace_variables::trace, result->GetTrace(), unittest_trace_variables::trace.size());
+    delete result;
+}
+
+TEST_FIXTURE(XiaListModeDataDecoder, TestKeepMask) {
+    vector<bool> keepMask(16, true);
+    keepMask[channelNumber] = false;
+    SetKeepMask(keepMask);
+    CHECK_EQUAL((unsigned int)0, DecodeBuffer(&headerWithTrace[0], mask).size());
+    CHECK_EQUAL((unsigned long long)1, GetNumberOfDiscardedHits());
+
+    keepMask[channelNumber] = true;
+    SetKeepMask(keepMask);
+    vector<XiaData *> result = DecodeBuffer(&header[0], mask);
+    CHECK_EQUAL((unsigned int)1, result.size());
+    CHECK_EQUAL((unsigned long long)1, GetNumberOfDiscardedHits());
+    delete result.front();
+
+    //Channels outside of the mask are left for the Unpacker to deal with.
+    SetKeepMask(vector<bool>(channelNumber, false));
+    result = DecodeBuffer(&header[0], mask);
+    CHECK_EQUAL((unsigned int)1, result.size());
+    CHECK_EQUAL((unsigned long long)1, GetNumberOfDiscardedHits());
+    delete result.front();
 }
 
 int main(int argv, char *argc[]) {
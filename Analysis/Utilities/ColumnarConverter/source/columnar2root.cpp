@@ -0,0 +1,77 @@
+///@file columnar2root.cpp
+///@brief Program that converts a columnar file written by utkscan into a ROOT tree.
+///@date October 17, 2026
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstring>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "ColumnarReader.hpp"
+
+void help(char *name_) {
+    std::cout << "  SYNTAX: " << name_ << " <input.col> <output.root> [tree name]\n";
+    std::cout << "   Every column becomes a branch of the tree, the default name of the tree is \"data\".\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cout << " Error: Invalid number of arguments to " << argv[0] << ". Expected 2 or 3, received "
+                  << argc - 1 << ".\n";
+        help(argv[0]);
+        return 1;
+    }
+
+    try {
+        ColumnarReader reader(argv[1]);
+        if (!reader.IsComplete())
+            std::cout << " Warning: " << argv[1] << " has no footer, converting the " << reader.GetNumberOfRows()
+                      << " rows of its complete chunks.\n";
+
+        TFile file(argv[2], "RECREATE");
+        if (file.IsZombie()) {
+            std::cout << " Error: Unable to open " << argv[2] << ".\n";
+            return 1;
+        }
+        //The file owns the tree and deletes it when it is closed.
+        TTree *tree = new TTree(argc == 4 ? argv[3] : "data", argv[1]);
+
+        //The branch of each column reads from a buffer holding one row, which we copy out of the chunk.
+        const std::vector<ColumnarReader::Column> &columns = reader.GetColumns();
+        std::vector<std::vector<char> > rows(columns.size()), chunks(columns.size());
+        for (std::vector<ColumnarReader::Column>::size_type i = 0; i < columns.size(); i++) {
+            std::stringstream leaflist;
+            std::string leaf = columns[i].name.substr(columns[i].name.find_last_of('.') + 1);
+            leaflist << leaf;
+            if (columns[i].count > 1)
+                leaflist << "[" << columns[i].count << "]";
+            leaflist << "/" << columns[i].type;
+            rows[i].resize(columns[i].size);
+            tree->Branch(columns[i].name.c_str(), rows[i].data(), leaflist.str().c_str());
+        }
+
+        for (size_t chunk = 0; chunk < reader.GetChunks().size(); chunk++) {
+            for (std::vector<ColumnarReader::Column>::size_type i = 0; i < columns.size(); i++)
+                reader.ReadChunk(chunk, i, chunks[i]);
+            for (uint32_t row = 0; row < reader.GetChunks()[chunk].numberOfRows; row++) {
+                for (std::vector<ColumnarReader::Column>::size_type i = 0; i < columns.size(); i++)
+                    memcpy(rows[i].data(), chunks[i].data() + row * columns[i].size, columns[i].size);
+                tree->Fill();
+            }
+        }
+
+        file.Write();
+        std::cout << " Converted " << tree->GetEntries() << " rows of " << columns.size() << " columns from "
+                  << argv[1] << " into " << argv[2] << ".\n";
+        file.Close();
+    } catch (std::exception &ex) {
+        std::cout << " Error: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
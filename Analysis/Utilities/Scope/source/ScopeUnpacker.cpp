@@ -334,8 +334,8 @@ void ScopeUnpacker::Plot() {
         f.Close();
 
         ofstream ascii((saveFile_ + ".dat").c_str());
-        vector<unsigned int> trc = chanEvents_.front()->GetTrace();
-        for (vector<unsigned int>::iterator it = trc.begin(); it != trc.end(); it++)
+        const Trace &trc = chanEvents_.front()->GetTrace();
+        for (Trace::const_iterator it = trc.begin(); it != trc.end(); it++)
             ascii << int(it - trc.begin()) << " " << *it << endl;
         saveFile_ = "";
     }
@@ -22,6 +22,10 @@ public:
     /** Declare the plots */
     void DeclarePlots(void) const {};
 
+    ///@param[in] cfg : Configuration of the channel
+    ///@return False for every channel if the requested CFD type was unknown
+    bool AppliesTo(const ChannelConfiguration &cfg) const { return driver_ != NULL; }
+
     /** Do the analysis on traces
     * \param [in] trace : the trace to analyze
     * \param [in] detType : the detector type
@@ -31,6 +35,7 @@ public:
 
 private:
     TimingDriver *driver_;
+    std::vector<double> waveform_; //!< The waveform of the trace, the memory is reused for every trace
 };
 
 #endif
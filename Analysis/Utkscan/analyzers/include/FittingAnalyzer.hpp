@@ -11,6 +11,7 @@
 #define __FITTINGANALYZER_HPP_
 
 #include <string>
+#include <vector>
 
 #include "TimingDriver.hpp"
 #include "Trace.hpp"
@@ -34,6 +35,7 @@ public:
 
 private:
     TimingDriver *driver_;
+    std::vector<double> waveform_; //!< The waveform of the trace, the memory is reused for every trace
 };
 
 #endif // __FITTINGANALYZER_HPP_
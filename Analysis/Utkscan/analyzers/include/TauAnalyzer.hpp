@@ -23,6 +23,12 @@ public:
     /** Default Destructor */
     ~TauAnalyzer() {};
 
+    ///@param[in] cfg : Configuration of the channel
+    ///@return True if the type or the subtype of the channel matches ours
+    bool AppliesTo(const ChannelConfiguration &cfg) const {
+        return type == cfg.GetType() || subtype == cfg.GetSubtype();
+    }
+
     /** The main analysis driver
     * \param [in] trace : the trace to analyze
     * \param [in] aType : the type being analyze
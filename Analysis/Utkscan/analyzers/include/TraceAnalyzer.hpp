@@ -35,6 +35,13 @@ public:
     /** Declare Plots (empty for now) */
     virtual void DeclarePlots(void) {};
 
+    ///Tells the DetectorDriver if the analyzer does anything with the traces of a channel. The driver asks once for
+    /// each channel when it starts and leaves the analyzer out of the chain of the channels where the answer is
+    /// false, so checks that only depend on the configuration of the channel belong here instead of in Analyze.
+    ///@param[in] cfg : Configuration of the channel
+    ///@return True if the analyzer should see the traces of the channel, the default is every channel.
+    virtual bool AppliesTo(const ChannelConfiguration &cfg) const { return true; }
+
     ///Function to analyze a trace online.
     ///@param [in] trace: the trace
     ///@param [in] cfg : Configuration for the channel to analyze.
@@ -66,19 +73,19 @@ protected:
     /** plot trace into a 1D histogram
     * \param [in] trc : The trace that we want to plot
     * \param [in] id : histogram ID to plot into */
-    void Plot(const std::vector<unsigned int> &trc, const int &id);
+    void Plot(const Trace &trc, const int &id);
 
     /** plot trace into row of a 2D histogram
     * \param [in] trc : The trace that we want to plot
     * \param [in] id : histogram ID to plot into
     * \param [in] row : the row to plot into */
-    void Plot(const std::vector<unsigned int> &trc, int id, int row);
+    void Plot(const Trace &trc, int id, int row);
 
     /** plot trace absolute value and scaled into a 1D histogram
     * \param [in] trc : The trace that we want to plot
     * \param [in] id : histogram ID to plot into
     * \param [in] scale : the scaling for the trace */
-    void ScalePlot(const std::vector<unsigned int> &trc, int id, double
+    void ScalePlot(const Trace &trc, int id, double
     scale);
 
     /** plot trace absolute value and scaled into a 2D histogram
@@ -86,20 +93,20 @@ protected:
     * \param [in] id : histogram ID to plot into
     * \param [in] row : the row to plot the histogram into
     * \param [in] scale : the scaling for the trace */
-    void ScalePlot(const std::vector<unsigned int> &trc, int id, int row, double scale);
+    void ScalePlot(const Trace &trc, int id, int row, double scale);
 
     /** plot trace with a vertical offset in a 1D histogram
      * \param [in] trc : The trace that we want to plot
     * \param [in] id : histogram ID to plot into
     * \param [in] offset : the offset for the trace */
-    void OffsetPlot(const std::vector<unsigned int> &trc, int id, double offset);
+    void OffsetPlot(const Trace &trc, int id, double offset);
 
     /** plot trace with a vertical offset in a 2D histogram
      * \param [in] trc : The trace that we want to plot
     * \param [in] id : histogram ID to plot into
     * \param [in] row : the row to plot the trace into
     * \param [in] offset : the offset for the trace*/
-    void OffsetPlot(const std::vector<unsigned int> &trc, int id, int row, double offset);
+    void OffsetPlot(const Trace &trc, int id, int row, double offset);
 private:
     tms tmsBegin;             ///< time at which the analyzer began
     double userTime;          ///< user time used by this class
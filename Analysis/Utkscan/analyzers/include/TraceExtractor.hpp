@@ -28,6 +28,12 @@ public:
     /** Default Destructor */
     ~TraceExtractor() {};
 
+    ///@param[in] cfg : Configuration of the channel
+    ///@return True if the channel has our type, subtype and tag
+    bool AppliesTo(const ChannelConfiguration &cfg) const {
+        return type_ == cfg.GetType() && subtype_ == cfg.GetSubtype() && cfg.HasTag(tag_);
+    }
+
     /** Declare the plots for the analyzer */
     void DeclarePlots(void);
 
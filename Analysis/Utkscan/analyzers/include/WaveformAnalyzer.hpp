@@ -23,6 +23,12 @@ public:
     /** Declare the plots */
     void DeclarePlots(void) const {}
 
+    ///@param[in] cfg : Configuration of the channel
+    ///@return False if the type of the channel is one of the ignored types
+    bool AppliesTo(const ChannelConfiguration &cfg) const {
+        return ignoredTypes_.find(cfg.GetType()) == ignoredTypes_.end();
+    }
+
     /** Do the analysis on traces
     * \param [in] trace : the trace to analyze
     * \param [in] type : the detector type
@@ -36,12 +36,13 @@ void CfdAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
         return;
     }
 
-    if (trace.IsSaturated() || trace.empty() || trace.GetWaveform().empty()) {
+    trace.GetWaveform(waveform_);
+    if (trace.IsSaturated() || trace.empty() || waveform_.empty()) {
         EndAnalyze();
         return;
     }
 
-    trace.SetPhase(driver_->CalculatePhase(trace.GetWaveform(), cfg.GetTimingConfiguration(),
+    trace.SetPhase(driver_->CalculatePhase(waveform_, cfg.GetTraceAnalysisParameters().timingConfiguration,
                                            trace.GetExtrapolatedMaxInfo(), trace.GetBaselineInfo()) + trace.GetMaxInfo().first);
     EndAnalyze();
 }
@@ -52,14 +52,13 @@ void FittingAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
         return;
     }
 
-    auto timingConfiguration = cfg.GetTimingConfiguration();
-
+    //The channel resolved everything but the QDC, which belongs to the trace. The configuration is a handful of
+    // numbers so taking a copy of it to set the QDC is cheap.
+    TimingConfiguration timingConfiguration = cfg.GetTraceAnalysisParameters().timingConfiguration;
     timingConfiguration.SetQdc(trace.GetQdc());
 
-    if (cfg.GetType() == "beta" && cfg.GetSubtype() == "double" && cfg.HasTag("timing"))
-        timingConfiguration.SetIsFastSiPm(true);
-
-    trace.SetPhase(driver_->CalculatePhase(trace.GetWaveform(), timingConfiguration, trace.GetMaxInfo(),
+    trace.GetWaveform(waveform_);
+    trace.SetPhase(driver_->CalculatePhase(waveform_, timingConfiguration, trace.GetMaxInfo(),
                                            trace.GetBaselineInfo()) + trace.GetMaxInfo().first);
     EndAnalyze();
 }
\ No newline at end of file
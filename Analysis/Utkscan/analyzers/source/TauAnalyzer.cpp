@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "Globals.hpp"
+#include "SampleSpan.hpp"
 #include "TauAnalyzer.hpp"
 
 using namespace std;
@@ -31,15 +32,12 @@ void TauAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
 //    if (trace.HasValue("filterEnergy2")) {
 //        return;
 //    }
-    // only do analysis for the proper type and subtype
-    if (type != cfg.GetType() && subtype != cfg.GetSubtype())
-        return;
-
     TraceAnalyzer::Analyze(trace, cfg);
 
-    Trace::const_iterator itMax = max_element(trace.begin(), trace.end());
-    Trace::const_iterator itMin = min_element(itMax, (Trace::const_iterator) trace.end());
-    iterator_traits<Trace::const_iterator>::difference_type size = distance(itMax, itMin);
+    const SampleSpan<unsigned short> samples(trace);
+    SampleSpan<unsigned short>::const_iterator itMax = max_element(samples.begin(), samples.end());
+    SampleSpan<unsigned short>::const_iterator itMin = min_element(itMax, samples.end());
+    iterator_traits<SampleSpan<unsigned short>::const_iterator>::difference_type size = distance(itMax, itMin);
 
     // skip over the area near the extrema since it may be non-exponential there
     advance(itMax, size / 10);
@@ -50,7 +48,7 @@ void TauAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
 
     double sum1 = 0, sum2 = 0;
     double i = 0;
-    for (Trace::const_iterator it = itMax; it != itMin; it++) {
+    for (SampleSpan<unsigned short>::const_iterator it = itMax; it != itMin; it++) {
         double j = i + 1.;
         sum1 += double(*it) * (j * n * n - 3 * j * j * n + 2 * j * j * j);
         sum2 += double(*it) * (i * n * n - 3 * i * i * n + 2 * i * i * i);
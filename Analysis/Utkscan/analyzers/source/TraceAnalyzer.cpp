@@ -37,32 +37,32 @@ TraceAnalyzer::~TraceAnalyzer() {
     cout << name << " analyzer : " << userTime << " user time, " << systemTime << " system time" << endl;
 }
 
-void TraceAnalyzer::Plot(const vector<unsigned int> &trc, const int &id) {
+void TraceAnalyzer::Plot(const Trace &trc, const int &id) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, 1, (int) trc.at(i));
 }
 
-void TraceAnalyzer::Plot(const vector<unsigned int> &trc, int id, int row) {
+void TraceAnalyzer::Plot(const Trace &trc, int id, int row) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, row, (int) trc.at(i));
 }
 
-void TraceAnalyzer::ScalePlot(const vector<unsigned int> &trc, int id, double scale) {
+void TraceAnalyzer::ScalePlot(const Trace &trc, int id, double scale) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, 1, abs((int) trc.at(i)) / scale);
 }
 
-void TraceAnalyzer::ScalePlot(const vector<unsigned int> &trc, int id, int row, double scale) {
+void TraceAnalyzer::ScalePlot(const Trace &trc, int id, int row, double scale) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, row, abs((int) trc.at(i)) / scale);
 }
 
-void TraceAnalyzer::OffsetPlot(const vector<unsigned int> &trc, int id, double offset) {
+void TraceAnalyzer::OffsetPlot(const Trace &trc, int id, double offset) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, 1, max(0., (int) trc.at(i) - offset));
 }
 
-void TraceAnalyzer::OffsetPlot(const vector<unsigned int> &trc, int id, int row, double offset) {
+void TraceAnalyzer::OffsetPlot(const Trace &trc, int id, int row, double offset) {
     for (unsigned int i = 0; i < trc.size(); i++)
         histo.Plot(id, i, row, max(0., (int) trc.at(i) - offset));
 }
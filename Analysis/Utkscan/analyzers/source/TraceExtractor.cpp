@@ -36,7 +36,7 @@ void TraceExtractor::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
     ///@TODO : Fix this once we enable filling plots with weights in ROOT
     histo.Plot(DD_TRACE, 1, 100);
 
-    if (type_ == cfg.GetType() && subtype_ == cfg.GetSubtype() && cfg.HasTag(tag_) && numPlottedTraces < numTraces) {
+    if (numPlottedTraces < numTraces) {
         TraceAnalyzer::Analyze(trace, cfg);
         OffsetPlot(trace, DD_TRACE, numPlottedTraces, 0.0);
         numPlottedTraces++;
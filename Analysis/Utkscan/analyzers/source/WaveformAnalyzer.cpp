@@ -14,6 +14,7 @@
 #include <cmath>
 
 #include "HelperFunctions.hpp"
+#include "TraceKernels.hpp"
 #include "WaveformAnalyzer.hpp"
 
 using namespace std;
@@ -27,18 +28,23 @@ WaveformAnalyzer::WaveformAnalyzer(const std::set<std::string> &ignoredTypes)
 void WaveformAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
     TraceAnalyzer::Analyze(trace, cfg);
 
-    if (trace.IsSaturated() || trace.empty() || ignoredTypes_.find(cfg.GetType()) != ignoredTypes_.end()) {
+    if (trace.IsSaturated() || trace.empty()) {
         trace.SetHasValidAnalysis(false);
         EndAnalyze();
         return;
     }
 
-    pair<unsigned int, unsigned int> range = cfg.GetWaveformBoundsInSamples();
+    const TraceAnalysisParameters &parameters = cfg.GetTraceAnalysisParameters();
+    const pair<unsigned int, unsigned int> &range = parameters.waveformBoundsInSamples;
 
-    //First we calculate the position of the maximum.
+    //First we calculate the position of the maximum. We start the search after the minimum number of samples that
+    // we need for the baseline and stop at the trace delay, like TraceFunctions::FindMaximum.
     pair<unsigned int, double> max;
     try {
-        max = TraceFunctions::FindMaximum(trace, cfg.GetTraceDelayInSamples());
+        if (parameters.traceDelayInSamples < TraceFunctions::minimum_baseline_length)
+            throw range_error("The trace delay is shorter than the minimum length of the baseline.");
+        max = TraceKernels::FindMaximum(trace, TraceFunctions::minimum_baseline_length,
+                                        parameters.traceDelayInSamples);
     } catch (range_error &ex) {
         trace.SetHasValidAnalysis(false);
         cout << "WaveformAnalyzer::Analyze - " << ex.what() << endl;
@@ -61,8 +67,12 @@ void WaveformAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
     }
 
     try {
-        //Next we calculate the baseline and its standard deviation
-        pair<double, double> baseline = TraceFunctions::CalculateBaseline(trace, make_pair(0, max.first - range.first));
+        //Next we calculate the baseline, its standard deviation and the QDC in the waveform range. The baseline ends
+        // where the waveform starts, so a single pass over the samples gives us all of them.
+        pair<unsigned int, unsigned int> waveformRange(max.first - range.first, max.first + range.second);
+        const TraceKernels::BaselineAndQdc baselineAndQdc =
+                TraceKernels::CalculateBaselineAndQdc(trace, waveformRange.first, waveformRange.second);
+        const pair<double, double> &baseline = baselineAndQdc.baseline;
 
         //For well behaved traces the standard deviation of the baseline
         // shouldn't ever be more than 1-3 ADC units. However, for traces
@@ -80,22 +90,12 @@ void WaveformAnalyzer::Analyze(Trace &trace, const ChannelConfiguration &cfg) {
         //Subtract the baseline from the maximum value.
         max.second -= baseline.first;
 
-        vector<double> traceNoBaseline;
-        for (unsigned int i = 0; i < trace.size(); i++)
-            traceNoBaseline.push_back(trace[i] - baseline.first);
-
-        //Finally, we calculate the QDC in the waveform range and subtract
-        // the baseline from it.
-        pair<unsigned int, unsigned int> waveformRange(max.first - range.first, max.first + range.second);
-        double qdc = TraceFunctions::CalculateQdc(traceNoBaseline, waveformRange);
-
         //Now we are going to set all the different values into the trace.
-        trace.SetQdc(qdc);
         trace.SetBaseline(baseline);
+        trace.SetQdc(baselineAndQdc.qdc);
         trace.SetMax(max);
         trace.SetExtrapolatedMax(make_pair(max.first,
                                            TraceFunctions::ExtrapolateMaximum(trace, max).first - baseline.first));
-        trace.SetTraceSansBaseline(traceNoBaseline);
         trace.SetWaveformRange(waveformRange);
         trace.SetHasValidAnalysis(true);
     } catch (range_error &ex) {
@@ -25,13 +25,13 @@ public:
     /** Gets the built bar map. If you have used the default constructor
      * you must call the BuildBars method <strong> first </strong>.
      * \return A BarMap of the bars having traces. */
-    BarMap GetBarMap(void) { return (hrtBars_); };
+    const BarMap &GetBarMap(void) const { return (hrtBars_); };
 
     /** Gets the built bar map. If you have used the default constructor
      * you must call the BuildBars method <strong> first </strong>.
      * \return A BarMap of the bars having no traces */
-    std::map<unsigned int, std::pair<double, double> >
-    GetLrtBarMap(void) { return (lrtBars_); };
+    const std::map<unsigned int, std::pair<double, double> > &
+    GetLrtBarMap(void) const { return (lrtBars_); };
 
     /** Builds BarDetectors from the individual channel maps. We make assumptions
 	that the bars are not going to be vastly out of order, such that the 
@@ -55,17 +55,18 @@ private:
     /** Clears out the data maps from any previously built bars and ends */
     void ClearMaps(void);
 
-    /** Fills the ends of the detector into two separate maps. Things labeled
-     * {left, up,top} are filled into one map, and things labeled {right, down,bottom}
-     * are filled into another map. Currently these are the only six
-     * recognized end types that one may have, this can be expanded later if
-     * others should arise. */
+    /** Fills the ends of the detector into two arrays indexed by the bar
+     * number. Things labeled {left, up,top} are filled into one array, and
+     * things labeled {right, down,bottom} are filled into the other. Currently
+     * these are the only six recognized end types that one may have, this can
+     * be expanded later if others should arise. */
     void FillMaps(void);
 
     BarMap hrtBars_; //!< Map containing bars with high resolution timing..
     std::map<unsigned int, std::pair<double, double> > lrtBars_; //!<Map with low res bars
-    std::map<unsigned int, unsigned int> lefts_; //!< Map containing the left sides of bars
-    std::map<unsigned int, unsigned int> rights_; //!< Map containing the left sides of bars
+    std::vector<int> lefts_; //!< Index in list_ of the left side of each bar, -1 if there is none
+    std::vector<int> rights_; //!< Index in list_ of the right side of each bar, -1 if there is none
+    std::vector<unsigned int> barNumbers_; //!< The bar numbers that have at least one side in list_
     std::vector<ChanEvent *> list_; //!< Vector of events to build bars out of.
 };
 
@@ -16,60 +16,70 @@
 //! A class to handle detectors that have two readouts viewing the same volume
 class BarDetector {
 public:
+    /** The known types of bars, anything else is OTHER */
+    enum BarType {
+        OTHER, SMALL, MEDIUM, BIG
+    };
+
     /** Default constructor */
-    BarDetector() {};
+    BarDetector() : type_(OTHER), lengthInNs_(0), speedOfLightInCmPerNs_(0), calibration_(NULL) {};
 
     /** Default destructor */
     ~BarDetector() {};
 
-    /** \brief The constructor for the structure
+    /** \brief The constructor for the structure. The type of the bar, its
+    * length, speed of light and time calibration are resolved here once.
     * \param [in] Right : The right side of the bar
     * \param [in] Left : The left side of the bar
     * \param [in] key : The TimingIdentifier for the bar */
-    BarDetector(HighResTimingData Left, HighResTimingData Right,
-                TimingDefs::TimingIdentifier &key) {
-        left_ = Left;
-        right_ = Right;
-        key_ = key;
+    BarDetector(const HighResTimingData &Left, const HighResTimingData &Right,
+                const TimingDefs::TimingIdentifier &key) : right_(Right), left_(Left), key_(key) {
+        type_ = StringToBarType(key.second);
+        switch (type_) {
+            case SMALL:
+                lengthInNs_ = Globals::get()->GetVandleSmallLengthInNs();
+                speedOfLightInCmPerNs_ = Globals::get()->GetVandleSmallSpeedOfLightInCmPerNs();
+                break;
+            case MEDIUM:
+                lengthInNs_ = Globals::get()->GetVandleMediumLengthInNs();
+                speedOfLightInCmPerNs_ = Globals::get()->GetVandleMediumSpeedOfLightInCmPerNs();
+                break;
+            case BIG:
+                lengthInNs_ = Globals::get()->GetVandleBigLengthInNs();
+                speedOfLightInCmPerNs_ = Globals::get()->GetVandleBigSpeedOfLightInCmPerNs();
+                break;
+            default:
+                lengthInNs_ = speedOfLightInCmPerNs_ = 0;
+                break;
+        }
+        calibration_ = &TimingCalibrator::get()->GetCalibration(key);
+    }
+
+    /** \return The bar type for the provided subtype
+     * \param [in] a : The subtype of the bar, e.g. "small" */
+    static BarType StringToBarType(const std::string &a) {
+        if (a == "small")
+            return SMALL;
+        if (a == "medium")
+            return MEDIUM;
+        if (a == "big")
+            return BIG;
+        return OTHER;
     }
 
     /** \return the true if there was an event in the bar */
     bool GetHasEvent(void) const {
-        if (GetType() == "small") {
-            double lengthSmallTime = Globals::get()->GetVandleSmallLengthInNs();
-            return (fabs(GetTimeDifference()) < lengthSmallTime + 20 &&
-                    GetRightSide().GetIsValid() && GetLeftSide().GetIsValid());
-        } else if (GetType() == "big") {
-            double lengthBigTime = Globals::get()->GetVandleBigLengthInNs();
-            return (fabs(GetTimeDifference()) < lengthBigTime + 20 &&
-                    GetRightSide().GetIsValid() && GetLeftSide().GetIsValid());
-        } else if (GetType() == "medium") {
-            double lengthMediumTime =
-                    Globals::get()->GetVandleMediumLengthInNs();
-            return (fabs(GetTimeDifference()) < lengthMediumTime + 20 &&
-                    GetRightSide().GetIsValid() && GetLeftSide().GetIsValid());
-        }
+        if (type_ != OTHER && !(fabs(GetTimeDifference()) < lengthInNs_ + 20))
+            return false;
         return (GetRightSide().GetIsValid() && GetLeftSide().GetIsValid());
     }
 
     /** \return the flight path of the particle to the detector */
     double GetFlightPath(void) const {
-        if (GetType() == "small")
-            return (sqrt(GetCalibration().GetZ0() * GetCalibration().GetZ0() +
-                         pow(Globals::get()->GetVandleSmallSpeedOfLightInCmPerNs() *
-                             0.5 * GetTimeDifference() +
-                             GetCalibration().GetXOffset(), 2)));
-        else if (GetType() == "big")
-            return (sqrt(GetCalibration().GetZ0() * GetCalibration().GetZ0() +
-                         pow(Globals::get()->GetVandleBigSpeedOfLightInCmPerNs() *
-                             0.5 * GetTimeDifference() +
-                             GetCalibration().GetXOffset(), 2)));
-        else if (GetType() == "medium")
-            return (sqrt(GetCalibration().GetZ0() * GetCalibration().GetZ0() +
-                         pow(Globals::get()->GetVandleMediumSpeedOfLightInCmPerNs() *
-                             0.5 * GetTimeDifference() +
-                             GetCalibration().GetXOffset(), 2)));
-        return (std::numeric_limits<double>::quiet_NaN());
+        if (type_ == OTHER)
+            return (std::numeric_limits<double>::quiet_NaN());
+        return (sqrt(calibration_->GetZ0() * calibration_->GetZ0() +
+                     pow(speedOfLightInCmPerNs_ * 0.5 * GetTimeDifference() + calibration_->GetXOffset(), 2)));
     }
 
     /** \return the position independent qdc for the bar */
@@ -97,7 +107,7 @@ public:
     /** \return the timeDiff_ var */
     double GetTimeDifference() const {
         return ((left_.GetHighResTimeInNs() - right_.GetHighResTimeInNs()) +
-                GetCalibration().GetLeftRightTimeOffset());
+                calibration_->GetLeftRightTimeOffset());
     }
 
     /** \return The walk corrected time average */
@@ -110,7 +120,7 @@ public:
     double GetCorTimeDiff() const {
         return (left_.GetWalkCorrectedTime() -
                 right_.GetWalkCorrectedTime() +
-                GetCalibration().GetLeftRightTimeOffset());
+                calibration_->GetLeftRightTimeOffset());
     }
 
     /** \return the left_ var */
@@ -120,17 +130,22 @@ public:
     const HighResTimingData &GetRightSide() const { return (right_); }
 
     /** \return the type of bar detector */
-    std::string GetType() const { return (key_.second); }
+    const std::string &GetType() const { return (key_.second); }
+
+    /** \return the type of bar detector as a BarType */
+    BarType GetBarType() const { return (type_); }
 
     /** \return the time calibration var */
-    const TimingCalibration GetCalibration() const {
-        return (TimingCalibrator::get()->GetCalibration(key_));
-    }
+    const TimingCalibration &GetCalibration() const { return (*calibration_); }
 
 private:
     HighResTimingData right_; //!< The Right side of the detector
     HighResTimingData left_; //!< The Left side of the detector
     TimingDefs::TimingIdentifier key_; //!< The key for the detector 
+    BarType type_; //!< The type of the bar resolved from the subtype
+    double lengthInNs_; //!< The length of the bar in ns, from the Globals
+    double speedOfLightInCmPerNs_; //!< The speed of light in the bar, from the Globals
+    const TimingCalibration *calibration_; //!< The time calibration, owned by the TimingCalibrator
 };
 
 /** Defines a map to hold Bar Detectors */
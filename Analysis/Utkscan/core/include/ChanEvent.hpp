@@ -37,11 +37,11 @@ public:
 
     //! \return The channelConfiguration in the map for the channel event
     const ChannelConfiguration &GetChanID() const {
-        return DetectorLibrary::get()->at(GetModuleNumber(), GetChannelNumber());
+        return DetectorLibrary::get()->at(GetId());
     }
 
-    /** \return the channel id defined as pixie module # * 16 + channel number */
-    unsigned int GetID() const { return DetectorLibrary::get()->GetIndex(GetModuleNumber(), GetChannelNumber()); }
+    /** \return the dense channel id, see XiaData::GetId */
+    unsigned int GetID() const { return GetId(); }
 
     ///Equality operator, we only check to see if the module number, channel number, and times are equal.
     ///@param [in] rhs : the configuration to compare to
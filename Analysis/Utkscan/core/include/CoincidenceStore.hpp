@@ -0,0 +1,175 @@
+///@file CoincidenceStore.hpp
+///@brief Class that stores symmetric gamma-gamma or gamma-gamma-gamma coincidences as sparse cells and answers gate
+/// and project queries on them.
+///@date October 17, 2026
+#ifndef PAASS_COINCIDENCESTORE_HPP
+#define PAASS_COINCIDENCESTORE_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <stdint.h>
+
+class TH1D;
+class TH2D;
+
+///A class holding a symmetric coincidence matrix (dimension 2) or cube (dimension 3) of energies. Only the cells that
+/// were hit are kept, and each combination of bins is stored once with its bins in ascending order, so a matrix needs
+/// half and a cube a sixth of the cells of the dense histogram. Every cell costs a 64-bit key, holding the packed
+/// bin numbers, and a 32-bit count.
+///
+/// New coincidences are appended to a pending buffer. Once the buffer is full it is sorted and merged into the sorted
+/// cells, together with an index to the first cell of each lowest bin. The queries compact the store first.
+///
+/// The queries behave as if the coincidences were filled into the dense histogram in every order, the way that
+/// CloverProcessor::symplot fills the gamma-gamma matrices. A bin is inside a gate if its lower edge is at or below
+/// the high edge of the gate and its upper edge is above the low edge of the gate.
+class CoincidenceStore {
+public:
+    ///A gate on the energy, the low and high edges are given in the same units as the energies
+    typedef std::pair<double, double> Gate;
+
+    ///The version of the file format, files written with a different version are not loaded.
+    static const uint32_t version = 1;
+
+    ///The largest number of bins on each axis, the bin numbers are packed into 16 bits of the keys.
+    static const unsigned int maximumNumberOfBins = 65536;
+
+    ///Constructor
+    ///@param[in] dimension : The number of coincident energies in each entry, either 2 or 3
+    ///@param[in] numberOfBins : The number of bins on each axis
+    ///@param[in] binWidth : The width of a bin in the units of the energies
+    ///@param[in] pendingSize : The number of entries that are buffered before they are merged into the cells
+    ///@throws invalid_argument if the dimension, the number of bins or the bin width are out of range
+    CoincidenceStore(const unsigned int &dimension, const unsigned int &numberOfBins, const double &binWidth = 1.0,
+                     const size_t &pendingSize = 1 << 20);
+
+    ///Default destructor
+    ~CoincidenceStore() {}
+
+    ///Adds a pair of coincident energies to a store of dimension 2. Pairs outside of the axis are ignored.
+    ///@param[in] e1 : The first energy
+    ///@param[in] e2 : The second energy
+    void Add(const double &e1, const double &e2);
+
+    ///Adds a triple of coincident energies to a store of dimension 3. Triples outside of the axis are ignored.
+    ///@param[in] e1 : The first energy
+    ///@param[in] e2 : The second energy
+    ///@param[in] e3 : The third energy
+    void Add(const double &e1, const double &e2, const double &e3);
+
+    ///Removes all of the entries
+    void Clear();
+
+    ///Merges the pending entries into the sorted cells
+    void Compact();
+
+    ///@return The number of coincidences in each entry
+    unsigned int GetDimension() const { return dimension_; }
+
+    ///@return The number of bins on each axis
+    unsigned int GetNumberOfBins() const { return numberOfBins_; }
+
+    ///@return The width of a bin in the units of the energies
+    double GetBinWidth() const { return binWidth_; }
+
+    ///@return The number of occupied cells, the pending entries are not counted
+    size_t GetNumberOfCells() const { return keys_.size(); }
+
+    ///@return The number of entries that were added
+    unsigned long long GetNumberOfEntries() const { return numberOfEntries_; }
+
+    ///@return The number of bytes held by the cells, the index and the pending buffer
+    size_t GetMemoryUsage() const;
+
+    ///Projects the whole matrix onto one axis. For dimension 3 this is the projection of the cube on one axis.
+    ///@return The projection, one value per bin
+    std::vector<double> Project();
+
+    ///Projects the matrix onto one axis with a gate on the other axis. This is only allowed for dimension 2.
+    ///@param[in] gate : The gate on the other axis
+    ///@return The projection, one value per bin
+    ///@throws logic_error if the store has dimension 3
+    std::vector<double> Project(const Gate &gate);
+
+    ///Projects the cube onto one axis with gates on the other two axes. This is only allowed for dimension 3.
+    ///@param[in] gate1 : The gate on the first of the other axes
+    ///@param[in] gate2 : The gate on the second of the other axes
+    ///@return The projection, one value per bin
+    ///@throws logic_error if the store has dimension 2
+    std::vector<double> Project(const Gate &gate1, const Gate &gate2);
+
+    ///Cuts a slice out of the cube with a gate on one axis. This is only allowed for dimension 3.
+    ///@param[in] gate : The gate on the axis that we cut
+    ///@return A store of dimension 2 with the coincidences on the two other axes
+    ///@throws logic_error if the store has dimension 2
+    CoincidenceStore Slice(const Gate &gate);
+
+    ///Fills a projection into a new ROOT histogram with the binning of the store. The caller owns the histogram.
+    ///@param[in] projection : The projection, see Project
+    ///@param[in] name : The name of the histogram
+    ///@param[in] title : The title of the histogram
+    ///@return A pointer to the new histogram
+    TH1D *ToHistogram(const std::vector<double> &projection, const std::string &name, const std::string &title) const;
+
+    ///Fills the whole matrix into a new ROOT histogram, e.g. after cutting a slice. This is only allowed for
+    /// dimension 2. The caller owns the histogram.
+    ///@param[in] name : The name of the histogram
+    ///@param[in] title : The title of the histogram
+    ///@return A pointer to the new histogram
+    ///@throws logic_error if the store has dimension 3
+    TH2D *ToHistogram(const std::string &name, const std::string &title);
+
+    ///Loads the store from a file. The entries that we already hold are replaced only if the load succeeds.
+    ///@param[in] fileName : The name of the file that holds the store
+    ///@return True if the file exists, has the current version, the same dimension and binning as this store, and
+    /// could be read completely
+    bool Load(const std::string &fileName);
+
+    ///Writes the store to a file. The file is written under a temporary name and renamed once it is complete.
+    ///@param[in] fileName : The name of the file that will hold the store
+    ///@return True if the file was written
+    bool Save(const std::string &fileName);
+
+private:
+    ///A range of bins, both ends are included. The range is empty if the first bin is larger than the second.
+    typedef std::pair<unsigned int, unsigned int> BinRange;
+
+    ///@param[in] energy : The energy that we want to bin
+    ///@param[out] bin : The bin of the energy
+    ///@return True if the energy is on the axis
+    bool ToBin(const double &energy, unsigned int &bin) const;
+
+    ///@param[in] gate : The gate that we want to convert
+    ///@return The bins that are inside the gate
+    BinRange ToBinRange(const Gate &gate) const;
+
+    ///Appends a key to the pending buffer, compacting the store if the buffer is full.
+    ///@param[in] key : The packed bins of the entry, in ascending order with the lowest bin in the highest bits
+    void AddKey(const uint64_t &key);
+
+    ///@param[in] key : The key of a cell
+    ///@param[in] axis : The index of the bin in the key, 0 is the lowest bin
+    ///@return The bin on that axis
+    unsigned int GetBin(const uint64_t &key, const unsigned int &axis) const {
+        return (unsigned int) ((key >> (16 * (dimension_ - 1 - axis))) & 0xFFFF);
+    }
+
+    ///Rebuilds the index to the first cell of each lowest bin
+    void BuildIndex();
+
+    unsigned int dimension_; ///< The number of coincident energies in each entry
+    unsigned int numberOfBins_; ///< The number of bins on each axis
+    double binWidth_; ///< The width of a bin
+    size_t pendingSize_; ///< The number of entries that we buffer before compacting
+    unsigned long long numberOfEntries_; ///< The number of entries that were added
+
+    std::vector<uint64_t> keys_; ///< The sorted keys of the occupied cells
+    std::vector<uint32_t> counts_; ///< The counts of the occupied cells
+    std::vector<size_t> index_; ///< The first cell of each lowest bin, with one extra element for the end
+    std::vector<uint64_t> pending_; ///< The keys of the entries that have not been merged yet
+};
+
+#endif //PAASS_COINCIDENCESTORE_HPP
@@ -0,0 +1,80 @@
+///@file ConfigurationCache.hpp
+///@brief Class that stores the resolved channel map of the configuration file in a versioned binary file so that
+/// later runs with the same configuration can skip resolving the Map node.
+///@date October 17, 2026
+#ifndef PAASS_CONFIGURATIONCACHE_HPP
+#define PAASS_CONFIGURATIONCACHE_HPP
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "ChannelConfiguration.hpp"
+
+///A class holding the fully resolved contents of the Map node : one record per channel with its configuration
+/// (including the locations that were assigned automatically), and the calibration and walk corrections of the
+/// channel. The records can be written to a binary file that is keyed by a hash of the configuration. Loading the
+/// file maps it into memory once and rebuilds the records, it fails if the file was written for a different
+/// configuration or by a different version of the cache.
+class ConfigurationCache {
+public:
+    ///Structure holding a calibration or walk correction as it was given in the configuration file
+    struct Correction {
+        std::string model; ///< The name of the model
+        double min; ///< The lower bound of the range of the correction
+        double max; ///< The upper bound of the range of the correction
+        std::vector<double> parameters; ///< The parameters of the model
+    };
+
+    ///Structure holding everything that the Map node defines for a single channel
+    struct ChannelRecord {
+        int module; ///< The module number counted over all of the crates
+        unsigned int channel; ///< The channel number inside of the module
+        ChannelConfiguration configuration; ///< The resolved configuration of the channel
+        std::vector<Correction> calibrations; ///< The energy calibrations of the channel
+        std::vector<Correction> walks; ///< The walk corrections of the channel
+    };
+
+    ///The version of the file format, files written with a different version are not loaded.
+    static const uint32_t version = 1;
+
+    ///Default constructor
+    ConfigurationCache() {}
+
+    ///Default destructor
+    ~ConfigurationCache() {}
+
+    ///Calculates the 64-bit FNV-1a hash of a string
+    ///@param[in] a : The string that we want to hash, usually the whole configuration file
+    ///@return The hash of the string
+    static uint64_t Hash(const std::string &a);
+
+    ///Adds a channel to the end of the cache
+    ///@param[in] a : The record of the channel
+    void Add(const ChannelRecord &a) { records_.push_back(a); }
+
+    ///Removes all of the records
+    void Clear() { records_.clear(); }
+
+    ///@return The records of the channels in the order that they were added
+    const std::vector<ChannelRecord> &GetRecords() const { return records_; }
+
+    ///Loads the records from a file. The records that we already hold are replaced only if the load succeeds.
+    ///@param[in] fileName : The name of the file that holds the cache
+    ///@param[in] key : The hash of the configuration that the cache must have been written for
+    ///@return True if the file exists, has the current version and key, and could be read completely
+    bool Load(const std::string &fileName, const uint64_t &key);
+
+    ///Writes the records to a file. The file is written under a temporary name and renamed once it is complete, so
+    /// that an interrupted write never leaves a partial cache behind.
+    ///@param[in] fileName : The name of the file that will hold the cache
+    ///@param[in] key : The hash of the configuration that the records came from
+    ///@return True if the file was written
+    bool Save(const std::string &fileName, const uint64_t &key) const;
+
+private:
+    std::vector<ChannelRecord> records_; ///< The records of the channels
+};
+
+#endif //PAASS_CONFIGURATIONCACHE_HPP
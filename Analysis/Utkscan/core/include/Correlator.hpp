@@ -11,6 +11,7 @@
 #include <vector>
 
 #include <cmath>
+#include <cstddef>
 
 #include "DammPlotIds.hpp"
 #include "Globals.hpp"
@@ -90,14 +91,27 @@ public:
 /*!
   \brief correlate decays with previous implants
 
-  The class controls the correlations of decays with previous implants.  There
-  are arrays of size MAX_STRIP %x MAX_STRIP that store implants and decays.
-  When an event has been identified as either an implant or decay, its
-  information is placed in the appropriate array based on its pixel location.
+  The class controls the correlations of decays with previous implants.  A
+  flat table of size xSize %x ySize stores the implants and decays for each
+  pixel. When an event has been identified as either an implant or decay, its
+  information is placed in the appropriate list based on its pixel location.
   If a decay was identified, it is correlated with a previous implant.  The
   correlator checks to make sure that the time between implants is
   sufficiently long and that the correlation time has not been exceeded
   before correlating an implant with a decay.
+
+  Pixels holding a chain are tracked in a live list so that operations over
+  the whole detector only visit occupied pixels. Implants are also entered
+  into a timing wheel with a slot width of corrTime / numWheelSlots. The wheel
+  is advanced with the event time, and chains whose implant is older than the
+  correlation time are expired as their slot comes around, without scanning
+  the detector. Each implant is touched once by the wheel, so the cost per
+  decay is O(1) amortized independent of the detector size.
+
+  The implant of an expired chain is kept until the next event in its pixel.
+  A decay that arrives after the wheel expired the chain is reported once as
+  DECAY_TOO_LATE, exactly as if it had found the chain itself, and an implant
+  still sees the expired implant as a BACK_TO_BACK_IMPLANT.
 */
 class Correlator {
 public:
@@ -115,6 +129,11 @@ public:
     /** Default Constructor */
     Correlator();
 
+    /** Constructor taking the size of the detector
+     * \param [in] xSize : the number of front strips
+     * \param [in] ySize : the number of back strips */
+    Correlator(const unsigned int &xSize, const unsigned int &ySize);
+
     /** Default Destructor */
     virtual ~Correlator();
 
@@ -149,6 +168,18 @@ public:
      * \param [in] fch : the locations to correlate with */
     void CorrelateAllY(EventInfo &event, unsigned int fch);
 
+    /** Correlates the event with the most recent implant found in the
+     * neighbourhood of the given pixel. This is useful when the decay and
+     * implant are not reconstructed in the same pixel due to charge sharing
+     * between strips.
+     * \param [in] event : the event to correlate with
+     * \param [in] fch : the front strip of the event
+     * \param [in] bch : the back strip of the event
+     * \param [in] radius : the number of strips to search on each side
+     * \return true if an implant was found in the neighbourhood */
+    bool CorrelateNeighbourhood(EventInfo &event, unsigned int fch,
+                                unsigned int bch, unsigned int radius = 1);
+
     /** Print the decay list
      * \param [in] fch : the first location to print
      * \param [in] bch : the second location to print  */
@@ -186,6 +217,15 @@ public:
         return condition;
     }
 
+    /** \return The number of pixels that currently hold a chain */
+    unsigned int GetNumberOfLiveChains(void) const {
+        return (unsigned int) livePixels_.size();
+    }
+
+    /** \return The approximate number of bytes held by the correlator,
+     * including the storage of the live chains */
+    size_t GetMemoryFootprint(void) const;
+
 private:
     Plots histo; //!< Instance of the Plots class
 
@@ -218,7 +258,8 @@ private:
         histo.DeclareHistogram2D(dammId, xSize, ySize, title);
     }
 
-    static const size_t arraySize = 40; /**< Size of the 2D array to hold the decay lists */
+    static const unsigned int defaultArraySize = 40; /**< Default number of strips on each side */
+    static const unsigned int numWheelSlots = 256; /**< Number of slots in the expiry timing wheel */
 
     static const double minImpTime; /**< The minimum amount of time that must
 				       pass before an implant will be considered
@@ -229,11 +270,54 @@ private:
     static const double fastTime;   /**< Times shorter than this are output as
                                          a fast decay */
 
-    EventInfo *lastImplant;  ///< last implant processed by correlator
-    EventInfo *lastDecay;    ///< last decay procssed by correlator
+    double lastImplantTime;  ///< time of the last implant processed by correlator
+    double lastDecayTime;    ///< decay time of the last decay procssed by correlator
 
     EConditions condition;     ///< condition for last processed event
-    CorrelationList decaylist[arraySize][arraySize]; ///< list of event data for a particular pixel since implant
+
+    unsigned int xSize_; ///< number of front strips
+    unsigned int ySize_; ///< number of back strips
+    std::vector<CorrelationList> decaylist_; ///< list of event data for a particular pixel since implant
+    std::vector<EventInfo> expiredImplants_; ///< implant of the chain that the wheel expired, NAN time if none
+
+    std::vector<unsigned int> livePixels_; ///< pixels that currently hold a chain
+    std::vector<int> livePosition_; ///< position of each pixel in livePixels_, -1 if not live
+    std::vector<unsigned int> scratch_; ///< copy of the live pixels used while iterating
+
+    double wheelSlotWidth_; ///< width of a slot in the timing wheel in clock ticks
+    long long wheelTick_; ///< the last slot of the wheel that was expired
+    std::vector<std::vector<std::pair<unsigned int, double> > > wheel_; ///< pixels and implant times for each slot
+
+    /** Initializes the tables for the given detector size */
+    void Initialize(void);
+
+    /** \return the index of the pixel in the flat tables */
+    unsigned int GetPixel(const unsigned int &fch, const unsigned int &bch) const {
+        return fch * ySize_ + bch;
+    }
+
+    /** Adds a pixel to the list of live pixels
+     * \param [in] pixel : the pixel to add */
+    void AddLivePixel(const unsigned int &pixel);
+
+    /** Clears the chain in the pixel and removes it from the list of live
+     * pixels. Flagged chains are printed before they are cleared.
+     * \param [in] pixel : the pixel to clear */
+    void ClearPixel(const unsigned int &pixel);
+
+    /** Clears all of the live chains and resets the timing wheel. */
+    void ClearAll(void);
+
+    /** Schedules the expiry of an implant in the timing wheel
+     * \param [in] pixel : the pixel of the implant
+     * \param [in] time : the time of the implant in clock ticks */
+    void ScheduleExpiry(const unsigned int &pixel, const double &time);
+
+    /** Advances the timing wheel to the given time, expiring the chains whose
+     * implant is older than the correlation time. A time far before the
+     * wheel is taken as a reset of the clock and clears everything.
+     * \param [in] time : the current time in clock ticks */
+    void AdvanceWheel(const double &time);
 };
 
 #endif // __CORRELATOR_PROCESSOR_HPP_
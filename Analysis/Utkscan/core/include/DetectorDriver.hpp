@@ -38,6 +38,8 @@
 #include <utility>
 #include <vector>
 
+#include <stdint.h>
+
 #include "Calibrator.hpp"
 #include "ChanEvent.hpp"
 #include "Globals.hpp"
@@ -47,6 +49,8 @@
 
 class Calibration;
 
+class ColumnarWriter;
+
 class RawEvent;
 
 class EventProcessor;
@@ -167,12 +171,45 @@ private:
     DetectorDriver &operator=(DetectorDriver const &);//!< Equality constructor
     static DetectorDriver *instance;//!< The only instance of DetectorDriver
 
+    /** Builds the chain of trace analyzers for every channel in the map. A
+     * chain keeps the order of the configuration file and only holds the
+     * analyzers whose AppliesTo accepts the channel, so the traces of a
+     * channel that no analyzer wants skip the analysis entirely. Channels
+     * that are not set in the map yet have no plan, they get every analyzer
+     * if they are set later. */
+    void BuildAnalyzerPlans(void);
+
+    /** Assigns a bit to every used detector type and builds the masks of the
+     * channels and the processors. A processor only runs when the mask of the
+     * event shares a bit with its mask, which is what HasEvent checks with
+     * the detector summaries.
+     * \throw PaassException if there are more detector types than bits */
+    void BuildTypeMasks(void);
+
+    /** Orders the processors so that every processor comes after the
+     * processors listed in its dependencies. Processors without a dependency
+     * between them keep the order of the configuration file.
+     * \throw PaassException if the dependencies form a cycle */
+    void ScheduleProcessors(void);
+
     std::vector<EventProcessor *> vecProcess; /**< vector of processors to handle each event */
+    std::vector<EventProcessor *> columnarProcessors_; /**< The processors that
+                   added columns to the columnar output */
+    ColumnarWriter *columnarWriter_; /**< The writer of the columnar output,
+                   NULL unless it was requested in the configuration */
 
     std::vector<TraceAnalyzer *> vecAnalyzer; /**< object which analyzes traces of channels to extract
                    energy and time information */
+    std::vector<std::vector<TraceAnalyzer *> > analyzerPlans_; /**< The
+                   analyzers that apply to each channel, by channel index */
+    std::vector<bool> hasAnalyzerPlan_; /**< True for the channels that were
+                   set in the map when the plans were built */
     std::set<std::string> knownDetectors; /**< list of valid detectors that can
                    be used as detector types */
+    std::vector<uint64_t> channelMasks_; /**< The bit of the detector type of
+                   each channel, zero for channels that are not summarized */
+    std::vector<uint64_t> processorMasks_; /**< The bits of the detector types
+                   that each processor in vecProcess operates on */
     std::string cfg_; //!< The configuration file to read
     std::pair<double, time_t> pixieToWallClock; /**< rough estimate of pixie to wall clock */
 };
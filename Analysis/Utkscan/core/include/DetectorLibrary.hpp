@@ -72,8 +72,9 @@ public:
      * \return the id for the locaton */
     unsigned int GetNextLocation(const std::string &type, const std::string &subtype) const;
 
-    /** Get the index for a given module and channel
-     * \param [in] mod : the module number
+    /** Get the index for a given module and channel. The index is the same as
+     * the one returned by XiaData::GetId.
+     * \param [in] mod : the module number counted over all of the crates
      * \param [in] chan : the channel number
      * \return the index for a given module, channel */
     unsigned int GetIndex(int mod, int chan) const;
@@ -105,6 +106,11 @@ public:
      * \return true if it has a value at the given mod,chan */
     bool HasValue(int index) const;
 
+    /** Builds a mask of the channels that we want the unpacker to keep. A
+     * channel is kept if it is defined in the map and isn't typed "ignore".
+     * \return The keep mask indexed like XiaData::GetId */
+    std::vector<bool> GetKeepMask() const;
+
     /** Check that the detector is in the list and kill if it's not
      * \param [in] index : the index to look for
      * \param [in] value : the value to check for */
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -20,6 +21,7 @@
 #include "PaassExceptions.hpp"
 #include "Messenger.hpp"
 #include "TrapFilterParameters.hpp"
+#include "XiaTopology.hpp"
 
 ///! Namespace defining some information for Timing related stuff
 namespace TimingDefs {
@@ -48,6 +50,9 @@ public:
     ///@return the adc clock in seconds 
     double GetAdcClockInSeconds() const { return adcClockInSeconds_; }
 
+    ///@return The DAMM banana file that Plots::BananaTest reads when we don't use the HRIBF libraries
+    std::string GetBananaFileName() const { return bananaFile_; }
+
     ///@return the pixie clock in seconds 
     double GetClockInSeconds() const { return clockInSeconds_; }
 
@@ -57,6 +62,9 @@ public:
     ///@return the event size in seconds
     double GetEventLengthInSeconds() const { return eventLengthInSeconds_; }
 
+    ///@return The number of rows in each chunk of the columnar output
+    unsigned int GetColumnarRowsPerChunk() const { return columnarRowsPerChunk_; }
+
     ///@return the event width
     unsigned int GetEventLengthInTicks() const { return eventLengthInTicks_; }
 
@@ -73,7 +81,7 @@ public:
     std::string GetPixieRevision() const { return revision_; }
 
     ///@return rejection regions to exclude from scan.
-    std::vector<std::pair<unsigned int, unsigned int> > GetRejectionRegions() const { return reject_; }
+    const std::vector<std::pair<unsigned int, unsigned int> > &GetRejectionRegions() const { return reject_; }
 
     ///@return the frequency of the system clock in Hz
     double GetSystemClockFreqInHz() const { return sysClockFreqInHz_; }
@@ -96,20 +104,84 @@ public:
     ///@return the speed of light in the small VANDLE bars in cm/ns
     double GetVandleSmallSpeedOfLightInCmPerNs() const { return vandleSmallSpeedOfLight_; }
 
+    ///@return The clock offset (in clock ticks) and drift (in ticks per tick) of the merged sources, keyed by the
+    /// index of the source.
+    const std::map<unsigned int, std::pair<double, double>> &GetClockCorrections() const { return clockCorrections_; }
+
+    ///@return How far back in clock ticks a spill has to start before we treat it as a clock reset
+    double GetClockResetThresholdInTicks() const { return clockResetThresholdInTicks_; }
+
+    ///@return The width of the re-ordering buffer for the hits in clock ticks
+    double GetReorderWindowInTicks() const { return reorderWindowInTicks_; }
+
+    ///@return The pre and post trigger windows (in clock ticks) of the detector types that aren't listed in the
+    /// EventBuilder node
+    const std::pair<double, double> &GetDefaultEventWindow() const { return defaultEventWindow_; }
+
+    ///@return The pre and post trigger windows (in clock ticks) keyed by detector type
+    const std::map<std::string, std::pair<double, double>> &GetEventWindows() const { return eventWindows_; }
+
+    ///@return The detector types that trigger events. Events are built with the event width if this is empty.
+    const std::set<std::string> &GetTriggerTypes() const { return triggerTypes_; }
+
+    ///@return The maximum number of hits buffered per source when merging sources
+    unsigned int GetMaximumMergeBufferedHits() const { return maxMergeBufferedHits_; }
+
+    ///@return The crate, module and channel layout of the system
+    const XiaTopology &GetTopology() const { return topology_; }
+
+    ///@return The number of bytes of histogram contents that a single ROOT flush may copy, zero for no limit
+    size_t GetRootFlushBudgetInBytes() const { return rootFlushBudgetInBytes_; }
+
+    ///@return The time in seconds between two flushes of the ROOT files
+    double GetRootFlushIntervalInSeconds() const { return rootFlushIntervalInSeconds_; }
+
+    ///@return The ROOT compression settings of the trees that have their own, by the name of the tree
+    const std::map<std::string, int> &GetTreeCompressionSettings() const { return treeCompressionSettings_; }
+
+    ///@return The number of threads that compress the baskets of the trees, 1 for no implicit multi-threading
+    unsigned int GetTreeCompressionThreads() const { return treeCompressionThreads_; }
+
+    ///@return The number of entries that may wait for the tree writer thread
+    unsigned int GetTreeQueueSize() const { return treeQueueSize_; }
+
+    ///@return true if the processors write their branches into a columnar file
+    bool HasColumnarOutput() const { return hasColumnarOutput_; }
+
+    ///@return true if the columns of the columnar output are compressed
+    bool IsColumnarOutputCompressed() const { return isColumnarOutputCompressed_; }
+
     ///@return true if any reject region was defined
     bool HasRejectionRegion() const { return !reject_.empty(); }
 
     ///@return true if we will define the raw histograms
     bool HasRawHistogramsDefined() const { return hasRawHistogramsDefined_; }
 
+    ///@return true if the traces, QDCs and energy sums are only decoded when requested
+    bool HasLazyDecoding() const { return hasLazyDecoding_; }
+
     ///Sets the Pixie-16 ADC clock speed in seconds.
     ///@param[in] a : The parameter that we are going to set
     void SetAdcClockInSeconds(const double &a) { adcClockInSeconds_ = a; }
 
+    ///Sets the DAMM banana file that Plots::BananaTest reads when we don't use the HRIBF libraries
+    ///@param[in] a : The name of the file
+    void SetBananaFileName(const std::string &a) { bananaFile_ = a; }
+
     ///Sets the speed Pixie-16 clock in seconds.
     ///@param[in] a : The parameter that we are going to set
     void SetClockInSeconds(const double &a) { clockInSeconds_ = a; }
 
+    ///Sets the layout of the columnar output, see ColumnarWriter
+    ///@param[in] hasOutput : True if the processors write their branches into a columnar file
+    ///@param[in] rowsPerChunk : The number of rows in each chunk
+    ///@param[in] isCompressed : True if the columns are compressed
+    void SetColumnarOutput(const bool &hasOutput, const unsigned int &rowsPerChunk, const bool &isCompressed) {
+        hasColumnarOutput_ = hasOutput;
+        columnarRowsPerChunk_ = rowsPerChunk;
+        isColumnarOutputCompressed_ = isCompressed;
+    }
+
     ///Sets the event length in seconds that we will use to create events.
     ///@param[in] a : The parameter that we are going to set
     void SetEventLengthInSeconds(const double &a) { eventLengthInSeconds_ = a; }
@@ -126,6 +198,73 @@ public:
     ///@param[in] a : The parameter that we are going to set
     void SetHasRawHistogramsDefined(const bool &a) { hasRawHistogramsDefined_ = a; }
 
+    ///Sets a flag that controls if we defer decoding the traces, QDCs and energy sums until they are requested.
+    ///@param[in] a : The parameter that we are going to set
+    void SetHasLazyDecoding(const bool &a) { hasLazyDecoding_ = a; }
+
+    ///Sets the clock correction of one of the merged sources
+    ///@param[in] source : The index of the source
+    ///@param[in] offset : The clock offset in clock ticks
+    ///@param[in] drift : The clock drift in ticks per tick
+    void SetClockCorrection(const unsigned int &source, const double &offset, const double &drift) {
+        clockCorrections_[source] = std::make_pair(offset, drift);
+    }
+
+    ///Sets how far back in clock ticks a spill has to start before we treat it as a clock reset
+    ///@param[in] a : The parameter that we are going to set
+    void SetClockResetThresholdInTicks(const double &a) { clockResetThresholdInTicks_ = a; }
+
+    ///Sets the width of the re-ordering buffer for the hits in clock ticks
+    ///@param[in] a : The parameter that we are going to set
+    void SetReorderWindowInTicks(const double &a) { reorderWindowInTicks_ = a; }
+
+    ///Sets the pre and post trigger windows of the detector types that don't have their own
+    ///@param[in] pre : The window before the trigger in clock ticks
+    ///@param[in] post : The window after the trigger in clock ticks
+    void SetDefaultEventWindow(const double &pre, const double &post) { defaultEventWindow_ = std::make_pair(pre, post); }
+
+    ///Sets the pre and post trigger windows of a detector type
+    ///@param[in] type : The detector type from the Map
+    ///@param[in] pre : The window before the trigger in clock ticks
+    ///@param[in] post : The window after the trigger in clock ticks
+    ///@param[in] isTrigger : True if hits from this type start events
+    void SetEventWindow(const std::string &type, const double &pre, const double &post, const bool &isTrigger) {
+        eventWindows_[type] = std::make_pair(pre, post);
+        if (isTrigger)
+            triggerTypes_.insert(type);
+    }
+
+    ///Sets the maximum number of hits buffered per source when merging sources
+    ///@param[in] a : The parameter that we are going to set
+    void SetMaximumMergeBufferedHits(const unsigned int &a) { maxMergeBufferedHits_ = a; }
+
+    ///Sets the number of bytes of histogram contents that a single ROOT flush may copy
+    ///@param[in] a : The budget in bytes, zero for no limit
+    void SetRootFlushBudgetInBytes(const size_t &a) { rootFlushBudgetInBytes_ = a; }
+
+    ///Sets the time between two flushes of the ROOT files
+    ///@param[in] a : The interval in seconds
+    void SetRootFlushIntervalInSeconds(const double &a) { rootFlushIntervalInSeconds_ = a; }
+
+    ///Sets the ROOT compression settings of a tree
+    ///@param[in] tree : The name of the tree
+    ///@param[in] settings : The settings, 100 * algorithm + level
+    void SetTreeCompressionSettings(const std::string &tree, const int &settings) {
+        treeCompressionSettings_[tree] = settings;
+    }
+
+    ///Sets the number of threads that compress the baskets of the trees
+    ///@param[in] a : The number of threads, 0 lets ROOT decide and 1 disables implicit multi-threading
+    void SetTreeCompressionThreads(const unsigned int &a) { treeCompressionThreads_ = a; }
+
+    ///Sets the number of entries that may wait for the tree writer thread
+    ///@param[in] a : The size of the queue
+    void SetTreeQueueSize(const unsigned int &a) { treeQueueSize_ = a; }
+
+    ///Sets the crate, module and channel layout of the system
+    ///@param[in] a : The parameter that we are going to set
+    void SetTopology(const XiaTopology &a) { topology_ = a; }
+
     ///Sets output Filename from scan interface
     ///@param[in] a : The parameter that we are going to set
     void SetOutputFilename(const std::string &a) { outputFilename_ = a; }
@@ -175,17 +314,35 @@ private:
     void InitializeMemberVariables(void);
 
     double adcClockInSeconds_; //!< adc clock in second
+    std::string bananaFile_; //!< The DAMM banana file for Plots::BananaTest
     double clockInSeconds_;//!< the ACQ clock in seconds
+    unsigned int columnarRowsPerChunk_; //!< The number of rows in each chunk of the columnar output
     std::string configFile_; //!< The configuration file
     double eventLengthInSeconds_;//!< event width in seconds
     unsigned int eventLengthInTicks_; //!< the size of the events
     double filterClockInSeconds_;//!< filter clock in seconds
     bool hasRawHistogramsDefined_; //!< True if we are plotting Raw Histograms
+    bool hasLazyDecoding_; //!< True if we defer decoding of the payload of each hit
+    bool hasColumnarOutput_; //!< True if the processors write their branches into a columnar file
+    bool isColumnarOutputCompressed_; //!< True if the columns of the columnar output are compressed
     std::string outputFilename_; //!<Output Filename
     std::string outputPath_; //!< The path to additional configuration files
     std::string revision_; //!< the pixie revision
     double sysClockFreqInHz_; //!< frequency of the system clock
     std::vector<std::pair<unsigned int, unsigned int>> reject_; ///< Rejection regions
+    XiaTopology topology_; ///< The crate, module and channel layout of the system
+    std::map<unsigned int, std::pair<double, double>> clockCorrections_; ///< Clock offset and drift of merged sources
+    unsigned int maxMergeBufferedHits_; ///< Maximum number of hits buffered per merged source
+    double reorderWindowInTicks_; ///< Width of the re-ordering buffer in clock ticks
+    std::map<std::string, std::pair<double, double>> eventWindows_; ///< Pre and post trigger windows per type
+    std::pair<double, double> defaultEventWindow_; ///< Pre and post trigger windows of the other types
+    std::set<std::string> triggerTypes_; ///< The detector types that trigger events
+    double clockResetThresholdInTicks_; ///< Backwards jump in clock ticks that starts a new time epoch
+    size_t rootFlushBudgetInBytes_; ///< Bytes of histogram contents that a ROOT flush may copy, zero for no limit
+    double rootFlushIntervalInSeconds_; ///< Time between two flushes of the ROOT files
+    std::map<std::string, int> treeCompressionSettings_; ///< ROOT compression settings by the name of the tree
+    unsigned int treeCompressionThreads_; ///< Threads compressing the baskets of the trees
+    unsigned int treeQueueSize_; ///< Entries that may wait for the tree writer thread
     double vandleBigSpeedOfLight_;//!< speed of light in big VANDLE bars in cm/ns
     double vandleMediumSpeedOfLight_;//!< speed of light in medium VANDLE bars in cm/ns
     double vandleSmallSpeedOfLight_;//!< speed of light in small VANDLE bars in cm/ns
@@ -31,6 +31,13 @@ public:
     ///@return The text that was contained in the node.
     std::string ParseDescriptionNode(const pugi::xml_node &node);
 
+    ///Parses the EventBuilder node from the xml configuration file.
+    ///@param[in] node : The node that we are going to parse
+    ///@param[in] globals : A pointer to the globals class so we can set the
+    /// values that we need.
+    ///@throw invalid_argument if there is no Trigger node or a node is missing the type
+    void ParseEventBuilder(const pugi::xml_node &node, Globals *globals);
+
     ///Parses the Global node from the xml configuration file.
     ///@param[in] node : The node that we are going to parse
     ///@param[in] globals : A pointer to the globals class so we can set the
@@ -40,6 +47,11 @@ public:
     ///@throw invalid_argument if the Revision is missing.
     void ParseGlobalNode(const pugi::xml_node &node, Globals *globals);
 
+    ///Parses the TreeOutput node from the xml configuration file.
+    ///@param[in] node : The node that we are going to parse
+    ///@param[in] globals : The instance of the globals class that we're going to fill.
+    void ParseTreeOutput(const pugi::xml_node &node, Globals *globals);
+
     ///Parses the Reject node from the xml configuration file.
     ///@param[in] node : The node that we are going to parse
     ///@return The vector containing all of the rejection regions
@@ -12,17 +12,48 @@
 
 //! Class for holding information for high resolution timing. All times more
 //! precise than the filter time will be in nanoseconds (phase, highResTime).
-class HighResTimingData : public ChanEvent {
+//! The class only refers to the channel event that it was built from, so the
+//! channel event must live as long as this object, i.e. until the raw event
+//! is zeroed.
+class HighResTimingData {
 public:
     /** Default constructor */
-    HighResTimingData() {};
+    HighResTimingData() : chan_(NULL) {};
 
     /** Default destructor */
     virtual ~HighResTimingData() {};
 
     /** Constructor using the channel event
-    * \param [in] chan : the channel event for grabbing values from */
-    HighResTimingData(ChanEvent &evt) : ChanEvent(evt) {}
+    * \param [in] evt : the channel event for grabbing values from */
+    HighResTimingData(const ChanEvent &evt) : chan_(&evt) {}
+
+    /** Constructor using a pointer to the channel event
+    * \param [in] evt : the channel event for grabbing values from */
+    HighResTimingData(const ChanEvent *evt) : chan_(evt) {}
+
+    /** \return The channel event that this object refers to */
+    const ChanEvent &GetChanEvent() const { return *chan_; }
+
+    /** \return The configuration of the channel */
+    const ChannelConfiguration &GetChanID() const { return chan_->GetChanID(); }
+
+    /** \return The calibrated energy of the channel */
+    double GetCalibratedEnergy() const { return chan_->GetCalibratedEnergy(); }
+
+    /** \return The energy calculated by the module */
+    double GetEnergy() const { return chan_->GetEnergy(); }
+
+    /** \return The high resolution time of the channel in ns */
+    double GetHighResTimeInNs() const { return chan_->GetHighResTimeInNs(); }
+
+    /** \return The time of the channel in clock ticks */
+    double GetTime() const { return chan_->GetTime(); }
+
+    /** \return The trace of the channel */
+    const Trace &GetTrace() const { return chan_->GetTrace(); }
+
+    /** \return The walk corrected time of the channel */
+    double GetWalkCorrectedTime() const { return chan_->GetWalkCorrectedTime(); }
 
     /** Calculate the energy from the time of flight, using a correction
     * \param [in] tof : The time of flight to use for the calculation in ns
@@ -103,6 +134,9 @@ public:
         s.qdc = -9999.;
         s.id = 9999;
     }
+
+private:
+    const ChanEvent *chan_; //!< The channel event that holds the data, owned by the RawEvent
 };
 
 /** Defines a map to hold timing data for a channel. */
@@ -0,0 +1,53 @@
+///@file LineGateIndex.hpp
+///@brief Class that finds all of the line gates containing a value with a single binary search.
+///@date October 17, 2026
+#ifndef PAASS_LINEGATEINDEX_HPP
+#define PAASS_LINEGATEINDEX_HPP
+
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <stdint.h>
+
+///A class holding up to 64 line gates, i.e. closed intervals [min, max]. The edges of all of the gates are sorted
+/// once, and each edge and each interval between two edges keeps a mask of the gates containing it. Checking a
+/// value against every gate is then a binary search over the edges instead of a loop over the gates.
+class LineGateIndex {
+public:
+    ///The largest number of gates that fit into a mask
+    static const size_t maximumNumberOfGates = 64;
+
+    ///Default constructor, the index holds no gates
+    LineGateIndex() {}
+
+    ///Constructor
+    ///@param[in] gates : The limits of the gates, the order of the limits of a gate does not matter. Gate i sets
+    /// bit i of the masks.
+    ///@throws invalid_argument if there are more than 64 gates
+    LineGateIndex(const std::vector<std::pair<double, double> > &gates);
+
+    ///Default destructor
+    ~LineGateIndex() {}
+
+    ///@param[in] value : The value that we check
+    ///@return The mask of the gates containing the value, bit i is set if min_i <= value <= max_i
+    uint64_t GetMask(const double &value) const;
+
+    ///@return The number of gates in the index
+    size_t GetNumberOfGates() const { return numberOfGates_; }
+
+    ///Checks a number of values at once
+    ///@param[in] values : The values that we check
+    ///@param[in] numberOfValues : The number of values
+    ///@param[out] masks : The mask of each value, resized to the number of values
+    void Test(const double *values, const size_t &numberOfValues, std::vector<uint64_t> &masks) const;
+
+private:
+    size_t numberOfGates_ = 0; ///< The number of gates
+    std::vector<double> edges_; ///< The sorted edges of the gates without duplicates
+    std::vector<uint64_t> atEdge_; ///< The gates containing each edge
+    std::vector<uint64_t> aboveEdge_; ///< The gates containing the values between an edge and the next one
+};
+
+#endif //PAASS_LINEGATEINDEX_HPP
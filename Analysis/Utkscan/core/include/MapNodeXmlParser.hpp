@@ -7,6 +7,7 @@
 
 #include "Calibrator.hpp"
 #include "ChannelConfiguration.hpp"
+#include "ConfigurationCache.hpp"
 #include "DetectorLibrary.hpp"
 #include "Messenger.hpp"
 #include "TimingConfiguration.hpp"
@@ -43,11 +44,21 @@ private:
     ///A WalkCorrector object that contains the parsed walk corrections.
     WalkCorrector walkCorrector_;
 
-    ///Method to parse the Calibration node from the XML file.
-    ///@param[in] node : The calibration node that we want to parse
-    ///@param[in] config : The channel configuration that we will use to hold all this info.
+    ///The resolved channels, written to the file named by the cache attribute of the Map node.
+    ConfigurationCache cache_;
+
+    ///Adds a resolved channel to the detector library, the calibrations and the TreeCorrelator.
+    ///@param[in] record : The channel that we are adding
+    ///@param[in] lib : The detector library that holds the channel configurations
+    ///@param[in] isVerboseTree : True if we want verbose messaging when creating the place
+    void ApplyRecord(const ConfigurationCache::ChannelRecord &record, DetectorLibrary *lib, const bool &isVerboseTree);
+
+    ///Method to parse the Calibration or Walk nodes from the XML file.
+    ///@param[in] node : The first calibration node that we want to parse
+    ///@param[out] corrections : The vector that we append the parsed corrections to
     ///@param[in] isVerbose : True if we want verbose messaging
-    void ParseCalibrations(const pugi::xml_node &node, const ChannelConfiguration &config, const bool &isVerbose);
+    void ParseCalibrations(const pugi::xml_node &node, std::vector<ConfigurationCache::Correction> &corrections,
+                           const bool &isVerbose);
 
     ///Parses the Cfd node from the xml configuration file.
     ///@param[in] node : The node that we are going to parse
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "PlotsRegister.hpp"
+#include "PolygonGate.hpp"
 #include "RootHandler.hpp"
 
 //! Holds pointers to all Histograms
@@ -139,6 +140,8 @@ public:
     /** Method to test if a parameter is inside of a loaded banana
     *
     * Will not help you defend against a man wielding a pointed stick.
+    * Without the HRIBF libraries the bananas are read from the file given by
+    * the Bananas node of the configuration the first time that we test one.
     * \param [in] id : the banana id to look at
     * \param [in] x : the x value to check
     * \param [in] y : the y value to check
@@ -147,6 +150,8 @@ public:
 
 private:
     static PlotsRegister *plots_register_;//!< Instance of the plots register
+    static std::map<unsigned int, PolygonGate> bananas_; //!< The compiled bananas by their number
+    static bool hasReadBananas_; //!< True once we read the banana file
     RootHandler *rootHandler_; //!< Instance of the ROOT Handler so we can plot histograms.
     /** Holds offset for a given set of plots */
     int offset_;
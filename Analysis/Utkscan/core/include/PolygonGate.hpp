@@ -0,0 +1,98 @@
+///@file PolygonGate.hpp
+///@brief Class that compiles a polygon (banana) gate into a grid, so that testing a point does not depend on the
+/// number of vertices.
+///@date October 17, 2026
+#ifndef PAASS_POLYGONGATE_HPP
+#define PAASS_POLYGONGATE_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <stdint.h>
+
+///A class holding a closed polygon, e.g. a banana drawn in DAMM. The bounding box of the polygon is divided into a grid
+/// of cells when the gate is constructed. A cell that no edge touches is entirely inside or outside of the polygon,
+/// which costs one lookup. The other cells keep the few edges that can cross a horizontal ray from a point in the cell,
+/// the edges far to the right that span the whole row only contribute a constant to the parity of the crossings. The
+/// answers are identical to the even-odd crossing test over all of the edges.
+class PolygonGate {
+public:
+    ///A vertex of the polygon, the x and y coordinate
+    typedef std::pair<double, double> Vertex;
+
+    ///Default constructor, the gate contains nothing
+    PolygonGate();
+
+    ///Constructor compiling the polygon. The polygon is closed between the last and the first vertex.
+    ///@param[in] vertices : The vertices of the polygon
+    ///@param[in] gridSize : The number of cells along each side of the bounding box
+    ///@throws invalid_argument if the polygon has less than three vertices or gridSize is zero
+    PolygonGate(const std::vector<Vertex> &vertices, const unsigned int &gridSize = 64);
+
+    ///Default destructor
+    ~PolygonGate() {}
+
+    ///@return The number of cells that need the exact test
+    size_t GetNumberOfBoundaryCells() const;
+
+    ///@return The vertices of the polygon
+    const std::vector<Vertex> &GetVertices() const { return vertices_; }
+
+    ///@param[in] x : The x coordinate of the point
+    ///@param[in] y : The y coordinate of the point
+    ///@return True if the point is inside the polygon
+    bool IsWithin(const double &x, const double &y) const;
+
+    ///Tests a number of points at once
+    ///@param[in] x : The x coordinates of the points
+    ///@param[in] y : The y coordinates of the points
+    ///@param[in] numberOfPoints : The number of points
+    ///@param[out] mask : Bit i % 64 of word i / 64 is set if point i is inside, resized to fit the points
+    void Test(const double *x, const double *y, const size_t &numberOfPoints, std::vector<uint64_t> &mask) const;
+
+    ///Reads the bananas from a DAMM banana file (.ban). The file has records of 80 characters, the INP record of
+    /// each banana gives its number and the CXY records hold up to seven pairs of coordinates.
+    ///@param[in] fileName : The name of the file
+    ///@param[in] gridSize : The number of cells along each side of the bounding boxes
+    ///@return The compiled bananas, by their number in the file
+    ///@throws invalid_argument if the file cannot be read or a banana has less than three points
+    static std::map<unsigned int, PolygonGate> ReadBananaFile(const std::string &fileName,
+                                                              const unsigned int &gridSize = 64);
+
+private:
+    ///The state of a cell of the grid
+    enum CellState {
+        OUTSIDE = 0, ///< The whole cell is outside of the polygon
+        INSIDE = 1, ///< The whole cell is inside of the polygon
+        BOUNDARY = 2 ///< Edges touch the cell, the points need the exact test
+    };
+
+    ///The even-odd crossing test over a list of edges
+    ///@param[in] begin : The first index of the edges, edge i goes from vertex i to vertex i + 1
+    ///@param[in] end : One past the last index of the edges
+    ///@param[in] x : The x coordinate of the point
+    ///@param[in] y : The y coordinate of the point
+    ///@return True if an odd number of edges cross the horizontal ray from the point to the right
+    bool Cross(const uint32_t *begin, const uint32_t *end, const double &x, const double &y) const;
+
+    ///Divides the bounding box into cells and classifies them
+    void Compile();
+
+    std::vector<Vertex> vertices_; ///< The vertices, with the first one repeated at the end
+    unsigned int gridSize_; ///< The number of cells along each side
+    double xMin_; ///< The left side of the bounding box
+    double yMin_; ///< The bottom of the bounding box
+    double xMax_; ///< The right side of the bounding box
+    double yMax_; ///< The top of the bounding box
+    double xScale_; ///< The number of cells per unit of x
+    double yScale_; ///< The number of cells per unit of y
+    std::vector<uint8_t> states_; ///< The state of each cell, row after row, see CellState
+    std::vector<uint8_t> parities_; ///< The crossings of the edges that a boundary cell doesn't keep
+    std::vector<uint32_t> edgeOffsets_; ///< The first edge of each cell in edges_, with one extra for the end
+    std::vector<uint32_t> edges_; ///< The edges that the boundary cells keep
+};
+
+#endif //PAASS_POLYGONGATE_HPP
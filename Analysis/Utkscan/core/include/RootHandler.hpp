@@ -11,8 +11,15 @@
 #include <TH2.h>
 #include <TH3.h>
 
+#include <atomic>
 #include <map>
-#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+#include "SparseHistogram.hpp"
+#include "TreeWriter.hpp"
 
 //! A Class to handle outputting things into ROOT, registering histograms, filling trees, all that jazzy stuff.
 class RootHandler {
@@ -31,25 +38,47 @@ public:
     /// the destructor is called. Ex. delete RootHandler::get();
     ~RootHandler();
 
-    /// Method to access a specific histogram
+    ///Declares a histogram without allocating it. A 1D histogram is allocated when it is filled for the first time.
+    /// A 2D or 3D histogram first keeps only its filled bins in a SparseHistogram, and becomes a dense ROOT histogram
+    /// once the filled bins take more memory than the dense histogram would, or when somebody asks for the ROOT
+    /// histogram through one of the getters. The sparse histograms are converted into ROOT histograms when they are
+    /// written. The arguments are the same as for RegisterHistogram, a histogram that was already declared is kept.
+    ///@param[in] id : The numerical ID of the histogram to declare
+    ///@param[in] title : The Title of the histogram
+    ///@param[in] xBins : The numbers of bins in the X Direction
+    ///@param[in] yBins : The Number of bins in the Y Direction
+    ///@param[in] zBins : The Number of bins in teh Z direction.
+    void DeclareHistogram(const unsigned int &id, const std::string &title, const unsigned int &xBins,
+                          const unsigned int &yBins = 0, const unsigned int &zBins = 0);
+
+    /// Method to access a specific histogram, this allocates the histogram if it was only declared
     /// @param [in] id : The id of the histogram that we're after, this should include the OFFSET that the
     /// Analyzer/Processor defines in its namespace.
     /// @returns a TH1D pointer to the correct histogram
     TH1D *Get1DHistogram(const unsigned int &id);
 
-    /// Method to access a specific histogram
+    /// Method to access a specific histogram, this allocates the histogram if it was only declared
     /// @param [in] id : The id of the histogram that we're after, this should include the OFFSET that the
     /// Analyzer/Processor defines in its namespace.
     /// @returns a TH2D pointer to the histogram.
     TH2D *Get2DHistogram(const unsigned int &id);
 
-    /// Method to access a specific histogram
+    /// Method to access a specific histogram, this allocates the histogram if it was only declared
     /// @param [in] id : The id of the histogram that we're after, this should include the OFFSET that the
     /// Analyzer/Processor defines in its namespace.
     /// @returns a TH3D pointer to the histogram.
     TH3D *Get3DHistogram(const unsigned int &id);
 
-    ///Registers a branch with the provided tree.
+    ///Copies the current contents of the branches of a tree and hands them to the tree writer thread, which fills the
+    /// tree and compresses its baskets. Use this instead of TTree::Fill on the registered trees, the writer thread is
+    /// the only one that may touch them once the first entry is filled. This only waits if the writer falls behind
+    /// by more entries than the queue holds.
+    ///@param[in] tree : The tree returned by RegisterTree
+    ///@throws invalid_argument if no branches were registered on the tree
+    void FillTree(TTree *tree) { treeWriter_->Fill(tree); }
+
+    ///Registers a branch with the provided tree. The branch reads the contents of address when the tree is filled
+    /// with FillTree, so all of the branches of a tree have to be registered here before the first entry is filled.
     ///@param[in] treeName : The name of the tree that they want to add a branch to.
     ///@param[in] name : The name of the branch that they're adding
     ///@param[in] address : A pointer to the memory address for the object we're adding to the tree
@@ -65,6 +94,7 @@ public:
     bool Plot(const unsigned int &id, const double &xval, const double &yval = -1, const double &zval = -1);
 
     /// Wrapper function for the ROOT TH* constructors. We've simplified things to make it look more like DAMM for now.
+    /// This allocates the histogram right away, see DeclareHistogram for histograms that may stay empty.
     ///@param[in] id : The numerical ID of the histogram to register. The method prepends it with an "h", ex. h1
     ///@param[in] title : The Title of the histogram
     ///@param[in] xbins : The numbers of bins in the X Direction
@@ -81,12 +111,48 @@ public:
     /// TTree if one was inserted.
     TTree *RegisterTree(const std::string &name, const std::string &description = "");
 
-    ///Method that will update all the trees and histograms in the system. It spawns a new thread that writes histograms
-    ///  to disk. It locks the histogramFile_ for writing. Trees write to disk serially due to the complex memory
-    ///  management necessary to write them in parallel. BEWARE: This could become a time sink if you have a lot of
-    ///  big trees defined in the system.
+    ///Method that will update all the trees and histograms in the system. The histograms whose number of entries
+    /// changed since they were last written are copied into snapshots, which a writer thread then writes to disk
+    /// while the histograms keep being filled. Nothing is copied while the writer is still busy with the previous
+    /// snapshots, the histograms stay modified and are picked up by the next call. The snapshots are deleted as soon as
+    /// they are written. See AsyncFlush for the order in which the keys of the file are replaced.
+    /// Trees write to disk serially due to the complex memory management necessary to write them in parallel.
+    /// BEWARE: This could become a time sink if you have a lot of big trees defined in the system.
     void Flush();
 
+    ///@return The number of histograms that were allocated as dense ROOT histograms
+    size_t GetNumberOfDenseHistograms() const { return histogramList_.size(); }
+
+    ///@return The number of histograms that were copied by the last call to Flush that found the writer idle
+    size_t GetNumberOfFlushedHistograms() const { return numFlushedHistograms_; }
+
+    ///@return The number of histograms that keep only their filled bins
+    size_t GetNumberOfSparseHistograms() const { return sparseHistograms_.size(); }
+
+    ///Sets the number of bytes of histogram contents that a single flush may copy. The histograms that don't fit are
+    /// written by the following flushes, in order of their IDs. A single histogram larger than the budget is still
+    /// written on its own. Zero, the default, writes all of the modified histograms every time.
+    ///@param[in] a : The budget in bytes
+    void SetFlushBudgetInBytes(const size_t &a) { flushBudgetInBytes_ = a; }
+
+    ///Blocks until the writer thread has written the last snapshots
+    void WaitForFlush();
+
+    ///Sets the compression of a tree, this also applies to the branches that were already registered.
+    ///@param[in] treeName : The name of the tree
+    ///@param[in] settings : The ROOT compression settings, 100 * algorithm + level, see ROOT::CompressionSettings
+    ///@throws invalid_argument if the tree is unknown to us
+    void SetTreeCompressionSettings(const std::string &treeName, const int &settings);
+
+    ///Sets the number of entries that may wait for the tree writer thread
+    ///@param[in] a : The size of the queue
+    void SetTreeQueueSize(const size_t &a) { treeWriter_->SetQueueSize(a); }
+
+    ///Enables ROOT's implicit multi-threading, which compresses the baskets of the branches of a tree in parallel
+    /// when the tree writer thread fills it.
+    ///@param[in] a : The number of threads, 0 lets ROOT decide and 1 leaves it disabled
+    void SetTreeCompressionThreads(const unsigned int &a);
+
 private:
     ///The static instance of the RootHandler that everybody can access.
     static RootHandler *instance_;
@@ -99,21 +165,56 @@ private:
     ///@param [in] fileName : The name of the ROOT File
     RootHandler(const std::string &fileName);
 
-    ///Checks that a histogram is defined in the histogramList_
+    ///Structure holding what we need to allocate a declared histogram
+    struct Definition {
+        std::string title; ///< The title of the histogram
+        unsigned int xBins; ///< The number of bins on the x axis
+        unsigned int yBins; ///< The number of bins on the y axis, zero for a 1D histogram
+        unsigned int zBins; ///< The number of bins on the z axis, zero for a 1D or 2D histogram
+    };
+
+    ///Creates a new ROOT histogram from its definition
+    ///@param[in] id : The ID of the histogram
+    ///@param[in] definition : The definition of the histogram
+    ///@returns a pointer to the new histogram, which belongs to the caller and not to any directory
+    static TH1 *CreateHistogram(const unsigned int &id, const Definition &definition);
+
+    ///Checks that a histogram is declared and allocates it in the histogramList_ if it wasn't yet.
     ///@param[in] id : The ID of the histogram that we're looking for
     ///@param[in] callingFunctionName : The name of the function that called this one, so that we can generate the throw message
     ///@throws invalid_argument if we couldn't find the histogram in the list
     ///@returns a pointer to the histogram in the list if we found it.
     TH1 *GetHistogramFromList(const unsigned int &id, const std::string &callingFunctionName);
 
-    ///Method that loops through histogramList_ and calls Write() on everything that has a non-zero number of entries.
+    ///Allocates the dense ROOT histogram of a declared histogram, moving the contents of its sparse histogram into it.
+    ///@param[in] id : The ID of the histogram
+    ///@param[in] definition : The definition of the histogram
+    ///@returns a pointer to the histogram in the histogramList_
+    static TH1 *Materialize(const unsigned int &id, const Definition &definition);
+
+    ///Method run by the writer thread. It writes the snapshots in flushedHistograms_ as new cycles of their keys and
+    /// commits the directory and the header of the file. Only then are the previous cycles deleted and the file
+    /// committed again, so the space of a cycle is never reused while the directory on disk still points to it as
+    /// the latest one. The snapshots are deleted once they're written.
     static void AsyncFlush();
 
+    ///Writes the directory, the streamer info, the free segments and the header of the histogram file to disk.
+    static void CommitHistogramFile();
+
     static TFile *histogramFile_; //!< ROOT file storing user registered histograms
-    static std::map<unsigned int, TH1 *> histogramList_; //!< List of user registered histograms
+    static std::map<unsigned int, Definition> definitions_; //!< The declared histograms, allocated or not
+    static std::map<unsigned int, TH1 *> histogramList_; //!< The histograms that were allocated as ROOT histograms
+    static std::map<unsigned int, SparseHistogram *> sparseHistograms_; //!< The histograms keeping their filled bins
     static TFile *treeFile_; //!< ROOT File storing user registered trees.
     static std::map<std::string, TTree *> treeList_; //!< The list of user registered trees
-    static std::mutex flushMutex_; //!< Ensures only one thread writes to histogramFile_
+    static TreeWriter *treeWriter_; //!< Fills the user registered trees on its own thread
+    static std::map<unsigned int, double> flushedEntries_; //!< The entries of each histogram when it was last copied
+    static std::vector<TH1 *> flushedHistograms_; //!< The snapshots that the current flush writes, owned by the writer
+    static size_t numFlushedHistograms_; //!< The number of histograms copied by the last flush
+    static std::thread writer_; //!< The thread writing the snapshots, the only thread that writes histogramFile_
+    static std::atomic<bool> isWriting_; //!< True while the writer thread is running
+    static size_t flushBudgetInBytes_; //!< The number of bytes a flush may copy, zero for no limit
+    static unsigned int lastFlushedId_; //!< The ID of the last histogram that was copied
 };
 
 #endif // __ROOTHANDLER_HPP_
\ No newline at end of file
@@ -0,0 +1,103 @@
+///@file SparseHistogram.hpp
+///@brief Class that holds the occupied bins of a 2D or 3D histogram until it is converted into a ROOT histogram.
+///@date October 17, 2026
+#ifndef PAASS_SPARSEHISTOGRAM_HPP
+#define PAASS_SPARSEHISTOGRAM_HPP
+
+#include <unordered_map>
+
+#include <cstddef>
+#include <stdint.h>
+
+class TH1;
+
+///A class holding the contents of a 2D or 3D histogram whose axes start at zero and have bins of width one, the way
+/// that RootHandler declares them. Only the bins that were filled take memory. The bins are numbered like the global
+/// bins of ROOT, including the underflow and overflow bins, so the contents can be copied into a TH2D or TH3D
+/// without rebinning.
+class SparseHistogram {
+public:
+    ///The approximate number of bytes that a bin of the hash table costs, including the node and the bucket
+    static const size_t bytesPerBin = 40;
+
+    ///Constructor
+    ///@param[in] xBins : The number of bins on the x axis
+    ///@param[in] yBins : The number of bins on the y axis
+    ///@param[in] zBins : The number of bins on the z axis, zero for a 2D histogram
+    SparseHistogram(const unsigned int &xBins, const unsigned int &yBins, const unsigned int &zBins = 0);
+
+    ///Default destructor
+    ~SparseHistogram() {}
+
+    ///Adds the contents to a ROOT histogram with the same binning and adds our entries to its entries.
+    ///@param[in] histogram : The histogram that gets the contents
+    void AddTo(TH1 *histogram) const;
+
+    ///Fills a 2D histogram
+    ///@param[in] x : The value on the x axis
+    ///@param[in] y : The value on the y axis
+    ///@return True if the fill added a bin to the table
+    bool Fill(const double &x, const double &y) { return Fill(FindBin(x, xBins_) + (xBins_ + 2) * FindBin(y, yBins_)); }
+
+    ///Fills a 3D histogram
+    ///@param[in] x : The value on the x axis
+    ///@param[in] y : The value on the y axis
+    ///@param[in] z : The value on the z axis
+    ///@return True if the fill added a bin to the table
+    bool Fill(const double &x, const double &y, const double &z) {
+        return Fill(FindBin(x, xBins_) + (xBins_ + 2) * (FindBin(y, yBins_) + (uint64_t) (yBins_ + 2) * FindBin(z, zBins_)));
+    }
+
+    ///@param[in] bin : The global bin, numbered like ROOT numbers them
+    ///@return The contents of the bin
+    double GetBinContent(const uint64_t &bin) const;
+
+    ///@return The number of dimensions, 2 or 3
+    unsigned int GetDimension() const { return zBins_ == 0 ? 2 : 3; }
+
+    ///@return The number of times that the histogram was filled
+    double GetEntries() const { return entries_; }
+
+    ///@return The approximate number of bytes that the filled bins take
+    size_t GetMemoryUsage() const { return contents_.size() * bytesPerBin; }
+
+    ///@return The number of bins that were filled
+    size_t GetNumberOfFilledBins() const { return contents_.size(); }
+
+    ///@return The number of bins of the dense histogram, including the underflow and overflow bins
+    uint64_t GetNumberOfCells() const;
+
+    ///@return True if the dense histogram would take less memory than the filled bins do
+    bool IsDenseSmaller() const { return GetMemoryUsage() > GetNumberOfCells() * sizeof(double); }
+
+private:
+    ///Finds the bin of a value on an axis from zero to the number of bins, with 0 as the underflow and bins + 1 as
+    /// the overflow bin. Values that are not a number go to the underflow bin.
+    ///@param[in] value : The value on the axis
+    ///@param[in] bins : The number of bins on the axis
+    ///@return The bin of the value
+    static uint64_t FindBin(const double &value, const unsigned int &bins) {
+        if (!(value >= 0))
+            return 0;
+        if (value >= bins)
+            return bins + 1;
+        return (uint64_t) value + 1;
+    }
+
+    ///Adds one to the contents of a global bin
+    ///@param[in] bin : The global bin
+    ///@return True if the bin was not filled before
+    bool Fill(const uint64_t &bin) {
+        entries_++;
+        double &contents = contents_[bin];
+        return contents++ == 0;
+    }
+
+    unsigned int xBins_; ///< The number of bins on the x axis
+    unsigned int yBins_; ///< The number of bins on the y axis
+    unsigned int zBins_; ///< The number of bins on the z axis, zero for a 2D histogram
+    double entries_; ///< The number of times that the histogram was filled
+    std::unordered_map<uint64_t, double> contents_; ///< The contents of the filled bins by their global bin
+};
+
+#endif //PAASS_SPARSEHISTOGRAM_HPP
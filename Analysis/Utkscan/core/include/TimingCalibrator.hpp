@@ -92,7 +92,7 @@ public:
 
     /** \return The calibration for the requested bar
      * \param [in] id : the id of the bar that you want the calibration for */
-    TimingCalibration GetCalibration(const TimingDefs::TimingIdentifier &id);
+    const TimingCalibration &GetCalibration(const TimingDefs::TimingIdentifier &id);
 
 private:
     TimingCalibrator() { ReadTimingCalXml(); }; //!<Default constructor
@@ -0,0 +1,101 @@
+///@file TofKernel.hpp
+///@brief Class that calculates the times of flight between every bar and every start of an event in one pass.
+///@date October 17, 2026
+#ifndef __TOFKERNEL_HPP__
+#define __TOFKERNEL_HPP__
+
+#include <vector>
+
+#include <cstddef>
+
+#include "TimingCalibrator.hpp"
+
+///A class that holds the bars and starts of an event as a structure of arrays and calculates the time of flight and
+/// the geometry corrected time of flight for every (bar, start) pair. The results are stored bar major, the pair
+/// (bar, start) is at index bar * GetNumberOfStarts() + start. The inner loop runs over the starts with only
+/// contiguous loads and stores, so that the compiler can vectorize it. The operations are the same, and in the same
+/// order, as in VandleProcessor::CorrectTOF and the TOF calculation that feeds it, so the results are identical to
+/// the scalar calculation.
+class TofKernel {
+public:
+    ///Default constructor
+    TofKernel() {}
+
+    ///Default destructor
+    ~TofKernel() {}
+
+    ///Removes all of the bars and starts, the memory is kept for the next event.
+    void Clear() {
+        barTime_.clear();
+        barRatio_.clear();
+        startTime_.clear();
+        startLocation_.clear();
+        tofOffset_.clear();
+    }
+
+    ///Adds a start. All of the starts must be added before the first bar.
+    ///@param[in] time : The time of the start in ns
+    ///@param[in] location : The location of the start, used to look up the TOF offsets of the bars
+    void AddStart(const double &time, const unsigned int &location) {
+        startTime_.push_back(time);
+        startLocation_.push_back(location);
+    }
+
+    ///Adds a bar and looks up its TOF offset for each of the starts.
+    ///@param[in] time : The time of the bar in ns, e.g. BarDetector::GetCorTimeAve
+    ///@param[in] flightPath : The flight path to the bar, see BarDetector::GetFlightPath
+    ///@param[in] cal : The time calibration of the bar
+    void AddBar(const double &time, const double &flightPath, const TimingCalibration &cal) {
+        barTime_.push_back(time);
+        barRatio_.push_back(cal.GetZ0() / flightPath);
+        for (std::vector<unsigned int>::const_iterator it = startLocation_.begin(); it != startLocation_.end(); it++)
+            tofOffset_.push_back(cal.GetTofOffset(*it));
+    }
+
+    ///Calculates the time of flight and the corrected time of flight of every pair.
+    void Calculate() {
+        const size_t numStarts = startTime_.size();
+        tof_.resize(barTime_.size() * numStarts);
+        corTof_.resize(tof_.size());
+
+        const double *starts = startTime_.data();
+        for (size_t bar = 0; bar < barTime_.size(); bar++) {
+            const double time = barTime_[bar];
+            const double ratio = barRatio_[bar];
+            const double *offsets = tofOffset_.data() + bar * numStarts;
+            double *tofs = tof_.data() + bar * numStarts;
+            double *corTofs = corTof_.data() + bar * numStarts;
+            for (size_t start = 0; start < numStarts; start++) {
+                tofs[start] = time - starts[start] + offsets[start];
+                corTofs[start] = ratio * tofs[start];
+            }
+        }
+    }
+
+    ///@return The number of bars that were added
+    size_t GetNumberOfBars() const { return barTime_.size(); }
+
+    ///@return The number of starts that were added
+    size_t GetNumberOfStarts() const { return startTime_.size(); }
+
+    ///@param[in] start : The index of the start
+    ///@return The location of the start
+    unsigned int GetStartLocation(const size_t &start) const { return startLocation_[start]; }
+
+    ///@return The times of flight of all of the pairs in ns, see the class description for the layout
+    const std::vector<double> &GetTofs() const { return tof_; }
+
+    ///@return The geometry corrected times of flight of all of the pairs in ns
+    const std::vector<double> &GetCorrectedTofs() const { return corTof_; }
+
+private:
+    std::vector<double> barTime_; ///< The times of the bars
+    std::vector<double> barRatio_; ///< z0 over the flight path of the bars
+    std::vector<double> startTime_; ///< The times of the starts
+    std::vector<unsigned int> startLocation_; ///< The locations of the starts
+    std::vector<double> tofOffset_; ///< The TOF offsets of the pairs
+    std::vector<double> tof_; ///< The times of flight of the pairs
+    std::vector<double> corTof_; ///< The corrected times of flight of the pairs
+};
+
+#endif //__TOFKERNEL_HPP__
@@ -0,0 +1,113 @@
+///@file TreeWriter.hpp
+///@brief Class that fills ROOT trees on a writer thread from copies of the branch contents taken on the analysis
+/// thread.
+///@date October 17, 2026
+#ifndef PAASS_TREEWRITER_HPP
+#define PAASS_TREEWRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+class TBranch;
+class TTree;
+
+///A class that moves TTree::Fill, and with it the compression of the baskets, off of the analysis thread. The
+/// branches are created on buffers that belong to the writer, the analysis thread keeps filling its own structures.
+/// Fill copies the structures of every branch of a tree into one entry and appends it to a bounded queue, the writer
+/// thread copies the entry into the branch buffers and fills the tree. The analysis thread only waits if the queue is
+/// full. All of the branches have to be registered before the first entry is filled, and every branch of a tree has
+/// to be registered through this class, since the writer thread is the only one that touches the trees afterwards.
+class TreeWriter {
+public:
+    ///Default constructor
+    TreeWriter();
+
+    ///Destructor, writes the entries that are still queued and stops the writer thread
+    ~TreeWriter();
+
+    ///Calculates the number of bytes that a leaf list describes, the way ROOT lays out the leaves without padding.
+    /// A leaf without a type has the type of the leaf before it, the first leaf defaults to F.
+    ///@param[in] leaflist : The leaf list of the branch, e.g. "qdc/D:time:id/i"
+    ///@return The size of the branch in bytes
+    ///@throws invalid_argument if the leaf list has strings, arrays of variable length or unknown types
+    static size_t GetLeafListSize(const std::string &leaflist);
+
+    ///Adds a branch to a tree. The branch reads from a buffer of the writer, the contents of address are copied into
+    /// it for every entry.
+    ///@param[in] tree : The tree that gets the branch
+    ///@param[in] name : The name of the branch
+    ///@param[in] address : The structure that the analysis fills
+    ///@param[in] leaflist : The leaf definition of the structure
+    ///@throws logic_error if the writer thread already started
+    void AddBranch(TTree *tree, const std::string &name, const void *address, const std::string &leaflist);
+
+    ///Requests that the trees are saved to their files, the writer does this once it reaches the request.
+    void AutoSave();
+
+    ///Copies the current contents of the branches of a tree into an entry and queues it. This waits if the queue is
+    /// full. The first call starts the writer thread.
+    ///@param[in] tree : The tree that we want to fill
+    ///@throws invalid_argument if the tree has no branches registered with this class
+    void Fill(TTree *tree);
+
+    ///@return The number of times that Fill had to wait for the writer thread
+    unsigned long long GetNumberOfWaits() const { return numberOfWaits_; }
+
+    ///Sets the compression of the branches of a tree, including the branches that are added later.
+    ///@param[in] tree : The tree whose branches we compress
+    ///@param[in] settings : The ROOT compression settings, 100 * algorithm + level
+    ///@throws logic_error if the writer thread already started
+    void SetCompressionSettings(TTree *tree, const int &settings);
+
+    ///Sets the number of entries that may wait in the queue
+    ///@param[in] a : The size of the queue, at least 1
+    void SetQueueSize(const size_t &a) { queueSize_ = a == 0 ? 1 : a; }
+
+    ///Writes the entries that are still queued and stops the writer thread. Fill starts it again.
+    void Stop();
+
+private:
+    ///Structure holding a branch and the buffer that it reads from
+    struct Branch {
+        TBranch *branch; ///< The branch of the tree
+        const void *source; ///< The structure that the analysis fills
+        std::vector<char> buffer; ///< The buffer that the branch reads from
+    };
+
+    ///Structure holding the branches of a tree
+    struct Tree {
+        std::vector<Branch> branches; ///< The branches of the tree
+        size_t entrySize; ///< The sum of the sizes of the branches
+        int compressionSettings; ///< The compression of the branches, -1 for the default of the file
+    };
+
+    ///Structure holding a queued entry. An entry without a tree is a request to save the trees.
+    struct Entry {
+        TTree *tree; ///< The tree that gets the entry
+        Tree *branches; ///< The branches of the tree
+        std::vector<char> data; ///< The contents of all of the branches, one after the other
+    };
+
+    ///The loop of the writer thread
+    void Run();
+
+    std::map<TTree *, Tree> trees_; ///< The trees and their branches
+    std::deque<Entry> queue_; ///< The entries that wait to be written
+    std::vector<std::vector<char> > freeBuffers_; ///< Buffers of written entries that can be reused
+    size_t queueSize_; ///< The number of entries that may wait in the queue
+    bool isStopping_; ///< True once Stop was called
+    unsigned long long numberOfWaits_; ///< The number of times that Fill waited
+    std::mutex mutex_; ///< Guards the queue and the free buffers
+    std::condition_variable notEmpty_; ///< Signals the writer that there is an entry
+    std::condition_variable notFull_; ///< Signals Fill that there is room in the queue
+    std::thread thread_; ///< The writer thread
+};
+
+#endif //PAASS_TREEWRITER_HPP
@@ -24,6 +24,10 @@ public:
     bool Initialize(std::string prefix_ = "");
 private:
     std::string outputFname_; /// The output histogram filename prefix.
+
+    /** Set up the unpacker to build events around the trigger types from the
+     * EventBuilder node of the configuration. */
+    void SetTriggeredBuilding();
 };
 
 #endif //__UTK_SCAN_INTERFACE_HPP__
@@ -17,8 +17,10 @@
 ///A class that is derived from Unpacker that defines what we are going to do
 /// with all of the events that are built by the Unpacker class. We only
 /// define a single class (ProcessRawEvent) and overload the RawStats class
-/// to take a pointer to a DetectorDriver instance. The rest of the virtual
-/// methods in the parent are used as default.
+/// to take a pointer to a DetectorDriver instance. When only the headers are
+/// decoded (ScanInterface --headers-only) ProcessHitBatch fills the same raw
+/// statistics without building any events. The rest of the virtual methods
+/// in the parent are used as default.
 class UtkUnpacker : public Unpacker {
 public:
     /// Default constructor that does nothing in particular
@@ -35,6 +37,10 @@ private:
     ///@param[in]  addr_ Pointer to a ScanInterface object.
     void ProcessRawEvent();
 
+    ///@brief Fills the raw statistics for all of the hits in a spill when only the headers are decoded.
+    ///@param[in] batch : The columns of the hits in the spill.
+    void ProcessHitBatch(const XiaHitBatch &batch);
+
     ///@brief Initializes the DetectorLibrary and DetectorDriver
     ///@param[in] driver A pointer to the DetectorDriver that we're using.
     ///@param[in] detlib A pointer to the DetectorLibrary that we're using.
@@ -49,11 +55,11 @@ private:
     void PrintProcessingTimeInformation(const double &eventTime, const unsigned int &eventCounter,
                                         std::chrono::duration<double> &processingTime);
 
-    ///@brief Add an event to generic statistics output.
-    ///@param[in] event_ Pointer to the current XIA event.
+    ///@brief Add a hit to generic statistics output.
+    ///@param[in] id The channel ID of the hit (see XiaData::GetId).
+    ///@param[in] time The time of the hit in clock ticks.
     ///@param[in] driver Pointer to the DetectorDriver class that we're using.
-    ///@param[in] addr_  Pointer to a ScanInterface object.
-    void RawStats(XiaData *event_, DetectorDriver *driver);
+    void RawStats(const unsigned int &id, const double &time, DetectorDriver *driver);
 };
 
 #endif //__UTKUNPACKER_HPP__
@@ -3,6 +3,7 @@
  *  \author S. V. Paulauskas
  *  \date December 15, 2014
 */
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -11,26 +12,53 @@
 
 using namespace std;
 
+namespace {
+    ///The side of a bar that a channel reads out
+    enum BarSide {
+        UNRESOLVED, NO_SIDE, LEFT, RIGHT
+    };
+
+    ///@return The side of the bar for the channel, the tags are only looked at the first time that we see a channel.
+    BarSide GetSide(const ChanEvent &chan) {
+        static vector<BarSide> sides;
+        unsigned int id = chan.GetID();
+        if (id >= sides.size())
+            sides.resize(id + 1, UNRESOLVED);
+        if (sides[id] == UNRESOLVED) {
+            const ChannelConfiguration &cfg = chan.GetChanID();
+            if (cfg.HasTag("left") || cfg.HasTag("up") || cfg.HasTag("top"))
+                sides[id] = LEFT;
+            else if (cfg.HasTag("right") || cfg.HasTag("down") || cfg.HasTag("bottom"))
+                sides[id] = RIGHT;
+            else
+                sides[id] = NO_SIDE;
+        }
+        return sides[id];
+    }
+}
+
 void BarBuilder::BuildBars(void) {
     ClearMaps();
     FillMaps();
 
-    for (map<unsigned int, unsigned int>::const_iterator it = lefts_.begin(); it != lefts_.end(); it++) {
-        map<unsigned int, unsigned int>::const_iterator mate = rights_.find(it->first);
-        if (mate == rights_.end())
+    //The maps come out sorted by bar number, so we insert in that order and let the maps append at the end.
+    sort(barNumbers_.begin(), barNumbers_.end());
+    for (vector<unsigned int>::const_iterator it = barNumbers_.begin(); it != barNumbers_.end(); it++) {
+        if (lefts_[*it] < 0 || rights_[*it] < 0)
             continue;
 
-        if (list_.at(it->second)->GetTrace().size() != 0 && list_.at(mate->second)->GetTrace().size() != 0) {
-            TimingDefs::TimingIdentifier key =
-                    make_pair(it->first, list_.at(it->second)->GetChanID().GetSubtype());
-            hrtBars_.insert(make_pair(key, BarDetector(HighResTimingData(*(list_.at(it->second))),
-                                                       HighResTimingData(*(list_.at(mate->second))), key)));
+        const ChanEvent *left = list_[lefts_[*it]];
+        const ChanEvent *right = list_[rights_[*it]];
+        if (left->GetTrace().size() != 0 && right->GetTrace().size() != 0) {
+            TimingDefs::TimingIdentifier key = make_pair(*it, left->GetChanID().GetSubtype());
+            hrtBars_.insert(hrtBars_.end(), make_pair(key, BarDetector(HighResTimingData(left),
+                                                                       HighResTimingData(right), key)));
         } else {
-            lrtBars_.insert(make_pair(it->first,
-                                      make_pair(0.5 * (list_.at(it->second)->GetWalkCorrectedTime() +
-                                                        list_.at(mate->second)->GetWalkCorrectedTime()),
-                                                sqrt(list_.at(it->second)->GetCalibratedEnergy() *
-                                                             list_.at(mate->second)->GetCalibratedEnergy()))));
+            lrtBars_.insert(lrtBars_.end(),
+                            make_pair(*it, make_pair(0.5 * (left->GetWalkCorrectedTime() +
+                                                            right->GetWalkCorrectedTime()),
+                                                     sqrt(left->GetCalibratedEnergy() *
+                                                          right->GetCalibratedEnergy()))));
         }
     }
 }
@@ -42,18 +70,28 @@ unsigned int BarBuilder::CalcBarNumber(const unsigned int &loc) {
 void BarBuilder::ClearMaps(void) {
     lrtBars_.clear();
     hrtBars_.clear();
-    lefts_.clear();
-    rights_.clear();
+    for (vector<unsigned int>::const_iterator it = barNumbers_.begin(); it != barNumbers_.end(); it++)
+        lefts_[*it] = rights_[*it] = -1;
+    barNumbers_.clear();
 }
 
 void BarBuilder::FillMaps(void) {
     for (vector<ChanEvent *>::const_iterator it = list_.begin(); it != list_.end(); it++) {
-        ChannelConfiguration id = (*it)->GetChanID();
-        unsigned int barNum = CalcBarNumber(id.GetLocation());
-        unsigned int idx = (unsigned int) (it - list_.begin());
-        if (id.HasTag("left") || id.HasTag("up") || id.HasTag("top"))
-            lefts_.insert(make_pair(barNum, idx));
-        if (id.HasTag("right") || id.HasTag("down") || id.HasTag("bottom"))
-            rights_.insert(make_pair(barNum, idx));
+        BarSide side = GetSide(*(*it));
+        if (side == NO_SIDE)
+            continue;
+
+        unsigned int barNum = CalcBarNumber((*it)->GetChanID().GetLocation());
+        if (barNum >= lefts_.size()) {
+            lefts_.resize(barNum + 1, -1);
+            rights_.resize(barNum + 1, -1);
+        }
+        if (lefts_[barNum] < 0 && rights_[barNum] < 0)
+            barNumbers_.push_back(barNum);
+
+        //Like a map insert, the first channel that we find for a side wins.
+        vector<int> &ends = side == LEFT ? lefts_ : rights_;
+        if (ends[barNum] < 0)
+            ends[barNum] = (int) (it - list_.begin());
     }
 }
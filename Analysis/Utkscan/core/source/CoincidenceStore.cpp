@@ -0,0 +1,361 @@
+///@file CoincidenceStore.cpp
+///@brief Class that stores symmetric gamma-gamma or gamma-gamma-gamma coincidences as sparse cells and answers gate
+/// and project queries on them.
+///@date October 17, 2026
+#include "CoincidenceStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include <TH1D.h>
+#include <TH2D.h>
+
+using namespace std;
+
+namespace {
+    ///The first word of every store file, the bytes spell PAASSCOI.
+    const uint64_t magicWord = 0x494F435353414150ULL;
+
+    ///Appends the bytes of a plain value to the file
+    template<typename T>
+    void Write(ofstream &out, const T &a) { out.write(reinterpret_cast<const char *>(&a), sizeof(T)); }
+
+    ///Reads the bytes of a plain value from the file
+    template<typename T>
+    bool Read(ifstream &in, T &a) { return (bool) in.read(reinterpret_cast<char *>(&a), sizeof(T)); }
+
+    ///@return True if the bin is inside of the range
+    inline bool IsWithin(const unsigned int &bin, const pair<unsigned int, unsigned int> &range) {
+        return bin >= range.first && bin <= range.second;
+    }
+}
+
+const uint32_t CoincidenceStore::version;
+const unsigned int CoincidenceStore::maximumNumberOfBins;
+
+CoincidenceStore::CoincidenceStore(const unsigned int &dimension, const unsigned int &numberOfBins,
+                                   const double &binWidth/*= 1.0*/, const size_t &pendingSize/*= 1 << 20*/) :
+        dimension_(dimension), numberOfBins_(numberOfBins), binWidth_(binWidth), pendingSize_(pendingSize),
+        numberOfEntries_(0) {
+    if (dimension != 2 && dimension != 3)
+        throw invalid_argument("CoincidenceStore::CoincidenceStore - Only dimensions 2 and 3 are supported.");
+    if (numberOfBins == 0 || numberOfBins > maximumNumberOfBins)
+        throw invalid_argument("CoincidenceStore::CoincidenceStore - The number of bins has to be between 1 and "
+                               + to_string(maximumNumberOfBins) + ".");
+    if (!(binWidth > 0))
+        throw invalid_argument("CoincidenceStore::CoincidenceStore - The bin width has to be positive.");
+    if (pendingSize_ == 0)
+        pendingSize_ = 1;
+    BuildIndex();
+}
+
+void CoincidenceStore::Add(const double &e1, const double &e2) {
+    if (dimension_ != 2)
+        throw logic_error("CoincidenceStore::Add - Pairs can only be added to a store of dimension 2.");
+    unsigned int b1, b2;
+    if (!ToBin(e1, b1) || !ToBin(e2, b2))
+        return;
+    if (b1 > b2)
+        swap(b1, b2);
+    AddKey(((uint64_t) b1 << 16) | b2);
+}
+
+void CoincidenceStore::Add(const double &e1, const double &e2, const double &e3) {
+    if (dimension_ != 3)
+        throw logic_error("CoincidenceStore::Add - Triples can only be added to a store of dimension 3.");
+    unsigned int b1, b2, b3;
+    if (!ToBin(e1, b1) || !ToBin(e2, b2) || !ToBin(e3, b3))
+        return;
+    if (b1 > b2)
+        swap(b1, b2);
+    if (b2 > b3)
+        swap(b2, b3);
+    if (b1 > b2)
+        swap(b1, b2);
+    AddKey(((uint64_t) b1 << 32) | ((uint64_t) b2 << 16) | b3);
+}
+
+void CoincidenceStore::AddKey(const uint64_t &key) {
+    pending_.push_back(key);
+    numberOfEntries_++;
+    if (pending_.size() >= pendingSize_)
+        Compact();
+}
+
+void CoincidenceStore::BuildIndex() {
+    index_.assign(numberOfBins_ + 1, keys_.size());
+    size_t cell = 0;
+    for (unsigned int bin = 0; bin < numberOfBins_; bin++) {
+        while (cell < keys_.size() && GetBin(keys_[cell], 0) < bin)
+            cell++;
+        index_[bin] = cell;
+    }
+}
+
+void CoincidenceStore::Clear() {
+    keys_.clear();
+    counts_.clear();
+    pending_.clear();
+    numberOfEntries_ = 0;
+    BuildIndex();
+}
+
+void CoincidenceStore::Compact() {
+    if (pending_.empty())
+        return;
+
+    sort(pending_.begin(), pending_.end());
+
+    vector<uint64_t> keys;
+    vector<uint32_t> counts;
+    keys.reserve(keys_.size() + pending_.size());
+    counts.reserve(keys_.size() + pending_.size());
+
+    vector<uint64_t>::const_iterator newKey = pending_.begin();
+    size_t cell = 0;
+    while (cell < keys_.size() || newKey != pending_.end()) {
+        if (newKey == pending_.end() || (cell < keys_.size() && keys_[cell] < *newKey)) {
+            keys.push_back(keys_[cell]);
+            counts.push_back(counts_[cell]);
+            cell++;
+            continue;
+        }
+
+        uint64_t key = *newKey;
+        uint32_t count = 0;
+        for (; newKey != pending_.end() && *newKey == key; newKey++)
+            count++;
+        if (cell < keys_.size() && keys_[cell] == key)
+            count += counts_[cell++];
+        keys.push_back(key);
+        counts.push_back(count);
+    }
+
+    keys.shrink_to_fit();
+    counts.shrink_to_fit();
+    keys_.swap(keys);
+    counts_.swap(counts);
+    pending_.clear();
+    BuildIndex();
+}
+
+size_t CoincidenceStore::GetMemoryUsage() const {
+    return keys_.capacity() * sizeof(uint64_t) + counts_.capacity() * sizeof(uint32_t)
+           + index_.capacity() * sizeof(size_t) + pending_.capacity() * sizeof(uint64_t);
+}
+
+bool CoincidenceStore::ToBin(const double &energy, unsigned int &bin) const {
+    double position = floor(energy / binWidth_);
+    if (!(position >= 0 && position < numberOfBins_))
+        return false;
+    bin = (unsigned int) position;
+    return true;
+}
+
+CoincidenceStore::BinRange CoincidenceStore::ToBinRange(const Gate &gate) const {
+    double low = max(floor(gate.first / binWidth_), 0.);
+    double high = min(floor(gate.second / binWidth_), numberOfBins_ - 1.);
+    if (!(low <= high))
+        return make_pair(1u, 0u);
+    return make_pair((unsigned int) low, (unsigned int) high);
+}
+
+vector<double> CoincidenceStore::Project() {
+    Compact();
+    vector<double> projection(numberOfBins_, 0);
+    //Every bin of a triple shows up on the projected axis in two of the six orders.
+    double weight = dimension_ == 2 ? 1 : 2;
+    for (size_t cell = 0; cell < keys_.size(); cell++)
+        for (unsigned int axis = 0; axis < dimension_; axis++)
+            projection[GetBin(keys_[cell], axis)] += weight * counts_[cell];
+    return projection;
+}
+
+vector<double> CoincidenceStore::Project(const Gate &gate) {
+    if (dimension_ != 2)
+        throw logic_error("CoincidenceStore::Project - A single gate can only be set on a store of dimension 2.");
+    Compact();
+    vector<double> projection(numberOfBins_, 0);
+    BinRange range = ToBinRange(gate);
+    if (range.first > range.second)
+        return projection;
+
+    //The cells with their lower bin in the gate are the rows of the gate.
+    for (size_t cell = index_[range.first]; cell < index_[range.second + 1]; cell++)
+        projection[GetBin(keys_[cell], 1)] += counts_[cell];
+
+    //The cells with their upper bin in the gate are a contiguous part of each row up to the end of the gate.
+    for (unsigned int row = 0; row <= range.second; row++) {
+        vector<uint64_t>::const_iterator begin = keys_.begin() + index_[row];
+        vector<uint64_t>::const_iterator end = keys_.begin() + index_[row + 1];
+        uint64_t rowKey = (uint64_t) row << 16;
+        vector<uint64_t>::const_iterator first = lower_bound(begin, end, rowKey | range.first);
+        vector<uint64_t>::const_iterator last = upper_bound(first, end, rowKey | range.second);
+        for (; first != last; first++)
+            projection[row] += counts_[first - keys_.begin()];
+    }
+    return projection;
+}
+
+vector<double> CoincidenceStore::Project(const Gate &gate1, const Gate &gate2) {
+    if (dimension_ != 3)
+        throw logic_error("CoincidenceStore::Project - Two gates can only be set on a store of dimension 3.");
+    Compact();
+    vector<double> projection(numberOfBins_, 0);
+    BinRange range1 = ToBinRange(gate1);
+    BinRange range2 = ToBinRange(gate2);
+    if (range1.first > range1.second || range2.first > range2.second)
+        return projection;
+
+    //Both gated bins are at least as large as the lowest bin of the cell, so only the rows up to the end of the
+    // higher gate can contribute.
+    unsigned int lastRow = max(range1.second, range2.second);
+    for (size_t cell = 0; cell < index_[lastRow + 1]; cell++) {
+        unsigned int bins[3] = {GetBin(keys_[cell], 0), GetBin(keys_[cell], 1), GetBin(keys_[cell], 2)};
+        for (unsigned int axis = 0; axis < 3; axis++) {
+            const unsigned int &x = bins[(axis + 1) % 3];
+            const unsigned int &y = bins[(axis + 2) % 3];
+            unsigned int orders = (IsWithin(x, range1) && IsWithin(y, range2))
+                                  + (IsWithin(y, range1) && IsWithin(x, range2));
+            projection[bins[axis]] += (double) orders * counts_[cell];
+        }
+    }
+    return projection;
+}
+
+CoincidenceStore CoincidenceStore::Slice(const Gate &gate) {
+    if (dimension_ != 3)
+        throw logic_error("CoincidenceStore::Slice - Only a store of dimension 3 can be sliced.");
+    Compact();
+    CoincidenceStore slice(2, numberOfBins_, binWidth_, pendingSize_);
+    BinRange range = ToBinRange(gate);
+    if (range.first > range.second)
+        return slice;
+
+    vector<pair<uint64_t, uint32_t> > cells;
+    for (size_t cell = 0; cell < index_[range.second + 1]; cell++) {
+        unsigned int bins[3] = {GetBin(keys_[cell], 0), GetBin(keys_[cell], 1), GetBin(keys_[cell], 2)};
+        for (unsigned int axis = 0; axis < 3; axis++) {
+            if (!IsWithin(bins[axis], range))
+                continue;
+            //The two other bins stay in ascending order when we leave one out.
+            unsigned int low = bins[axis == 0 ? 1 : 0];
+            unsigned int high = bins[axis == 2 ? 1 : 2];
+            cells.push_back(make_pair(((uint64_t) low << 16) | high, counts_[cell]));
+        }
+    }
+
+    sort(cells.begin(), cells.end());
+    for (vector<pair<uint64_t, uint32_t> >::const_iterator it = cells.begin(); it != cells.end(); it++) {
+        if (!slice.keys_.empty() && slice.keys_.back() == it->first)
+            slice.counts_.back() += it->second;
+        else {
+            slice.keys_.push_back(it->first);
+            slice.counts_.push_back(it->second);
+        }
+        slice.numberOfEntries_ += it->second;
+    }
+    slice.BuildIndex();
+    return slice;
+}
+
+TH1D *CoincidenceStore::ToHistogram(const std::vector<double> &projection, const std::string &name,
+                                    const std::string &title) const {
+    TH1D *histogram = new TH1D(name.c_str(), title.c_str(), numberOfBins_, 0, numberOfBins_ * binWidth_);
+    double entries = 0;
+    for (unsigned int bin = 0; bin < numberOfBins_ && bin < projection.size(); bin++) {
+        histogram->SetBinContent(bin + 1, projection[bin]);
+        entries += projection[bin];
+    }
+    histogram->SetEntries(entries);
+    return histogram;
+}
+
+TH2D *CoincidenceStore::ToHistogram(const std::string &name, const std::string &title) {
+    if (dimension_ != 2)
+        throw logic_error("CoincidenceStore::ToHistogram - Only a store of dimension 2 can be filled into a "
+                                  "2D histogram.");
+    Compact();
+    double range = numberOfBins_ * binWidth_;
+    TH2D *histogram = new TH2D(name.c_str(), title.c_str(), numberOfBins_, 0, range, numberOfBins_, 0, range);
+    for (size_t cell = 0; cell < keys_.size(); cell++) {
+        double x = (GetBin(keys_[cell], 0) + 0.5) * binWidth_;
+        double y = (GetBin(keys_[cell], 1) + 0.5) * binWidth_;
+        histogram->Fill(x, y, counts_[cell]);
+        histogram->Fill(y, x, counts_[cell]);
+    }
+    return histogram;
+}
+
+bool CoincidenceStore::Load(const std::string &fileName) {
+    ifstream in(fileName.c_str(), ios::binary);
+    if (!in)
+        return false;
+
+    uint64_t magic, numberOfCells;
+    uint32_t fileVersion, dimension, numberOfBins;
+    double binWidth;
+    unsigned long long numberOfEntries;
+    if (!Read(in, magic) || magic != magicWord || !Read(in, fileVersion) || fileVersion != version
+        || !Read(in, dimension) || dimension != dimension_ || !Read(in, numberOfBins) || numberOfBins != numberOfBins_
+        || !Read(in, binWidth) || binWidth != binWidth_ || !Read(in, numberOfEntries) || !Read(in, numberOfCells))
+        return false;
+
+    //Refuse cell counts that the file cannot hold before we allocate anything.
+    streampos start = in.tellg();
+    in.seekg(0, ios::end);
+    streampos end = in.tellg();
+    in.seekg(start);
+    if ((uint64_t) (end - start) != numberOfCells * (sizeof(uint64_t) + sizeof(uint32_t)))
+        return false;
+
+    vector<uint64_t> keys(numberOfCells);
+    vector<uint32_t> counts(numberOfCells);
+    if (!in.read(reinterpret_cast<char *>(keys.data()), numberOfCells * sizeof(uint64_t))
+        || !in.read(reinterpret_cast<char *>(counts.data()), numberOfCells * sizeof(uint32_t)))
+        return false;
+
+    for (size_t cell = 0; cell < keys.size(); cell++) {
+        if ((cell > 0 && keys[cell - 1] >= keys[cell]) || keys[cell] >> (16 * dimension_) != 0)
+            return false;
+        for (unsigned int axis = 0; axis < dimension_; axis++)
+            if (GetBin(keys[cell], axis) >= numberOfBins_
+                || (axis > 0 && GetBin(keys[cell], axis - 1) > GetBin(keys[cell], axis)))
+                return false;
+    }
+
+    keys_.swap(keys);
+    counts_.swap(counts);
+    pending_.clear();
+    numberOfEntries_ = numberOfEntries;
+    BuildIndex();
+    return true;
+}
+
+bool CoincidenceStore::Save(const std::string &fileName) {
+    Compact();
+
+    string temporary = fileName + ".tmp";
+    ofstream out(temporary.c_str(), ios::binary | ios::trunc);
+    if (!out)
+        return false;
+
+    Write(out, magicWord);
+    Write(out, version);
+    Write(out, (uint32_t) dimension_);
+    Write(out, (uint32_t) numberOfBins_);
+    Write(out, binWidth_);
+    Write(out, numberOfEntries_);
+    Write(out, (uint64_t) keys_.size());
+    out.write(reinterpret_cast<const char *>(keys_.data()), keys_.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char *>(counts_.data()), counts_.size() * sizeof(uint32_t));
+    out.close();
+    if (!out) {
+        remove(temporary.c_str());
+        return false;
+    }
+    return rename(temporary.c_str(), fileName.c_str()) == 0;
+}
@@ -0,0 +1,276 @@
+///@file ConfigurationCache.cpp
+///@brief Class that stores the resolved channel map of the configuration file in a versioned binary file so that
+/// later runs with the same configuration can skip resolving the Map node.
+///@date October 17, 2026
+#include "ConfigurationCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    ///The first word of every cache file, the bytes spell PAASSCFG.
+    const uint64_t magicWord = 0x4746435353414150ULL;
+
+    ///Appends the bytes of a plain value to the output
+    template<typename T>
+    void Write(string &out, const T &a) { out.append(reinterpret_cast<const char *>(&a), sizeof(T)); }
+
+    void WriteString(string &out, const string &a) {
+        Write(out, (uint32_t) a.size());
+        out.append(a);
+    }
+
+    void WriteCorrections(string &out, const vector<ConfigurationCache::Correction> &a) {
+        Write(out, (uint32_t) a.size());
+        for (vector<ConfigurationCache::Correction>::const_iterator it = a.begin(); it != a.end(); it++) {
+            WriteString(out, it->model);
+            Write(out, it->min);
+            Write(out, it->max);
+            Write(out, (uint32_t) it->parameters.size());
+            for (vector<double>::const_iterator par = it->parameters.begin(); par != it->parameters.end(); par++)
+                Write(out, *par);
+        }
+    }
+
+    void WriteFilter(string &out, TrapFilterParameters a) {
+        Write(out, a.GetRisetime());
+        Write(out, a.GetFlattop());
+        Write(out, a.GetT());
+    }
+
+    ///The smallest number of bytes that a correction takes up : the size of the model, the range and the number of
+    /// parameters.
+    const size_t minCorrectionBytes = 2 * sizeof(uint32_t) + 2 * sizeof(double);
+
+    ///The smallest number of bytes that a channel record takes up : the fixed fields with empty strings, no tags
+    /// and no corrections.
+    const size_t minRecordBytes = sizeof(int) + sizeof(unsigned int) + 2 * sizeof(uint32_t) + 2 * sizeof(uint32_t)
+                                  + 7 * sizeof(double) + 4 * sizeof(uint32_t) + 4 * sizeof(double)
+                                  + 3 * sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
+    ///A cursor over the mapped file that refuses to read past its end.
+    class Reader {
+    public:
+        Reader(const char *begin, const size_t &size) : pos_(begin), end_(begin + size) {}
+
+        bool IsAtEnd() const { return pos_ == end_; }
+
+        ///@return True if the rest of the file can hold the number of items of at least the given size. We check
+        /// the counts read from the file with this before allocating anything for them.
+        bool HasRoomFor(const uint32_t &count, const size_t &minBytes) const {
+            return (size_t) (end_ - pos_) / minBytes >= count;
+        }
+
+        template<typename T>
+        bool Read(T &a) {
+            if ((size_t) (end_ - pos_) < sizeof(T))
+                return false;
+            memcpy(&a, pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(string &a) {
+            uint32_t size;
+            if (!Read(size) || (size_t) (end_ - pos_) < size)
+                return false;
+            a.assign(pos_, size);
+            pos_ += size;
+            return true;
+        }
+
+        bool ReadCorrections(vector<ConfigurationCache::Correction> &a) {
+            uint32_t size;
+            if (!Read(size) || !HasRoomFor(size, minCorrectionBytes))
+                return false;
+            a.resize(size);
+            for (vector<ConfigurationCache::Correction>::iterator it = a.begin(); it != a.end(); it++) {
+                uint32_t numParameters;
+                if (!ReadString(it->model) || !Read(it->min) || !Read(it->max) || !Read(numParameters)
+                    || !HasRoomFor(numParameters, sizeof(double)))
+                    return false;
+                it->parameters.resize(numParameters);
+                for (vector<double>::iterator par = it->parameters.begin(); par != it->parameters.end(); par++)
+                    Read(*par);
+            }
+            return true;
+        }
+
+        bool ReadFilter(TrapFilterParameters &a) {
+            double l, g, t;
+            if (!Read(l) || !Read(g) || !Read(t))
+                return false;
+            a = TrapFilterParameters(l, g, t);
+            return true;
+        }
+
+    private:
+        const char *pos_; ///< The next byte that we will read
+        const char *end_; ///< One past the last byte of the file
+    };
+
+    ///Reads the header and all of the records from a mapped file
+    bool Decode(Reader &in, const uint64_t &key, vector<ConfigurationCache::ChannelRecord> &records) {
+        uint64_t magic, fileKey;
+        uint32_t fileVersion, numRecords;
+        if (!in.Read(magic) || magic != magicWord || !in.Read(fileVersion) || fileVersion != ConfigurationCache::version
+            || !in.Read(fileKey) || fileKey != key || !in.Read(numRecords) || !in.HasRoomFor(numRecords, minRecordBytes))
+            return false;
+
+        records.resize(numRecords);
+        for (vector<ConfigurationCache::ChannelRecord>::iterator it = records.begin(); it != records.end(); it++) {
+            ChannelConfiguration &cfg = it->configuration;
+            string type, subtype;
+            uint32_t location, numTags, discriminationStart, traceDelay, waveformLow, waveformHigh;
+            double baselineThreshold;
+            TrapFilterParameters trigger, energy;
+
+            if (!in.Read(it->module) || !in.Read(it->channel) || !in.ReadString(type) || !in.ReadString(subtype)
+                || !in.Read(location) || !in.Read(numTags))
+                return false;
+            cfg.SetType(type);
+            cfg.SetSubtype(subtype);
+            cfg.SetLocation(location);
+            for (uint32_t i = 0; i < numTags; i++) {
+                string tag;
+                if (!in.ReadString(tag))
+                    return false;
+                cfg.AddTag(tag);
+            }
+
+            if (!in.Read(baselineThreshold) || !in.Read(discriminationStart) || !in.ReadFilter(trigger)
+                || !in.ReadFilter(energy) || !in.Read(traceDelay) || !in.Read(waveformLow) || !in.Read(waveformHigh))
+                return false;
+            cfg.SetBaselineThreshold(baselineThreshold);
+            cfg.SetDiscriminationStartInSamples(discriminationStart);
+            cfg.SetTriggerFilterParameters(trigger);
+            cfg.SetEnergyFilterParameters(energy);
+            cfg.SetTraceDelayInSamples(traceDelay);
+            cfg.SetWaveformBoundsInSamples(make_pair(waveformLow, waveformHigh));
+
+            TimingConfiguration timing;
+            double beta, fraction, gamma, qdc;
+            uint32_t delay, gap, length;
+            uint8_t isFastSiPm;
+            if (!in.Read(beta) || !in.Read(delay) || !in.Read(fraction) || !in.Read(gamma) || !in.Read(gap)
+                || !in.Read(isFastSiPm) || !in.Read(length) || !in.Read(qdc))
+                return false;
+            timing.SetBeta(beta);
+            timing.SetDelay(delay);
+            timing.SetFraction(fraction);
+            timing.SetGamma(gamma);
+            timing.SetGap(gap);
+            timing.SetIsFastSiPm(isFastSiPm != 0);
+            timing.SetLength(length);
+            timing.SetQdc(qdc);
+            cfg.SetTimingConfiguration(timing);
+
+            if (!in.ReadCorrections(it->calibrations) || !in.ReadCorrections(it->walks))
+                return false;
+        }
+
+        return in.IsAtEnd();
+    }
+}
+
+const uint32_t ConfigurationCache::version;
+
+uint64_t ConfigurationCache::Hash(const std::string &a) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (string::const_iterator it = a.begin(); it != a.end(); it++) {
+        hash ^= (unsigned char) *it;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool ConfigurationCache::Load(const std::string &fileName, const uint64_t &key) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    Reader in(static_cast<const char *>(data), (size_t) info.st_size);
+    vector<ChannelRecord> records;
+    bool isLoaded = Decode(in, key, records);
+    munmap(data, (size_t) info.st_size);
+
+    if (isLoaded)
+        records_.swap(records);
+    return isLoaded;
+}
+
+bool ConfigurationCache::Save(const std::string &fileName, const uint64_t &key) const {
+    string out;
+    Write(out, magicWord);
+    Write(out, version);
+    Write(out, key);
+    Write(out, (uint32_t) records_.size());
+
+    for (vector<ChannelRecord>::const_iterator it = records_.begin(); it != records_.end(); it++) {
+        const ChannelConfiguration &cfg = it->configuration;
+        Write(out, it->module);
+        Write(out, it->channel);
+        WriteString(out, cfg.GetType());
+        WriteString(out, cfg.GetSubtype());
+        Write(out, (uint32_t) cfg.GetLocation());
+
+        set<string> tags = cfg.GetTags();
+        Write(out, (uint32_t) tags.size());
+        for (set<string>::const_iterator tag = tags.begin(); tag != tags.end(); tag++)
+            WriteString(out, *tag);
+
+        Write(out, cfg.GetBaselineThreshold());
+        Write(out, (uint32_t) cfg.GetDiscriminationStartInSamples());
+        WriteFilter(out, cfg.GetTriggerFilterParameters());
+        WriteFilter(out, cfg.GetEnergyFilterParameters());
+        Write(out, (uint32_t) cfg.GetTraceDelayInSamples());
+        Write(out, (uint32_t) cfg.GetWaveformBoundsInSamples().first);
+        Write(out, (uint32_t) cfg.GetWaveformBoundsInSamples().second);
+
+        TimingConfiguration timing = cfg.GetTimingConfiguration();
+        Write(out, timing.GetBeta());
+        Write(out, (uint32_t) timing.GetDelay());
+        Write(out, timing.GetFraction());
+        Write(out, timing.GetGamma());
+        Write(out, (uint32_t) timing.GetGap());
+        Write(out, (uint8_t) timing.IsFastSiPm());
+        Write(out, (uint32_t) timing.GetLength());
+        Write(out, timing.GetQdc());
+
+        WriteCorrections(out, it->calibrations);
+        WriteCorrections(out, it->walks);
+    }
+
+    string temporary = fileName + ".tmp";
+    ofstream file(temporary.c_str(), ios::binary | ios::trunc);
+    if (!file)
+        return false;
+    file.write(out.data(), out.size());
+    file.close();
+    if (!file) {
+        remove(temporary.c_str());
+        return false;
+    }
+    return rename(temporary.c_str(), fileName.c_str()) == 0;
+}
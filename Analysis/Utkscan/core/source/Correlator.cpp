@@ -34,6 +34,7 @@ namespace dammIds {
         const int D_CONDITION = 0;//!< Conditions
         const int D_TIME_BW_IMPLANTS = 1;//!< Time between implants
         const int D_TIME_BW_ALL_IMPLANTS = 2;//!< Time between all implants
+        const int D_LIVE_CHAINS = 3;//!< Number of live decay chains
     }
 } // correlator namespace
 
@@ -42,7 +43,25 @@ const double Correlator::minImpTime = 5e-3;
 const double Correlator::corrTime = 60; // used to be 3300
 const double Correlator::fastTime = 40e-6;
 
-Correlator::Correlator() : histo(OFFSET, RANGE, "correlator"), lastImplant(NULL), lastDecay(NULL), condition(UNKNOWN_CONDITION) {
+Correlator::Correlator() : histo(OFFSET, RANGE, "correlator"), lastImplantTime(NAN), lastDecayTime(NAN),
+                           condition(UNKNOWN_CONDITION), xSize_(defaultArraySize), ySize_(defaultArraySize) {
+    Initialize();
+}
+
+Correlator::Correlator(const unsigned int &xSize, const unsigned int &ySize) :
+        histo(OFFSET, RANGE, "correlator"), lastImplantTime(NAN), lastDecayTime(NAN), condition(UNKNOWN_CONDITION),
+        xSize_(xSize), ySize_(ySize) {
+    Initialize();
+}
+
+void Correlator::Initialize() {
+    const unsigned int numPixels = xSize_ * ySize_;
+    decaylist_.resize(numPixels);
+    expiredImplants_.assign(numPixels, EventInfo());
+    livePosition_.assign(numPixels, -1);
+    wheel_.resize(numWheelSlots);
+    wheelSlotWidth_ = corrTime / Globals::get()->GetFilterClockInSeconds() / numWheelSlots;
+    wheelTick_ = -1;
 }
 
 EventInfo::EventInfo() {
@@ -156,13 +175,12 @@ void CorrelationList::PrintDecayList() const {
 }
 
 Correlator::~Correlator() {
+    cout << "Correlator : " << livePixels_.size() << " live decay chains using " << GetMemoryFootprint() / 1024.
+         << " kB at the end of the scan." << endl;
     // dump any flagged decay lists which have not been output
-    for (unsigned int i = 0; i < arraySize; i++) {
-        for (unsigned int j = 0; j < arraySize; j++) {
-            if (IsFlagged(i, j))
-                PrintDecayList(i, j);
-        }
-    }
+    for (vector<unsigned int>::const_iterator it = livePixels_.begin(); it != livePixels_.end(); it++)
+        if (decaylist_[*it].IsFlagged())
+            PrintDecayList(*it / ySize_, *it % ySize_);
 }
 
 void Correlator::DeclarePlots() {
@@ -171,16 +189,20 @@ void Correlator::DeclarePlots() {
     DeclareHistogram1D(D_CONDITION, S9, "Correlator condition");
     DeclareHistogram1D(D_TIME_BW_IMPLANTS, S9, "time between implants, 100 ms/bin");
     DeclareHistogram1D(D_TIME_BW_ALL_IMPLANTS, SA, "time between all implants, 1 us/bin");
+    DeclareHistogram1D(D_LIVE_CHAINS, SE, "number of live decay chains at implant");
 }
 
 void Correlator::Correlate(EventInfo &event, unsigned int fch,
                            unsigned int bch) {
-    if (fch >= arraySize || bch >= arraySize) {
+    if (fch >= xSize_ || bch >= ySize_) {
         plot(D_CONDITION, INVALID_LOCATION);
         return;
     }
 
-    CorrelationList &theList = decaylist[fch][bch];
+    AdvanceWheel(event.time);
+
+    const unsigned int pixel = GetPixel(fch, bch);
+    CorrelationList &theList = decaylist_[pixel];
 
     double lastTime = NAN;
     double clockInSeconds = Globals::get()->GetFilterClockInSeconds();
@@ -191,10 +213,12 @@ void Correlator::Correlate(EventInfo &event, unsigned int fch,
                 PrintDecayList(fch, bch);
 
             lastTime = GetImplantTime(fch, bch);
+            if (std::isnan(lastTime))
+                lastTime = expiredImplants_[pixel].time;
             theList.clear();
             condition = VALID_IMPLANT;
-            if (lastImplant != NULL) {
-                double dt = event.time - lastImplant->time;
+            if (!std::isnan(lastImplantTime)) {
+                double dt = event.time - lastImplantTime;
                 plot(D_TIME_BW_ALL_IMPLANTS, dt * clockInSeconds / 1e-6);
             }
             if (!std::isnan(lastTime)) {
@@ -206,11 +230,26 @@ void Correlator::Correlate(EventInfo &event, unsigned int fch,
             }
             event.generation = 0;
             theList.push_back(event);
-            lastImplant = &theList.back();
+            lastImplantTime = event.time;
+            expiredImplants_[pixel].time = NAN;
+            AddLivePixel(pixel);
+            ScheduleExpiry(pixel, event.time);
+            plot(D_LIVE_CHAINS, livePixels_.size());
             break;
         default:
-            if (theList.empty())
+            if (theList.empty()) {
+                //The wheel expired the chain, we handle the decay as if the chain was still there.
+                const EventInfo &implant = expiredImplants_[pixel];
+                if (std::isnan(implant.time))
+                    break;
+                if (implant.dtime * clockInSeconds >= minImpTime) {
+                    condition = DECAY_TOO_LATE;
+                    event.dtime = event.time - implant.time;
+                    expiredImplants_[pixel].time = NAN;
+                } else
+                    condition = IMPLANT_TOO_SOON;
                 break;
+            }
 
             if (std::isnan(theList.GetImplantTime())) {
                 cout << "No implant time for decay list" << endl;
@@ -232,13 +271,7 @@ void Correlator::Correlate(EventInfo &event, unsigned int fch,
                          << "\n  DT: " << dt << endl;
                     // PIXIE's clock has most likely been zeroed due to a file marker
                     //   no chance of doing correlations
-                    for (unsigned int i = 0; i < arraySize; i++) {
-                        for (unsigned int j = 0; j < arraySize; j++) {
-                            if (IsFlagged(i, j))
-                                PrintDecayList(i, j);
-                            decaylist[i][j].clear();
-                        }
-                    }
+                    ClearAll();
                 } else if (event.type != EventInfo::GAMMA_EVENT) {
                     // since gammas are processed at a different time than everything else
                     cout << "negative correlation time, DECAY: " << event.time
@@ -271,9 +304,9 @@ void Correlator::Correlate(EventInfo &event, unsigned int fch,
                 theList.Flag();
 
             if (condition == VALID_DECAY)
-                lastDecay = &theList.back();
+                lastDecayTime = event.dtime;
             else if (condition == DECAY_TOO_LATE)
-                theList.clear();
+                ClearPixel(pixel);
 
             break;
     }
@@ -281,58 +314,185 @@ void Correlator::Correlate(EventInfo &event, unsigned int fch,
 }
 
 void Correlator::CorrelateAll(EventInfo &event) {
-    for (unsigned int fch = 0; fch < arraySize; fch++) {
-        for (unsigned int bch = 0; bch < arraySize; bch++) {
-            if (decaylist[fch][bch].size() == 0)
-                continue;
-            if (event.time - decaylist[fch][bch].back().time < 10e-6 / Globals::get()->GetFilterClockInSeconds())
-                Correlate(event, fch, bch);
-        }
+    AdvanceWheel(event.time);
+    // Correlate may clear chains, so we iterate over a copy of the live pixels
+    scratch_ = livePixels_;
+    for (vector<unsigned int>::const_iterator it = scratch_.begin(); it != scratch_.end(); it++) {
+        if (decaylist_[*it].empty())
+            continue;
+        if (event.time - decaylist_[*it].back().time < 10e-6 / Globals::get()->GetFilterClockInSeconds())
+            Correlate(event, *it / ySize_, *it % ySize_);
     }
 }
 
 void Correlator::CorrelateAllX(EventInfo &event, unsigned int bch) {
-    for (unsigned int fch = 0; fch < arraySize; fch++)
+    for (unsigned int fch = 0; fch < xSize_; fch++)
         Correlate(event, fch, bch);
 }
 
 void Correlator::CorrelateAllY(EventInfo &event, unsigned int fch) {
-    for (unsigned int bch = 0; bch < arraySize; bch++)
+    for (unsigned int bch = 0; bch < ySize_; bch++)
         Correlate(event, fch, bch);
 }
 
+bool Correlator::CorrelateNeighbourhood(EventInfo &event, unsigned int fch, unsigned int bch, unsigned int radius) {
+    if (fch >= xSize_ || bch >= ySize_) {
+        plot(D_CONDITION, INVALID_LOCATION);
+        return false;
+    }
+
+    AdvanceWheel(event.time);
+
+    unsigned int xLow = fch > radius ? fch - radius : 0;
+    unsigned int xHigh = min(fch + radius, xSize_ - 1);
+    unsigned int yLow = bch > radius ? bch - radius : 0;
+    unsigned int yHigh = min(bch + radius, ySize_ - 1);
+
+    double latestImplant = -INFINITY;
+    unsigned int bestX = fch, bestY = bch;
+    for (unsigned int x = xLow; x <= xHigh; x++) {
+        for (unsigned int y = yLow; y <= yHigh; y++) {
+            double implantTime = GetImplantTime(x, y);
+            if (std::isnan(implantTime) || implantTime > event.time || implantTime <= latestImplant)
+                continue;
+            latestImplant = implantTime;
+            bestX = x;
+            bestY = y;
+        }
+    }
+
+    if (std::isinf(latestImplant))
+        return false;
+
+    Correlate(event, bestX, bestY);
+    return true;
+}
+
 double Correlator::GetDecayTime(void) const {
-    if (lastDecay == NULL)
-        return NAN;
-    else
-        return lastDecay->dtime;
+    return lastDecayTime;
 }
 
 double Correlator::GetDecayTime(int fch, int bch) const {
-    return decaylist[fch][bch].GetDecayTime();
+    return decaylist_[GetPixel(fch, bch)].GetDecayTime();
 }
 
 double Correlator::GetImplantTime(void) const {
-    if (lastImplant == NULL)
-        return NAN;
-    else
-        return lastImplant->time;
+    return lastImplantTime;
 }
 
 double Correlator::GetImplantTime(int fch, int bch) const {
-    return decaylist[fch][bch].GetImplantTime();
+    return decaylist_[GetPixel(fch, bch)].GetImplantTime();
 }
 
 void Correlator::Flag(int fch, int bch) {
-    if (!decaylist[fch][bch].empty())
-        decaylist[fch][bch].Flag();
+    if (!decaylist_[GetPixel(fch, bch)].empty())
+        decaylist_[GetPixel(fch, bch)].Flag();
 }
 
 bool Correlator::IsFlagged(int fch, int bch) {
-    return decaylist[fch][bch].IsFlagged();
+    return decaylist_[GetPixel(fch, bch)].IsFlagged();
 }
 
 void Correlator::PrintDecayList(unsigned int fch, unsigned int bch) const {
     cout << "Current decay list for " << fch << " , " << bch << " : " << endl;
-    decaylist[fch][bch].PrintDecayList();
+    decaylist_[GetPixel(fch, bch)].PrintDecayList();
+}
+
+size_t Correlator::GetMemoryFootprint(void) const {
+    size_t bytes = sizeof(Correlator) + decaylist_.capacity() * sizeof(CorrelationList)
+                   + expiredImplants_.capacity() * sizeof(EventInfo) + livePosition_.capacity() * sizeof(int)
+                   + (livePixels_.capacity() + scratch_.capacity()) * sizeof(unsigned int);
+
+    for (vector<unsigned int>::const_iterator it = livePixels_.begin(); it != livePixels_.end(); it++)
+        bytes += decaylist_[*it].capacity() * sizeof(EventInfo);
+
+    for (vector<vector<pair<unsigned int, double> > >::const_iterator it = wheel_.begin(); it != wheel_.end(); it++)
+        bytes += sizeof(*it) + it->capacity() * sizeof(pair<unsigned int, double>);
+
+    return bytes;
+}
+
+void Correlator::AddLivePixel(const unsigned int &pixel) {
+    if (livePosition_[pixel] >= 0)
+        return;
+    livePosition_[pixel] = (int) livePixels_.size();
+    livePixels_.push_back(pixel);
+}
+
+void Correlator::ClearPixel(const unsigned int &pixel) {
+    if (decaylist_[pixel].IsFlagged())
+        PrintDecayList(pixel / ySize_, pixel % ySize_);
+
+    //Swap the storage out so that expired chains do not keep their memory
+    CorrelationList().swap(decaylist_[pixel]);
+
+    int position = livePosition_[pixel];
+    if (position < 0)
+        return;
+    unsigned int last = livePixels_.back();
+    livePixels_[position] = last;
+    livePosition_[last] = position;
+    livePixels_.pop_back();
+    livePosition_[pixel] = -1;
+}
+
+void Correlator::ClearAll(void) {
+    while (!livePixels_.empty())
+        ClearPixel(livePixels_.back());
+    for (vector<vector<pair<unsigned int, double> > >::iterator it = wheel_.begin(); it != wheel_.end(); it++)
+        it->clear();
+    expiredImplants_.assign(expiredImplants_.size(), EventInfo());
+    wheelTick_ = -1;
+}
+
+void Correlator::ScheduleExpiry(const unsigned int &pixel, const double &time) {
+    long long slot = (long long) ceil((time + numWheelSlots * wheelSlotWidth_) / wheelSlotWidth_);
+    wheel_[slot % numWheelSlots].push_back(make_pair(pixel, time));
+}
+
+void Correlator::AdvanceWheel(const double &time) {
+    if (std::isnan(time) || time < 0)
+        return;
+
+    long long tick = (long long) floor(time / wheelSlotWidth_);
+    if (wheelTick_ < 0) {
+        wheelTick_ = tick;
+        return;
+    }
+    if (tick <= wheelTick_) {
+        //PIXIE's clock was most likely zeroed, nothing that is live can be correlated with what follows.
+        if (time - wheelTick_ * wheelSlotWidth_ < -5e11) {
+            cout << "Correlator::AdvanceWheel - Event following pixie clock reset, clearing decay lists!" << endl;
+            ClearAll();
+            wheelTick_ = tick;
+        }
+        return;
+    }
+
+    //If we jumped more than a revolution every slot needs to be visited once.
+    long long last = min(tick, wheelTick_ + (long long) numWheelSlots);
+    const double corrTicks = numWheelSlots * wheelSlotWidth_;
+
+    for (long long i = wheelTick_ + 1; i <= last; i++) {
+        vector<pair<unsigned int, double> > &slot = wheel_[i % numWheelSlots];
+        unsigned int kept = 0;
+        for (unsigned int j = 0; j < slot.size(); j++) {
+            const unsigned int pixel = slot[j].first;
+            const CorrelationList &theList = decaylist_[pixel];
+
+            //The entry is stale if the pixel was re-implanted or cleared since it was scheduled.
+            if (theList.empty() || theList.GetImplantTime() != slot[j].second)
+                continue;
+
+            if (time - slot[j].second < corrTicks) {
+                slot[kept++] = slot[j];
+                continue;
+            }
+
+            expiredImplants_[pixel] = theList.front();
+            ClearPixel(pixel);
+        }
+        slot.resize(kept);
+    }
+    wheelTick_ = tick;
 }
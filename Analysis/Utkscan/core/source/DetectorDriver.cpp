@@ -5,6 +5,7 @@
 */
 #include "DetectorDriver.hpp"
 
+#include "ColumnarWriter.hpp"
 #include "DammPlotIds.hpp"
 #include "DetectorDriverXmlParser.hpp"
 #include "DetectorLibrary.hpp"
@@ -37,7 +38,7 @@ DetectorDriver *DetectorDriver::get() {
     return instance;
 }
 
-DetectorDriver::DetectorDriver() : histo_(OFFSET, RANGE, "DetectorDriver") {
+DetectorDriver::DetectorDriver() : histo_(OFFSET, RANGE, "DetectorDriver"), columnarWriter_(NULL) {
     try {
         DetectorDriverXmlParser parser;
         parser.ParseNode(this);
@@ -55,6 +56,9 @@ DetectorDriver::DetectorDriver() : histo_(OFFSET, RANGE, "DetectorDriver") {
 }
 
 DetectorDriver::~DetectorDriver() {
+    delete columnarWriter_;
+    columnarProcessors_.clear();
+
     for (vector<EventProcessor *>::iterator it = vecProcess.begin(); it != vecProcess.end(); it++)
         delete (*it);
     vecProcess.clear();
@@ -76,8 +80,22 @@ void DetectorDriver::Init(RawEvent &rawev) {
         (*it)->SetLevel(20);
     }
 
+    BuildAnalyzerPlans();
+
+    ScheduleProcessors();
     for (vector<EventProcessor *>::iterator it = vecProcess.begin(); it != vecProcess.end(); it++)
         (*it)->Init(rawev);
+    BuildTypeMasks();
+
+    if (Globals::get()->HasColumnarOutput()) {
+        columnarWriter_ = new ColumnarWriter(Globals::get()->GetOutputPath()
+                                             + Globals::get()->GetOutputFileName() + ".col",
+                                             Globals::get()->GetColumnarRowsPerChunk(),
+                                             Globals::get()->IsColumnarOutputCompressed());
+        for (vector<EventProcessor *>::iterator it = vecProcess.begin(); it != vecProcess.end(); it++)
+            if ((*it)->AddBranch(*columnarWriter_))
+                columnarProcessors_.push_back(*it);
+    }
 
     walk_ = DetectorLibrary::get()->GetWalkCorrections();
     cali_ = DetectorLibrary::get()->GetCalibrations();
@@ -86,11 +104,15 @@ void DetectorDriver::Init(RawEvent &rawev) {
 void DetectorDriver::ProcessEvent(RawEvent &rawev) {
     histo_.Plot(dammIds::raw::D_NUMBER_OF_EVENTS, dammIds::GENERIC_CHANNEL);
     try {
+        uint64_t eventMask = 0;
         for (vector<ChanEvent *>::const_iterator it = rawev.GetEventList().begin(); it != rawev.GetEventList().end(); ++it) {
             PlotRaw((*it));
             ThreshAndCal((*it), rawev);
             PlotCal((*it));
 
+            if ((*it)->GetID() < channelMasks_.size())
+                eventMask |= channelMasks_[(*it)->GetID()];
+
             string place = (*it)->GetChanID().GetPlaceName();
             if (place == "__9999")
                 continue;
@@ -108,14 +130,22 @@ void DetectorDriver::ProcessEvent(RawEvent &rawev) {
 
         //!First round is preprocessing, where process result must be guaranteed
         //!to not to be dependent on results of other Processors.
-        for (vector<EventProcessor *>::iterator iProc = vecProcess.begin(); iProc != vecProcess.end(); iProc++)
-            if ((*iProc)->HasEvent())
-                (*iProc)->PreProcess(rawev);
+        for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++)
+            if (eventMask & processorMasks_[i])
+                vecProcess[i]->PreProcess(rawev);
         ///In the second round the Process is called, which may depend on other
-        ///Processors.
-        for (vector<EventProcessor *>::iterator iProc = vecProcess.begin(); iProc != vecProcess.end(); iProc++)
-            if ((*iProc)->HasEvent())
-                (*iProc)->Process(rawev);
+        ///Processors. ScheduleProcessors put those other Processors first.
+        for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++)
+            if (eventMask & processorMasks_[i])
+                vecProcess[i]->Process(rawev);
+        ///Every event gets a row in the columnar output, the processors zero
+        ///their structures in FillBranch when they didn't have an event.
+        if (!columnarProcessors_.empty()) {
+            for (vector<EventProcessor *>::iterator it = columnarProcessors_.begin();
+                 it != columnarProcessors_.end(); it++)
+                (*it)->FillBranch();
+            columnarWriter_->Fill();
+        }
         // Clear all places in correlator (if of resetable type)
         for (map<string, Place *>::iterator it = TreeCorrelator::get()->places_.begin();
              it != TreeCorrelator::get()->places_.end(); ++it)
@@ -185,13 +215,11 @@ void DetectorDriver::DeclarePlots() {
 }
 
 int DetectorDriver::ThreshAndCal(ChanEvent *chan, RawEvent &rawev) {
-    ChannelConfiguration chanCfg = chan->GetChanID();
+    const ChannelConfiguration &chanCfg = chan->GetChanID();
     int id = chan->GetID();
-    string type = chanCfg.GetType();
-    string subtype = chanCfg.GetSubtype();
-    set<string> tags = chanCfg.GetTags();
+    const string &type = chanCfg.GetType();
+    const string &subtype = chanCfg.GetSubtype();
     bool hasStartTag = chanCfg.HasTag("start");
-    Trace &trace = chan->GetTrace();
 
     RandomInterface *randoms = RandomInterface::get();
 
@@ -200,10 +228,15 @@ int DetectorDriver::ThreshAndCal(ChanEvent *chan, RawEvent &rawev) {
     if (type == "ignore" || type == "")
         return (0);
 
+    Trace &trace = chan->GetTrace();
+
     if (!trace.empty()) {
         histo_.Plot(D_HAS_TRACE, id);
 
-        for (vector<TraceAnalyzer *>::iterator it = vecAnalyzer.begin(); it != vecAnalyzer.end(); it++)
+        //Channels that were not set in the map when we started have no plan and get the whole chain.
+        const vector<TraceAnalyzer *> &plan =
+                (unsigned int) id < analyzerPlans_.size() && hasAnalyzerPlan_[id] ? analyzerPlans_[id] : vecAnalyzer;
+        for (vector<TraceAnalyzer *>::const_iterator it = plan.begin(); it != plan.end(); it++)
             (*it)->Analyze(trace, chanCfg);
 
         //We are going to handle the filtered energies here.
@@ -263,6 +296,118 @@ int DetectorDriver::PlotCal(const ChanEvent *chan) {
     return (0);
 }
 
+void DetectorDriver::BuildAnalyzerPlans(void) {
+    DetectorLibrary *lib = DetectorLibrary::get();
+    analyzerPlans_.assign(lib->size(), vector<TraceAnalyzer *>());
+    hasAnalyzerPlan_.assign(lib->size(), false);
+    for (DetectorLibrary::size_type i = 0; i < lib->size(); i++) {
+        if (!lib->HasValue(i))
+            continue;
+        hasAnalyzerPlan_[i] = true;
+        const ChannelConfiguration &cfg = lib->at(i);
+        for (vector<TraceAnalyzer *>::const_iterator it = vecAnalyzer.begin(); it != vecAnalyzer.end(); it++)
+            if ((*it)->AppliesTo(cfg))
+                analyzerPlans_[i].push_back(*it);
+    }
+}
+
+void DetectorDriver::BuildTypeMasks(void) {
+    DetectorLibrary *lib = DetectorLibrary::get();
+    const set<string> &usedTypes = lib->GetUsedDetectors();
+    if (usedTypes.size() > 64) {
+        stringstream ss;
+        ss << "DetectorDriver::BuildTypeMasks - There are " << usedTypes.size()
+           << " detector types in the Map, but the event masks only hold 64.";
+        throw PaassException(ss.str());
+    }
+
+    map<string, uint64_t> bitOfType;
+    unsigned int bit = 0;
+    for (set<string>::const_iterator it = usedTypes.begin(); it != usedTypes.end(); it++)
+        bitOfType[*it] = (uint64_t) 1 << bit++;
+
+    //ThreshAndCal does not add these channels to the summaries, so they never count as an event.
+    channelMasks_.assign(lib->size(), 0);
+    for (DetectorLibrary::size_type i = 0; i < lib->size(); i++) {
+        if (!lib->HasValue(i))
+            continue;
+        string type = lib->at(i).GetType();
+        if (type == "ignore" || type == "")
+            continue;
+        channelMasks_[i] = bitOfType[type];
+    }
+
+    processorMasks_.clear();
+    for (vector<EventProcessor *>::const_iterator it = vecProcess.begin(); it != vecProcess.end(); it++) {
+        uint64_t mask = 0;
+        for (set<string>::const_iterator type = (*it)->GetTypes().begin(); type != (*it)->GetTypes().end(); type++) {
+            map<string, uint64_t>::const_iterator found = bitOfType.find(*type);
+            if (found != bitOfType.end())
+                mask |= found->second;
+        }
+        processorMasks_.push_back(mask);
+    }
+}
+
+void DetectorDriver::ScheduleProcessors(void) {
+    Messenger m;
+    map<string, vector<EventProcessor *>::size_type> indexOfName;
+    for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++)
+        indexOfName.insert(make_pair(vecProcess[i]->GetName(), i));
+
+    vector<set<vector<EventProcessor *>::size_type> > successors(vecProcess.size());
+    vector<unsigned int> numInputs(vecProcess.size(), 0);
+    for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++) {
+        const set<string> &dependencies = vecProcess[i]->GetDependencies();
+        for (set<string>::const_iterator it = dependencies.begin(); it != dependencies.end(); it++) {
+            map<string, vector<EventProcessor *>::size_type>::const_iterator input = indexOfName.find(*it);
+            if (input == indexOfName.end()) {
+                m.detail(vecProcess[i]->GetName() + " uses the results of " + *it + ", which is not in the list of "
+                        "processors.");
+                continue;
+            }
+            if (input->second != i && successors[input->second].insert(i).second)
+                numInputs[i]++;
+        }
+    }
+
+    //We always take the ready processor that comes first in the configuration file, so that the order only changes
+    // where a dependency requires it.
+    set<vector<EventProcessor *>::size_type> ready;
+    for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++)
+        if (numInputs[i] == 0)
+            ready.insert(i);
+
+    vector<EventProcessor *> ordered;
+    while (!ready.empty()) {
+        vector<EventProcessor *>::size_type i = *ready.begin();
+        ready.erase(ready.begin());
+        ordered.push_back(vecProcess[i]);
+        for (set<vector<EventProcessor *>::size_type>::const_iterator it = successors[i].begin();
+             it != successors[i].end(); it++)
+            if (--numInputs[*it] == 0)
+                ready.insert(*it);
+    }
+
+    if (ordered.size() != vecProcess.size()) {
+        stringstream ss;
+        ss << "DetectorDriver::ScheduleProcessors - The dependencies of the following processors form a cycle :";
+        for (vector<EventProcessor *>::size_type i = 0; i < vecProcess.size(); i++)
+            if (numInputs[i] != 0)
+                ss << " " << vecProcess[i]->GetName();
+        throw PaassException(ss.str());
+    }
+
+    if (ordered != vecProcess) {
+        stringstream ss;
+        ss << "Processors were reordered to satisfy their dependencies :";
+        for (vector<EventProcessor *>::const_iterator it = ordered.begin(); it != ordered.end(); it++)
+            ss << " " << (*it)->GetName();
+        m.detail(ss.str());
+    }
+    vecProcess.swap(ordered);
+}
+
 EventProcessor *DetectorDriver::GetProcessor(const std::string &name) const {
     for (vector<EventProcessor *>::const_iterator it = vecProcess.begin(); it != vecProcess.end(); it++)
         if ((*it)->GetName() == name)
@@ -91,7 +91,7 @@ vector<EventProcessor *> DetectorDriverXmlParser::ParseProcessors(const pugi::xm
         } else if (name == "CloverProcessor") {
             ///@TODO This needs to be cleaned. No method should have this
             /// many variables as arguments.
-            vecProcess.push_back(new CloverProcessor(
+            CloverProcessor *clover = new CloverProcessor(
                     processor.attribute("gamma_threshold").as_double(1.0),
                     processor.attribute("low_ratio").as_double(1.0),
                     processor.attribute("high_ratio").as_double(3.0),
@@ -101,17 +101,24 @@ vector<EventProcessor *> DetectorDriverXmlParser::ParseProcessors(const pugi::xm
                     processor.attribute("cycle_gate1_min").as_double(0.0),
                     processor.attribute("cycle_gate1_max").as_double(0.0),
                     processor.attribute("cycle_gate2_min").as_double(0.0),
-                    processor.attribute("cycle_gate2_max").as_double(0.0)));
+                    processor.attribute("cycle_gate2_max").as_double(0.0));
+            if (processor.attribute("coincidence_bins").as_uint(0) != 0)
+                clover->SetCoincidenceStore(processor.attribute("coincidence_bins").as_uint(),
+                                            processor.attribute("coincidence_bin_width").as_double(1.0));
+            vecProcess.push_back(clover);
         } else if (name == "DoubleBetaProcessor") {
             vecProcess.push_back(new DoubleBetaProcessor());
         } else if (name == "DssdProcessor") {
-            vecProcess.push_back(new DssdProcessor());
+            vecProcess.push_back(new DssdProcessor(processor.attribute("num_front_strips").as_uint(40),
+                                                   processor.attribute("num_back_strips").as_uint(40),
+                                                   processor.attribute("correlation_radius").as_uint(0)));
         } else if (name == "GeProcessor") {
             vecProcess.push_back(new GeProcessor());
         } else if (name == "Hen3Processor") {
             vecProcess.push_back(new Hen3Processor());
         } else if (name == "ImplantSsdProcessor") {
-            vecProcess.push_back(new ImplantSsdProcessor());
+            vecProcess.push_back(new ImplantSsdProcessor(processor.attribute("num_strips").as_uint(40),
+                                                         processor.attribute("num_positions").as_uint(40)));
         } else if (name == "IonChamberProcessor") {
             vecProcess.push_back(new IonChamberProcessor());
         } else if (name == "LiquidScintProcessor") {
@@ -11,6 +11,7 @@
 
 #include "Constants.hpp"
 #include "DetectorLibrary.hpp"
+#include "Globals.hpp"
 #include "MapNodeXmlParser.hpp"
 #include "Messenger.hpp"
 
@@ -85,7 +86,7 @@ unsigned int DetectorLibrary::GetNextLocation(const std::string &type, const std
 }
 
 unsigned int DetectorLibrary::GetIndex(int mod, int chan) const {
-    return mod * Pixie16::maximumNumberOfChannels + chan;
+    return mod * Globals::get()->GetTopology().GetChannelsPerModule() + chan;
 }
 
 bool DetectorLibrary::HasValue(int mod, int chan) const {
@@ -96,6 +97,13 @@ bool DetectorLibrary::HasValue(int index) const {
     return ((signed) size() > index && at(index).GetType() != "");
 }
 
+vector<bool> DetectorLibrary::GetKeepMask() const {
+    vector<bool> mask(Globals::get()->GetTopology().GetNumberOfChannels(), false);
+    for (unsigned int i = 0; i < size() && i < mask.size(); i++)
+        mask[i] = HasValue(i) && at(i).GetType() != "ignore";
+    return mask;
+}
+
 void DetectorLibrary::Set(int index, const ChannelConfiguration &value) {
     if (knownDetectors.find(value.GetType()) == knownDetectors.end())
         knownDetectors.insert(value.GetType());
@@ -103,7 +111,7 @@ void DetectorLibrary::Set(int index, const ChannelConfiguration &value) {
     unsigned int module = ModuleFromIndex(index);
     if (module >= numModules) {
         numModules = module + 1;
-        resize(numModules * Pixie16::maximumNumberOfChannels);
+        resize(numModules * Globals::get()->GetTopology().GetChannelsPerModule());
         if (!value.HasTag("virtual"))
             numPhysicalModules = module + 1;
     }
@@ -147,11 +155,11 @@ const set <string> &DetectorLibrary::GetUsedDetectors(void) const {
 }
 
 int DetectorLibrary::ModuleFromIndex(int index) const {
-    return int(index / Pixie16::maximumNumberOfChannels);
+    return int(index / Globals::get()->GetTopology().GetChannelsPerModule());
 }
 
 int DetectorLibrary::ChannelFromIndex(int index) const {
-    return (index % Pixie16::maximumNumberOfChannels);
+    return (index % Globals::get()->GetTopology().GetChannelsPerModule());
 }
 
 DetectorLibrary::mapkey_t DetectorLibrary::MakeKey(const std::string &type, const std::string &subtype) const {
@@ -55,7 +55,19 @@ Globals::Globals(const std::string &file) {
 void Globals::InitializeMemberVariables() {
     sysClockFreqInHz_ = sysconf(_SC_CLK_TCK);
     hasRawHistogramsDefined_ = true;
-    outputFilename_ = outputPath_ = revision_ = "";
+    hasLazyDecoding_ = false;
+    topology_ = XiaTopology();
+    maxMergeBufferedHits_ = 1000000;
+    reorderWindowInTicks_ = clockResetThresholdInTicks_ = 0;
+    rootFlushBudgetInBytes_ = 0;
+    rootFlushIntervalInSeconds_ = 2;
+    treeCompressionThreads_ = 1;
+    treeQueueSize_ = 10000;
+    hasColumnarOutput_ = false;
+    columnarRowsPerChunk_ = 65536;
+    isColumnarOutputCompressed_ = true;
+    defaultEventWindow_ = std::make_pair(0.0, 0.0);
+    bananaFile_ = outputFilename_ = outputPath_ = revision_ = "";
     eventLengthInTicks_ = 0;
     adcClockInSeconds_ = clockInSeconds_ = eventLengthInSeconds_ =
     filterClockInSeconds_ = vandleBigSpeedOfLight_ =
@@ -3,6 +3,7 @@
 ///@author S. V. Paulauskas, K. Miernik
 ///@date February 09, 2017
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <string>
 
@@ -98,15 +99,184 @@ void GlobalsXmlParser::ParseGlobalNode(const pugi::xml_node &node, Globals *glob
     } else
         throw invalid_argument(CriticalNodeMessage("EventWidth"));
 
+    if (!node.child("EventBuilder").empty())
+        ParseEventBuilder(node.child("EventBuilder"), globals);
+
+    if (!node.child("ReorderWindow").empty()) {
+        double windowInSeconds = Conversions::ConvertSecondsWithPrefix(
+                node.child("ReorderWindow").attribute("value").as_double(0),
+                node.child("ReorderWindow").attribute("unit").as_string("None"));
+        globals->SetReorderWindowInTicks(windowInSeconds / globals->GetClockInSeconds());
+        sstream_ << "Re-ordering window: " << windowInSeconds * 1e6 << " us, i.e. "
+                 << globals->GetReorderWindowInTicks() << " pixie16 clock ticks.";
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+
+    if (!node.child("ClockResetThreshold").empty())
+        globals->SetClockResetThresholdInTicks(Conversions::ConvertSecondsWithPrefix(
+                node.child("ClockResetThreshold").attribute("value").as_double(0),
+                node.child("ClockResetThreshold").attribute("unit").as_string("None")) / globals->GetClockInSeconds());
+    else
+        globals->SetClockResetThresholdInTicks(1.0 / globals->GetClockInSeconds());
+
     if (!node.child("HasRaw").empty())
         globals->SetHasRawHistogramsDefined(node.child("HasRaw").attribute("value").as_bool(true));
     else
         globals->SetHasRawHistogramsDefined(true);
 
-    set <string> knownNodes = {"Revision", "EventWidth", "HasRaw"};
+    if (!node.child("LazyDecoding").empty()) {
+        globals->SetHasLazyDecoding(node.child("LazyDecoding").attribute("value").as_bool(false));
+        if (globals->HasLazyDecoding())
+            messenger_.detail("Traces, QDCs and energy sums will be decoded on demand.");
+    }
+
+    if (!node.child("Topology").empty()) {
+        pugi::xml_node topology = node.child("Topology");
+        globals->SetTopology(XiaTopology(topology.attribute("crates").as_uint(1),
+                                         topology.attribute("modulesPerCrate").as_uint(
+                                                 Pixie16::maximumNumberOfModulesPerCrate),
+                                         topology.attribute("channelsPerModule").as_uint(
+                                                 Pixie16::maximumNumberOfChannels)));
+    }
+    sstream_ << "Topology : " << globals->GetTopology().GetNumberOfCrates() << " crate(s) with "
+             << globals->GetTopology().GetModulesPerCrate() << " modules of "
+             << globals->GetTopology().GetChannelsPerModule() << " channels";
+    messenger_.detail(sstream_.str());
+    sstream_.str("");
+
+    if (!node.child("Merge").empty()) {
+        pugi::xml_node merge = node.child("Merge");
+        globals->SetMaximumMergeBufferedHits(merge.attribute("maxBufferedHits").as_uint(1000000));
+        for (pugi::xml_node source = merge.child("Source"); source; source = source.next_sibling("Source")) {
+            if (source.attribute("number").empty())
+                throw invalid_argument("GlobalsXmlParser::ParseGlobal - Merge/Source nodes need a \"number\" "
+                                               "attribute.");
+            double offsetInSeconds = Conversions::ConvertSecondsWithPrefix(
+                    source.attribute("offset").as_double(0), source.attribute("unit").as_string("ns"));
+            globals->SetClockCorrection(source.attribute("number").as_uint(),
+                                        offsetInSeconds / globals->GetClockInSeconds(),
+                                        source.attribute("drift").as_double(0));
+            sstream_ << "Merge source " << source.attribute("number").as_uint() << " : offset = "
+                     << offsetInSeconds / globals->GetClockInSeconds() << " clock ticks, drift = "
+                     << source.attribute("drift").as_double(0);
+            messenger_.detail(sstream_.str());
+            sstream_.str("");
+        }
+    }
+
+    if (!node.child("RootFlush").empty()) {
+        pugi::xml_node flush = node.child("RootFlush");
+        globals->SetRootFlushIntervalInSeconds(Conversions::ConvertSecondsWithPrefix(
+                flush.attribute("interval").as_double(2), flush.attribute("unit").as_string("s")));
+        globals->SetRootFlushBudgetInBytes((size_t) (flush.attribute("budgetInMb").as_double(0) * 1024 * 1024));
+        sstream_ << "ROOT flush : every " << globals->GetRootFlushIntervalInSeconds() << " s";
+        if (globals->GetRootFlushBudgetInBytes() != 0)
+            sstream_ << ", copying at most " << flush.attribute("budgetInMb").as_double(0) << " MB each time";
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+
+    if (!node.child("TreeOutput").empty())
+        ParseTreeOutput(node.child("TreeOutput"), globals);
+
+    if (!node.child("ColumnarOutput").empty()) {
+        pugi::xml_node columnar = node.child("ColumnarOutput");
+        string compression = columnar.attribute("compression").as_string("lz4");
+        if (compression != "lz4" && compression != "none")
+            throw invalid_argument("GlobalsXmlParser::ParseGlobalNode - The compression of the ColumnarOutput has "
+                                           "to be lz4 or none.");
+        globals->SetColumnarOutput(true, columnar.attribute("rowsPerChunk").as_uint(65536), compression == "lz4");
+        sstream_ << "Columnar output : " << globals->GetColumnarRowsPerChunk() << " rows per chunk, compression "
+                 << compression;
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+
+    if (!node.child("Bananas").empty()) {
+        if (node.child("Bananas").attribute("file").empty())
+            throw invalid_argument("GlobalsXmlParser::ParseGlobalNode - The Bananas node needs a \"file\" "
+                                           "attribute.");
+        globals->SetBananaFileName(node.child("Bananas").attribute("file").as_string());
+        sstream_ << "Banana file : " << globals->GetBananaFileName();
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+
+    set <string> knownNodes = {"Revision", "EventWidth", "HasRaw", "LazyDecoding", "Topology", "Merge",
+                                "ReorderWindow", "ClockResetThreshold", "EventBuilder", "RootFlush", "TreeOutput",
+                                "ColumnarOutput", "Bananas"};
     WarnOfUnknownChildren(node, knownNodes);
 }
 
+///This method parses the TreeOutput node. The threads attribute sets how many
+/// threads compress the baskets of the trees, and queueSize how many entries
+/// may wait for the tree writer thread. Each Tree child gives the compression
+/// algorithm (zlib, lzma, lz4 or zstd) and level of the tree with that name.
+void GlobalsXmlParser::ParseTreeOutput(const pugi::xml_node &node, Globals *globals) {
+    //The algorithms are numbered like ROOT::ECompressionAlgorithm.
+    static const map<string, int> algorithms = {{"zlib", 1}, {"lzma", 2}, {"lz4", 4}, {"zstd", 5}};
+
+    globals->SetTreeCompressionThreads(node.attribute("threads").as_uint(1));
+    globals->SetTreeQueueSize(node.attribute("queueSize").as_uint(10000));
+    sstream_ << "Tree output : " << globals->GetTreeCompressionThreads() << " compression thread(s), "
+             << globals->GetTreeQueueSize() << " queued entries";
+    messenger_.detail(sstream_.str());
+    sstream_.str("");
+
+    for (pugi::xml_node tree = node.child("Tree"); tree; tree = tree.next_sibling("Tree")) {
+        string algorithm = tree.attribute("algorithm").as_string("zlib");
+        if (tree.attribute("name").empty() || algorithms.find(algorithm) == algorithms.end())
+            throw invalid_argument("GlobalsXmlParser::ParseTreeOutput - Tree nodes need a \"name\" and an "
+                                           "\"algorithm\" of zlib, lzma, lz4 or zstd.");
+        unsigned int level = tree.attribute("level").as_uint(1);
+        globals->SetTreeCompressionSettings(tree.attribute("name").as_string(),
+                                            100 * algorithms.find(algorithm)->second + (level > 9 ? 9 : level));
+        sstream_ << "Tree " << tree.attribute("name").as_string() << " : " << algorithm << " level "
+                 << (level > 9 ? 9 : level);
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+}
+
+///This method parses the EventBuilder node. Each Trigger or Window child gives
+/// the pre and post trigger windows of one of the detector types in the Map,
+/// the Trigger children also start events. The types without a window use
+/// the Default child, which is zero before and the event width after the
+/// trigger unless it's given.
+void GlobalsXmlParser::ParseEventBuilder(const pugi::xml_node &node, Globals *globals) {
+    const string unit = node.attribute("unit").as_string("ns");
+    const double ticksPerUnit = Conversions::ConvertSecondsWithPrefix(1.0, unit) / globals->GetClockInSeconds();
+
+    globals->SetDefaultEventWindow(node.child("Default").attribute("pre").as_double(0) * ticksPerUnit,
+                                   node.child("Default").attribute("post").as_double(
+                                           globals->GetEventLengthInTicks() / ticksPerUnit) * ticksPerUnit);
+
+    for (pugi::xml_node window = node.first_child(); window; window = window.next_sibling()) {
+        const string name = window.name();
+        if (name == "Default")
+            continue;
+        if (name != "Trigger" && name != "Window")
+            throw invalid_argument("GlobalsXmlParser::ParseEventBuilder - Unknown node \"" + name + "\", the "
+                    "known nodes are Trigger, Window and Default.");
+        if (window.attribute("type").empty())
+            throw invalid_argument("GlobalsXmlParser::ParseEventBuilder - " + name + " nodes need a \"type\" "
+                    "attribute.");
+
+        double pre = window.attribute("pre").as_double(0) * ticksPerUnit;
+        double post = window.attribute("post").as_double(0) * ticksPerUnit;
+        globals->SetEventWindow(window.attribute("type").as_string(), pre, post, name == "Trigger");
+        sstream_ << name << " " << window.attribute("type").as_string() << " : -" << pre << " / +" << post
+                 << " clock ticks";
+        messenger_.detail(sstream_.str());
+        sstream_.str("");
+    }
+
+    if (globals->GetTriggerTypes().empty())
+        throw invalid_argument("GlobalsXmlParser::ParseEventBuilder - The EventBuilder node needs at least one "
+                                       "Trigger node.");
+}
+
 ///This method parses the Reject node. The rejection regions are regions of
 /// the data files that the user would like to ignore. These rejection
 /// regions must be entered with units of seconds.
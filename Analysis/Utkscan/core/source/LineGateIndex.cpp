@@ -0,0 +1,48 @@
+///@file LineGateIndex.cpp
+///@brief Class that finds all of the line gates containing a value with a single binary search.
+///@date October 17, 2026
+#include "LineGateIndex.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+LineGateIndex::LineGateIndex(const std::vector<std::pair<double, double> > &gates) : numberOfGates_(gates.size()) {
+    if (gates.size() > maximumNumberOfGates)
+        throw invalid_argument("LineGateIndex::LineGateIndex - The index holds at most 64 gates.");
+
+    for (vector<pair<double, double> >::const_iterator it = gates.begin(); it != gates.end(); it++) {
+        edges_.push_back(it->first);
+        edges_.push_back(it->second);
+    }
+    sort(edges_.begin(), edges_.end());
+    edges_.erase(unique(edges_.begin(), edges_.end()), edges_.end());
+
+    atEdge_.assign(edges_.size(), 0);
+    aboveEdge_.assign(edges_.size(), 0);
+    for (vector<pair<double, double> >::size_type i = 0; i < gates.size(); i++) {
+        const double low = min(gates[i].first, gates[i].second), high = max(gates[i].first, gates[i].second);
+        const size_t first = lower_bound(edges_.begin(), edges_.end(), low) - edges_.begin();
+        const size_t last = lower_bound(edges_.begin(), edges_.end(), high) - edges_.begin();
+        for (size_t edge = first; edge <= last; edge++) {
+            atEdge_[edge] |= (uint64_t) 1 << i;
+            if (edge != last)
+                aboveEdge_[edge] |= (uint64_t) 1 << i;
+        }
+    }
+}
+
+uint64_t LineGateIndex::GetMask(const double &value) const {
+    //The first edge above the value, the value is at or above the edge before it.
+    const size_t edge = upper_bound(edges_.begin(), edges_.end(), value) - edges_.begin();
+    if (edge == 0)
+        return 0;
+    return edges_[edge - 1] == value ? atEdge_[edge - 1] : aboveEdge_[edge - 1];
+}
+
+void LineGateIndex::Test(const double *values, const size_t &numberOfValues, std::vector<uint64_t> &masks) const {
+    masks.resize(numberOfValues);
+    for (size_t i = 0; i < numberOfValues; i++)
+        masks[i] = GetMask(values[i]);
+}
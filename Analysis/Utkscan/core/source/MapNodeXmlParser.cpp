@@ -5,14 +5,14 @@
 #include "MapNodeXmlParser.hpp"
 
 #include "DefaultConfigurationValues.hpp"
+#include "Globals.hpp"
 #include "HelperFunctions.hpp"
 #include "StringManipulationFunctions.hpp"
 #include "TreeCorrelator.hpp"
 #include "XmlInterface.hpp"
 
 #include <iostream>
-
-#include <cstring>
+#include <sstream>
 
 using namespace std;
 
@@ -26,23 +26,53 @@ void MapNodeXmlParser::ParseNode(DetectorLibrary *lib) {
     bool isVerboseTree =
             XmlInterface::get()->GetDocument()->child("Configuration").child("Tree").attribute("verbose").as_bool(
                     false);
-    TreeCorrelator *tree = TreeCorrelator::get();
 
     messenger_.start("Loading channels map");
 
+    //The cache is keyed by the whole configuration file and the topology, since both decide how the Map resolves.
+    const XiaTopology &topology = Globals::get()->GetTopology();
+    string cacheFile = map.attribute("cache").as_string("");
+    uint64_t cacheKey = 0;
+    if (!cacheFile.empty()) {
+        stringstream document;
+        XmlInterface::get()->GetDocument()->save(document, "", pugi::format_raw);
+        document << topology.GetNumberOfCrates() << " " << topology.GetModulesPerCrate() << " "
+                 << topology.GetChannelsPerModule();
+        cacheKey = ConfigurationCache::Hash(document.str());
+
+        if (cache_.Load(cacheFile, cacheKey)) {
+            for (vector<ConfigurationCache::ChannelRecord>::const_iterator it = cache_.GetRecords().begin();
+                 it != cache_.GetRecords().end(); it++)
+                ApplyRecord(*it, lib, isVerboseTree);
+            lib->SetCalibrations(calibrations_);
+            lib->SetWalkCorrection(walkCorrector_);
+            messenger_.detail("Loaded " + to_string(cache_.GetRecords().size()) + " channels from the cache " +
+                              cacheFile);
+            messenger_.done();
+            return;
+        }
+    }
+
     //These attributes have reserved meaning, all other attributes of [Channel] are treated as tags
     set<string> reserved = {"number", "type", "subtype", "location", "tags", "firmware", "frequency"};
 
     for (pugi::xml_node module = map.child("Module"); module; module = module.next_sibling("Module")) {
 
         int module_number = module.attribute("number").as_int(-1);
+        unsigned int crate_number = module.attribute("crate").as_uint(0);
 
-        if (module_number < 0) {
+        if (module_number < 0 || (unsigned int) module_number >= topology.GetModulesPerCrate()
+            || crate_number >= topology.GetNumberOfCrates()) {
             sstream_ << "MapNodeXmlParser::ParseNode : User requested illegal module number (" << module_number
-                     << ") in configuration file.";
+                     << ") in crate " << crate_number << " in configuration file. The topology has "
+                     << topology.GetNumberOfCrates() << " crate(s) with " << topology.GetModulesPerCrate()
+                     << " modules.";
             throw PaassException(sstream_.str());
         }
 
+        //The DetectorLibrary counts the modules over all of the crates.
+        module_number += crate_number * topology.GetModulesPerCrate();
+
         if (isVerbose) {
             sstream_ << "Module " << module_number << ":";
             messenger_.detail(sstream_.str());
@@ -50,9 +80,9 @@ void MapNodeXmlParser::ParseNode(DetectorLibrary *lib) {
         }
 
         for (pugi::xml_node channel = module.child("Channel"); channel; channel = channel.next_sibling("Channel")) {
-            unsigned int channelNumber = channel.attribute("number").as_uint(Pixie16::maximumNumberOfChannels);
+            unsigned int channelNumber = channel.attribute("number").as_uint(topology.GetChannelsPerModule());
 
-            if (channelNumber >= Pixie16::maximumNumberOfChannels) {
+            if (channelNumber >= topology.GetChannelsPerModule()) {
                 sstream_ << "MapNodeXmlParser::ParseNode : Illegal channel " << "number (" << channelNumber
                          << ") in configuration file.";
                 throw PaassException(sstream_.str());
@@ -92,9 +122,10 @@ void MapNodeXmlParser::ParseNode(DetectorLibrary *lib) {
             }
 
             TimingConfiguration timingConfiguration;
+            ConfigurationCache::ChannelRecord record;
 
             if (channel.child("Calibration").text())
-                ParseCalibrations(channel.child("Calibration"), chanCfg, isVerbose);
+                ParseCalibrations(channel.child("Calibration"), record.calibrations, isVerbose);
             else if (isVerbose)
                 messenger_.detail("This channel has no calibration associated with it.", 2);
 
@@ -119,31 +150,53 @@ void MapNodeXmlParser::ParseNode(DetectorLibrary *lib) {
                 messenger_.detail("Using default trace settings for this channel.", 2);
 
             if (channel.child("Walk").text())
-                ParseCalibrations(channel.child("Walk"), chanCfg, isVerbose);
+                ParseCalibrations(channel.child("Walk"), record.walks, isVerbose);
             else if (isVerbose)
                 messenger_.detail("This channel is not walk corrected.", 2);
 
-            lib->Set(module_number, channelNumber, chanCfg);
             chanCfg.SetTimingConfiguration(timingConfiguration);
-
-            //Create basic place for TreeCorrelator
-            std::map<string, string> params;
-            params["name"] = chanCfg.GetPlaceName();
-            params["parent"] = "root";
-            params["type"] = "PlaceDetector";
-            params["reset"] = "true";
-            params["fifo"] = "2";
-            params["init"] = "false";
-            tree->createPlace(params, isVerboseTree);
+            record.module = module_number;
+            record.channel = channelNumber;
+            record.configuration = chanCfg;
+            ApplyRecord(record, lib, isVerboseTree);
+            cache_.Add(record);
         }//end loop over channels
     }//end loop over modules
 
     lib->SetCalibrations(calibrations_);
     lib->SetWalkCorrection(walkCorrector_);
+
+    if (!cacheFile.empty() && !cache_.Save(cacheFile, cacheKey))
+        cout << "MapNodeXmlParser::ParseNode : The channel map could not be written to the cache " << cacheFile
+             << ". We will parse the Map node again on the next run." << endl;
     messenger_.done();
 }
 
-void MapNodeXmlParser::ParseCalibrations(const pugi::xml_node &node, const ChannelConfiguration &cfg,
+void MapNodeXmlParser::ApplyRecord(const ConfigurationCache::ChannelRecord &record, DetectorLibrary *lib,
+                                   const bool &isVerboseTree) {
+    const ChannelConfiguration &chanCfg = record.configuration;
+    lib->Set(record.module, record.channel, chanCfg);
+
+    for (vector<ConfigurationCache::Correction>::const_iterator it = record.calibrations.begin();
+         it != record.calibrations.end(); it++)
+        calibrations_.AddChannel(chanCfg, it->model, it->min, it->max, it->parameters);
+    for (vector<ConfigurationCache::Correction>::const_iterator it = record.walks.begin();
+         it != record.walks.end(); it++)
+        walkCorrector_.AddChannel(chanCfg, it->model, it->min, it->max, it->parameters);
+
+    //Create basic place for TreeCorrelator
+    std::map<string, string> params;
+    params["name"] = chanCfg.GetPlaceName();
+    params["parent"] = "root";
+    params["type"] = "PlaceDetector";
+    params["reset"] = "true";
+    params["fifo"] = "2";
+    params["init"] = "false";
+    TreeCorrelator::get()->createPlace(params, isVerboseTree);
+}
+
+void MapNodeXmlParser::ParseCalibrations(const pugi::xml_node &node,
+                                         std::vector<ConfigurationCache::Correction> &corrections,
                                          const bool &isVerbose) {
     for (pugi::xml_node cal = node; cal; cal = cal.next_sibling(node.name())) {
         string model = cal.attribute("model").as_string("None");
@@ -172,10 +225,12 @@ void MapNodeXmlParser::ParseCalibrations(const pugi::xml_node &node, const Chann
             sstream_.str("");
         }
 
-        if (strcmp(node.name(), "Calibration") == 0)
-            calibrations_.AddChannel(cfg, model, min, max, parameters);
-        if (strcmp(node.name(), "Walk") == 0)
-            walkCorrector_.AddChannel(cfg, model, min, max, parameters);
+        ConfigurationCache::Correction correction;
+        correction.model = model;
+        correction.min = min;
+        correction.max = max;
+        correction.parameters = parameters;
+        corrections.push_back(correction);
     }
 }
 
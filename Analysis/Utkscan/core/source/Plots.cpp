@@ -2,6 +2,7 @@
  * \brief Implement a block declaration scheme for DAMM plots
  * @authors D. Miller, K. Miernik, S. V. Paulauskas
  */
+#include "Globals.hpp"
 #include "Plots.hpp"
 #include "PaassExceptions.hpp"
 
@@ -16,6 +17,9 @@
 
 using namespace std;
 
+std::map<unsigned int, PolygonGate> Plots::bananas_;
+bool Plots::hasReadBananas_ = false;
+
 Plots::Plots(int offset, int range, std::string name) {
     offset_ = offset;
     range_ = range;
@@ -29,7 +33,13 @@ bool Plots::BananaTest(const int &id, const double &x, const double &y) {
 #ifdef USE_HRIBF
     return (bantesti_(id, round(x), round(y)));
 #else
-    return false;
+    if (!hasReadBananas_) {
+        if (!Globals::get()->GetBananaFileName().empty())
+            bananas_ = PolygonGate::ReadBananaFile(Globals::get()->GetBananaFileName());
+        hasReadBananas_ = true;
+    }
+    map<unsigned int, PolygonGate>::const_iterator banana = bananas_.find((unsigned int) id);
+    return banana != bananas_.end() && banana->second.IsWithin(round(x), round(y));
 #endif
 }
 
@@ -75,7 +85,7 @@ bool Plots::DeclareHistogram1D(int dammId, int xSize, const char *title, int hal
 #ifdef USE_HRIBF
     hd1d_(dammId + offset_, halfWordsPerChan, xSize, xHistLength, xLow, xHigh, title, strlen(title));
 #endif
-    rootHandler_->RegisterHistogram(dammId + offset_, title, xHistLength);
+    rootHandler_->DeclareHistogram(dammId + offset_, title, xHistLength);
     titleList.insert(pair<int, string>(dammId, string(title)));
     return true;
 }
@@ -116,7 +126,7 @@ bool Plots::DeclareHistogram2D(int dammId, int xSize, int ySize, const char *tit
 #ifdef USE_HRIBF
     hd2d_(dammId + offset_, halfWordsPerChan, xSize, xHistLength, xLow, xHigh, ySize, yHistLength, yLow, yHigh, title, strlen(title));
 #endif
-    rootHandler_->RegisterHistogram(dammId + offset_, title, xSize, ySize);
+    rootHandler_->DeclareHistogram(dammId + offset_, title, xSize, ySize);
     titleList.insert(pair<int, string>(dammId, string(title)));
     return true;
 }
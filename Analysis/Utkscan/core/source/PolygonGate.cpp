@@ -0,0 +1,175 @@
+///@file PolygonGate.cpp
+///@brief Class that compiles a polygon (banana) gate into a grid, so that testing a point does not depend on the
+/// number of vertices.
+///@date October 17, 2026
+#include "PolygonGate.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+    ///The number of characters in a record of a banana file
+    const size_t recordSize = 80;
+    ///The column where the coordinates of a CXY record begin and the width of each of them
+    const size_t coordinateOffset = 5, coordinateWidth = 5;
+}
+
+PolygonGate::PolygonGate() : gridSize_(0), xMin_(0), yMin_(0), xMax_(-1), yMax_(-1), xScale_(0), yScale_(0) {}
+
+PolygonGate::PolygonGate(const std::vector<Vertex> &vertices, const unsigned int &gridSize) : vertices_(vertices),
+                                                                                                gridSize_(gridSize) {
+    if (vertices.size() < 3)
+        throw invalid_argument("PolygonGate::PolygonGate - A polygon needs at least three vertices.");
+    if (gridSize == 0)
+        throw invalid_argument("PolygonGate::PolygonGate - The grid needs at least one cell.");
+    vertices_.push_back(vertices.front());
+    Compile();
+}
+
+void PolygonGate::Compile() {
+    xMin_ = xMax_ = vertices_[0].first;
+    yMin_ = yMax_ = vertices_[0].second;
+    for (vector<Vertex>::const_iterator it = vertices_.begin(); it != vertices_.end(); it++) {
+        xMin_ = min(xMin_, it->first);
+        xMax_ = max(xMax_, it->first);
+        yMin_ = min(yMin_, it->second);
+        yMax_ = max(yMax_, it->second);
+    }
+
+    const double width = (xMax_ - xMin_) / gridSize_, height = (yMax_ - yMin_) / gridSize_;
+    xScale_ = width > 0 ? 1 / width : 0;
+    yScale_ = height > 0 ? 1 / height : 0;
+    //The cells are widened a little so that a point that rounding puts into the neighbouring cell is still covered.
+    const double xMargin = 1e-9 * (fabs(xMin_) + fabs(xMax_) + 1), yMargin = 1e-9 * (fabs(yMin_) + fabs(yMax_) + 1);
+
+    const size_t numberOfCells = (size_t) gridSize_ * gridSize_;
+    states_.assign(numberOfCells, OUTSIDE);
+    parities_.assign(numberOfCells, 0);
+    edgeOffsets_.assign(numberOfCells + 1, 0);
+    edges_.clear();
+
+    for (unsigned int row = 0; row < gridSize_; row++) {
+        const double y0 = yMin_ + row * height - yMargin, y1 = yMin_ + (row + 1) * height + yMargin;
+        for (unsigned int column = 0; column < gridSize_; column++) {
+            const double x0 = xMin_ + column * width - xMargin, x1 = xMin_ + (column + 1) * width + xMargin;
+            const size_t cell = (size_t) row * gridSize_ + column;
+            uint8_t parity = 0;
+
+            for (uint32_t edge = 0; edge + 1 < vertices_.size(); edge++) {
+                const Vertex &a = vertices_[edge], &b = vertices_[edge + 1];
+                const double edgeYMin = min(a.second, b.second), edgeYMax = max(a.second, b.second);
+                //An edge crosses the ray from (x, y) only if edgeYMin <= y < edgeYMax, horizontal edges never do.
+                if (edgeYMin == edgeYMax || edgeYMin > y1 || edgeYMax <= y0 || max(a.first, b.first) < x0)
+                    continue;
+                if (min(a.first, b.first) > x1 && edgeYMin <= y0 && edgeYMax > y1)
+                    parity ^= 1;
+                else
+                    edges_.push_back(edge);
+            }
+
+            parities_[cell] = parity;
+            edgeOffsets_[cell + 1] = (uint32_t) edges_.size();
+            if (edgeOffsets_[cell + 1] != edgeOffsets_[cell])
+                states_[cell] = BOUNDARY;
+            else
+                states_[cell] = parity ? INSIDE : OUTSIDE;
+        }
+    }
+}
+
+bool PolygonGate::Cross(const uint32_t *begin, const uint32_t *end, const double &x, const double &y) const {
+    bool isInside = false;
+    for (const uint32_t *it = begin; it != end; it++) {
+        const Vertex &a = vertices_[*it], &b = vertices_[*it + 1];
+        if ((a.second > y) != (b.second > y)
+            && x < (b.first - a.first) * (y - a.second) / (b.second - a.second) + a.first)
+            isInside = !isInside;
+    }
+    return isInside;
+}
+
+size_t PolygonGate::GetNumberOfBoundaryCells() const {
+    return (size_t) count(states_.begin(), states_.end(), (uint8_t) BOUNDARY);
+}
+
+bool PolygonGate::IsWithin(const double &x, const double &y) const {
+    //Points outside of the bounding box, including the ones that are not a number, cannot be inside.
+    if (!(x >= xMin_ && x <= xMax_ && y >= yMin_ && y <= yMax_))
+        return false;
+
+    const size_t cell = min((unsigned int) ((y - yMin_) * yScale_), gridSize_ - 1) * (size_t) gridSize_
+                        + min((unsigned int) ((x - xMin_) * xScale_), gridSize_ - 1);
+    if (states_[cell] != BOUNDARY)
+        return states_[cell] == INSIDE;
+    return (parities_[cell] != 0)
+           != Cross(edges_.data() + edgeOffsets_[cell], edges_.data() + edgeOffsets_[cell + 1], x, y);
+}
+
+void PolygonGate::Test(const double *x, const double *y, const size_t &numberOfPoints,
+                       std::vector<uint64_t> &mask) const {
+    mask.assign((numberOfPoints + 63) / 64, 0);
+    for (size_t i = 0; i < numberOfPoints; i++)
+        if (IsWithin(x[i], y[i]))
+            mask[i / 64] |= (uint64_t) 1 << (i % 64);
+}
+
+std::map<unsigned int, PolygonGate> PolygonGate::ReadBananaFile(const std::string &fileName,
+                                                                const unsigned int &gridSize) {
+    ifstream file(fileName.c_str());
+    if (!file.good())
+        throw invalid_argument("PolygonGate::ReadBananaFile - Unable to open " + fileName + ".");
+    string contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    //DAMM writes the records without line breaks, edited files may have them.
+    vector<string> records;
+    if (contents.find('\n') == string::npos) {
+        for (size_t i = 0; i < contents.size(); i += recordSize)
+            records.push_back(contents.substr(i, recordSize));
+    } else {
+        istringstream lines(contents);
+        for (string line; getline(lines, line);)
+            records.push_back(line);
+    }
+
+    map<unsigned int, PolygonGate> bananas;
+    for (vector<string>::size_type i = 0; i < records.size(); i++) {
+        if (records[i].compare(0, 3, "INP") != 0)
+            continue;
+
+        string histogramFile;
+        int histogram = 0, number = -1, unused = 0, numberOfPoints = 0;
+        istringstream input(records[i].substr(3));
+        if (!(input >> histogramFile >> histogram >> number >> unused >> numberOfPoints) || number < 0)
+            throw invalid_argument("PolygonGate::ReadBananaFile - Unable to read the INP record \"" + records[i]
+                                   + "\" in " + fileName + ".");
+
+        vector<Vertex> vertices;
+        for (vector<string>::size_type j = i + 1; j < records.size() && records[j].compare(0, 3, "INP") != 0; j++) {
+            if (records[j].compare(0, 3, "CXY") != 0)
+                continue;
+            for (size_t position = coordinateOffset; position + 2 * coordinateWidth <= records[j].size()
+                                                     && (int) vertices.size() < numberOfPoints;
+                 position += 2 * coordinateWidth)
+                vertices.push_back(make_pair(atof(records[j].substr(position, coordinateWidth).c_str()),
+                                             atof(records[j].substr(position + coordinateWidth,
+                                                                    coordinateWidth).c_str())));
+        }
+
+        if ((int) vertices.size() != numberOfPoints || vertices.size() < 3) {
+            stringstream ss;
+            ss << "PolygonGate::ReadBananaFile - Banana " << number << " in " << fileName << " has "
+               << vertices.size() << " of its " << numberOfPoints << " points, we need at least three.";
+            throw invalid_argument(ss.str());
+        }
+        bananas[(unsigned int) number] = PolygonGate(vertices, gridSize);
+    }
+    return bananas;
+}
@@ -5,7 +5,11 @@
 #include "RootHandler.hpp"
 
 #include <iostream>
-#include <thread>
+#include <string>
+#include <utility>
+
+#include <TKey.h>
+#include <TROOT.h>
 
 using namespace std;
 
@@ -13,8 +17,17 @@ RootHandler *RootHandler::instance_ = nullptr; //!< The ONLY instance of this cl
 TFile *RootHandler::histogramFile_ = nullptr; //!< ROOT file storing user registered histograms
 TFile *RootHandler::treeFile_ = nullptr; //!< ROOT File storing user registered trees.
 map<std::string, TTree *> RootHandler::treeList_; //!< The list of user registered trees
-map<unsigned int, TH1 *> RootHandler::histogramList_; //!< List of user registered histograms
-mutex RootHandler::flushMutex_; //!< Ensures only one thread writes to histogramFile_
+TreeWriter *RootHandler::treeWriter_ = nullptr; //!< Fills the user registered trees on its own thread
+map<unsigned int, RootHandler::Definition> RootHandler::definitions_; //!< The declared histograms
+map<unsigned int, TH1 *> RootHandler::histogramList_; //!< The histograms that were allocated as ROOT histograms
+map<unsigned int, SparseHistogram *> RootHandler::sparseHistograms_; //!< The histograms keeping their filled bins
+map<unsigned int, double> RootHandler::flushedEntries_; //!< The entries of each histogram when it was last copied
+vector<TH1 *> RootHandler::flushedHistograms_; //!< The snapshots that the current flush writes
+size_t RootHandler::numFlushedHistograms_ = 0; //!< The number of histograms copied by the last flush
+thread RootHandler::writer_; //!< The thread writing the snapshots
+atomic<bool> RootHandler::isWriting_(false); //!< True while the writer thread is running
+size_t RootHandler::flushBudgetInBytes_ = 0; //!< The number of bytes a flush may copy, zero for no limit
+unsigned int RootHandler::lastFlushedId_ = 0; //!< The ID of the last histogram that was copied
 
 RootHandler *RootHandler::get() {
     if (!instance_)
@@ -29,35 +42,87 @@ RootHandler *RootHandler::get(const std::string &fileName) {
 }
 
 RootHandler::RootHandler(const std::string &fileName) {
+    //The writer thread writes to the histogram file while the main thread keeps using ROOT.
+    ROOT::EnableThreadSafety();
     histogramFile_ = new TFile((fileName+"-hist.root").c_str(), "recreate");
     treeFile_ = new TFile((fileName+"-tree.root").c_str(), "recreate");
+    treeWriter_ = new TreeWriter();
 }
 
 RootHandler::~RootHandler() {
-    if(histogramFile_) {
-        while(!flushMutex_.try_lock())
-            usleep(1000000);
+    WaitForFlush();
+    flushedEntries_.clear();
+    numFlushedHistograms_ = 0;
+    lastFlushedId_ = 0;
 
+    //The histograms don't belong to the file, so that allocating one while the writer thread is busy doesn't touch
+    // the directory. We write the ones that were filled and delete all of them ourselves.
+    if(histogramFile_) {
         histogramFile_->cd();
         for(const auto &hist : histogramList_)
             if(hist.second->GetEntries() > 0)
-                hist.second->Write(nullptr, TObject::kWriteDelete);
+                histogramFile_->WriteTObject(hist.second, hist.second->GetName(), "WriteDelete");
+        //The sparse histograms only become ROOT histograms for as long as it takes to write them.
+        for(const auto &sparse : sparseHistograms_) {
+            TH1 *hist = CreateHistogram(sparse.first, definitions_[sparse.first]);
+            sparse.second->AddTo(hist);
+            histogramFile_->WriteTObject(hist, hist->GetName(), "WriteDelete");
+            delete hist;
+        }
 
         histogramFile_->Write(nullptr, TObject::kWriteDelete);
         histogramFile_->Close();
         delete histogramFile_;
+        histogramFile_ = nullptr;
     }
+    for(const auto &hist : histogramList_)
+        delete hist.second;
+    histogramList_.clear();
+    for(const auto &sparse : sparseHistograms_)
+        delete sparse.second;
+    sparseHistograms_.clear();
+    definitions_.clear();
+
+    //The writer thread has to finish filling the trees before we write them.
+    delete treeWriter_;
+    treeWriter_ = nullptr;
 
     if(treeFile_) {
         treeFile_->cd();
         treeFile_->Write(nullptr, TObject::kWriteDelete);
         treeFile_->Close();
         delete treeFile_;
+        treeFile_ = nullptr;
     }
+    treeList_.clear();
 
     instance_ = nullptr;
 }
 
+TH1 *RootHandler::CreateHistogram(const unsigned int &id, const Definition &definition) {
+    const string name = "h" + to_string(id);
+    TH1 *histogram = nullptr;
+    if (!definition.yBins && !definition.zBins)
+        histogram = new TH1D(name.c_str(), definition.title.c_str(), definition.xBins, 0, definition.xBins);
+    else if (definition.yBins && !definition.zBins)
+        histogram = new TH2D(name.c_str(), definition.title.c_str(), definition.xBins, 0, definition.xBins,
+                             definition.yBins, 0, definition.yBins);
+    else if (!definition.yBins)
+        histogram = new TH2D(name.c_str(), definition.title.c_str(), definition.xBins, 0, definition.xBins,
+                             definition.zBins, 0, definition.zBins);
+    else
+        histogram = new TH3D(name.c_str(), definition.title.c_str(), definition.xBins, 0, definition.xBins,
+                             definition.yBins, 0, definition.yBins, definition.zBins, 0, definition.zBins);
+    histogram->SetDirectory(nullptr);
+    return histogram;
+}
+
+void RootHandler::DeclareHistogram(const unsigned int &id, const std::string &title, const unsigned int &xBins,
+                                   const unsigned int &yBins/* = 0*/, const unsigned int &zBins/* = 0*/) {
+    Definition definition = {title, xBins, yBins, zBins};
+    definitions_.emplace(id, definition);
+}
+
 TH1D *RootHandler::Get1DHistogram(const unsigned int &id) {
     return dynamic_cast<TH1D*>(GetHistogramFromList(id, "Get1DHistogram"));
 }
@@ -75,7 +140,7 @@ void RootHandler::RegisterBranch(const std::string &treeName, const std::string
     if (tree == treeList_.end())
         throw invalid_argument("Roothandler::RegisterBranch - Attempt to graft branch named " + name
                                + " onto tree named " + treeName + ", which is unknown to us!!");
-    tree->second->Branch(name.c_str(), address, leaflist.c_str());
+    treeWriter_->AddBranch(tree->second, name, address, leaflist);
 }
 
 TTree *RootHandler::RegisterTree(const std::string &name, const std::string &description/*=""*/) {
@@ -89,17 +154,46 @@ TTree *RootHandler::RegisterTree(const std::string &name, const std::string &des
 }
 
 bool RootHandler::Plot(const unsigned int &id, const double &xval, const double &yval/*=-1*/, const double &zval/*=-1*/) {
+    bool hasYval = yval != -1;
+    bool hasZval = zval != -1;
+
     TH1 *histogram = nullptr;
-    try {
-        histogram = GetHistogramFromList(id, "Plot");
-    } catch(invalid_argument &invalidArgument) {
-        ///@TODO Really we want to rethrow here, but for now we're just going to emulate what happened with DAMM. We
-        /// just silently ignored any Plot request to an unknown histogram id.
-        return false;
+    auto dense = histogramList_.find(id);
+    if(dense != histogramList_.end()) {
+        histogram = dense->second;
+    } else {
+        auto sparse = sparseHistograms_.find(id);
+        if(sparse == sparseHistograms_.end()) {
+            auto definition = definitions_.find(id);
+            ///@TODO Really we want to throw here, but for now we're just going to emulate what happened with DAMM. We
+            /// just silently ignored any Plot request to an unknown histogram id.
+            if(definition == definitions_.end())
+                return false;
+
+            //The histograms are only allocated once they're filled for the first time.
+            const Definition &def = definition->second;
+            if(!def.yBins && !def.zBins)
+                histogram = Materialize(id, def);
+            else if(!def.yBins)
+                sparse = sparseHistograms_.emplace(id, new SparseHistogram(def.xBins, def.zBins)).first;
+            else
+                sparse = sparseHistograms_.emplace(id, new SparseHistogram(def.xBins, def.yBins, def.zBins)).first;
+        }
+
+        if(histogram == nullptr) {
+            bool isNewBin = false;
+            if(sparse->second->GetDimension() == 2 && hasYval != hasZval)
+                isNewBin = sparse->second->Fill(xval, hasYval ? yval : zval);
+            else if(sparse->second->GetDimension() == 3 && hasYval && hasZval)
+                isNewBin = sparse->second->Fill(xval, yval, zval);
+            else
+                return false;
+            if(isNewBin && sparse->second->IsDenseSmaller())
+                Materialize(id, definitions_[id]);
+            return true;
+        }
     }
 
-    bool hasYval = yval != -1;
-    bool hasZval = zval != -1;
     if(!hasYval && !hasZval)
         histogram->Fill(xval);
     if(hasYval && !hasZval)
@@ -119,44 +213,139 @@ TH1 *RootHandler::RegisterHistogram(const unsigned int &id, const std::string &t
     if (histogram != histogramList_.end())
         return histogram->second;
 
-    TH1 *pTempHistogram = nullptr;
-
-    if (!yBins && !zBins)
-        pTempHistogram = histogramList_.emplace(make_pair(id, new TH1D(("h"+to_string(id)).c_str(), title.c_str(), xBins, 0, xBins))).first->second;
-    else if(yBins && !zBins)
-        pTempHistogram = histogramList_.emplace(make_pair(id, new TH2D(("h"+to_string(id)).c_str(), title.c_str(), xBins, 0, xBins, yBins, 0, yBins))).first->second;
-    else if(!yBins)
-        pTempHistogram = histogramList_.emplace(make_pair(id, new TH2D(("h"+to_string(id)).c_str(), title.c_str(), xBins, 0, xBins, zBins, 0, zBins))).first->second;
-    else
-        pTempHistogram = histogramList_.emplace(make_pair(id, new TH3D(("h"+to_string(id)).c_str(), title.c_str(), xBins, 0, xBins, yBins, 0, yBins, zBins, 0, zBins))).first->second;
-
-    pTempHistogram->SetDirectory(histogramFile_);
-    return pTempHistogram;
+    DeclareHistogram(id, title, xBins, yBins, zBins);
+    return Materialize(id, definitions_[id]);
 }
 
 void RootHandler::AsyncFlush() {
-    for(const auto &hist : histogramList_) {
-        histogramFile_->cd();
-        if(hist.second->GetEntries() > 0)
-            hist.second->Write(nullptr, TObject::kWriteDelete);
+    //Overwriting a key frees its space right away, and the next key that we write can land in it before the
+    // directory on disk stops pointing there. We add new cycles instead and only delete the old ones after the
+    // header knows about the new ones.
+    vector<pair<string, short> > oldCycles;
+    for(const auto &histogram : flushedHistograms_) {
+        TKey *key = histogramFile_->GetKey(histogram->GetName());
+        if(key)
+            oldCycles.push_back(make_pair(string(histogram->GetName()), key->GetCycle()));
+        histogramFile_->WriteTObject(histogram, histogram->GetName());
+    }
+    CommitHistogramFile();
+
+    if(!oldCycles.empty()) {
+        for(const auto &cycle : oldCycles)
+            histogramFile_->Delete((cycle.first + ";" + to_string(cycle.second)).c_str());
+        CommitHistogramFile();
     }
-    flushMutex_.unlock();
+
+    for(const auto &histogram : flushedHistograms_)
+        delete histogram;
+    flushedHistograms_.clear();
+    isWriting_ = false;
+}
+
+void RootHandler::CommitHistogramFile() {
+    histogramFile_->SaveSelf(kTRUE);
+    histogramFile_->WriteStreamerInfo();
+    histogramFile_->WriteFree();
+    histogramFile_->WriteHeader();
+    histogramFile_->Flush();
 }
 
 void RootHandler::Flush() {
-    for(const auto &tree : treeList_)
-        tree.second->AutoSave("overwrite");
+    treeWriter_->AutoSave();
+
+    if(isWriting_ || definitions_.empty())
+        return;
+    if(writer_.joinable())
+        writer_.join();
+
+    //Start after the histogram that we copied last, so that a budget that is smaller than all of the modified
+    // histograms still gets around to each of them.
+    numFlushedHistograms_ = 0;
+    size_t bytes = 0;
+    auto definition = definitions_.upper_bound(lastFlushedId_);
+    for(size_t i = 0; i < definitions_.size(); i++, definition++) {
+        if(definition == definitions_.end())
+            definition = definitions_.begin();
+
+        const unsigned int id = definition->first;
+        auto dense = histogramList_.find(id);
+        auto sparse = sparseHistograms_.find(id);
+        double entries = 0;
+        size_t size = 0;
+        if(dense != histogramList_.end()) {
+            entries = dense->second->GetEntries();
+            size = dense->second->GetNcells() * sizeof(double);
+        } else if(sparse != sparseHistograms_.end()) {
+            entries = sparse->second->GetEntries();
+            size = sparse->second->GetNumberOfCells() * sizeof(double);
+        }
 
-    if(flushMutex_.try_lock()) {
-        thread worker0(AsyncFlush);
-        worker0.detach();
+        auto flushed = flushedEntries_.find(id);
+        if(entries == 0 || (flushed != flushedEntries_.end() && flushed->second == entries))
+            continue;
+        if(flushBudgetInBytes_ != 0 && bytes != 0 && bytes + size > flushBudgetInBytes_)
+            break;
+        flushedEntries_[id] = entries;
+
+        //The copies only live until the writer has written them, so we don't keep a second set of histograms.
+        TH1 *copy = nullptr;
+        if(sparse != sparseHistograms_.end()) {
+            copy = CreateHistogram(id, definition->second);
+            sparse->second->AddTo(copy);
+        } else {
+            copy = dynamic_cast<TH1 *>(dense->second->Clone());
+            copy->SetDirectory(nullptr);
+        }
+        flushedHistograms_.push_back(copy);
+
+        bytes += size;
+        lastFlushedId_ = id;
     }
+
+    numFlushedHistograms_ = flushedHistograms_.size();
+    if(flushedHistograms_.empty())
+        return;
+    isWriting_ = true;
+    writer_ = thread(AsyncFlush);
+}
+
+void RootHandler::SetTreeCompressionSettings(const std::string &treeName, const int &settings) {
+    auto tree = treeList_.find(treeName);
+    if (tree == treeList_.end())
+        throw invalid_argument("RootHandler::SetTreeCompressionSettings - Attempt to set the compression of the tree "
+                               "named " + treeName + ", which is unknown to us!!");
+    treeWriter_->SetCompressionSettings(tree->second, settings);
+}
+
+void RootHandler::SetTreeCompressionThreads(const unsigned int &a) {
+    if(a != 1)
+        ROOT::EnableImplicitMT(a);
+}
+
+void RootHandler::WaitForFlush() {
+    if(writer_.joinable())
+        writer_.join();
 }
 
 TH1 *RootHandler::GetHistogramFromList(const unsigned int &id, const std::string &callingFunctionName) {
     auto histogramPair = histogramList_.find(id);
-    if(histogramPair == histogramList_.end())
+    if(histogramPair != histogramList_.end())
+        return histogramPair->second;
+
+    auto definition = definitions_.find(id);
+    if(definition == definitions_.end())
         throw invalid_argument("RootHandler::" + callingFunctionName + " - Somebody requested histogram "
                                + to_string(id) + ", which I know nothing about!!");
-    return histogramPair->second;
-}
\ No newline at end of file
+    return Materialize(id, definition->second);
+}
+
+TH1 *RootHandler::Materialize(const unsigned int &id, const Definition &definition) {
+    TH1 *histogram = CreateHistogram(id, definition);
+    auto sparse = sparseHistograms_.find(id);
+    if(sparse != sparseHistograms_.end()) {
+        sparse->second->AddTo(histogram);
+        delete sparse->second;
+        sparseHistograms_.erase(sparse);
+    }
+    return histogramList_.emplace(id, histogram).first->second;
+}
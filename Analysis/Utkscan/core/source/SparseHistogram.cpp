@@ -0,0 +1,29 @@
+///@file SparseHistogram.cpp
+///@brief Class that holds the occupied bins of a 2D or 3D histogram until it is converted into a ROOT histogram.
+///@date October 17, 2026
+#include "SparseHistogram.hpp"
+
+#include <TH1.h>
+
+using namespace std;
+
+SparseHistogram::SparseHistogram(const unsigned int &xBins, const unsigned int &yBins, const unsigned int &zBins) :
+        xBins_(xBins), yBins_(yBins), zBins_(zBins), entries_(0) {}
+
+void SparseHistogram::AddTo(TH1 *histogram) const {
+    double entries = histogram->GetEntries();
+    for (unordered_map<uint64_t, double>::const_iterator it = contents_.begin(); it != contents_.end(); it++)
+        histogram->AddBinContent((int) it->first, it->second);
+    //Setting the contents directly leaves the statistics behind, so we recalculate them from the bins.
+    histogram->ResetStats();
+    histogram->SetEntries(entries + entries_);
+}
+
+double SparseHistogram::GetBinContent(const uint64_t &bin) const {
+    unordered_map<uint64_t, double>::const_iterator it = contents_.find(bin);
+    return it == contents_.end() ? 0 : it->second;
+}
+
+uint64_t SparseHistogram::GetNumberOfCells() const {
+    return (uint64_t) (xBins_ + 2) * (yBins_ + 2) * (zBins_ == 0 ? 1 : zBins_ + 2);
+}
@@ -15,7 +15,7 @@ using namespace std;
 
 TimingCalibrator *TimingCalibrator::instance = NULL;
 
-TimingCalibration
+const TimingCalibration &
 TimingCalibrator::GetCalibration(const TimingDefs::TimingIdentifier &id) {
     map<TimingDefs::TimingIdentifier, TimingCalibration>::iterator it = calibrations_.find(id);
 
@@ -0,0 +1,183 @@
+///@file TreeWriter.cpp
+///@brief Class that fills ROOT trees on a writer thread from copies of the branch contents taken on the analysis
+/// thread.
+///@date October 17, 2026
+#include "TreeWriter.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <TBranch.h>
+#include <TTree.h>
+
+using namespace std;
+
+namespace {
+    ///@return The size in bytes of a ROOT leaf type, or zero if we can't copy the type
+    size_t GetLeafTypeSize(const char &type) {
+        switch (type) {
+            case 'B': case 'b': case 'O':
+                return 1;
+            case 'S': case 's':
+                return 2;
+            case 'I': case 'i': case 'F': case 'f':
+                return 4;
+            case 'D': case 'd': case 'L': case 'l': case 'G': case 'g':
+                return 8;
+            default:
+                return 0;
+        }
+    }
+}
+
+TreeWriter::TreeWriter() : queueSize_(10000), isStopping_(false), numberOfWaits_(0) {}
+
+TreeWriter::~TreeWriter() {
+    Stop();
+}
+
+size_t TreeWriter::GetLeafListSize(const std::string &leaflist) {
+    size_t size = 0;
+    char type = 'F';
+    stringstream leaves(leaflist);
+    string leaf;
+    while (getline(leaves, leaf, ':')) {
+        size_t slash = leaf.find('/');
+        if (slash != string::npos) {
+            if (slash + 2 != leaf.size())
+                throw invalid_argument("TreeWriter::GetLeafListSize - The leaf \"" + leaf + "\" has a malformed type.");
+            type = leaf[slash + 1];
+            leaf.erase(slash);
+        }
+        if (GetLeafTypeSize(type) == 0)
+            throw invalid_argument("TreeWriter::GetLeafListSize - The leaf \"" + leaf + "\" has the type " + type
+                                   + ", which we cannot copy.");
+
+        size_t length = 1;
+        for (size_t open = leaf.find('['); open != string::npos; open = leaf.find('[', open + 1)) {
+            size_t close = leaf.find(']', open);
+            string dimension = leaf.substr(open + 1, close == string::npos ? string::npos : close - open - 1);
+            if (close == string::npos || dimension.empty()
+                || dimension.find_first_not_of("0123456789") != string::npos)
+                throw invalid_argument("TreeWriter::GetLeafListSize - The leaf \"" + leaf + "\" needs arrays of "
+                        "fixed length.");
+            length *= stoul(dimension);
+        }
+        size += length * GetLeafTypeSize(type);
+    }
+    return size;
+}
+
+void TreeWriter::AddBranch(TTree *tree, const std::string &name, const void *address, const std::string &leaflist) {
+    if (thread_.joinable())
+        throw logic_error("TreeWriter::AddBranch - The branch " + name + " has to be registered before the first "
+                "entry is filled.");
+
+    Tree &branches = trees_.emplace(tree, Tree{vector<Branch>(), 0, -1}).first->second;
+    Branch branch = {nullptr, address, vector<char>(GetLeafListSize(leaflist), 0)};
+    branches.branches.push_back(branch);
+    //The contents of the vector don't move when the branch is moved, so the address that we hand to ROOT stays valid.
+    Branch &added = branches.branches.back();
+    added.branch = tree->Branch(name.c_str(), added.buffer.data(), leaflist.c_str());
+    if (branches.compressionSettings >= 0)
+        added.branch->SetCompressionSettings(branches.compressionSettings);
+    branches.entrySize += added.buffer.size();
+}
+
+void TreeWriter::AutoSave() {
+    if (!thread_.joinable()) {
+        for (auto it = trees_.begin(); it != trees_.end(); it++)
+            it->first->AutoSave("overwrite");
+        return;
+    }
+    lock_guard<mutex> lock(mutex_);
+    queue_.push_back(Entry{nullptr, nullptr, vector<char>()});
+    notEmpty_.notify_one();
+}
+
+void TreeWriter::Fill(TTree *tree) {
+    auto branches = trees_.find(tree);
+    if (branches == trees_.end() || branches->second.branches.empty())
+        throw invalid_argument("TreeWriter::Fill - The tree has no branches that were registered with us.");
+
+    if (!thread_.joinable()) {
+        isStopping_ = false;
+        thread_ = thread(&TreeWriter::Run, this);
+    }
+
+    unique_lock<mutex> lock(mutex_);
+    if (queue_.size() >= queueSize_) {
+        numberOfWaits_++;
+        notFull_.wait(lock, [this] { return queue_.size() < queueSize_; });
+    }
+
+    Entry entry = {tree, &branches->second, vector<char>()};
+    if (!freeBuffers_.empty()) {
+        entry.data.swap(freeBuffers_.back());
+        freeBuffers_.pop_back();
+    }
+    lock.unlock();
+
+    //The copy is the only work that stays on the analysis thread.
+    entry.data.resize(branches->second.entrySize);
+    char *position = entry.data.data();
+    for (auto it = branches->second.branches.begin(); it != branches->second.branches.end(); it++) {
+        memcpy(position, it->source, it->buffer.size());
+        position += it->buffer.size();
+    }
+
+    lock.lock();
+    queue_.push_back(move(entry));
+    notEmpty_.notify_one();
+}
+
+void TreeWriter::Run() {
+    unique_lock<mutex> lock(mutex_);
+    while (true) {
+        notEmpty_.wait(lock, [this] { return !queue_.empty() || isStopping_; });
+        if (queue_.empty())
+            return;
+
+        Entry entry = move(queue_.front());
+        queue_.pop_front();
+        notFull_.notify_one();
+        lock.unlock();
+
+        if (entry.tree == nullptr) {
+            for (auto it = trees_.begin(); it != trees_.end(); it++)
+                it->first->AutoSave("overwrite");
+        } else {
+            const char *position = entry.data.data();
+            for (auto it = entry.branches->branches.begin(); it != entry.branches->branches.end(); it++) {
+                memcpy(it->buffer.data(), position, it->buffer.size());
+                position += it->buffer.size();
+            }
+            entry.tree->Fill();
+        }
+
+        lock.lock();
+        freeBuffers_.push_back(move(entry.data));
+    }
+}
+
+void TreeWriter::SetCompressionSettings(TTree *tree, const int &settings) {
+    if (thread_.joinable())
+        throw logic_error("TreeWriter::SetCompressionSettings - The compression has to be set before the first entry "
+                "is filled.");
+    Tree &branches = trees_.emplace(tree, Tree{vector<Branch>(), 0, -1}).first->second;
+    branches.compressionSettings = settings;
+    for (auto it = branches.branches.begin(); it != branches.branches.end(); it++)
+        it->branch->SetCompressionSettings(settings);
+}
+
+void TreeWriter::Stop() {
+    if (!thread_.joinable())
+        return;
+    {
+        lock_guard<mutex> lock(mutex_);
+        isStopping_ = true;
+        notEmpty_.notify_one();
+    }
+    thread_.join();
+}
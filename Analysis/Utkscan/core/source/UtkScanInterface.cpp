@@ -6,6 +6,7 @@
 #include <stdexcept>
 
 #include "DetectorDriver.hpp"
+#include "DetectorLibrary.hpp"
 #include "Display.h"
 #include "RootHandler.hpp"
 #include "TreeCorrelator.hpp"
@@ -38,6 +39,7 @@ bool UtkScanInterface::Initialize(string prefix_) {
                 "parse " << GetSetupFilename() << endl;
         XmlInterface::get(GetSetupFilename());
         Globals::get(GetSetupFilename());
+        unpacker_->SetTopology(Globals::get()->GetTopology());
         DetectorLibrary::get();
         TreeCorrelator::get()->buildTree();
     } catch (invalid_argument &ex) {
@@ -45,6 +47,26 @@ bool UtkScanInterface::Initialize(string prefix_) {
     }
 
     unpacker_->SetEventWidth(Globals::get()->GetEventLengthInTicks());
+    unpacker_->SetLazyDecoding(Globals::get()->HasLazyDecoding());
+    unpacker_->SetKeepMask(DetectorLibrary::get()->GetKeepMask());
+    unpacker_->SetMaximumBufferedHits(Globals::get()->GetMaximumMergeBufferedHits());
+    if (Globals::get()->HasRejectionRegion()) {
+        vector<pair<double, double>> regions;
+        const vector<pair<unsigned int, unsigned int>> &rejectRegions = Globals::get()->GetRejectionRegions();
+        for (vector<pair<unsigned int, unsigned int>>::const_iterator it = rejectRegions.begin();
+             it != rejectRegions.end(); it++)
+            regions.push_back(make_pair(it->first / Globals::get()->GetClockInSeconds(),
+                                        it->second / Globals::get()->GetClockInSeconds()));
+        unpacker_->SetRejectionRegions(regions);
+    }
+    if (!Globals::get()->GetTriggerTypes().empty())
+        SetTriggeredBuilding();
+    unpacker_->SetReorderWindow(Globals::get()->GetReorderWindowInTicks());
+    unpacker_->SetClockResetThreshold(Globals::get()->GetClockResetThresholdInTicks());
+    const map<unsigned int, pair<double, double>> &corrections = Globals::get()->GetClockCorrections();
+    for (map<unsigned int, pair<double, double>>::const_iterator it = corrections.begin(); it != corrections.end(); it++)
+        if (it->first < unpacker_->GetNumberOfSources())
+            unpacker_->SetClockCorrection(it->first, it->second.first, it->second.second);
     Globals::get()->SetOutputFilename(GetOutputFilename());
     Globals::get()->SetOutputPath(GetOutputPath());
     RootHandler::get(GetOutputPath() + GetOutputFilename());
@@ -71,4 +93,40 @@ bool UtkScanInterface::Initialize(string prefix_) {
     }
 #endif
     return (scan_init = true);
-}
\ No newline at end of file
+}
+/** Set up the unpacker to build events around the trigger types from the
+ * EventBuilder node. Every detector type with its own event window gets its
+ * own time sorted list of hits in the unpacker, all of the other channels
+ * share the default window.
+ * \throw invalid_argument if one of the trigger types isn't used in the map */
+void UtkScanInterface::SetTriggeredBuilding() {
+    const Globals *globals = Globals::get();
+    DetectorLibrary *modChan = DetectorLibrary::get();
+
+    for (set<string>::const_iterator it = globals->GetTriggerTypes().begin();
+         it != globals->GetTriggerTypes().end(); it++)
+        if (modChan->GetUsedDetectors().find(*it) == modChan->GetUsedDetectors().end())
+            throw invalid_argument("UtkScanInterface::SetTriggeredBuilding - The trigger type \"" + *it
+                                   + "\" is not used in the Map.");
+
+    vector<Unpacker::EventWindow> windows(1, Unpacker::EventWindow(globals->GetDefaultEventWindow().first,
+                                                                    globals->GetDefaultEventWindow().second));
+    map<string, unsigned int> groups;
+    for (map<string, pair<double, double>>::const_iterator it = globals->GetEventWindows().begin();
+         it != globals->GetEventWindows().end(); it++) {
+        groups[it->first] = (unsigned int) windows.size();
+        windows.push_back(Unpacker::EventWindow(it->second.first, it->second.second,
+                                                globals->GetTriggerTypes().count(it->first) != 0));
+    }
+
+    vector<unsigned int> groupOfId(globals->GetTopology().GetNumberOfChannels(), 0);
+    for (unsigned int id = 0; id < groupOfId.size() && id < modChan->size(); id++) {
+        if (!modChan->HasValue(id))
+            continue;
+        map<string, unsigned int>::const_iterator group = groups.find(modChan->at(id).GetType());
+        if (group != groups.end())
+            groupOfId[id] = group->second;
+    }
+
+    unpacker_->SetTriggeredBuilding(groupOfId, windows);
+}
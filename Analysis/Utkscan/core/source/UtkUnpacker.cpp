@@ -13,7 +13,7 @@
 using namespace std;
 using namespace dammIds::raw;
 
-UtkUnpacker::UtkUnpacker()  : Unpacker() {
+UtkUnpacker::UtkUnpacker()  : Unpacker(), driver_(NULL), detectorLibrary_(NULL) {
     ///Does nothing at all
 }
 
@@ -23,6 +23,19 @@ UtkUnpacker::UtkUnpacker()  : Unpacker() {
 /// the amount of time spent in each processor is output to the screen at the
 /// end of execution.
 UtkUnpacker::~UtkUnpacker() {
+    cout << "UtkUnpacker::~UtkUnpacker : Discarded " << GetNumberOfDiscardedHits()
+         << " hits from channels that were ignored or not in the map." << endl;
+    if (GetNumberOfOutOfRangeHits() != 0)
+        cout << "UtkUnpacker::~UtkUnpacker : Dropped " << GetNumberOfOutOfRangeHits()
+             << " hits from channels outside of the configured topology." << endl;
+    if (GetNumberOfRejectedSpills() != 0)
+        cout << "UtkUnpacker::~UtkUnpacker : Skipped " << GetNumberOfRejectedSpills()
+             << " spills inside of rejection regions." << endl;
+    if (GetNumberOfLateHits() != 0)
+        cout << "UtkUnpacker::~UtkUnpacker : " << GetNumberOfLateHits()
+             << " hits arrived after the re-ordering window had passed them." << endl;
+    if (GetNumberOfClockResets() != 0)
+        cout << "UtkUnpacker::~UtkUnpacker : Detected " << GetNumberOfClockResets() << " clock resets." << endl;
     if(driver_)
         delete DetectorDriver::get();
 }
@@ -54,6 +67,11 @@ void UtkUnpacker::ProcessRawEvent() {
         driver_ = DetectorDriver::get();
         detectorLibrary_ = DetectorLibrary::get();
         InitializeDriver(driver_, detectorLibrary_, rawev, systemStartTime);
+        RootHandler::get()->SetFlushBudgetInBytes(Globals::get()->GetRootFlushBudgetInBytes());
+        RootHandler::get()->SetTreeCompressionThreads(Globals::get()->GetTreeCompressionThreads());
+        RootHandler::get()->SetTreeQueueSize(Globals::get()->GetTreeQueueSize());
+        for (const auto &tree : Globals::get()->GetTreeCompressionSettings())
+            RootHandler::get()->SetTreeCompressionSettings(tree.first, tree.second);
         RootHandler::get()->Flush();
         lastFlushTime = chrono::steady_clock::now();
     }
@@ -64,22 +82,17 @@ void UtkUnpacker::ProcessRawEvent() {
         PrintProcessingTimeInformation(GetEventStartTime(), eventCounter, processingTime);
     }
 
-    if(chrono::duration_cast<chrono::duration<int>>(chrono::steady_clock::now() - lastFlushTime).count() == 2) {
+    static const double flushIntervalInSeconds = Globals::get()->GetRootFlushIntervalInSeconds();
+    if(chrono::duration_cast<chrono::duration<double>>(chrono::steady_clock::now() - lastFlushTime).count()
+       >= flushIntervalInSeconds) {
         RootHandler::get()->Flush();
         lastFlushTime = chrono::steady_clock::now();
     }
 
     eventCounter++;
 
-    if (Globals::get()->HasRejectionRegion()) {
-        double eventTime = (GetEventStartTime() - GetFirstTime()) * pixieClockInSeconds;
-        vector <pair<unsigned int, unsigned int>> rejectRegions = Globals::get()->GetRejectionRegions();
-
-        for (vector<pair<unsigned int, unsigned int> >::iterator region = rejectRegions.begin();
-             region != rejectRegions.end(); ++region)
-            if (eventTime > region->first && eventTime < region->second)
-                return;
-    }
+    if (IsRejected(GetEventStartTime()))
+        return;
 
     ///@TODO : Need to figure out why the plot command is so obnoxiously slow. I'm commenting these out for now until
     /// we can figure out the issues. These histograms are not used very often anyway.
@@ -97,7 +110,7 @@ void UtkUnpacker::ProcessRawEvent() {
         if (!(*it))
             continue;
 
-        RawStats((*it), driver_);
+        RawStats((*it)->GetId(), (*it)->GetTime(), driver_);
 
         if ((*it)->GetId() == std::numeric_limits<unsigned int>::max()) {
             ss << "pattern 0 ignore";
@@ -137,18 +150,30 @@ void UtkUnpacker::ProcessRawEvent() {
     }
 }
 
+/// Only the raw statistics are available from the headers of the hits. The
+/// hits outside of the topology are skipped, as they never make it into an
+/// event when the events are built.
+void UtkUnpacker::ProcessHitBatch(const XiaHitBatch &batch) {
+    if (!driver_)
+        driver_ = DetectorDriver::get();
+
+    for (size_t i = 0; i < batch.Size(); i++)
+        if (batch.GetIds()[i] != XiaTopology::InvalidId())
+            RawStats(batch.GetIds()[i], batch.GetTime(i), driver_);
+}
+
 /// This method plots information about the running time of the program, the
 /// hit spectrum, and the scalars for each of the channels. The two runtime
 /// spectra are critical when we are trying to debug potential data losses in
 /// the system. These spectra print the total number of counts in a given
 /// (milli)second of time.
-void UtkUnpacker::RawStats(XiaData *event_, DetectorDriver *driver) {
+void UtkUnpacker::RawStats(const unsigned int &id, const double &time, DetectorDriver *driver) {
     static const int specNoBins = SD;
     static double runTimeSecs = 0, remainNumSecs = 0;
     static double runTimeMsecs = 0, remainNumMsecs = 0;
     static int rowNumSecs = 0, rowNumMsecs = 0;
 
-    runTimeSecs = (event_->GetTime() - GetFirstTime()) * Globals::get()->GetClockInSeconds();
+    runTimeSecs = (time - GetFirstTime()) * Globals::get()->GetClockInSeconds();
     rowNumSecs = int(runTimeSecs / specNoBins);
     remainNumSecs = runTimeSecs - rowNumSecs * specNoBins;
 
@@ -156,10 +181,10 @@ void UtkUnpacker::RawStats(XiaData *event_, DetectorDriver *driver) {
     rowNumMsecs = int(runTimeMsecs / specNoBins);
     remainNumMsecs = runTimeMsecs - rowNumMsecs * specNoBins;
 
-    driver->histo_.Plot(D_HIT_SPECTRUM, event_->GetId());
+    driver->histo_.Plot(D_HIT_SPECTRUM, id);
     driver->histo_.Plot(DD_RUNTIME_SEC, remainNumSecs, rowNumSecs);
     driver->histo_.Plot(DD_RUNTIME_MSEC, remainNumMsecs, rowNumMsecs);
-    driver->histo_.Plot(D_SCALAR + event_->GetId(), runTimeSecs);
+    driver->histo_.Plot(D_SCALAR + id, runTimeSecs);
 }
 
 /// First we initialize the DetectorLibrary, which reads the Map
@@ -0,0 +1,117 @@
+///@file unittest-CoincidenceStore.cpp
+///@brief Unit tests for the CoincidenceStore class
+///@date October 17, 2026
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include <UnitTest++.h>
+
+#include "CoincidenceStore.hpp"
+
+using namespace std;
+
+///Energies of a few coincidences, including repeated and diagonal cells and energies off of the axis.
+static const double triples[][3] = {{1.5, 3.2, 7.9}, {3.9, 1.1, 7.0}, {5.0, 5.5, 2.0}, {2.0, 2.0, 2.0},
+                                    {9.9, 0.0, 4.4}, {12.0, 1.0, 2.0}, {-1.0, 3.0, 4.0}, {7.5, 3.5, 1.5}};
+static const unsigned int numberOfTriples = sizeof(triples) / sizeof(triples[0]);
+
+TEST(TestProjectionsMatchTheDenseMatrix) {
+    //A pending size of 3 makes the store compact several times while we fill it.
+    CoincidenceStore store(2, 10, 1.0, 3);
+    vector<vector<double> > dense(10, vector<double>(10, 0));
+    for (unsigned int i = 0; i < numberOfTriples; i++) {
+        store.Add(triples[i][0], triples[i][1]);
+        int x = (int) triples[i][0], y = (int) triples[i][1];
+        if (triples[i][0] >= 0 && triples[i][1] >= 0 && x < 10 && y < 10) {
+            dense[x][y]++;
+            dense[y][x]++;
+        }
+    }
+
+    store.Compact();
+    CHECK_EQUAL(6ULL, store.GetNumberOfEntries());
+    CHECK_EQUAL((size_t) 5, store.GetNumberOfCells());
+
+    CoincidenceStore::Gate gate(2.5, 5.2);
+    vector<double> gated = store.Project(gate);
+    vector<double> total = store.Project();
+    for (unsigned int y = 0; y < 10; y++) {
+        double expectedGated = 0, expectedTotal = 0;
+        for (unsigned int x = 0; x < 10; x++) {
+            if (x >= 2 && x <= 5)
+                expectedGated += dense[x][y];
+            expectedTotal += dense[x][y];
+        }
+        CHECK_EQUAL(expectedGated, gated[y]);
+        CHECK_EQUAL(expectedTotal, total[y]);
+    }
+
+    CHECK_THROW(store.Add(1, 2, 3), logic_error);
+    CHECK_THROW(store.Project(gate, gate), logic_error);
+    CHECK_THROW(CoincidenceStore(4, 10), invalid_argument);
+    CHECK_THROW(CoincidenceStore(2, 70000), invalid_argument);
+}
+
+TEST(TestCubeQueriesMatchTheDenseCube) {
+    CoincidenceStore store(3, 10, 1.0, 2);
+    vector<double> dense(1000, 0);
+    for (unsigned int i = 0; i < numberOfTriples; i++) {
+        store.Add(triples[i][0], triples[i][1], triples[i][2]);
+        int b[3];
+        bool isOnAxis = true;
+        for (unsigned int j = 0; j < 3; j++) {
+            b[j] = (int) triples[i][j];
+            isOnAxis = isOnAxis && triples[i][j] >= 0 && b[j] < 10;
+        }
+        if (!isOnAxis)
+            continue;
+        static const int orders[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+        for (unsigned int o = 0; o < 6; o++)
+            dense[100 * b[orders[o][0]] + 10 * b[orders[o][1]] + b[orders[o][2]]]++;
+    }
+
+    CoincidenceStore::Gate gate1(1.0, 2.9), gate2(3.0, 3.9);
+    vector<double> gated = store.Project(gate1, gate2);
+    CoincidenceStore slice = store.Slice(gate1);
+    vector<double> sliceProjection = slice.Project();
+    vector<double> sliceGated = slice.Project(gate2);
+    for (unsigned int z = 0; z < 10; z++) {
+        double expectedGated = 0, expectedSlice = 0;
+        for (unsigned int x = 1; x <= 2; x++) {
+            for (unsigned int y = 0; y < 10; y++) {
+                if (y == 3)
+                    expectedGated += dense[100 * x + 10 * y + z];
+                expectedSlice += dense[100 * x + 10 * y + z];
+            }
+        }
+        CHECK_EQUAL(expectedGated, gated[z]);
+        CHECK_EQUAL(expectedGated, sliceGated[z]);
+        CHECK_EQUAL(expectedSlice, sliceProjection[z]);
+    }
+}
+
+TEST(TestSaveAndLoad) {
+    const string fileName = "unittest-CoincidenceStore.bin";
+    CoincidenceStore store(3, 10);
+    for (unsigned int i = 0; i < numberOfTriples; i++)
+        store.Add(triples[i][0], triples[i][1], triples[i][2]);
+    CHECK(store.Save(fileName));
+
+    CoincidenceStore loaded(3, 10);
+    CHECK(loaded.Load(fileName));
+    CHECK_EQUAL(store.GetNumberOfEntries(), loaded.GetNumberOfEntries());
+    CHECK_EQUAL(store.GetNumberOfCells(), loaded.GetNumberOfCells());
+    vector<double> expected = store.Project(), actual = loaded.Project();
+    CHECK_ARRAY_EQUAL(expected, actual, 10);
+
+    CoincidenceStore otherBinning(3, 20);
+    CHECK(!otherBinning.Load(fileName));
+    CoincidenceStore otherDimension(2, 10);
+    CHECK(!otherDimension.Load(fileName));
+    remove(fileName.c_str());
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
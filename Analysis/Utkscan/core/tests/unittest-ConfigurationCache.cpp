@@ -0,0 +1,141 @@
+///@file unittest-ConfigurationCache.cpp
+///@brief Unit tests for the ConfigurationCache class
+///@date October 17, 2026
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <UnitTest++.h>
+
+#include "ConfigurationCache.hpp"
+
+using namespace std;
+
+static const string cacheFile = "unittest-ConfigurationCache.bin";
+
+///Makes a cache holding two channels, the first with an energy calibration and tags.
+ConfigurationCache MakeCache() {
+    ConfigurationCache cache;
+
+    ConfigurationCache::ChannelRecord first;
+    first.module = 17;
+    first.channel = 3;
+    first.configuration = ChannelConfiguration("vandle", "small", 4);
+    first.configuration.AddTag("left");
+    first.configuration.AddTag("timing");
+    first.configuration.SetBaselineThreshold(3.5);
+    first.configuration.SetDiscriminationStartInSamples(12);
+    first.configuration.SetTriggerFilterParameters(TrapFilterParameters(0.1, 0.2, 3));
+    first.configuration.SetEnergyFilterParameters(TrapFilterParameters(1, 2, 30));
+    first.configuration.SetTraceDelayInSamples(80);
+    first.configuration.SetWaveformBoundsInSamples(make_pair(5u, 10u));
+    ConfigurationCache::Correction calibration;
+    calibration.model = "linear";
+    calibration.min = 0;
+    calibration.max = 1e4;
+    calibration.parameters = {0.5, 1.25};
+    first.calibrations.push_back(calibration);
+    cache.Add(first);
+
+    ConfigurationCache::ChannelRecord second;
+    second.module = 0;
+    second.channel = 0;
+    second.configuration = ChannelConfiguration("ge", "clover_high", 0);
+    ConfigurationCache::Correction walk;
+    walk.model = "B1";
+    walk.min = 0;
+    walk.max = 100;
+    walk.parameters = {1, 2, 3, 4};
+    second.walks.push_back(walk);
+    cache.Add(second);
+
+    return cache;
+}
+
+TEST(TestHash) {
+    CHECK_EQUAL(0xcbf29ce484222325ULL, ConfigurationCache::Hash(""));
+    CHECK_EQUAL(0xaf63dc4c8601ec8cULL, ConfigurationCache::Hash("a"));
+    CHECK(ConfigurationCache::Hash("<Map/>") != ConfigurationCache::Hash("<Map />"));
+}
+
+TEST(TestRoundTrip) {
+    CHECK(MakeCache().Save(cacheFile, 42));
+
+    ConfigurationCache cache;
+    CHECK(cache.Load(cacheFile, 42));
+    CHECK_EQUAL((size_t) 2, cache.GetRecords().size());
+
+    const ConfigurationCache::ChannelRecord &first = cache.GetRecords().at(0);
+    CHECK_EQUAL(17, first.module);
+    CHECK_EQUAL(3u, first.channel);
+    CHECK_EQUAL("vandle", first.configuration.GetType());
+    CHECK_EQUAL("small", first.configuration.GetSubtype());
+    CHECK_EQUAL(4u, first.configuration.GetLocation());
+    CHECK(first.configuration.HasTag("left") && first.configuration.HasTag("timing"));
+    CHECK_EQUAL(3.5, first.configuration.GetBaselineThreshold());
+    CHECK_EQUAL(12u, first.configuration.GetDiscriminationStartInSamples());
+    CHECK_EQUAL(3., first.configuration.GetTriggerFilterParameters().GetT());
+    CHECK_EQUAL(2., first.configuration.GetEnergyFilterParameters().GetFlattop());
+    CHECK_EQUAL(80u, first.configuration.GetTraceDelayInSamples());
+    CHECK_EQUAL(10u, first.configuration.GetWaveformBoundsInSamples().second);
+    CHECK_EQUAL((size_t) 1, first.calibrations.size());
+    CHECK_EQUAL("linear", first.calibrations[0].model);
+    CHECK_EQUAL(1.25, first.calibrations[0].parameters.at(1));
+    CHECK(first.walks.empty());
+
+    const ConfigurationCache::ChannelRecord &second = cache.GetRecords().at(1);
+    CHECK_EQUAL("clover_high", second.configuration.GetSubtype());
+    CHECK_EQUAL((size_t) 4, second.walks.at(0).parameters.size());
+
+    remove(cacheFile.c_str());
+}
+
+TEST(TestRejectedFiles) {
+    ConfigurationCache cache = MakeCache();
+    CHECK(!cache.Load("this-file-does-not-exist.bin", 42));
+
+    //A cache written for another configuration is ignored and leaves the records alone.
+    CHECK(cache.Save(cacheFile, 42));
+    CHECK(!cache.Load(cacheFile, 43));
+    CHECK_EQUAL((size_t) 2, cache.GetRecords().size());
+
+    //A truncated cache is not loaded.
+    ifstream in(cacheFile.c_str(), ios::binary);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    ofstream out(cacheFile.c_str(), ios::binary | ios::trunc);
+    out.write(contents.data(), contents.size() - 1);
+    out.close();
+    ConfigurationCache empty;
+    CHECK(!empty.Load(cacheFile, 42));
+    CHECK(empty.GetRecords().empty());
+
+    //Counts that the rest of the file cannot hold are rejected before anything is allocated for them. The number
+    // of records follows the magic word, version and key, the number of calibrations of the first channel follows
+    // its 170 bytes of fixed fields, strings and tags.
+    const size_t numRecordsOffset = 20, numCalibrationsOffset = 24 + 170;
+    uint32_t count;
+    memcpy(&count, &contents[numRecordsOffset], sizeof(count));
+    CHECK_EQUAL(2u, count);
+    memcpy(&count, &contents[numCalibrationsOffset], sizeof(count));
+    CHECK_EQUAL(1u, count);
+
+    const size_t offsets[2] = {numRecordsOffset, numCalibrationsOffset};
+    for (unsigned int i = 0; i < 2; i++) {
+        string corrupt(contents);
+        count = 0xFFFFFFF0;
+        memcpy(&corrupt[offsets[i]], &count, sizeof(count));
+        out.open(cacheFile.c_str(), ios::binary | ios::trunc);
+        out.write(corrupt.data(), corrupt.size());
+        out.close();
+        CHECK(!empty.Load(cacheFile, 42));
+        CHECK(empty.GetRecords().empty());
+    }
+
+    remove(cacheFile.c_str());
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -0,0 +1,221 @@
+///@file unittest-Correlator.cpp
+///@brief Unit tests for the Correlator class
+///@date October 17, 2026
+#include <cmath>
+
+#include <UnitTest++.h>
+
+#include "Correlator.hpp"
+#include "DetectorDriver.hpp"
+#include "Globals.hpp"
+#include "Plots.hpp"
+
+using namespace std;
+
+///The correlator only needs the filter clock from the globals and does not plot anything that we look at. These
+/// stand in for the parts of utkscan that need a configuration file and a histogram file.
+Globals::Globals(const std::string &file) {
+    filterClockInSeconds_ = 8e-9;
+}
+
+Globals *Globals::get() {
+    static Globals *globals = new Globals("unittest");
+    return globals;
+}
+
+DetectorDriver *DetectorDriver::get() {
+    return NULL;
+}
+
+Plots::Plots(int offset, int range, std::string name) {}
+
+bool Plots::Plot(int dammId, double val1, double val2, double val3, const char *name) {
+    return true;
+}
+
+bool Plots::DeclareHistogram1D(int dammId, int xSize, const char *title, int halfWordsPerChan, const std::string &mne) {
+    return true;
+}
+
+bool Plots::DeclareHistogram2D(int dammId, int xSize, int ySize, const char *title, int halfWordPerChan,
+                               const std::string &mne) {
+    return true;
+}
+
+namespace {
+    ///@return The number of clock ticks in the provided number of seconds
+    double Ticks(const double &seconds) {
+        return seconds / Globals::get()->GetFilterClockInSeconds();
+    }
+
+    ///@return An event of the given type at the time given in seconds
+    EventInfo MakeEvent(const EventInfo::EEventTypes &type, const double &seconds) {
+        EventInfo event;
+        event.type = type;
+        event.time = Ticks(seconds);
+        event.energy = 1000;
+        return event;
+    }
+
+    ///A 16x16 detector, implants at 1 s are well separated from anything else.
+    class TestCorrelator : public Correlator {
+    public:
+        TestCorrelator() : Correlator(16, 16) {}
+
+        ///Implants in the pixel at the given time in seconds
+        void Implant(const unsigned int &fch, const unsigned int &bch, const double &seconds) {
+            EventInfo event = MakeEvent(EventInfo::IMPLANT_EVENT, seconds);
+            Correlate(event, fch, bch);
+        }
+
+        ///Decays in the pixel at the given time in seconds.
+        ///@return The event after correlation
+        EventInfo Decay(const unsigned int &fch, const unsigned int &bch, const double &seconds) {
+            EventInfo event = MakeEvent(EventInfo::DECAY_EVENT, seconds);
+            Correlate(event, fch, bch);
+            return event;
+        }
+    };
+}
+
+TEST_FIXTURE(TestCorrelator, TestValidDecay) {
+    Implant(3, 4, 1);
+    CHECK_EQUAL(VALID_IMPLANT, GetCondition());
+    CHECK_EQUAL(1u, GetNumberOfLiveChains());
+
+    EventInfo decay = Decay(3, 4, 31);
+    CHECK_EQUAL(VALID_DECAY, GetCondition());
+    CHECK_CLOSE(Ticks(30), decay.dtime, 1);
+    CHECK_CLOSE(Ticks(30), GetDecayTime(3, 4), 1);
+}
+
+///The wheel clears the chains whose implant is older than the correlation time as it is advanced by events in
+/// other pixels.
+TEST_FIXTURE(TestCorrelator, TestWheelExpiry) {
+    Implant(3, 4, 1);
+    Implant(5, 6, 30);
+    CHECK_EQUAL(2u, GetNumberOfLiveChains());
+
+    Implant(0, 0, 60);
+    CHECK_EQUAL(3u, GetNumberOfLiveChains());
+
+    Implant(0, 1, 62);
+    CHECK_EQUAL(3u, GetNumberOfLiveChains());
+    CHECK(std::isnan(GetImplantTime(3, 4)));
+    CHECK_CLOSE(Ticks(30), GetImplantTime(5, 6), 1);
+
+    Implant(0, 2, 91);
+    CHECK_EQUAL(3u, GetNumberOfLiveChains());
+    CHECK(std::isnan(GetImplantTime(5, 6)));
+}
+
+///An event that jumps more than a full revolution of the wheel ahead must still visit every slot once, expiring
+/// everything, and leave the wheel usable for the chains that follow.
+TEST_FIXTURE(TestCorrelator, TestJumpLongerThanRevolution) {
+    for (unsigned int i = 0; i < 16; i++)
+        Implant(i, i, 1 + 3 * i);
+    CHECK_EQUAL(16u, GetNumberOfLiveChains());
+
+    Implant(8, 9, 1000);
+    CHECK_EQUAL(1u, GetNumberOfLiveChains());
+    for (unsigned int i = 0; i < 16; i++)
+        CHECK(std::isnan(GetImplantTime(i, i)));
+
+    Implant(10, 11, 1001);
+    Decay(8, 9, 1059);
+    CHECK_EQUAL(VALID_DECAY, GetCondition());
+    CHECK_EQUAL(2u, GetNumberOfLiveChains());
+
+    Implant(0, 0, 1060.5);
+    CHECK(std::isnan(GetImplantTime(8, 9)));
+    CHECK_CLOSE(Ticks(1001), GetImplantTime(10, 11), 1);
+}
+
+///A decay that comes after the correlation time is reported once, whether it finds the chain itself or the wheel
+/// expired the chain before.
+TEST_FIXTURE(TestCorrelator, TestDecayTooLate) {
+    //The wheel has not reached the slot of the implant yet
+    Implant(3, 4, 1);
+    EventInfo decay = Decay(3, 4, 61.1);
+    CHECK_EQUAL(DECAY_TOO_LATE, GetCondition());
+    CHECK_CLOSE(Ticks(60.1), decay.dtime, 1);
+    CHECK_EQUAL(0u, GetNumberOfLiveChains());
+
+    Implant(5, 6, 70);
+    Decay(5, 6, 71);
+    CHECK_EQUAL(VALID_DECAY, GetCondition());
+    Decay(3, 4, 72);
+    CHECK(GetCondition() != DECAY_TOO_LATE);
+
+    //Expired by an implant in another pixel before the decay arrives
+    Implant(7, 8, 200);
+    Implant(0, 0, 300);
+    CHECK(std::isnan(GetImplantTime(7, 8)));
+    decay = Decay(7, 8, 301);
+    CHECK_EQUAL(DECAY_TOO_LATE, GetCondition());
+    CHECK_CLOSE(Ticks(101), decay.dtime, 1);
+
+    Decay(0, 0, 302);
+    CHECK_EQUAL(VALID_DECAY, GetCondition());
+    Decay(7, 8, 303);
+    CHECK(GetCondition() != DECAY_TOO_LATE);
+}
+
+///An implant after an expired implant in the same pixel is still a back to back implant.
+TEST_FIXTURE(TestCorrelator, TestImplantAfterExpiry) {
+    Implant(3, 4, 1);
+    Implant(0, 0, 100);
+    CHECK(std::isnan(GetImplantTime(3, 4)));
+
+    Implant(3, 4, 101);
+    CHECK_EQUAL(BACK_TO_BACK_IMPLANT, GetCondition());
+}
+
+///After a clock reset the chains from before are cleared and the wheel expires the new chains again.
+TEST_FIXTURE(TestCorrelator, TestClockReset) {
+    Implant(3, 4, 5000);
+    Implant(5, 6, 5001);
+    CHECK_EQUAL(2u, GetNumberOfLiveChains());
+
+    Implant(7, 8, 1);
+    CHECK_EQUAL(1u, GetNumberOfLiveChains());
+    CHECK(std::isnan(GetImplantTime(3, 4)));
+
+    Implant(9, 10, 100);
+    CHECK_EQUAL(1u, GetNumberOfLiveChains());
+    CHECK(std::isnan(GetImplantTime(7, 8)));
+}
+
+TEST_FIXTURE(TestCorrelator, TestCorrelateNeighbourhood) {
+    Implant(5, 5, 1);
+    Implant(6, 5, 2);
+    Implant(7, 7, 3);
+
+    //(7, 7) is outside of the neighbourhood, (6, 5) is the latest implant inside
+    EventInfo decay = MakeEvent(EventInfo::DECAY_EVENT, 4);
+    CHECK(CorrelateNeighbourhood(decay, 5, 6));
+    CHECK_EQUAL(VALID_DECAY, GetCondition());
+    CHECK_CLOSE(Ticks(2), decay.dtime, 1);
+    CHECK_CLOSE(Ticks(2), GetDecayTime(6, 5), 1);
+    CHECK(std::isnan(GetDecayTime(5, 5)));
+
+    decay = MakeEvent(EventInfo::DECAY_EVENT, 5);
+    CHECK(CorrelateNeighbourhood(decay, 5, 6, 2));
+    CHECK_CLOSE(Ticks(2), GetDecayTime(7, 7), 1);
+
+    //Nothing near the edges of the detector
+    decay = MakeEvent(EventInfo::DECAY_EVENT, 6);
+    CHECK(!CorrelateNeighbourhood(decay, 0, 0));
+    CHECK(!CorrelateNeighbourhood(decay, 15, 15, 3));
+
+    //Implants that come after the decay are ignored
+    decay = MakeEvent(EventInfo::DECAY_EVENT, 0.5);
+    CHECK(!CorrelateNeighbourhood(decay, 5, 5));
+
+    decay = MakeEvent(EventInfo::DECAY_EVENT, 7);
+    CHECK(!CorrelateNeighbourhood(decay, 16, 0));
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
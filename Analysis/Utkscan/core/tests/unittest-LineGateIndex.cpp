@@ -0,0 +1,55 @@
+///@file unittest-LineGateIndex.cpp
+///@brief Unit tests for the LineGateIndex class
+///@date October 17, 2026
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <UnitTest++.h>
+
+#include "LineGateIndex.hpp"
+
+using namespace std;
+
+TEST(TestMatchesEachGate) {
+    //Overlapping gates, a gate inside another one, gates sharing edges and a gate given from high to low.
+    vector<pair<double, double> > gates;
+    gates.push_back(make_pair(100., 200.));
+    gates.push_back(make_pair(150., 250.));
+    gates.push_back(make_pair(120., 130.));
+    gates.push_back(make_pair(200., 300.));
+    gates.push_back(make_pair(400., 350.));
+    gates.push_back(make_pair(500., 500.));
+    LineGateIndex index(gates);
+    CHECK_EQUAL(gates.size(), index.GetNumberOfGates());
+
+    vector<double> values;
+    for (double value = 0; value <= 600; value += 0.5)
+        values.push_back(value);
+    vector<uint64_t> masks;
+    index.Test(values.data(), values.size(), masks);
+    CHECK_EQUAL(values.size(), masks.size());
+
+    for (size_t i = 0; i < values.size(); i++) {
+        uint64_t expected = 0;
+        for (size_t gate = 0; gate < gates.size(); gate++)
+            if (values[i] >= min(gates[gate].first, gates[gate].second)
+                && values[i] <= max(gates[gate].first, gates[gate].second))
+                expected |= (uint64_t) 1 << gate;
+        CHECK_EQUAL(expected, masks[i]);
+        CHECK_EQUAL(expected, index.GetMask(values[i]));
+    }
+    CHECK_EQUAL((uint64_t) 0, index.GetMask(NAN));
+    CHECK_EQUAL((uint64_t) 0, LineGateIndex().GetMask(100));
+}
+
+TEST(TestTooManyGates) {
+    vector<pair<double, double> > gates(64, make_pair(1., 2.));
+    CHECK_EQUAL((uint64_t) -1, LineGateIndex(gates).GetMask(1.5));
+    gates.push_back(make_pair(1., 2.));
+    CHECK_THROW(LineGateIndex index(gates), invalid_argument);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -0,0 +1,63 @@
+///@file unittest-MapNodeXmlParser.cpp
+///@brief Unit tests for the MapNodeXmlParser class
+///@date October 17, 2026
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <UnitTest++.h>
+
+#include "DefaultConfigurationValues.hpp"
+#include "DetectorLibrary.hpp"
+#include "Globals.hpp"
+#include "XmlInterface.hpp"
+
+using namespace std;
+
+static const string configFile = "unittest-MapNodeXmlParser.xml";
+
+///Writes a configuration with one module, the first channel has its own CFD and fitting parameters.
+void WriteConfiguration() {
+    ofstream file(configFile.c_str());
+    file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+         << "<Configuration>\n"
+         << "    <Description>MapNodeXmlParser unit test</Description>\n"
+         << "    <Global>\n"
+         << "        <Revision version=\"F\"/>\n"
+         << "        <EventWidth unit=\"s\" value=\"1e-6\"/>\n"
+         << "    </Global>\n"
+         << "    <Map>\n"
+         << "        <Module number=\"0\">\n"
+         << "            <Channel number=\"0\" type=\"vandle\" subtype=\"small\" location=\"0\">\n"
+         << "                <Cfd f=\"0.4\" d=\"3\" l=\"2\" g=\"5\"/>\n"
+         << "                <Fit beta=\"0.0035\" gamma=\"1.25\"/>\n"
+         << "            </Channel>\n"
+         << "            <Channel number=\"1\" type=\"vandle\" subtype=\"small\" location=\"1\"/>\n"
+         << "        </Module>\n"
+         << "    </Map>\n"
+         << "</Configuration>\n";
+}
+
+TEST(TestTimingConfiguration) {
+    WriteConfiguration();
+    XmlInterface::get(configFile);
+    Globals::get(configFile);
+    DetectorLibrary *lib = DetectorLibrary::get();
+    remove(configFile.c_str());
+
+    const TimingConfiguration &timing = lib->at(0, 0).GetTimingConfiguration();
+    CHECK_CLOSE(0.4, timing.GetFraction(), 1e-9);
+    CHECK_EQUAL(3u, timing.GetDelay());
+    CHECK_EQUAL(2u, timing.GetLength());
+    CHECK_EQUAL(5u, timing.GetGap());
+    CHECK_CLOSE(0.0035, timing.GetBeta(), 1e-9);
+    CHECK_CLOSE(1.25, timing.GetGamma(), 1e-9);
+
+    const TimingConfiguration &defaults = lib->at(0, 1).GetTimingConfiguration();
+    CHECK_CLOSE(DefaultConfig::cfdF, defaults.GetFraction(), 1e-9);
+    CHECK_CLOSE(DefaultConfig::fitBeta, defaults.GetBeta(), 1e-9);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
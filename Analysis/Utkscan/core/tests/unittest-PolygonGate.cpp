@@ -0,0 +1,116 @@
+///@file unittest-PolygonGate.cpp
+///@brief Unit tests for the PolygonGate class
+///@date October 17, 2026
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <UnitTest++.h>
+
+#include "PolygonGate.hpp"
+
+using namespace std;
+
+namespace {
+    ///The even-odd crossing test over all of the edges, which the compiled gate has to reproduce.
+    bool IsInPolygon(const vector<PolygonGate::Vertex> &vertices, const double &x, const double &y) {
+        bool isInside = false;
+        for (size_t i = 0; i < vertices.size(); i++) {
+            const PolygonGate::Vertex &a = vertices[i], &b = vertices[(i + 1) % vertices.size()];
+            if ((a.second > y) != (b.second > y)
+                && x < (b.first - a.first) * (y - a.second) / (b.second - a.second) + a.first)
+                isInside = !isInside;
+        }
+        return isInside;
+    }
+
+    ///A banana from 077cu.ban, it is concave and has vertices on the same rows and columns.
+    vector<PolygonGate::Vertex> GetBanana() {
+        const double points[][2] = {{260, 6339}, {259, 4639}, {259, 2991}, {261, 2345}, {265, 1410}, {269, 1087},
+                                    {276, 830}, {283, 653}, {284, 518}, {297, 386}, {305, 287}, {328, 185},
+                                    {352, 137}, {390, 104}, {424, 80}, {487, 71}, {538, 59}, {614, 38}, {630, 8},
+                                    {557, 5}, {396, 3}, {331, 5}, {299, 16}, {288, 40}, {278, 78}, {267, 123},
+                                    {256, 173}, {256, 196}, {249, 311}, {242, 393}, {239, 541}, {237, 673},
+                                    {239, 835}, {234, 949}, {233, 989}, {228, 2768}, {229, 4463}, {225, 6291}};
+        vector<PolygonGate::Vertex> vertices;
+        for (size_t i = 0; i < sizeof(points) / sizeof(points[0]); i++)
+            vertices.push_back(make_pair(points[i][0], points[i][1]));
+        return vertices;
+    }
+}
+
+TEST(TestMatchesCrossingTest) {
+    vector<PolygonGate::Vertex> banana = GetBanana();
+    for (unsigned int gridSize = 1; gridSize <= 64; gridSize *= 4) {
+        PolygonGate gate(banana, gridSize);
+        CHECK(gate.GetNumberOfBoundaryCells() <= (size_t) gridSize * gridSize);
+
+        //Every integer point in and around the bounding box, like the rounded values that BananaTest checks.
+        for (int x = 220; x <= 640; x++)
+            for (int y = -5; y <= 6345; y += 7)
+                CHECK_EQUAL(IsInPolygon(banana, x, y), gate.IsWithin(x, y));
+        for (size_t i = 0; i < banana.size(); i++)
+            CHECK_EQUAL(IsInPolygon(banana, banana[i].first, banana[i].second),
+                        gate.IsWithin(banana[i].first, banana[i].second));
+    }
+
+    PolygonGate gate(banana);
+    CHECK(gate.IsWithin(245, 3000));
+    CHECK(!gate.IsWithin(300, 3000));
+    CHECK(!gate.IsWithin(NAN, 3000));
+    CHECK(!PolygonGate().IsWithin(0, 0));
+}
+
+TEST(TestBatch) {
+    vector<PolygonGate::Vertex> square;
+    square.push_back(make_pair(0., 0.));
+    square.push_back(make_pair(10., 0.));
+    square.push_back(make_pair(10., 10.));
+    square.push_back(make_pair(0., 10.));
+    PolygonGate gate(square, 4);
+    CHECK(gate.GetNumberOfBoundaryCells() < 16);
+
+    vector<double> x, y;
+    for (unsigned int i = 0; i < 100; i++) {
+        x.push_back(i % 20);
+        y.push_back(5);
+    }
+    vector<uint64_t> mask;
+    gate.Test(x.data(), y.data(), x.size(), mask);
+    CHECK_EQUAL((size_t) 2, mask.size());
+    for (unsigned int i = 0; i < 100; i++)
+        CHECK_EQUAL(gate.IsWithin(x[i], y[i]), ((mask[i / 64] >> (i % 64)) & 1) != 0);
+
+    square.pop_back();
+    square.pop_back();
+    CHECK_THROW(PolygonGate(square, 4), invalid_argument);
+}
+
+TEST(TestReadBananaFile) {
+    const string fileName = "unittest-PolygonGate.ban";
+    const char *records[] = {"    7    0", "INP test.his 3115     7     0     4", "TIT test", "GATE      0     0",
+                             "CXY      0    0   10    0   10   10", "CXY      0   10", "CXY"};
+    ofstream file(fileName.c_str());
+    for (size_t i = 0; i < sizeof(records) / sizeof(records[0]); i++)
+        file << string(records[i]).append(80 - string(records[i]).size(), ' ');
+    file.close();
+
+    map<unsigned int, PolygonGate> bananas = PolygonGate::ReadBananaFile(fileName);
+    CHECK_EQUAL((size_t) 1, bananas.size());
+    CHECK_EQUAL((size_t) 4, bananas[7].GetVertices().size() - 1);
+    CHECK(bananas[7].IsWithin(5, 5));
+    CHECK(!bananas[7].IsWithin(11, 5));
+
+    file.open(fileName.c_str());
+    file << "INP test.his 3115     7     0     5\n" << "CXY      0    0   10    0   10   10\n";
+    file.close();
+    CHECK_THROW(PolygonGate::ReadBananaFile(fileName), invalid_argument);
+    remove(fileName.c_str());
+    CHECK_THROW(PolygonGate::ReadBananaFile(fileName), invalid_argument);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
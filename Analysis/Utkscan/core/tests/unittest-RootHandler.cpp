@@ -31,6 +31,70 @@ TEST(TestRootHandler) {
     delete RootHandler::get();
 }
 
+TEST(TestFlushCopiesOnlyModifiedHistograms) {
+    RootHandler *handler = RootHandler::get("/tmp/unittest-RootHandler-flush");
+    handler->RegisterHistogram(0, "first", 10);
+    handler->RegisterHistogram(1, "second", 10);
+    handler->RegisterHistogram(2, "third", 10, 10);
+
+    handler->Plot(0, 1);
+    handler->Plot(2, 1, 1);
+    handler->Flush();
+    handler->WaitForFlush();
+    CHECK_EQUAL(2u, handler->GetNumberOfFlushedHistograms());
+
+    handler->Plot(1, 2);
+    handler->Flush();
+    handler->WaitForFlush();
+    CHECK_EQUAL(1u, handler->GetNumberOfFlushedHistograms());
+
+    //A budget of one byte lets every flush copy a single histogram.
+    handler->SetFlushBudgetInBytes(1);
+    handler->Plot(0, 1);
+    handler->Plot(1, 1);
+    handler->Flush();
+    handler->WaitForFlush();
+    CHECK_EQUAL(1u, handler->GetNumberOfFlushedHistograms());
+    handler->Flush();
+    handler->WaitForFlush();
+    CHECK_EQUAL(1u, handler->GetNumberOfFlushedHistograms());
+
+    delete RootHandler::get();
+}
+
+TEST(TestDeclaredHistogramsAreAllocatedWhenFilled) {
+    RootHandler *handler = RootHandler::get("/tmp/unittest-RootHandler-lazy");
+    handler->DeclareHistogram(0, "1d", 10);
+    handler->DeclareHistogram(1, "2d", 100, 100);
+    handler->DeclareHistogram(2, "2d-xz", 100, 0, 100);
+    handler->DeclareHistogram(3, "2d-small", 2, 2);
+    CHECK_EQUAL(0u, handler->GetNumberOfDenseHistograms());
+
+    handler->Plot(0, 1);
+    handler->Plot(1, 1, 2);
+    handler->Plot(2, 1, -1, 2);
+    CHECK_EQUAL(1u, handler->GetNumberOfDenseHistograms());
+    CHECK_EQUAL(2u, handler->GetNumberOfSparseHistograms());
+
+    //Four filled bins take more memory than the 16 cells of the dense histogram.
+    handler->Plot(3, 0, 0);
+    handler->Plot(3, 0, 1);
+    handler->Plot(3, 1, 0);
+    handler->Plot(3, 1, 1);
+    CHECK_EQUAL(2u, handler->GetNumberOfDenseHistograms());
+    CHECK_EQUAL(2u, handler->GetNumberOfSparseHistograms());
+
+    //Asking for the ROOT histogram makes the sparse one dense and keeps its contents.
+    CHECK_EQUAL(1.0, handler->Get2DHistogram(1)->GetBinContent(2, 3));
+    CHECK_EQUAL(1u, handler->GetNumberOfSparseHistograms());
+
+    handler->Flush();
+    handler->WaitForFlush();
+    CHECK_EQUAL(4u, handler->GetNumberOfFlushedHistograms());
+
+    delete RootHandler::get();
+}
+
 int main(int argv, char *argc[]) {
     return (UnitTest::RunAllTests());
 }
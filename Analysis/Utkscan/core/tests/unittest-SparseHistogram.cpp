@@ -0,0 +1,49 @@
+///@file unittest-SparseHistogram.cpp
+///@brief Unit tests for the SparseHistogram class
+///@date October 17, 2026
+#include <cmath>
+
+#include <UnitTest++.h>
+
+#include "SparseHistogram.hpp"
+
+TEST(TestBinsAreNumberedLikeRoot) {
+    //A 10 x 5 histogram has 12 x 7 cells with the underflow and overflow bins.
+    SparseHistogram histogram(10, 5);
+    CHECK_EQUAL(2u, histogram.GetDimension());
+    CHECK_EQUAL(84ULL, (unsigned long long) histogram.GetNumberOfCells());
+
+    CHECK(histogram.Fill(0.5, 0.5));
+    CHECK(!histogram.Fill(0.7, 0.2));
+    CHECK(histogram.Fill(9.99, 4.5));
+    CHECK(histogram.Fill(-1, 10));
+    CHECK(histogram.Fill(NAN, 2));
+    CHECK_EQUAL(5.0, histogram.GetEntries());
+    CHECK_EQUAL((size_t) 4, histogram.GetNumberOfFilledBins());
+
+    CHECK_EQUAL(2.0, histogram.GetBinContent(1 + 12 * 1));
+    CHECK_EQUAL(1.0, histogram.GetBinContent(10 + 12 * 5));
+    CHECK_EQUAL(1.0, histogram.GetBinContent(0 + 12 * 6));
+    CHECK_EQUAL(1.0, histogram.GetBinContent(0 + 12 * 3));
+    CHECK_EQUAL(0.0, histogram.GetBinContent(5));
+}
+
+TEST(TestCubeAndMemory) {
+    SparseHistogram histogram(2, 2, 2);
+    CHECK_EQUAL(3u, histogram.GetDimension());
+    CHECK_EQUAL(64ULL, (unsigned long long) histogram.GetNumberOfCells());
+
+    histogram.Fill(1, 0, 1);
+    CHECK_EQUAL(1.0, histogram.GetBinContent(2 + 4 * (1 + 4 * 2)));
+
+    //The dense cube takes 512 bytes, so the sparse one stops paying off after 12 bins.
+    for (unsigned int i = 0; i < 12; i++) {
+        CHECK(!histogram.IsDenseSmaller());
+        histogram.Fill((int) (i % 4) - 1, i / 4, 0);
+    }
+    CHECK(histogram.IsDenseSmaller());
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
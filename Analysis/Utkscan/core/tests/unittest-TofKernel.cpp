@@ -0,0 +1,56 @@
+///@file unittest-TofKernel.cpp
+///@brief Unit tests for the TofKernel class
+///@date October 17, 2026
+#include <UnitTest++.h>
+
+#include "TofKernel.hpp"
+
+using namespace std;
+
+///The scalar calculation that VandleProcessor used for every pair.
+static double ScalarCorrectedTof(const double &tof, const double &flightPath, const double &z0) {
+    return ((z0 / flightPath) * tof);
+}
+
+TEST_FIXTURE(TofKernel, TestMatchesScalarCalculation) {
+    TimingCalibration first, second;
+    first.SetZ0(100.3);
+    first.SetTofOffset(1, 3.7);
+    first.SetTofOffset(4, -1.1);
+    second.SetZ0(50.1);
+    second.SetTofOffset(4, 0.3);
+
+    vector<double> startTimes = {10.123456789, 11.987654321, 9.5};
+    vector<unsigned int> startLocations = {1, 4, 7};
+    for (unsigned int i = 0; i < startTimes.size(); i++)
+        AddStart(startTimes[i], startLocations[i]);
+
+    vector<double> barTimes = {80.0001, 123.456789}, flightPaths = {101.7, 57.3};
+    AddBar(barTimes[0], flightPaths[0], first);
+    AddBar(barTimes[1], flightPaths[1], second);
+    Calculate();
+
+    CHECK_EQUAL((size_t) 2, GetNumberOfBars());
+    CHECK_EQUAL((size_t) 3, GetNumberOfStarts());
+    CHECK_EQUAL(7u, GetStartLocation(2));
+
+    const TimingCalibration *cals[] = {&first, &second};
+    for (unsigned int bar = 0; bar < 2; bar++) {
+        for (unsigned int start = 0; start < startTimes.size(); start++) {
+            double tof = barTimes[bar] - startTimes[start] + cals[bar]->GetTofOffset(startLocations[start]);
+            //Bitwise equality, not just close.
+            CHECK(tof == GetTofs().at(bar * 3 + start));
+            CHECK(ScalarCorrectedTof(tof, flightPaths[bar], cals[bar]->GetZ0()) ==
+                  GetCorrectedTofs().at(bar * 3 + start));
+        }
+    }
+
+    Clear();
+    AddBar(1, 1, first);
+    Calculate();
+    CHECK(GetTofs().empty());
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -0,0 +1,54 @@
+///@file unittest-TreeWriter.cpp
+///@brief Unit tests for the TreeWriter class
+///@date October 17, 2026
+#include <stdexcept>
+
+#include <UnitTest++.h>
+
+#include <TTree.h>
+
+#include "TreeWriter.hpp"
+
+using namespace std;
+
+TEST(TestGetLeafListSize) {
+    //The leaf list of the HrtRoot branches of TwoChanTimingProcessor
+    CHECK_EQUAL((size_t) 57, TreeWriter::GetLeafListSize("qdc/D:time:snr:wtime:phase:abase:sbase:id/b"));
+    CHECK_EQUAL((size_t) 4, TreeWriter::GetLeafListSize("energy"));
+    CHECK_EQUAL((size_t) 25, TreeWriter::GetLeafListSize("trace[10]/s:flag/O:pos[2][1]/s"));
+    CHECK_THROW(TreeWriter::GetLeafListSize("name/C"), invalid_argument);
+    CHECK_THROW(TreeWriter::GetLeafListSize("trace[n]/D"), invalid_argument);
+    CHECK_THROW(TreeWriter::GetLeafListSize("trace[4/D"), invalid_argument);
+    CHECK_THROW(TreeWriter::GetLeafListSize("energy/DD"), invalid_argument);
+}
+
+TEST(TestFillCopiesTheBranchContents) {
+    struct Data {
+        double energy;
+        unsigned int id;
+    } data = {0, 0};
+
+    TTree tree("tree", "tree");
+    TreeWriter writer;
+    writer.SetQueueSize(2);
+    writer.AddBranch(&tree, "data", &data, "energy/D:id/i");
+    CHECK_THROW(writer.Fill(nullptr), invalid_argument);
+
+    for (unsigned int i = 0; i < 100; i++) {
+        data.energy = 1.5 * i;
+        data.id = i;
+        writer.Fill(&tree);
+    }
+    CHECK_THROW(writer.AddBranch(&tree, "other", &data, "energy/D"), logic_error);
+    writer.Stop();
+    CHECK_EQUAL(100, tree.GetEntries());
+
+    //The writer's buffer holds the contents of the last entry that it filled.
+    Data *written = (Data *) tree.GetBranch("data")->GetAddress();
+    CHECK_EQUAL(1.5 * 99, written->energy);
+    CHECK_EQUAL(99u, written->id);
+}
+
+int main(int argv, char *argc[]) {
+    return (UnitTest::RunAllTests());
+}
@@ -39,8 +39,8 @@ public:
     virtual bool Process(RawEvent &event);
 
 private:
-    TFile *rootfile_; //!< the root file to be used for output
-    TTree *roottree_; //!< the root tree to be used for storing data
+    TFile *rootfile_; //!< the root file that holds the ROOT histograms
+    TTree *roottree_; //!< the tree registered with the RootHandler for the QDC and ToF
     TH2D *qdctof_; //!< a 2D histogram in ROOT
     TH1D *vsize_; //!< a 1D histogram in root
     std::ofstream *outstream; //!< filestream to output to text file
@@ -99,6 +99,8 @@ Anl1471Processor::Anl1471Processor() : EventProcessor(OFFSET, RANGE, "Anl1471Pro
     associatedTypes.insert("vandle");
     associatedTypes.insert("beta");
     associatedTypes.insert("ge");
+    dependencies.insert("VandleProcessor");
+    dependencies.insert("CloverProcessor");
 
     vandleTree_ = RootHandler::get()->RegisterTree("vandle", "VANDLE event data");
     RootHandler::get()->RegisterBranch("vandle", "vandle", &vroot,"tof/D:qdc:snrl:snrr:pos:tdiff:ben:bqdcl:bqdcr:bsnrl:bsnrr:cyc:bcyc:HPGE:vid/I:vtype:bid");
@@ -160,7 +162,7 @@ bool Anl1471Processor::Process(RawEvent &event) {
             barType = 1;
 
         unsigned int barLoc = barId.first;
-        const TimingCalibration cal = bar.GetCalibration();
+        const TimingCalibration &cal = bar.GetCalibration();
 
         for (BarMap::iterator itStart = betaStarts_.begin(); itStart != betaStarts_.end(); itStart++) {
             BarDetector beta_start = (*itStart).second;
@@ -217,7 +219,7 @@ bool Anl1471Processor::Process(RawEvent &event) {
             vroot.vid = barLoc;
             vroot.vtype = barType;
             vroot.bid = startLoc;
-            vandleTree_->Fill();
+            RootHandler::get()->FillTree(vandleTree_);
         } // for(TimingMap::iterator itStart
     } //(BarMap::iterator itBar
     //End processing for VANDLE bars
@@ -268,7 +270,7 @@ bool Anl1471Processor::Process(RawEvent &event) {
             groot.gbcyc = gb_time - gcyc_time;
             groot.gid = ge_id;
             groot.gbid = gb_startLoc;
-            gammaTree_->Fill();
+            RootHandler::get()->FillTree(gammaTree_);
         }
     }
 
@@ -14,6 +14,7 @@
 #include "DetectorDriver.hpp"
 #include "CloverProcessor.hpp"
 #include "IS600Processor.hpp"
+#include "RootHandler.hpp"
 #include "VandleProcessor.hpp"
 
 static double tof_;
@@ -64,6 +65,9 @@ IS600Processor::IS600Processor() : EventProcessor(OFFSET, RANGE,
     associatedTypes.insert("labr3");
     associatedTypes.insert("beta");
     associatedTypes.insert("ge");
+    dependencies.insert("VandleProcessor");
+    dependencies.insert("DoubleBetaProcessor");
+    dependencies.insert("CloverProcessor");
 
     stringstream name;
     name << Globals::get()->GetOutputPath()
@@ -75,9 +79,9 @@ IS600Processor::IS600Processor() : EventProcessor(OFFSET, RANGE,
              << Globals::get()->GetOutputFileName() << "-IS600.root";
     cout << rootname.str() << endl;
     rootfile_ = new TFile(rootname.str().c_str(), "RECREATE");
-    roottree_ = new TTree("vandle", "");
-    roottree_->Branch("tof", &tof_, "tof/D");
-    roottree_->Branch("qdc", &qdc_, "qdc/D");
+    roottree_ = RootHandler::get()->RegisterTree("vandle", "VANDLE QDC and ToF");
+    RootHandler::get()->RegisterBranch("vandle", "tof", &tof_, "tof/D");
+    RootHandler::get()->RegisterBranch("vandle", "qdc", &qdc_, "qdc/D");
     qdctof_ = new TH2D("qdctof", "", 1000, -100, 900, 16000, 0, 16000);
     vsize_ = new TH1D("vsize", "", 40, 0, 40);
 }
@@ -149,7 +153,7 @@ bool IS600Processor::Process(RawEvent &event) {
             continue;
 
         unsigned int barLoc = barId.first;
-        TimingCalibration cal = bar.GetCalibration();
+        const TimingCalibration &cal = bar.GetCalibration();
 
         for (BarMap::iterator itStart = betas.begin();
              itStart != betas.end(); itStart++) {
@@ -177,7 +181,7 @@ bool IS600Processor::Process(RawEvent &event) {
             qdctof_->Fill(tof, bar.GetQdc());
             qdc_ = bar.GetQdc();
             tof_ = tof;
-            roottree_->Fill();
+            RootHandler::get()->FillTree(roottree_);
             qdc_ = tof_ = -9999;
 
             histo.Plot(DD_DEBUGGING1, tof * plotMult_ + plotOffset_, bar.GetQdc());
@@ -203,7 +207,7 @@ bool IS600Processor::Process(RawEvent &event) {
 
                 bool isAdjacent = abs((int) barLoc2 - (int) barLoc) < 1;
 
-                TimingCalibration cal2 = bar2.GetCalibration();
+                const TimingCalibration &cal2 = bar2.GetCalibration();
 
                 double tofOffset2 = cal2.GetTofOffset(startLoc);
                 double tof2 = bar2.GetCorTimeAve() -
@@ -52,6 +52,8 @@ TemplateExpProcessor::~TemplateExpProcessor() = default;
 void TemplateExpProcessor::SetAssociatedTypes() {
     associatedTypes.insert("template");
     associatedTypes.insert("clover");
+    dependencies.insert("TemplateProcessor");
+    dependencies.insert("CloverProcessor");
 }
 
 ///Registers the ROOT tree and branches with RootHandler.
@@ -96,7 +98,7 @@ bool TemplateExpProcessor::Process(RawEvent &event) {
 
             tEnergy = templateEvent->GetEnergy();
             tof_ = templateEvent->GetTime() - geEvent->GetWalkCorrectedTime();
-            tree_->Fill();
+            RootHandler::get()->FillTree(tree_);
             tEnergy = tof_ = -9999;
 
             ///Plot the Ge energy with a cut
@@ -97,7 +97,7 @@ bool TwoChanTimingProcessor::Process(RawEvent &event) {
     if (start.GetIsValid() && stop.GetIsValid()) {
         start.FillRootStructure(rstart);
         stop.FillRootStructure(rstop);
-        tree_->Fill();
+        RootHandler::get()->FillTree(tree_);
         start.ZeroRootStructure(rstart);
         stop.ZeroRootStructure(rstop);
     }
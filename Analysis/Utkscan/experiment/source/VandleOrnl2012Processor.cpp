@@ -61,6 +61,8 @@ void VandleOrnl2012Processor::DeclarePlots(void) {
 VandleOrnl2012Processor::VandleOrnl2012Processor() :
         EventProcessor(OFFSET, RANGE, "VandleOrnl2012Processor") {
     associatedTypes.insert("vandle");
+    dependencies.insert("VandleProcessor");
+    dependencies.insert("CloverProcessor");
 
     stringstream name;
     name << Globals::get()->GetOutputPath()
@@ -100,7 +102,7 @@ bool VandleOrnl2012Processor::Process(RawEvent &event) {
             continue;
 
         unsigned int barLoc = barId.first;
-        TimingCalibration cal = bar.GetCalibration();
+        const TimingCalibration &cal = bar.GetCalibration();
 
         bool isLower = barLoc > 6 && barLoc < 16;
         bool isUpper = barLoc > 29 && barLoc < 39;
@@ -74,7 +74,7 @@ bool WalkVandleBetaProcessor::Process(RawEvent &event) {
         if (!isLower)
             continue;
 
-        TimingCalibration cal = bar.GetCalibration();
+        const TimingCalibration &cal = bar.GetCalibration();
 
         if (barLoc == 12) {
             plot(DD_DEBUGGING4, bar.GetLeftSide().GetTraceQdc(), 0);
@@ -9,9 +9,14 @@
 #include <utility>
 #include <cmath>
 
+#include "CoincidenceStore.hpp"
 #include "EventProcessor.hpp"
 #include "RawEvent.hpp"
 
+#ifdef GGATES
+#include "LineGateIndex.hpp"
+#endif
+
 namespace dammIds {
     //! Namespace containing histogram definitions for the GE
     namespace clover {
@@ -45,6 +50,7 @@ namespace dammIds {
         const int DD_ENERGY__TIMEX = 120;//!< Energy vs. Time
 
         const int DD_ADD_ENERGY = 150;//!< Addback Energy
+        const int DD_ADD_ENERGY__GATEX = 153;//!< Addback Energy in triples - Gated
 
         const int DD_TDIFF__GAMMA_GAMMA_ENERGY = 155;//!< Tdiff vs Gamma-Gamma Energy
         const int DD_TDIFF__GAMMA_GAMMA_ENERGY_SUM = 156;//!< Tdiff vs. Gamma-Gamma Energy sum
@@ -192,6 +198,18 @@ public:
                 double cycle_gate1_min, double cycle_gate1_max,
                 double cycle_gate2_min, double cycle_gate2_max);
 
+    /** Default destructor, writes the coincidence stores to disk */
+    virtual ~CloverProcessor();
+
+    /** Stores the prompt addback gamma-gamma and gamma-gamma-gamma
+     * coincidences in sparse CoincidenceStores instead of the dense
+     * addback gamma-gamma matrix. The stores are written next to the
+     * output file at the end of the run.
+     * \param [in] numberOfBins : the number of energy bins on each axis
+     * \param [in] binWidth : the width of an energy bin in keV */
+    void SetCoincidenceStore(const unsigned int &numberOfBins,
+                             const double &binWidth);
+
     /** Preprocess the event
      * \param [in] event : the event to preprocess
      * \return true if successful */
@@ -215,6 +233,23 @@ public:
     /** Returns the events that were added to the tas_ */
     std::vector<AddBackEvent> GetTasEvents(void) { return (tas_); }
 
+    /** Adds the addback gammas to the columnar output
+     * \param [in] writer : the writer of the columnar output
+     * \return true since the columns are always added */
+    bool AddBranch(ColumnarWriter &writer);
+
+    /** Copies the addback gammas of the event into the columnar structure,
+     * or zeroes it if there was no clover event */
+    void FillBranch(void);
+
+    /** Returns the sparse addback gamma-gamma store, NULL if disabled */
+    CoincidenceStore *GetGammaGammaStore(void) { return (gammaGamma_); }
+
+    /** Returns the sparse addback gamma-gamma-gamma store, NULL if disabled */
+    CoincidenceStore *GetGammaGammaGammaStore(void) {
+        return (gammaGammaGamma_);
+    }
+
 protected:
     static const unsigned int chansPerClover = 4; /*!< number of channels per clover */
 
@@ -264,6 +299,14 @@ protected:
      * \param [in] bin2 : the second bin to plot into */
     void symplot(int dammID, double bin1, double bin2);
 
+    /** Adds the prompt pairs and triples of addback gammas of an event
+     * to the coincidence stores.
+     * \param [in] ev : the index of the addback event */
+    void StoreCoincidences(unsigned int ev);
+
+    CoincidenceStore *gammaGamma_; //!< Sparse addback gamma-gamma store
+    CoincidenceStore *gammaGammaGamma_; //!< Sparse addback gamma-gamma-gamma store
+
     /** addbackEvents vector of vectors, where first vector
      * enumerates cloves, second events */
     std::vector<std::vector<AddBackEvent>> addbackEvents_;
@@ -273,6 +316,8 @@ protected:
     std::vector<AddBackEvent> tas_;
 #ifdef GGATES
     std::vector< std::vector<LineGate> > gGates; //!< List of Gamma gates to use
+    LineGateIndex lowGateIndex_; //!< The lower lines of gGates, bit i is gate i
+    LineGateIndex highGateIndex_; //!< The upper lines of gGates, bit i is gate i
 #endif
 
     /** Gamma low threshold in keV */
@@ -297,6 +342,21 @@ protected:
     double cycle_gate1_max_;//!< high value for first cycle gate
     double cycle_gate2_min_;//!< low value for second cycle gate
     double cycle_gate2_max_;//!< high value for second cycle gate
+
+private:
+    static const unsigned int numColumnarGammas = 16; /*!< number of addback gammas in a columnar row */
+
+    /** The addback gammas of an event laid out for the columnar output */
+    struct ColumnarData {
+        double energy[numColumnarGammas]; //!< energy of the addback gamma
+        double time[numColumnarGammas]; //!< time of the addback gamma
+        unsigned int clover[numColumnarGammas]; //!< clover of the addback gamma
+        unsigned int multiplicity[numColumnarGammas]; //!< number of crystals in the addback gamma
+        unsigned int mult; //!< number of addback gammas, only the first numColumnarGammas are kept
+
+        /** Zeroes the structure */
+        void Clear(void);
+    } columnarData_; //!< The structure that is written to the columnar output
 };
 
 #endif // __CloverProcessor_HPP_
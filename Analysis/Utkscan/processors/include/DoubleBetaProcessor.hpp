@@ -33,10 +33,10 @@ public:
     virtual bool Process(RawEvent &event);
 
     /** \return The map of the bars that had high resolution timing */
-    BarMap GetBars(void) { return (bars_); }
+    const BarMap &GetBars(void) const { return (bars_); }
 
     /** \return the map of the bars that had low resolution timing */
-    std::map<unsigned int, std::pair<double, double> > GetLowResBars(void) {
+    const std::map<unsigned int, std::pair<double, double> > &GetLowResBars(void) const {
         return (lrtbars_);
     }
 
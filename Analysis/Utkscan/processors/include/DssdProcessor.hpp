@@ -6,6 +6,7 @@
 #ifndef __DSSDPROCESSOR_HPP_
 #define __DSSDPROCESSOR_HPP_
 
+#include "Correlator.hpp"
 #include "EventProcessor.hpp"
 
 class DetectorSummary;
@@ -15,7 +16,13 @@ class RawEvent;
 ///Handles detectors of type dssd_front and dssd_back
 class DssdProcessor : public EventProcessor {
 public:
-    DssdProcessor(); // no virtual c'tors
+    /** Constructor taking the size of the detector
+     * \param [in] numFrontStrips : the number of front strips
+     * \param [in] numBackStrips : the number of back strips
+     * \param [in] radius : decays are correlated with the latest implant
+     * within this many strips, 0 only uses the pixel of the decay */
+    DssdProcessor(const unsigned int &numFrontStrips, const unsigned int &numBackStrips,
+                  const unsigned int &radius); // no virtual c'tors
     virtual void DeclarePlots(void);
 
     virtual bool Process(RawEvent &event);
@@ -24,6 +31,8 @@ private:
     DetectorSummary *frontSummary; ///< all detectors of type dssd_front
     DetectorSummary *backSummary;  ///< all detectors of type dssd_back
     static const double cutoffEnergy; ///< cutoff energy for implants versus decays
+    Correlator corr_; ///< correlates the decays with the implants in the detector
+    unsigned int radius_; ///< the number of strips searched around a decay for its implant
 };
 
 #endif // __DSSDPOCESSOR_HPP_
@@ -15,6 +15,8 @@
 #include "TreeCorrelator.hpp"
 
 // forward declarations
+class ColumnarWriter;
+
 class DetectorSummary;
 
 class RawEvent;
@@ -45,6 +47,12 @@ public:
         return (associatedTypes);
     }
 
+    /** \return The names of the processors whose results are used in
+     * Process. DetectorDriver calls Process on these processors first. */
+    const std::set<std::string> &GetDependencies(void) const {
+        return (dependencies);
+    }
+
     /** \return The status of the Processor */
     virtual bool DidProcess(void) const {
         return (didProcess);
@@ -91,6 +99,14 @@ public:
     */
     virtual bool AddBranch(TTree *tree) { return (false); };
 
+    /** This function adds the columns that hold the data generated by this
+    * event processor to the columnar output. It uses the same structures and
+    * leaf lists as the ROOT branch, and the structures are copied into a new
+    * row after FillBranch was called.
+    * \param [in] writer : The writer of the columnar output
+    * \return True if the processor added columns */
+    virtual bool AddBranch(ColumnarWriter &writer) { return (false); };
+
     /** This function is called to fill the appropriate root branch. Note that
     * since ROOT branches can't be empty that the data needs to be properly
     * zeroed for events where no detectors of interest to this processor
@@ -101,6 +117,7 @@ public:
 protected:
     std::string name; //!< Name of the Processor
     std::set<std::string> associatedTypes; //!< Set of associated types for Processor
+    std::set<std::string> dependencies; //!< Names of the processors whose results are used in Process
     bool initDone;//!< True if the initialization has finished
     bool didProcess;//!< True if the process finished
     std::map<std::string, const DetectorSummary *> sumMap; //!< Map of associated detector summary
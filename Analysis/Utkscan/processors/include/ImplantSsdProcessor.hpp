@@ -13,8 +13,10 @@ class RawEvent;
 //! Handles detectors of type ssd:implant
 class ImplantSsdProcessor : public EventProcessor {
 public:
-    /** Default Constructor */
-    ImplantSsdProcessor();
+    /** Constructor taking the size of the detector
+     * \param [in] numStrips : the number of strips (locations)
+     * \param [in] numPositions : the number of positions along a strip */
+    ImplantSsdProcessor(const unsigned int &numStrips, const unsigned int &numPositions);
 
     /** Default Destructor */
     ~ImplantSsdProcessor() {};
@@ -34,6 +36,8 @@ private:
 
     static const unsigned int numTraces = 100;//!< number of traces
 
+    Correlator corr_;//!< correlates the decays with the implants in the detector
+
     unsigned int fastTracesWritten;//!< Number of fast traces written
     unsigned int highTracesWritten;//!< Number of high traces written
 
@@ -47,6 +47,11 @@ public:
     * \return true if you could do it */
     bool AddBranch(TTree *tree);
 
+    /** Add the columns to the columnar output
+    * \param [in] writer : the writer of the columnar output
+    * \return true if you could do it */
+    bool AddBranch(ColumnarWriter &writer);
+
     /** Fill the branch */
     void FillBranch(void);
 };
@@ -16,10 +16,12 @@
 #define __VANDLEPROCESSOR_HPP_
 #include <set>
 #include <string>
+#include <vector>
 
 #include "BarDetector.hpp"
 #include "EventProcessor.hpp"
 #include "HighResTimingData.hpp"
+#include "TofKernel.hpp"
 
 /// Class to process VANDLE related events
 class VandleProcessor : public EventProcessor {
@@ -61,7 +63,7 @@ public:
     }
 
     ///@return the map of the build VANDLE bars */
-    BarMap GetBars(void) { return bars_; }
+    const BarMap &GetBars(void) const { return bars_; }
 
     ///@return true if we requested small bars in the xml */
     bool GetHasSmall(void) { return requestedTypes_.find("small") != requestedTypes_.end(); }
@@ -72,16 +74,36 @@ public:
     ///@return true if we requsted large bars in the xml */
     bool GetHasBig(void) { return requestedTypes_.find("big") != requestedTypes_.end(); }
 
+    ///Adds the times of flight of the bar and start pairs to the columnar output
+    ///@param [in] writer : the writer of the columnar output
+    ///@return true since the columns are always added
+    bool AddBranch(ColumnarWriter &writer);
+
+    ///Copies the times of flight of the event into the columnar structure, or zeroes it if there was no VANDLE event
+    void FillBranch(void);
+
 private:
-    ///Analyze the data for scenarios with Bar Starts; e.g. Double Beta detectors
-    void AnalyzeBarStarts(const BarDetector &bar, unsigned int &barLoc);
+    static const unsigned int numColumnarTofs = 16; //!< The number of bar and start pairs in a columnar row
 
-    ///Analyze the data for scenarios with Single sided Starts; e.g. LeRIBSS beta scintillators.
-    void AnalyzeStarts(const BarDetector &bar, unsigned int &barLoc);
+    ///The times of flight of an event laid out for the columnar output
+    struct ColumnarData {
+        double qdc[numColumnarTofs]; //!< The QDC of the bar
+        double tof[numColumnarTofs]; //!< The time of flight
+        double corTof[numColumnarTofs]; //!< The corrected time of flight
+        unsigned int bar[numColumnarTofs]; //!< The location of the bar
+        unsigned int start[numColumnarTofs]; //!< The location of the start
+        unsigned int mult; //!< The number of pairs in the event, only the first numColumnarTofs are kept
+
+        ///Zeroes the structure
+        void Clear(void);
+    } columnarData_; //!< The structure that is written to the columnar output
 
     ///Fill up the basic histograms
     void FillVandleOnlyHists();
 
+    ///Plots the times of flight of every pair of analyzed bar and start that the kernel calculated.
+    void PlotTofHistograms(void);
+
     void PlotTofHistograms(const double &tof, const double &cortof, const double &qdc,
                            const unsigned int &barPlusStartLoc, const unsigned int &offset);
 
@@ -92,6 +114,8 @@ private:
     BarMap bars_;//!< A map to hold all the bars
     TimingMap starts_;//!< A map to to hold all the starts
     BarMap barStarts_;//!< A map that holds all of the bar starts
+    TofKernel kernel_; //!< Calculates the times of flight of all bar and start pairs
+    std::vector<BarMap::const_iterator> analyzedBars_; //!< The bars in the kernel, in the same order
     DetectorSummary *geSummary_;//!< The Detector Summary for Ge Events
 
     bool hasDecay_; //!< True if there was a correlated beta decay
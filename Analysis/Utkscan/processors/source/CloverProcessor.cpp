@@ -16,6 +16,7 @@
 
 #include "pugixml.hpp"
 
+#include "ColumnarWriter.hpp"
 #include "DammPlotIds.hpp"
 #include "DetectorLibrary.hpp"
 #include "Display.h"
@@ -71,7 +72,7 @@ CloverProcessor::CloverProcessor(double gammaThreshold, double lowRatio,
                          double cycle_gate1_min, double cycle_gate1_max,
                          double cycle_gate2_min, double cycle_gate2_max) :
         EventProcessor(OFFSET, RANGE, "CloverProcessor"),
-        leafToClover() {
+        leafToClover(), gammaGamma_(NULL), gammaGammaGamma_(NULL) {
     associatedTypes.insert("ge"); // associate with germanium detectors
 
     gammaThreshold_ = gammaThreshold;
@@ -137,7 +138,124 @@ CloverProcessor::CloverProcessor(double gammaThreshold, double lowRatio,
             m.detail(ss.str(), 2);
         }
     }
+
+    //The gates are checked all at once in Process, each event then costs a binary search per line.
+    if (gGates.size() > LineGateIndex::maximumNumberOfGates)
+        throw PaassException("CloverProcessor::CloverProcessor - At most 64 gamma-gamma gates are implemented");
+    vector< pair<double, double> > lowLines, highLines;
+    for (vector< vector<LineGate> >::const_iterator it = gGates.begin(); it != gGates.end(); ++it) {
+        lowLines.push_back(make_pair((*it)[0].min, (*it)[0].max));
+        highLines.push_back(make_pair((*it)[1].min, (*it)[1].max));
+    }
+    lowGateIndex_ = LineGateIndex(lowLines);
+    highGateIndex_ = LineGateIndex(highLines);
+#endif
+}
+
+CloverProcessor::~CloverProcessor() {
+    if (gammaGamma_ == NULL)
+        return;
+
+#ifdef GGATES
+    /** Project the addback cube through the gamma-gamma gates */
+    TH2D *gated = RootHandler::get()->Get2DHistogram(
+            histo.GetOffset() + DD_ADD_ENERGY__GATEX);
+    unsigned ig = 0;
+    for (vector< vector<LineGate> >::iterator it_gate = gGates.begin();
+            it_gate != gGates.end(); ++it_gate, ++ig) {
+        vector<double> projection = gammaGammaGamma_->Project(
+                make_pair((*it_gate)[0].min, (*it_gate)[0].max),
+                make_pair((*it_gate)[1].min, (*it_gate)[1].max));
+        double binWidth = gammaGammaGamma_->GetBinWidth();
+        for (unsigned int bin = 0; bin < projection.size(); ++bin)
+            if (projection[bin] != 0)
+                gated->Fill((bin + 0.5) * binWidth, ig, projection[bin]);
+    }
 #endif
+
+    string prefix = Globals::get()->GetOutputPath() + Globals::get()->GetOutputFileName();
+    CoincidenceStore *stores[2] = {gammaGamma_, gammaGammaGamma_};
+    string suffixes[2] = {"-gg.bin", "-ggg.bin"};
+    for (unsigned int i = 0; i < 2; ++i) {
+        if (!stores[i]->Save(prefix + suffixes[i]))
+            cout << Display::WarningStr("CloverProcessor::~CloverProcessor"
+                                                " - Could not write "
+                                        + prefix + suffixes[i]) << endl;
+        else
+            cout << "CloverProcessor : Wrote " << stores[i]->GetNumberOfCells()
+                 << " cells holding " << stores[i]->GetNumberOfEntries()
+                 << " coincidences to " << prefix + suffixes[i] << endl;
+        delete stores[i];
+    }
+}
+
+void CloverProcessor::SetCoincidenceStore(const unsigned int &numberOfBins,
+                                          const double &binWidth) {
+    delete gammaGamma_;
+    delete gammaGammaGamma_;
+    gammaGamma_ = new CoincidenceStore(2, numberOfBins, binWidth);
+    gammaGammaGamma_ = new CoincidenceStore(3, numberOfBins, binWidth);
+}
+
+bool CloverProcessor::AddBranch(ColumnarWriter &writer) {
+    const string size = "[" + to_string(numColumnarGammas) + "]";
+    writer.AddColumns(name, &columnarData_, "energy" + size + "/D:time" + size
+                      + ":clover" + size + "/i:multiplicity" + size + ":mult");
+    return true;
+}
+
+void CloverProcessor::FillBranch(void) {
+    columnarData_.Clear();
+    if (!HasEvent())
+        return;
+
+    /** The gammas are ordered by sub-event and then by clover */
+    for (unsigned int ev = 0; ev < tas_.size(); ++ev) {
+        for (unsigned int det = 0; det < numClovers; ++det) {
+            const AddBackEvent &gamma = addbackEvents_[det][ev];
+            if (gamma.multiplicity == 0)
+                continue;
+            unsigned int i = columnarData_.mult++;
+            if (i >= numColumnarGammas)
+                continue;
+            columnarData_.energy[i] = gamma.energy;
+            columnarData_.time[i] = gamma.time;
+            columnarData_.clover[i] = det;
+            columnarData_.multiplicity[i] = gamma.multiplicity;
+        }
+    }
+}
+
+void CloverProcessor::ColumnarData::Clear(void) {
+    for (unsigned int i = 0; i < numColumnarGammas; ++i) {
+        energy[i] = time[i] = 0;
+        clover[i] = multiplicity[i] = 0;
+    }
+    mult = 0;
+}
+
+void CloverProcessor::StoreCoincidences(unsigned int ev) {
+    double clockInSeconds = Globals::get()->GetClockInSeconds();
+    for (unsigned int det1 = 0; det1 < numClovers; ++det1) {
+        const AddBackEvent &g1 = addbackEvents_[det1][ev];
+        if (g1.energy < gammaThreshold_)
+            continue;
+        for (unsigned int det2 = det1 + 1; det2 < numClovers; ++det2) {
+            const AddBackEvent &g2 = addbackEvents_[det2][ev];
+            if (g2.energy < gammaThreshold_ ||
+                abs(g2.time - g1.time) * clockInSeconds > gammaGammaLimit_)
+                continue;
+            gammaGamma_->Add(g1.energy, g2.energy);
+            for (unsigned int det3 = det2 + 1; det3 < numClovers; ++det3) {
+                const AddBackEvent &g3 = addbackEvents_[det3][ev];
+                if (g3.energy < gammaThreshold_ ||
+                    abs(g3.time - g1.time) * clockInSeconds > gammaGammaLimit_ ||
+                    abs(g3.time - g2.time) * clockInSeconds > gammaGammaLimit_)
+                    continue;
+                gammaGammaGamma_->Add(g1.energy, g2.energy, g3.energy);
+            }
+        }
+    }
 }
 
 /** Declare plots including many for decay/implant/neutron gated analysis  */
@@ -302,8 +420,15 @@ void CloverProcessor::DeclarePlots(void) {
                        energyBins2, energyBins2,
                        "Beta gated gamma gamma cycle gate 2");
 
-    histo.DeclareHistogram2D(DD_ADD_ENERGY,
-                       energyBins2, energyBins2, "Gamma gamma addback");
+    /** The coincidence stores replace the dense addback matrix */
+    if (gammaGamma_ == NULL)
+        histo.DeclareHistogram2D(DD_ADD_ENERGY,
+                           energyBins2, energyBins2, "Gamma gamma addback");
+#ifdef GGATES
+    else
+        histo.DeclareHistogram2D(DD_ADD_ENERGY__GATEX, energyBins2, S5,
+                           "Addback gamma-gamma gated triples");
+#endif
     histo.DeclareHistogram2D(multi::DD_ADD_ENERGY,
                        energyBins2, energyBins2,
                        "Gamma gamma addback multi-gated");
@@ -660,17 +785,11 @@ bool CloverProcessor::Process(RawEvent &event) {
             /**
             * Gamma-gamma gate
             */
-            unsigned ig = 0;
             double e1 = min(gEnergy, gEnergy2);
             double e2 = max(gEnergy, gEnergy2);
-            for (vector< vector<LineGate> >::iterator it_gate =
-                    gGates.begin();
-                    it_gate != gGates.end(); ++it_gate) {
-                if ((*it_gate).size() != 2)
-                    throw NotImplemented("Gamma gates of size different than 2 are not implemented");
-                if ((*it_gate)[0].IsWithin(e1) &&
-                    (*it_gate)[1].IsWithin(e2)) {
-
+            uint64_t gates = lowGateIndex_.GetMask(e1) & highGateIndex_.GetMask(e2);
+            for (unsigned ig = 0; gates != 0; ++ig, gates >>= 1) {
+                if (gates & 1) {
                     double plotResolution = clockInSeconds;
                     histo.Plot(DD_TDIFF__GATEX,
                          (int)(gg_dtime / plotResolution + 100), ig);
@@ -710,7 +829,6 @@ bool CloverProcessor::Process(RawEvent &event) {
                             histo.Plot(betaGated::DD_ENERGY__GATEX, gEnergy3, ig);
                     }
                 }
-                ++ig;
             }
 #endif
         } // iteration over other gammas
@@ -791,7 +909,8 @@ bool CloverProcessor::Process(RawEvent &event) {
                 if (abs(gg_dtime) > gammaGammaLimit_)
                     continue;
 
-                symplot(DD_ADD_ENERGY, gEnergy, gEnergy2);
+                if (gammaGamma_ == NULL)
+                    symplot(DD_ADD_ENERGY, gEnergy, gEnergy2);
                 if (gMulti == 1 && gMulti2 == 1)
                     symplot(multi::DD_ADD_ENERGY, gEnergy, gEnergy2);
                 if (hasBeta) {
@@ -809,6 +928,9 @@ bool CloverProcessor::Process(RawEvent &event) {
                 }
             } // iteration over other clovers
         } // itertaion over clovers
+
+        if (gammaGamma_ != NULL)
+            StoreCoincidences(ev);
     } // iteration over events
 
     EndProcess(); // update the processing time
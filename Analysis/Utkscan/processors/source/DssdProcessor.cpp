@@ -30,7 +30,10 @@ namespace dammIds {
     }
 }
 
-DssdProcessor::DssdProcessor() : EventProcessor(OFFSET, RANGE, "DssdProcessor"), frontSummary(NULL), backSummary(NULL) {
+DssdProcessor::DssdProcessor(const unsigned int &numFrontStrips, const unsigned int &numBackStrips,
+                             const unsigned int &radius) :
+        EventProcessor(OFFSET, RANGE, "DssdProcessor"), frontSummary(NULL), backSummary(NULL),
+        corr_(numFrontStrips, numBackStrips), radius_(radius) {
     associatedTypes.insert("dssd_front");
     associatedTypes.insert("dssd_back");
 }
@@ -63,8 +66,6 @@ bool DssdProcessor::Process(RawEvent &event) {
     if (!EventProcessor::Process(event))
         return false;
 
-    static Correlator corr;
-
     //some kind of magic number that correlates to some kind of useful value.
     static double cutoffEnergy = 4800;
 
@@ -74,9 +75,6 @@ bool DssdProcessor::Process(RawEvent &event) {
     if (backSummary == NULL)
         backSummary = event.GetSummary("dssd_back");
 
-    //Removed this until it can be updated with the TreeCorrelator
-    //static Correlator &corr = event.GetCorrelator();
-
     int frontPos = numeric_limits<int>::max(), backPos = numeric_limits<int>::max();
     double frontEnergy, backEnergy, frontTime = 0.;
 
@@ -113,7 +111,10 @@ bool DssdProcessor::Process(RawEvent &event) {
         } else {
             corEvent.type = EventInfo::UNKNOWN_EVENT;
         }
-        corr.Correlate(corEvent, frontPos, backPos);
+        //Charge sharing between the strips can move a decay out of the pixel of its implant.
+        if (corEvent.type != EventInfo::DECAY_EVENT || radius_ == 0
+            || !corr_.CorrelateNeighbourhood(corEvent, frontPos, backPos, radius_))
+            corr_.Correlate(corEvent, frontPos, backPos);
     } else if (hasFront) {
         if (frontEnergy > cutoffEnergy) {
             corEvent.type = EventInfo::IMPLANT_EVENT;
@@ -140,13 +141,13 @@ bool DssdProcessor::Process(RawEvent &event) {
             histo.Plot(DD_DECAY_BACK_ENERGY__POSITION, backEnergy, backPos);
         if (hasFront && hasBack)
             histo.Plot(DD_DECAY_POSITION, backPos, frontPos);
-        if (corr.GetCondition() == Correlator::VALID_DECAY) {
+        if (corr_.GetCondition() == Correlator::VALID_DECAY) {
             const unsigned int NumGranularities = 8;
             // time resolution in seconds per bin
             const double timeResolution[NumGranularities] = {10e-9, 100e-9, 400e-9, 1e-6, 100e-6, 1e-3, 10e-3, 100e-3};
 
             for (unsigned int i = 0; i < NumGranularities; i++) {
-                int timeBin = int(corr.GetDecayTime() * Globals::get()->GetFilterClockInSeconds() / timeResolution[i]);
+                int timeBin = int(corr_.GetDecayTime() * Globals::get()->GetFilterClockInSeconds() / timeResolution[i]);
 
                 histo.Plot(DD_ENERGY__DECAY_TIME_GRANX + i, frontEnergy, timeBin);
             }
@@ -59,9 +59,10 @@ namespace dammIds {
     }
 }
 
-ImplantSsdProcessor::ImplantSsdProcessor() :
-        EventProcessor(OFFSET, RANGE, "ImplantSsdProcessor") {
+ImplantSsdProcessor::ImplantSsdProcessor(const unsigned int &numStrips, const unsigned int &numPositions) :
+        EventProcessor(OFFSET, RANGE, "ImplantSsdProcessor"), corr_(numStrips, numPositions) {
     associatedTypes.insert("ssd");
+    dependencies.insert("LogicProcessor");
 }
 
 void ImplantSsdProcessor::DeclarePlots(void) {
@@ -157,7 +158,6 @@ bool ImplantSsdProcessor::Process(RawEvent &event) {
     static bool firstTime = true;
     static LogicProcessor *logProc = NULL;
 
-    static Correlator corr;
     static const DetectorSummary *tacSummary = event.GetSummary("generic:tac", true);
     static DetectorSummary *impSummary = event.GetSummary("ssd:sum", true);
     static const DetectorSummary *mcpSummary = event.GetSummary("logic:mcp", true);
@@ -284,7 +284,7 @@ bool ImplantSsdProcessor::Process(RawEvent &event) {
     }
 
     SetType(info);
-    Correlate(corr, info, location);
+    Correlate(corr_, info, location);
 
     // TOF spectra update
     if (tacSummary) {
@@ -331,12 +331,12 @@ bool ImplantSsdProcessor::Process(RawEvent &event) {
         //info.time = trigTime + trace.GetValue("filterTime2") - trace.GetValue("filterTime");
 
         SetType(info);
-        Correlate(corr, info, location);
+        Correlate(corr_, info, location);
 
         int numPulses = trace.GetTriggerPositions().size();
 
         if (numPulses > 2) {
-            corr.Flag(location, 1);
+            corr_.Flag(location, 1);
             cout << "Flagging triple event" << endl;
             for (int i = 3; i <= numPulses; i++) {
                 stringstream str;
@@ -347,7 +347,7 @@ bool ImplantSsdProcessor::Process(RawEvent &event) {
                 //info.time = trigTime + trace.GetValue(str.str()) - trace.GetValue("filterTime");
 
                 SetType(info);
-                Correlate(corr, info, location);
+                Correlate(corr_, info, location);
             }
         }
         // corr.Flag(location, 1);
@@ -369,7 +369,7 @@ bool ImplantSsdProcessor::Process(RawEvent &event) {
     }
 
     if (info.energy > 10000 && !ch->IsSaturated() && !std::isnan(info.position)) {
-        corr.Flag(location, info.position);
+        corr_.Flag(location, info.position);
     }
 
     if (info.energy > 8000 && !trace.empty()) {
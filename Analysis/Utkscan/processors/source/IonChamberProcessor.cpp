@@ -6,6 +6,7 @@
 
 #include <cmath>
 
+#include "ColumnarWriter.hpp"
 #include "DammPlotIds.hpp"
 #include "Globals.hpp"
 #include "RawEvent.hpp"
@@ -180,6 +181,11 @@ bool IonChamberProcessor::AddBranch(TTree *tree) {
     return false;
 }
 
+bool IonChamberProcessor::AddBranch(ColumnarWriter &writer) {
+    writer.AddColumns(name, &data, "raw[6]/D:cal[6]:mult/I");
+    return true;
+}
+
 void IonChamberProcessor::FillBranch(void) {
     if (!HasEvent())
         data.Clear();
@@ -308,7 +308,7 @@ bool PspmtProcessor::PreProcess(RawEvent &event) {
                 histo.Plot(D_TEMP4, f * qd);
             }
 
-            for (vector<unsigned int>::iterator ittr = trace.begin();
+            for (Trace::iterator ittr = trace.begin();
                  ittr != trace.end(); ittr++)
                 histo.Plot(DD_SINGLE_TRACE, ittr - trace.begin(), traceNum, *ittr);
         }
@@ -14,6 +14,7 @@
 #include <cmath>
 
 #include "BarBuilder.hpp"
+#include "ColumnarWriter.hpp"
 #include "DammPlotIds.hpp"
 #include "DetectorDriver.hpp"
 #include "RawEvent.hpp"
@@ -84,6 +85,9 @@ bool VandleProcessor::PreProcess(RawEvent &event) {
 
     bars_.clear();
     starts_.clear();
+    //The analyzed bars point into bars_
+    analyzedBars_.clear();
+    kernel_.Clear();
 
     static const vector<ChanEvent *> &events = event.GetSummary("vandle")->GetList();
 
@@ -131,48 +135,46 @@ bool VandleProcessor::Process(RawEvent &event) {
     startBars.BuildBars();
     barStarts_ = startBars.GetBarMap();
 
-    for (BarMap::iterator it = bars_.begin(); it != bars_.end(); it++) {
-        TimingDefs::TimingIdentifier barId = (*it).first;
-        BarDetector bar = (*it).second;
+    //With Double Beta starts we do not analyze the single sided starts, see the class description.
+    kernel_.Clear();
+    if (!doubleBetaStarts.empty()) {
+        for (BarMap::const_iterator it = barStarts_.begin(); it != barStarts_.end(); it++)
+            kernel_.AddStart(it->second.GetCorTimeAve(), it->first.first);
+    } else {
+        for (TimingMap::const_iterator it = starts_.begin(); it != starts_.end(); it++)
+            if (it->second.GetIsValid())
+                kernel_.AddStart(it->second.GetWalkCorrectedTime(), it->first.first);
+    }
 
+    analyzedBars_.clear();
+    for (BarMap::const_iterator it = bars_.begin(); it != bars_.end(); it++) {
+        const BarDetector &bar = it->second;
         if (!bar.GetHasEvent())
             continue;
-
-        if (!doubleBetaStarts.empty())
-            AnalyzeBarStarts(bar, barId.first);
-        else
-            AnalyzeStarts(bar, barId.first);
+        kernel_.AddBar(bar.GetCorTimeAve(), bar.GetFlightPath(), bar.GetCalibration());
+        analyzedBars_.push_back(it);
     }
 
+    kernel_.Calculate();
+    PlotTofHistograms();
+
     EndProcess();
     return true;
 }
 
-void VandleProcessor::AnalyzeBarStarts(const BarDetector &bar, unsigned int &barLoc) {
-        for (BarMap::iterator itStart = barStarts_.begin(); itStart != barStarts_.end(); itStart++) {
-            unsigned int startLoc = (*itStart).first.first;
-            BarDetector start = (*itStart).second;
-
-            double tof = bar.GetCorTimeAve() - start.GetCorTimeAve() + bar.GetCalibration().GetTofOffset(startLoc);
-            double corTof = CorrectTOF(tof, bar.GetFlightPath(), bar.GetCalibration().GetZ0());
-
-            PlotTofHistograms(tof, corTof, bar.GetQdc(), barLoc * numStarts_ + startLoc, ReturnOffset(bar.GetType()));
-        }
-}
-
-void VandleProcessor::AnalyzeStarts(const BarDetector &bar, unsigned int &barLoc) {
-        for (TimingMap::iterator itStart = starts_.begin(); itStart != starts_.end(); itStart++) {
-            if (!(*itStart).second.GetIsValid())
-                continue;
-
-            unsigned int startLoc = (*itStart).first.first;
-            HighResTimingData start = (*itStart).second;
-
-            double tof = bar.GetCorTimeAve() - start.GetWalkCorrectedTime() + bar.GetCalibration().GetTofOffset(startLoc);
-            double corTof = CorrectTOF(tof, bar.GetFlightPath(), bar.GetCalibration().GetZ0());
-
-            PlotTofHistograms(tof, corTof, bar.GetQdc(), barLoc * numStarts_ + startLoc, ReturnOffset(bar.GetType()));
-        }
+void VandleProcessor::PlotTofHistograms(void) {
+    const vector<double> &tofs = kernel_.GetTofs();
+    const vector<double> &corTofs = kernel_.GetCorrectedTofs();
+    const size_t numStarts = kernel_.GetNumberOfStarts();
+
+    for (size_t bar = 0; bar < analyzedBars_.size(); bar++) {
+        unsigned int barLoc = analyzedBars_[bar]->first.first;
+        double qdc = analyzedBars_[bar]->second.GetQdc();
+        unsigned int offset = ReturnOffset(analyzedBars_[bar]->second.GetType());
+        for (size_t start = 0; start < numStarts; start++)
+            PlotTofHistograms(tofs[bar * numStarts + start], corTofs[bar * numStarts + start], qdc,
+                              barLoc * numStarts_ + kernel_.GetStartLocation(start), offset);
+    }
 }
 
 void VandleProcessor::PlotTofHistograms(const double &tof, const double &cortof, const double &qdc,
@@ -206,6 +208,43 @@ void VandleProcessor::FillVandleOnlyHists(void) {
     }
 }
 
+bool VandleProcessor::AddBranch(ColumnarWriter &writer) {
+    const string size = "[" + to_string(numColumnarTofs) + "]";
+    writer.AddColumns(name, &columnarData_,
+                      "qdc" + size + "/D:tof" + size + ":corTof" + size + ":bar" + size + "/i:start" + size + ":mult");
+    return true;
+}
+
+void VandleProcessor::FillBranch(void) {
+    columnarData_.Clear();
+    if (!HasEvent())
+        return;
+
+    const vector<double> &tofs = kernel_.GetTofs();
+    const vector<double> &corTofs = kernel_.GetCorrectedTofs();
+    const size_t numStarts = kernel_.GetNumberOfStarts();
+    for (size_t bar = 0; bar < analyzedBars_.size(); bar++) {
+        for (size_t start = 0; start < numStarts; start++, columnarData_.mult++) {
+            unsigned int i = columnarData_.mult;
+            if (i >= numColumnarTofs)
+                continue;
+            columnarData_.qdc[i] = analyzedBars_[bar]->second.GetQdc();
+            columnarData_.tof[i] = tofs[bar * numStarts + start];
+            columnarData_.corTof[i] = corTofs[bar * numStarts + start];
+            columnarData_.bar[i] = analyzedBars_[bar]->first.first;
+            columnarData_.start[i] = kernel_.GetStartLocation(start);
+        }
+    }
+}
+
+void VandleProcessor::ColumnarData::Clear(void) {
+    for (unsigned int i = 0; i < numColumnarTofs; i++) {
+        qdc[i] = tof[i] = corTof[i] = 0;
+        bar[i] = start[i] = 0;
+    }
+    mult = 0;
+}
+
 unsigned int VandleProcessor::ReturnOffset(const std::string &type) {
     if (type == "small")
         return 0;
@@ -22,6 +22,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "SampleSpan.hpp"
+
 ///@TODO : Get rid of this. It's dangerous in a header. WTF Was I thinking???
 using namespace std;
 
@@ -44,7 +46,7 @@ namespace Filtering {
     ///@param[in] g : The filter gap.
     ///@returns A vector<double> containing the filter
     template<class T>
-    static const vector<double> TrapezoidalFilter(const vector<T> &data, const int &l, const int &g) {
+    static const vector<double> TrapezoidalFilter(const SampleSpan<T> &data, const int &l, const int &g) {
         if (data.empty())
             throw invalid_argument("HelperFunctions::Filtering::TrapezoidalFilter - The data vector was empty!");
 
@@ -66,6 +68,11 @@ namespace Filtering {
         }
         return filter;
     }
+
+    template<class T>
+    static const vector<double> TrapezoidalFilter(const vector<T> &data, const int &l, const int &g) {
+        return TrapezoidalFilter(SampleSpan<T>(data), l, g);
+    }
 }
 
 namespace Polynomial {
@@ -89,7 +96,7 @@ namespace Polynomial {
 
     template<class T>
     static const pair<double, vector<double> > CalculatePoly2(
-            const vector<T> &data, const unsigned int &startBin) {
+            const SampleSpan<T> &data, const unsigned int &startBin) {
         if (data.size() < 3)
             throw range_error("Polynomial::CalculatePoly2 - The data vector "
                                       "had the wrong size : " + std::to_string(data.size()));
@@ -123,8 +130,14 @@ namespace Polynomial {
     }
 
     template<class T>
-    static const pair<double, vector<double> > CalculatePoly3(
+    static const pair<double, vector<double> > CalculatePoly2(
             const vector<T> &data, const unsigned int &startBin) {
+        return CalculatePoly2(SampleSpan<T>(data), startBin);
+    }
+
+    template<class T>
+    static const pair<double, vector<double> > CalculatePoly3(
+            const SampleSpan<T> &data, const unsigned int &startBin) {
         if (data.size() < 4)
             throw range_error("Polynomial::CalculatePoly3 - The data vector "
                                       "had the wrong size : " + std::to_string(data.size()));
@@ -230,39 +243,56 @@ namespace Polynomial {
         return make_pair(p0 + p1 * xmax + p2 * xmax * xmax +
                          p3 * xmax * xmax * xmax, coeffs);
     }
+
+    template<class T>
+    static const pair<double, vector<double> > CalculatePoly3(
+            const vector<T> &data, const unsigned int &startBin) {
+        return CalculatePoly3(SampleSpan<T>(data), startBin);
+    }
 }//Polynomial namespace
 
 namespace Statistics {
     template<class T>
-    inline double CalculateAverage(const vector<T> &data) {
+    inline double CalculateAverage(const SampleSpan<T> &data) {
         double sum = 0.0;
-        for (typename vector<T>::const_iterator i = data.begin();
+        for (typename SampleSpan<T>::const_iterator i = data.begin();
              i != data.end(); i++)
             sum += *i;
         sum /= data.size();
         return sum;
     }
 
+    template<class T>
+    inline double CalculateAverage(const vector<T> &data) {
+        return CalculateAverage(SampleSpan<T>(data));
+    }
+
     //This calculation for the standard deviation assumes that we are
     // analyzing the full population, which we are in this case.
     template<class T>
-    inline double CalculateStandardDeviation(const vector<T> &data,
+    inline double CalculateStandardDeviation(const SampleSpan<T> &data,
                                              const double &mean) {
         double stddev = 0.0;
-        for (typename vector<T>::const_iterator it = data.begin();
+        for (typename SampleSpan<T>::const_iterator it = data.begin();
              it != data.end(); it++)
             stddev += pow(*it - mean, 2);
         stddev = sqrt(stddev / (double) data.size());
         return stddev;
     }
 
+    template<class T>
+    inline double CalculateStandardDeviation(const vector<T> &data,
+                                             const double &mean) {
+        return CalculateStandardDeviation(SampleSpan<T>(data), mean);
+    }
+
     ///@brief Do a quick and simple integration of the provided data using the
     /// trapezoidal rule. We will not be subtracting the baseline or anything
     /// like that to keep things general.
     ///@param[in] data : The data that we want to integrate.
     ///@return The integrated value
     template<class T>
-    inline double CalculateIntegral(const vector<T> &data) {
+    inline double CalculateIntegral(const SampleSpan<T> &data) {
         if (data.size() < 2)
             throw range_error("Statistical::CalculateIntegral - The data "
                                       "vector was too small to integrate. We "
@@ -272,6 +302,11 @@ namespace Statistics {
             integral += 0.5 * (double(data[i - 1] + data[i]));
         return integral;
     }
+
+    template<class T>
+    inline double CalculateIntegral(const vector<T> &data) {
+        return CalculateIntegral(SampleSpan<T>(data));
+    }
 }
 
 namespace TraceFunctions {
@@ -309,15 +344,12 @@ namespace TraceFunctions {
             throw range_error("TraceFunctions::ComputeBaseline - The range "
                                       "specified is smaller than the minimum"
                                       " necessary range.");
-        double baseline =
-                Statistics::CalculateAverage(
-                        vector<T>(data.begin(), data.begin() +
-                                                range.second));
+        const SampleSpan<T> baselineSamples =
+                SampleSpan<T>(data).SubSpan(0, range.second);
+        double baseline = Statistics::CalculateAverage(baselineSamples);
         double stddev =
-                Statistics::CalculateStandardDeviation(
-                        vector<T>(data.begin(), data.begin() +
-                                                range.second),
-                        baseline);
+                Statistics::CalculateStandardDeviation(baselineSamples,
+                                                       baseline);
         return make_pair(baseline, stddev);
     }
 
@@ -462,8 +494,8 @@ namespace TraceFunctions {
             throw range_error(msg.str());
         }
         return Statistics::CalculateIntegral(
-                vector<T>(data.begin() + range.first,
-                          data.begin() + range.second));
+                SampleSpan<T>(data).SubSpan(range.first,
+                                            range.second - range.first));
     }
 
     template<class T>
@@ -488,8 +520,8 @@ namespace TraceFunctions {
                                       "issues.");
 
         return Statistics::CalculateIntegral(
-                vector<T>(data.begin() + range.first,
-                          data.begin() + range.second)) / qdc;
+                SampleSpan<T>(data).SubSpan(range.first,
+                                            range.second - range.first)) / qdc;
 
     }
 
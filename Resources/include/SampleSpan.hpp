@@ -0,0 +1,68 @@
+///@file SampleSpan.hpp
+///@brief A read-only view over a contiguous range of samples (only depends on standard C++ headers).
+///@date October 17, 2026
+#ifndef PIXIESUITE_SAMPLESPAN_HPP
+#define PIXIESUITE_SAMPLESPAN_HPP
+
+#include <vector>
+
+#include <cstddef>
+
+///A pointer and a length into samples that someone else owns, e.g. a trace or a waveform. Functions that only read
+/// the samples take a span so that callers can hand them a whole vector or a piece of one without copying it. The
+/// span is only valid as long as the samples that it points to.
+template<class T>
+class SampleSpan {
+public:
+    typedef T value_type; ///< The type of the samples
+    typedef const T *const_iterator; ///< The iterator over the samples
+    typedef const T *iterator; ///< The samples are read-only, so both iterators are the same
+    typedef size_t size_type; ///< The type of the size
+
+    ///Default constructor, the span is empty
+    SampleSpan() : data_(NULL), size_(0) {}
+
+    ///Constructor
+    ///@param[in] data : The first sample
+    ///@param[in] size : The number of samples
+    SampleSpan(const T *data, const size_t &size) : data_(data), size_(size) {}
+
+    ///Constructor viewing all of the samples of a vector. This is not explicit so that a vector can be passed
+    /// wherever a span is expected.
+    ///@param[in] data : The vector with the samples
+    SampleSpan(const std::vector<T> &data) : data_(data.data()), size_(data.size()) {}
+
+    ///@return An iterator to the first sample
+    const_iterator begin() const { return data_; }
+
+    ///@return A pointer to the first sample
+    const T *data() const { return data_; }
+
+    ///@return True if there are no samples
+    bool empty() const { return size_ == 0; }
+
+    ///@return An iterator past the last sample
+    const_iterator end() const { return data_ + size_; }
+
+    ///@return The number of samples
+    size_t size() const { return size_; }
+
+    ///@param[in] offset : The first sample of the piece
+    ///@param[in] count : The number of samples in the piece
+    ///@return The piece of the span starting at offset, clamped to the end of the span
+    SampleSpan SubSpan(const size_t &offset, const size_t &count) const {
+        if (offset >= size_)
+            return SampleSpan(data_ + size_, 0);
+        return SampleSpan(data_ + offset, count < size_ - offset ? count : size_ - offset);
+    }
+
+    ///@param[in] i : The index of the sample
+    ///@return The sample, there is no bounds checking
+    const T &operator[](const size_t &i) const { return data_[i]; }
+
+private:
+    const T *data_; ///< The first sample
+    size_t size_; ///< The number of samples
+};
+
+#endif //PIXIESUITE_SAMPLESPAN_HPP
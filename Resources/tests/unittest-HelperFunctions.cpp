@@ -94,6 +94,22 @@ TEST(TestCalculateIntegral) {
     CHECK_EQUAL(integral, Statistics::CalculateIntegral(integration_data));
 }
 
+///Checks that the statistics see the same samples through a span as through a copy of the range.
+TEST(TestSampleSpan) {
+    SampleSpan<unsigned int> samples(trace);
+    CHECK_EQUAL(trace.size(), samples.size());
+    CHECK(samples.data() == trace.data());
+
+    SampleSpan<unsigned int> piece = samples.SubSpan(70, 21);
+    vector<unsigned int> copy(trace.begin() + 70, trace.begin() + 91);
+    CHECK_EQUAL(copy.size(), piece.size());
+    CHECK_EQUAL(Statistics::CalculateIntegral(copy), Statistics::CalculateIntegral(piece));
+    CHECK_EQUAL(Statistics::CalculateAverage(copy), Statistics::CalculateAverage(piece));
+
+    CHECK_EQUAL(10u, samples.SubSpan(trace.size() - 10, 100).size());
+    CHECK(samples.SubSpan(trace.size() + 10, 4).empty());
+}
+
 TEST(TestCalculateQdc) {
     CHECK_THROW(TraceFunctions::CalculateQdc(empty_vector_uint, make_pair(0, 4)), range_error);
     CHECK_THROW(TraceFunctions::CalculateQdc(trace, make_pair(0, trace.size() + 10)), range_error);